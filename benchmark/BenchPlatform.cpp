@@ -0,0 +1,861 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "BenchPlatform.hpp"
+#include "Exception.hpp"
+#include "geopm_hash.h"
+#include "geopm_message.h"
+
+using geopm::IPlatformTopo;
+using geopm::Exception;
+
+BenchIOGroup::BenchIOGroup(IPlatformTopo &topo)
+    : m_topo(topo)
+    , m_signal({{"TIME", IPlatformTopo::M_DOMAIN_BOARD},
+                {"ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE},
+                {"ENERGY_DRAM", IPlatformTopo::M_DOMAIN_PACKAGE},
+                {"FREQUENCY", IPlatformTopo::M_DOMAIN_CPU},
+                {"REGION_ID#", IPlatformTopo::M_DOMAIN_CPU},
+                {"REGION_PROGRESS", IPlatformTopo::M_DOMAIN_CPU},
+                {"REGION_RUNTIME", IPlatformTopo::M_DOMAIN_CPU},
+                {"EPOCH_RUNTIME", IPlatformTopo::M_DOMAIN_BOARD},
+                {"EPOCH_COUNT", IPlatformTopo::M_DOMAIN_BOARD},
+                {"POWER_PACKAGE_MIN", IPlatformTopo::M_DOMAIN_PACKAGE},
+                {"POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE}})
+    , m_region_id({geopm_crc32_str(0, "bench_dgemm"),
+                   geopm_crc32_str(0, "bench_stream"),
+                   geopm_crc32_str(0, "bench_all2all")})
+    , m_time_zero({{0, 0}})
+    , m_time(0.0)
+    , m_num_read(0)
+{
+    geopm_time(&m_time_zero);
+}
+
+std::set<std::string> BenchIOGroup::signal_names(void) const
+{
+    std::set<std::string> result;
+    for (const auto &it : m_signal) {
+        result.insert(it.name);
+    }
+    return result;
+}
+
+std::set<std::string> BenchIOGroup::control_names(void) const
+{
+    return {"POWER_PACKAGE"};
+}
+
+bool BenchIOGroup::is_valid_signal(const std::string &signal_name) const
+{
+    return signal_id(signal_name) != -1;
+}
+
+bool BenchIOGroup::is_valid_control(const std::string &control_name) const
+{
+    return control_name == "POWER_PACKAGE";
+}
+
+int BenchIOGroup::signal_domain_type(const std::string &signal_name) const
+{
+    int signal = signal_id(signal_name);
+    return signal == -1 ? IPlatformTopo::M_DOMAIN_INVALID : m_signal[signal].domain_type;
+}
+
+int BenchIOGroup::control_domain_type(const std::string &control_name) const
+{
+    return is_valid_control(control_name) ? IPlatformTopo::M_DOMAIN_PACKAGE :
+                                            IPlatformTopo::M_DOMAIN_INVALID;
+}
+
+int BenchIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+{
+    int signal = signal_id(signal_name);
+    if (signal == -1 || domain_type != m_signal[signal].domain_type ||
+        domain_idx < 0 || domain_idx >= m_topo.num_domain(domain_type)) {
+        throw Exception("BenchIOGroup::push_signal(): invalid request for " + signal_name,
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    auto request = std::make_pair(signal, domain_idx);
+    auto it = std::find(m_pushed_signal.begin(), m_pushed_signal.end(), request);
+    int result = it - m_pushed_signal.begin();
+    if (it == m_pushed_signal.end()) {
+        m_pushed_signal.push_back(request);
+        m_sample.push_back(NAN);
+    }
+    return result;
+}
+
+int BenchIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+{
+    if (!is_valid_control(control_name) || domain_type != IPlatformTopo::M_DOMAIN_PACKAGE ||
+        domain_idx < 0 || domain_idx >= m_topo.num_domain(domain_type)) {
+        throw Exception("BenchIOGroup::push_control(): invalid request for " + control_name,
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    m_setting.resize(m_topo.num_domain(domain_type), NAN);
+    return domain_idx;
+}
+
+void BenchIOGroup::read_batch(void)
+{
+    struct geopm_time_s now;
+    geopm_time(&now);
+    m_time = geopm_time_diff(&m_time_zero, &now);
+    for (size_t idx = 0; idx < m_pushed_signal.size(); ++idx) {
+        m_sample[idx] = value(m_pushed_signal[idx].first, m_pushed_signal[idx].second, m_time);
+    }
+    ++m_num_read;
+}
+
+void BenchIOGroup::write_batch(void)
+{
+
+}
+
+double BenchIOGroup::sample(int sample_idx)
+{
+    return m_sample.at(sample_idx);
+}
+
+void BenchIOGroup::adjust(int control_idx, double setting)
+{
+    m_setting.at(control_idx) = setting;
+}
+
+double BenchIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+{
+    int signal = signal_id(signal_name);
+    if (signal == -1 || domain_type != m_signal[signal].domain_type) {
+        throw Exception("BenchIOGroup::read_signal(): invalid request for " + signal_name,
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    struct geopm_time_s now;
+    geopm_time(&now);
+    return value(signal, domain_idx, geopm_time_diff(&m_time_zero, &now));
+}
+
+void BenchIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+{
+
+}
+
+void BenchIOGroup::save_control(void)
+{
+
+}
+
+void BenchIOGroup::restore_control(void)
+{
+
+}
+
+int BenchIOGroup::signal_id(const std::string &signal_name) const
+{
+    int result = -1;
+    for (int signal = 0; result == -1 && signal < M_NUM_SIGNAL; ++signal) {
+        if (m_signal[signal].name == signal_name) {
+            result = signal;
+        }
+    }
+    return result;
+}
+
+double BenchIOGroup::value(int signal, int domain_idx, double time) const
+{
+    // Values follow a fixed pattern: the application moves through
+    // the regions in m_region_id spending M_READ_PER_REGION reads in
+    // each, and one pass through all regions is an epoch.
+    uint64_t region_count = m_num_read / M_READ_PER_REGION;
+    double progress = (double)(m_num_read % M_READ_PER_REGION) / M_READ_PER_REGION;
+    double result = NAN;
+    switch (signal) {
+        case M_SIGNAL_TIME:
+            result = time;
+            break;
+        case M_SIGNAL_ENERGY_PACKAGE:
+            result = (100.0 + domain_idx) * time;
+            break;
+        case M_SIGNAL_ENERGY_DRAM:
+            result = (15.0 + domain_idx) * time;
+            break;
+        case M_SIGNAL_FREQUENCY:
+            result = 2.1e9 - 1e8 * (region_count % m_region_id.size());
+            break;
+        case M_SIGNAL_REGION_ID:
+            result = geopm_field_to_signal(m_region_id[region_count % m_region_id.size()]);
+            break;
+        case M_SIGNAL_REGION_PROGRESS:
+            result = progress;
+            break;
+        case M_SIGNAL_REGION_RUNTIME:
+            result = 0.005 * M_READ_PER_REGION;
+            break;
+        case M_SIGNAL_EPOCH_RUNTIME:
+            result = 0.005 * M_READ_PER_REGION * m_region_id.size();
+            break;
+        case M_SIGNAL_EPOCH_COUNT:
+            result = region_count / m_region_id.size();
+            break;
+        case M_SIGNAL_POWER_PACKAGE_MIN:
+            result = 50.0;
+            break;
+        case M_SIGNAL_POWER_PACKAGE_MAX:
+            result = 150.0;
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+BenchRegionSchedule::BenchRegionSchedule(const std::vector<std::pair<uint64_t, double> > &cycle)
+    : m_cycle(cycle)
+    , m_period(0.0)
+    , m_time_zero({{0, 0}})
+{
+    if (m_cycle.empty()) {
+        throw Exception("BenchRegionSchedule: cycle is empty",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    for (const auto &region : m_cycle) {
+        m_offset.push_back(m_period);
+        m_period += region.second;
+    }
+    geopm_time(&m_time_zero);
+}
+
+double BenchRegionSchedule::time(void) const
+{
+    struct geopm_time_s now;
+    geopm_time(&now);
+    return geopm_time_diff(&m_time_zero, &now);
+}
+
+uint64_t BenchRegionSchedule::num_entry(double time) const
+{
+    uint64_t num_cycle = time / m_period;
+    double cycle_time = time - num_cycle * m_period;
+    uint64_t result = num_cycle * m_cycle.size();
+    for (double offset : m_offset) {
+        if (offset <= cycle_time) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+uint64_t BenchRegionSchedule::region_id(uint64_t region_idx) const
+{
+    return m_cycle[region_idx % m_cycle.size()].first;
+}
+
+double BenchRegionSchedule::entry_time(uint64_t region_idx) const
+{
+    return (region_idx / m_cycle.size()) * m_period + m_offset[region_idx % m_cycle.size()];
+}
+
+double BenchRegionSchedule::duration(uint64_t region_idx) const
+{
+    return m_cycle[region_idx % m_cycle.size()].second;
+}
+
+BenchRegionIOGroup::BenchRegionIOGroup(std::shared_ptr<const BenchRegionSchedule> schedule,
+                                       double freq_min, double freq_max, double freq_step)
+    : m_schedule(schedule)
+    , m_constant({{"CPUINFO::FREQ_MIN", freq_min},
+                  {"CPUINFO::FREQ_MAX", freq_max},
+                  {"CPUINFO::FREQ_STEP", freq_step},
+                  {"CPUINFO::FREQ_STICKER", freq_max - freq_step}})
+    , m_setting(NAN)
+{
+
+}
+
+std::set<std::string> BenchRegionIOGroup::signal_names(void) const
+{
+    std::set<std::string> result {"TIME", "REGION_ID#", "ENERGY_PACKAGE", "ENERGY_DRAM"};
+    for (const auto &it : m_constant) {
+        result.insert(it.first);
+    }
+    return result;
+}
+
+std::set<std::string> BenchRegionIOGroup::control_names(void) const
+{
+    return {"FREQUENCY"};
+}
+
+bool BenchRegionIOGroup::is_valid_signal(const std::string &signal_name) const
+{
+    return signal_names().count(signal_name) != 0;
+}
+
+bool BenchRegionIOGroup::is_valid_control(const std::string &control_name) const
+{
+    return control_name == "FREQUENCY";
+}
+
+int BenchRegionIOGroup::signal_domain_type(const std::string &signal_name) const
+{
+    return is_valid_signal(signal_name) ? IPlatformTopo::M_DOMAIN_BOARD :
+                                          IPlatformTopo::M_DOMAIN_INVALID;
+}
+
+int BenchRegionIOGroup::control_domain_type(const std::string &control_name) const
+{
+    return is_valid_control(control_name) ? IPlatformTopo::M_DOMAIN_BOARD :
+                                            IPlatformTopo::M_DOMAIN_INVALID;
+}
+
+int BenchRegionIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+{
+    if (!is_valid_signal(signal_name) || domain_type != IPlatformTopo::M_DOMAIN_BOARD ||
+        domain_idx != 0) {
+        throw Exception("BenchRegionIOGroup::push_signal(): invalid request for " + signal_name,
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    auto it = std::find(m_pushed_signal.begin(), m_pushed_signal.end(), signal_name);
+    int result = it - m_pushed_signal.begin();
+    if (it == m_pushed_signal.end()) {
+        m_pushed_signal.push_back(signal_name);
+        m_sample.push_back(NAN);
+    }
+    return result;
+}
+
+int BenchRegionIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+{
+    if (!is_valid_control(control_name) || domain_type != IPlatformTopo::M_DOMAIN_BOARD ||
+        domain_idx != 0) {
+        throw Exception("BenchRegionIOGroup::push_control(): invalid request for " + control_name,
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    return 0;
+}
+
+void BenchRegionIOGroup::read_batch(void)
+{
+    double time = m_schedule->time();
+    for (size_t idx = 0; idx < m_pushed_signal.size(); ++idx) {
+        m_sample[idx] = value(m_pushed_signal[idx], time);
+    }
+}
+
+void BenchRegionIOGroup::write_batch(void)
+{
+    if (!std::isnan(m_setting) &&
+        (m_frequency_write.empty() || m_frequency_write.back().second != m_setting)) {
+        m_frequency_write.emplace_back(m_schedule->time(), m_setting);
+    }
+}
+
+double BenchRegionIOGroup::sample(int sample_idx)
+{
+    return m_sample.at(sample_idx);
+}
+
+void BenchRegionIOGroup::adjust(int control_idx, double setting)
+{
+    m_setting = setting;
+}
+
+double BenchRegionIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+{
+    if (!is_valid_signal(signal_name) || domain_type != IPlatformTopo::M_DOMAIN_BOARD) {
+        throw Exception("BenchRegionIOGroup::read_signal(): invalid request for " + signal_name,
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    return value(signal_name, m_schedule->time());
+}
+
+void BenchRegionIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+{
+
+}
+
+void BenchRegionIOGroup::save_control(void)
+{
+
+}
+
+void BenchRegionIOGroup::restore_control(void)
+{
+
+}
+
+const std::vector<std::pair<double, double> > &BenchRegionIOGroup::frequency_write(void) const
+{
+    return m_frequency_write;
+}
+
+double BenchRegionIOGroup::value(const std::string &signal_name, double time) const
+{
+    double result = NAN;
+    auto it = m_constant.find(signal_name);
+    if (it != m_constant.end()) {
+        result = it->second;
+    }
+    else if (signal_name == "TIME") {
+        result = time;
+    }
+    else if (signal_name == "REGION_ID#") {
+        result = geopm_field_to_signal(m_schedule->region_id(m_schedule->num_entry(time) - 1));
+    }
+    else if (signal_name == "ENERGY_PACKAGE") {
+        result = 100.0 * time;
+    }
+    else if (signal_name == "ENERGY_DRAM") {
+        result = 15.0 * time;
+    }
+    return result;
+}
+
+NoWaitAgent::NoWaitAgent(std::unique_ptr<geopm::Agent> agent)
+    : m_agent(std::move(agent))
+{
+
+}
+
+void NoWaitAgent::init(int level, const std::vector<int> &fan_in, bool is_level_root)
+{
+    m_agent->init(level, fan_in, is_level_root);
+}
+
+bool NoWaitAgent::descend(const std::vector<double> &in_policy,
+                          std::vector<std::vector<double> > &out_policy)
+{
+    return m_agent->descend(in_policy, out_policy);
+}
+
+bool NoWaitAgent::ascend(const std::vector<std::vector<double> > &in_signal,
+                         std::vector<double> &out_signal)
+{
+    return m_agent->ascend(in_signal, out_signal);
+}
+
+bool NoWaitAgent::descend_view(const std::vector<double> &in_policy,
+                               geopm::MatrixView<double> out_policy)
+{
+    return m_agent->descend_view(in_policy, out_policy);
+}
+
+bool NoWaitAgent::ascend_view(geopm::MatrixView<const double> in_signal,
+                              std::vector<double> &out_signal)
+{
+    return m_agent->ascend_view(in_signal, out_signal);
+}
+
+bool NoWaitAgent::adjust_platform(const std::vector<double> &policy)
+{
+    return m_agent->adjust_platform(policy);
+}
+
+bool NoWaitAgent::sample_platform(std::vector<double> &sample)
+{
+    return m_agent->sample_platform(sample);
+}
+
+void NoWaitAgent::wait(void)
+{
+
+}
+
+std::vector<std::pair<std::string, std::string> > NoWaitAgent::report_header(void) const
+{
+    return m_agent->report_header();
+}
+
+std::vector<std::pair<std::string, std::string> > NoWaitAgent::report_node(void) const
+{
+    return m_agent->report_node();
+}
+
+std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > NoWaitAgent::report_region(void) const
+{
+    return m_agent->report_region();
+}
+
+std::vector<std::string> NoWaitAgent::trace_names(void) const
+{
+    return m_agent->trace_names();
+}
+
+void NoWaitAgent::trace_values(std::vector<double> &values)
+{
+    m_agent->trace_values(values);
+}
+
+void NoWaitAgent::update_region_info(const std::list<geopm_region_info_s> &region_info)
+{
+    m_agent->update_region_info(region_info);
+}
+
+BenchTreeComm::BenchTreeComm(const std::vector<int> &fan_out)
+    : m_level_size(fan_out.rbegin(), fan_out.rend())
+    , m_sample(fan_out.size())
+    , m_policy(fan_out.size())
+{
+
+}
+
+int BenchTreeComm::num_level_controlled(void) const
+{
+    return m_level_size.size();
+}
+
+int BenchTreeComm::root_level(void) const
+{
+    return m_level_size.size();
+}
+
+int BenchTreeComm::level_rank(int level) const
+{
+    return 0;
+}
+
+int BenchTreeComm::level_size(int level) const
+{
+    return m_level_size.at(level);
+}
+
+void BenchTreeComm::send_up(int level, const std::vector<double> &sample)
+{
+    if (level < (int)m_sample.size()) {
+        m_sample[level] = sample;
+    }
+}
+
+void BenchTreeComm::send_down(int level, const std::vector<std::vector<double> > &policy)
+{
+    m_policy.at(level) = policy.at(0);
+}
+
+bool BenchTreeComm::receive_up(int level, std::vector<std::vector<double> > &sample)
+{
+    bool result = !m_sample.at(level).empty();
+    if (result) {
+        std::fill(sample.begin(), sample.end(), m_sample[level]);
+    }
+    return result;
+}
+
+bool BenchTreeComm::receive_down(int level, std::vector<double> &policy)
+{
+    bool result = !m_policy.at(level).empty();
+    if (result) {
+        policy = m_policy[level];
+    }
+    return result;
+}
+
+void BenchTreeComm::send_down_view(int level, geopm::MatrixView<const double> policy)
+{
+    m_policy.at(level).assign(policy.row(0), policy.row(0) + policy.num_col());
+}
+
+bool BenchTreeComm::receive_up_view(int level, geopm::MatrixView<double> sample)
+{
+    bool result = !m_sample.at(level).empty();
+    for (size_t row = 0; result && row < sample.num_row(); ++row) {
+        std::copy(m_sample[level].begin(), m_sample[level].end(), sample.row(row));
+    }
+    return result;
+}
+
+size_t BenchTreeComm::overhead_send(void) const
+{
+    return 0;
+}
+
+BenchApplicationIO::BenchApplicationIO()
+    : BenchApplicationIO(nullptr)
+{
+
+}
+
+BenchApplicationIO::BenchApplicationIO(std::shared_ptr<const BenchRegionSchedule> schedule)
+    : m_schedule(schedule)
+    , m_num_update(0)
+    , m_num_entry(0)
+{
+
+}
+
+void BenchApplicationIO::connect(void)
+{
+
+}
+
+bool BenchApplicationIO::do_shutdown(void) const
+{
+    return false;
+}
+
+std::string BenchApplicationIO::report_name(void) const
+{
+    return "";
+}
+
+std::string BenchApplicationIO::profile_name(void) const
+{
+    return "geopm_bench";
+}
+
+std::set<std::string> BenchApplicationIO::region_name_set(void) const
+{
+    return {};
+}
+
+double BenchApplicationIO::total_region_runtime(uint64_t region_id) const
+{
+    return 0.0;
+}
+
+double BenchApplicationIO::total_region_mpi_runtime(uint64_t region_id) const
+{
+    return 0.0;
+}
+
+double BenchApplicationIO::total_app_runtime(void) const
+{
+    return 0.0;
+}
+
+double BenchApplicationIO::total_app_energy(void) const
+{
+    return 0.0;
+}
+
+double BenchApplicationIO::total_app_mpi_runtime(void) const
+{
+    return 0.0;
+}
+
+double BenchApplicationIO::total_epoch_ignore_runtime(void) const
+{
+    return 0.0;
+}
+
+double BenchApplicationIO::total_epoch_runtime(void) const
+{
+    return 0.0;
+}
+
+double BenchApplicationIO::total_epoch_mpi_runtime(void) const
+{
+    return 0.0;
+}
+
+double BenchApplicationIO::total_epoch_energy(void) const
+{
+    return 0.0;
+}
+
+int BenchApplicationIO::total_count(uint64_t region_id) const
+{
+    return 0;
+}
+
+void BenchApplicationIO::update(std::shared_ptr<geopm::Comm> comm)
+{
+    if (m_schedule) {
+        // Exit and entry of each region of the schedule begun since
+        // the last update, with IDs without hint as from the
+        // application
+        uint64_t num_entry = m_schedule->num_entry(m_schedule->time());
+        for (; m_num_entry < num_entry; ++m_num_entry) {
+            if (m_num_entry) {
+                uint64_t last_idx = m_num_entry - 1;
+                m_region_info.push_back({geopm_region_id_unset_hint(GEOPM_MASK_REGION_HINT,
+                                                                    m_schedule->region_id(last_idx)),
+                                         1.0, m_schedule->duration(last_idx)});
+            }
+            m_region_info.push_back({geopm_region_id_unset_hint(GEOPM_MASK_REGION_HINT,
+                                                                m_schedule->region_id(m_num_entry)),
+                                     0.0, 0.0});
+        }
+    }
+    // Matches the region changes of BenchIOGroup: the
+    // application exits one region and enters the next.
+    else if (m_num_update % 50 == 0) {
+        uint64_t region_id = geopm_crc32_str(0, "bench_region");
+        m_region_info.push_back({region_id, 1.0, 0.25});
+        m_region_info.push_back({region_id, 0.0, 0.0});
+    }
+    ++m_num_update;
+}
+
+std::list<geopm_region_info_s> BenchApplicationIO::region_info(void) const
+{
+    return m_region_info;
+}
+
+void BenchApplicationIO::clear_region_info(void)
+{
+    m_region_info.clear();
+}
+
+void BenchApplicationIO::controller_ready(void)
+{
+
+}
+
+void BenchApplicationIO::abort(void)
+{
+
+}
+
+BenchManagerIOSampler::BenchManagerIOSampler(const std::vector<std::string> &policy_names,
+                                             const std::vector<double> &policy)
+    : m_policy_names(policy_names)
+    , m_policy(policy)
+{
+
+}
+
+void BenchManagerIOSampler::read_batch(void)
+{
+
+}
+
+double BenchManagerIOSampler::sample(const std::string &signal_name) const
+{
+    auto it = std::find(m_policy_names.begin(), m_policy_names.end(), signal_name);
+    if (it == m_policy_names.end()) {
+        throw Exception("BenchManagerIOSampler::sample(): unknown policy " + signal_name,
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    return m_policy.at(it - m_policy_names.begin());
+}
+
+std::vector<double> BenchManagerIOSampler::sample(void) const
+{
+    return m_policy;
+}
+
+bool BenchManagerIOSampler::is_update_available(void)
+{
+    return false;
+}
+
+std::vector<std::string> BenchManagerIOSampler::signal_names(void) const
+{
+    return m_policy_names;
+}
+
+BenchLinearFreqSearch::BenchLinearFreqSearch(double freq_min, double freq_max, double freq_step)
+    : m_freq_min(freq_min)
+    , m_freq_step(freq_step)
+    , m_freq_ctx(1 + (size_t)ceil((freq_max - freq_min) / freq_step), {0.0, 0.0, 0, 0})
+    , m_freq_idx(m_freq_ctx.size() - 1)
+    , m_target(0.0)
+    , m_is_learning(true)
+{
+
+}
+
+double BenchLinearFreqSearch::freq(void) const
+{
+    return m_freq_min + m_freq_idx * m_freq_step;
+}
+
+bool BenchLinearFreqSearch::is_learning(void) const
+{
+    return m_is_learning;
+}
+
+void BenchLinearFreqSearch::update(double runtime, double energy)
+{
+    if (!m_is_learning) {
+        return;
+    }
+    const int max_idx = m_freq_ctx.size() - 1;
+    auto &freq_ctx = m_freq_ctx[m_freq_idx];
+    double perf = -1.0 * runtime;
+    if (freq_ctx.num_sample == 0 || freq_ctx.perf_max < perf) {
+        freq_ctx.perf_max = perf;
+    }
+    if (freq_ctx.num_sample == 0 || freq_ctx.energy_min > energy) {
+        freq_ctx.energy_min = energy;
+    }
+    ++freq_ctx.num_sample;
+    if (freq_ctx.num_sample >= M_MIN_BASE_SAMPLE && m_target == 0.0 && m_freq_idx == max_idx) {
+        m_target = (1.0 + M_PERF_MARGIN) * freq_ctx.perf_max;
+    }
+    bool do_increase = false;
+    if (m_freq_idx != max_idx &&
+        m_freq_ctx[m_freq_idx + 1].energy_min < (1.0 - M_ENERGY_MARGIN) * freq_ctx.energy_min) {
+        do_increase = true;
+    }
+    else if (m_target != 0.0) {
+        if (freq_ctx.perf_max > m_target) {
+            if (m_freq_idx != 0) {
+                --m_freq_idx;
+            }
+        }
+        else if (m_freq_idx != max_idx) {
+            do_increase = true;
+        }
+    }
+    if (do_increase) {
+        ++freq_ctx.num_increase;
+        if (freq_ctx.num_increase == M_MAX_INCREASE) {
+            m_is_learning = false;
+        }
+        ++m_freq_idx;
+    }
+}
+
+std::string bench_lscpu(void)
+{
+    return "Architecture:          x86_64\n"
+           "CPU op-mode(s):        32-bit, 64-bit\n"
+           "Byte Order:            Little Endian\n"
+           "CPU(s):                72\n"
+           "On-line CPU(s) mask:   0xffffffffffffffffff\n"
+           "Thread(s) per core:    2\n"
+           "Core(s) per socket:    18\n"
+           "Socket(s):             2\n"
+           "NUMA node(s):          2\n"
+           "Vendor ID:             GenuineIntel\n"
+           "CPU family:            6\n"
+           "Model:                 79\n"
+           "Model name:            Intel(R) Xeon(R) CPU E5-2695 v4 @ 2.10GHz\n"
+           "Stepping:              1\n"
+           "CPU MHz:               2101.000\n"
+           "NUMA node0 CPU(s):     0x3ffff00003ffff\n"
+           "NUMA node1 CPU(s):     0xffffc0000ffffc0000\n";
+}
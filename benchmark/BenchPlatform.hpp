@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BENCHPLATFORM_HPP_INCLUDE
+#define BENCHPLATFORM_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <list>
+#include <memory>
+#include <functional>
+
+#include "geopm_time.h"
+#include "IOGroup.hpp"
+#include "PlatformIO.hpp"
+#include "PlatformTopo.hpp"
+#include "Agent.hpp"
+#include "Tracer.hpp"
+#include "TreeComm.hpp"
+#include "ApplicationIO.hpp"
+#include "ManagerIO.hpp"
+
+/// @brief IOGroup providing synthetic values for the signals and
+///        controls used by the built-in Agents and the Tracer.  It
+///        stands in for the MSR and profile IOGroups so that the
+///        controller can run without root or an application.
+class BenchIOGroup : public geopm::IOGroup
+{
+    public:
+        BenchIOGroup(geopm::IPlatformTopo &topo);
+        virtual ~BenchIOGroup() = default;
+        std::set<std::string> signal_names(void) const override;
+        std::set<std::string> control_names(void) const override;
+        bool is_valid_signal(const std::string &signal_name) const override;
+        bool is_valid_control(const std::string &control_name) const override;
+        int signal_domain_type(const std::string &signal_name) const override;
+        int control_domain_type(const std::string &control_name) const override;
+        int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+        int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+        void read_batch(void) override;
+        void write_batch(void) override;
+        double sample(int sample_idx) override;
+        void adjust(int control_idx, double setting) override;
+        double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+        void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+        void save_control(void) override;
+        void restore_control(void) override;
+    private:
+        enum m_signal_e {
+            M_SIGNAL_TIME,
+            M_SIGNAL_ENERGY_PACKAGE,
+            M_SIGNAL_ENERGY_DRAM,
+            M_SIGNAL_FREQUENCY,
+            M_SIGNAL_REGION_ID,
+            M_SIGNAL_REGION_PROGRESS,
+            M_SIGNAL_REGION_RUNTIME,
+            M_SIGNAL_EPOCH_RUNTIME,
+            M_SIGNAL_EPOCH_COUNT,
+            M_SIGNAL_POWER_PACKAGE_MIN,
+            M_SIGNAL_POWER_PACKAGE_MAX,
+            M_NUM_SIGNAL,
+        };
+        enum m_const_e {
+            /// Number of reads spent in each synthetic region.
+            M_READ_PER_REGION = 50,
+        };
+        struct m_signal_s {
+            std::string name;
+            int domain_type;
+        };
+        int signal_id(const std::string &signal_name) const;
+        double value(int signal, int domain_idx, double time) const;
+
+        geopm::IPlatformTopo &m_topo;
+        const std::vector<m_signal_s> m_signal;
+        const std::vector<uint64_t> m_region_id;
+        struct geopm_time_s m_time_zero;
+        double m_time;
+        uint64_t m_num_read;
+        /// Signal and domain index of each pushed signal.
+        std::vector<std::pair<int, int> > m_pushed_signal;
+        std::vector<double> m_sample;
+        std::vector<double> m_setting;
+};
+
+/// @brief Repeating sequence of regions run on the wall clock.
+///        Shared by the BenchRegionIOGroup and the
+///        BenchApplicationIO so that the REGION_ID# signal and the
+///        region entries and exits reported to the Agent agree.
+class BenchRegionSchedule
+{
+    public:
+        /// @param [in] cycle Region ID including hint and duration
+        ///        in seconds of each region in the order they run.
+        ///        The clock starts when the schedule is constructed.
+        BenchRegionSchedule(const std::vector<std::pair<uint64_t, double> > &cycle);
+        virtual ~BenchRegionSchedule() = default;
+        /// @brief Seconds since the schedule started.
+        double time(void) const;
+        /// @brief Number of regions entered by the given time.
+        uint64_t num_entry(double time) const;
+        /// @brief Region ID including hint of the region_idx'th
+        ///        region run.
+        uint64_t region_id(uint64_t region_idx) const;
+        /// @brief Time the region_idx'th region was entered.
+        double entry_time(uint64_t region_idx) const;
+        /// @brief Duration of the region_idx'th region.
+        double duration(uint64_t region_idx) const;
+    private:
+        std::vector<std::pair<uint64_t, double> > m_cycle;
+        /// Time each region of the cycle begins after the start
+        /// of the cycle.
+        std::vector<double> m_offset;
+        double m_period;
+        struct geopm_time_s m_time_zero;
+};
+
+/// @brief IOGroup that provides the signals and the FREQUENCY
+///        control used by the EnergyEfficientAgent.  The region is
+///        taken from a BenchRegionSchedule, and the time and value
+///        of every change to the frequency written is recorded.
+class BenchRegionIOGroup : public geopm::IOGroup
+{
+    public:
+        BenchRegionIOGroup(std::shared_ptr<const BenchRegionSchedule> schedule,
+                           double freq_min, double freq_max, double freq_step);
+        virtual ~BenchRegionIOGroup() = default;
+        std::set<std::string> signal_names(void) const override;
+        std::set<std::string> control_names(void) const override;
+        bool is_valid_signal(const std::string &signal_name) const override;
+        bool is_valid_control(const std::string &control_name) const override;
+        int signal_domain_type(const std::string &signal_name) const override;
+        int control_domain_type(const std::string &control_name) const override;
+        int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+        int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+        void read_batch(void) override;
+        void write_batch(void) override;
+        double sample(int sample_idx) override;
+        void adjust(int control_idx, double setting) override;
+        double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+        void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+        void save_control(void) override;
+        void restore_control(void) override;
+        /// @brief Time from the start of the schedule and value of
+        ///        each frequency written that differs from the one
+        ///        before it.
+        const std::vector<std::pair<double, double> > &frequency_write(void) const;
+    private:
+        double value(const std::string &signal_name, double time) const;
+
+        std::shared_ptr<const BenchRegionSchedule> m_schedule;
+        const std::map<std::string, double> m_constant;
+        std::vector<std::string> m_pushed_signal;
+        std::vector<double> m_sample;
+        double m_setting;
+        std::vector<std::pair<double, double> > m_frequency_write;
+};
+
+/// @brief Agent that forwards to another except for wait(), which
+///        returns immediately so that the Kontroller steps back to
+///        back.
+class NoWaitAgent : public geopm::Agent
+{
+    public:
+        NoWaitAgent(std::unique_ptr<geopm::Agent> agent);
+        virtual ~NoWaitAgent() = default;
+        void init(int level, const std::vector<int> &fan_in, bool is_level_root) override;
+        bool descend(const std::vector<double> &in_policy,
+                     std::vector<std::vector<double> > &out_policy) override;
+        bool ascend(const std::vector<std::vector<double> > &in_signal,
+                    std::vector<double> &out_signal) override;
+        bool descend_view(const std::vector<double> &in_policy,
+                          geopm::MatrixView<double> out_policy) override;
+        bool ascend_view(geopm::MatrixView<const double> in_signal,
+                         std::vector<double> &out_signal) override;
+        bool adjust_platform(const std::vector<double> &policy) override;
+        bool sample_platform(std::vector<double> &sample) override;
+        void wait(void) override;
+        std::vector<std::pair<std::string, std::string> > report_header(void) const override;
+        std::vector<std::pair<std::string, std::string> > report_node(void) const override;
+        std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > report_region(void) const override;
+        std::vector<std::string> trace_names(void) const override;
+        void trace_values(std::vector<double> &values) override;
+        void update_region_info(const std::list<geopm_region_info_s> &region_info) override;
+    private:
+        std::unique_ptr<geopm::Agent> m_agent;
+};
+
+/// @brief ITreeComm for a controller at the root of a tree that
+///        does not exist.  Every child reports the sample last sent
+///        up from the level below, and policies sent down are
+///        returned to the level below, so the Agents do the work of
+///        a root controller without any other processes.
+class BenchTreeComm : public geopm::ITreeComm
+{
+    public:
+        /// @param [in] fan_out Number of children at each level
+        ///        from the root down, as for TreeComm.
+        BenchTreeComm(const std::vector<int> &fan_out);
+        virtual ~BenchTreeComm() = default;
+        int num_level_controlled(void) const override;
+        int root_level(void) const override;
+        int level_rank(int level) const override;
+        int level_size(int level) const override;
+        void send_up(int level, const std::vector<double> &sample) override;
+        void send_down(int level, const std::vector<std::vector<double> > &policy) override;
+        bool receive_up(int level, std::vector<std::vector<double> > &sample) override;
+        bool receive_down(int level, std::vector<double> &policy) override;
+        void send_down_view(int level, geopm::MatrixView<const double> policy) override;
+        bool receive_up_view(int level, geopm::MatrixView<double> sample) override;
+        size_t overhead_send(void) const override;
+    private:
+        std::vector<int> m_level_size;
+        std::vector<std::vector<double> > m_sample;
+        std::vector<std::vector<double> > m_policy;
+};
+
+/// @brief IApplicationIO for a controller without an application.
+///        Reports a region entry every time the BenchIOGroup
+///        changes region, or the entries and exits of the regions
+///        of a BenchRegionSchedule.
+class BenchApplicationIO : public geopm::IApplicationIO
+{
+    public:
+        BenchApplicationIO();
+        BenchApplicationIO(std::shared_ptr<const BenchRegionSchedule> schedule);
+        virtual ~BenchApplicationIO() = default;
+        void connect(void) override;
+        bool do_shutdown(void) const override;
+        std::string report_name(void) const override;
+        std::string profile_name(void) const override;
+        std::set<std::string> region_name_set(void) const override;
+        double total_region_runtime(uint64_t region_id) const override;
+        double total_region_mpi_runtime(uint64_t region_id) const override;
+        double total_app_runtime(void) const override;
+        double total_app_energy(void) const override;
+        double total_app_mpi_runtime(void) const override;
+        double total_epoch_ignore_runtime(void) const override;
+        double total_epoch_runtime(void) const override;
+        double total_epoch_mpi_runtime(void) const override;
+        double total_epoch_energy(void) const override;
+        int total_count(uint64_t region_id) const override;
+        void update(std::shared_ptr<geopm::Comm> comm) override;
+        std::list<geopm_region_info_s> region_info(void) const override;
+        void clear_region_info(void) override;
+        void controller_ready(void) override;
+        void abort(void) override;
+    private:
+        std::shared_ptr<const BenchRegionSchedule> m_schedule;
+        uint64_t m_num_update;
+        /// Number of regions of the schedule reported.
+        uint64_t m_num_entry;
+        std::list<geopm_region_info_s> m_region_info;
+};
+
+/// @brief IManagerIOSampler that always provides the same policy.
+class BenchManagerIOSampler : public geopm::IManagerIOSampler
+{
+    public:
+        BenchManagerIOSampler(const std::vector<std::string> &policy_names,
+                              const std::vector<double> &policy);
+        virtual ~BenchManagerIOSampler() = default;
+        void read_batch(void) override;
+        double sample(const std::string &signal_name) const override;
+        std::vector<double> sample(void) const override;
+        bool is_update_available(void) override;
+        std::vector<std::string> signal_names(void) const override;
+    private:
+        std::vector<std::string> m_policy_names;
+        std::vector<double> m_policy;
+};
+
+/// @brief The search for the most energy efficient frequency that
+///        EnergyEfficientRegion made before it bisected, kept to
+///        compare convergence.  After the baseline at the maximum
+///        frequency the frequency steps down once per invocation
+///        while performance stays within the margin, and back up
+///        when it does not or when the frequency above used less
+///        energy.  Learning stops the fourth time the frequency
+///        steps back up from the same frequency.
+class BenchLinearFreqSearch
+{
+    public:
+        BenchLinearFreqSearch(double freq_min, double freq_max, double freq_step);
+        virtual ~BenchLinearFreqSearch() = default;
+        double freq(void) const;
+        bool is_learning(void) const;
+        /// @brief Record an invocation of the region at freq().
+        /// @param [in] runtime Runtime of the invocation in seconds.
+        /// @param [in] energy Energy of the invocation in joules.
+        void update(double runtime, double energy);
+    private:
+        struct m_freq_ctx_s {
+            double perf_max;
+            double energy_min;
+            size_t num_sample;
+            size_t num_increase;
+        };
+        const double M_PERF_MARGIN = 0.10;
+        const double M_ENERGY_MARGIN = 0.025;
+        const size_t M_MIN_BASE_SAMPLE = 4;
+        const size_t M_MAX_INCREASE = 4;
+        double m_freq_min;
+        double m_freq_step;
+        /// Context of each allowed frequency, lowest first.
+        std::vector<m_freq_ctx_s> m_freq_ctx;
+        int m_freq_idx;
+        double m_target;
+        bool m_is_learning;
+};
+
+/// @brief Contents of "lscpu -x" for a two socket, 18 core per
+///        socket, two thread per core server, used to build a
+///        PlatformTopo independent of the host.
+std::string bench_lscpu(void);
+
+#endif
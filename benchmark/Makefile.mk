@@ -0,0 +1,51 @@
+#  Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions
+#  are met:
+#
+#      * Redistributions of source code must retain the above copyright
+#        notice, this list of conditions and the following disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above copyright
+#        notice, this list of conditions and the following disclaimer in
+#        the documentation and/or other materials provided with the
+#        distribution.
+#
+#      * Neither the name of Intel Corporation nor the names of its
+#        contributors may be used to endorse or promote products derived
+#        from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+#  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+#  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+#  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+#  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+#  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+#  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+#  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+#  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+#  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+#  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+
+noinst_PROGRAMS += benchmark/matrix_reduce_bench
+benchmark_matrix_reduce_bench_SOURCES = benchmark/matrix_reduce_bench.cpp
+benchmark_matrix_reduce_bench_LDADD = libgeopmpolicy.la
+
+if ENABLE_MPI
+    noinst_PROGRAMS += benchmark/geopm_bench
+    benchmark_geopm_bench_SOURCES = benchmark/BenchPlatform.cpp \
+                                    benchmark/BenchPlatform.hpp \
+                                    benchmark/geopm_bench.cpp \
+                                    tutorial/imbalancer.h \
+                                    tutorial/Imbalancer.cpp \
+                                    tutorial/ModelRegion.cpp \
+                                    tutorial/ModelRegion.hpp \
+                                    # end
+    benchmark_geopm_bench_CPPFLAGS = $(AM_CPPFLAGS) -I$(top_srcdir)/tutorial
+    benchmark_geopm_bench_CXXFLAGS = $(AM_CXXFLAGS) $(MPI_CFLAGS) -std=gnu++11 -mavx
+    benchmark_geopm_bench_LDFLAGS = $(AM_LDFLAGS) $(MPI_LDFLAGS) -lm -mavx
+    benchmark_geopm_bench_LDADD = libgeopm.la $(MPI_CLIBS)
+endif
@@ -0,0 +1,768 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <errno.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+
+#include "geopm.h"
+#include "geopm_env.h"
+#include "geopm_error.h"
+#include "geopm_hash.h"
+#include "geopm_message.h"
+#include "geopm_version.h"
+#include "geopm_time.h"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "Kontroller.hpp"
+#include "KontrollerTimer.hpp"
+#include "Reporter.hpp"
+#include "PlatformIOInternal.hpp"
+#include "PlatformTopo.hpp"
+#include "ReplayIOGroup.hpp"
+#include "Tracer.hpp"
+#include "TraceRollup.hpp"
+#include "MonitorAgent.hpp"
+#include "PowerGovernorAgent.hpp"
+#include "EnergyEfficientAgent.hpp"
+#include "EnergyEfficientRegion.hpp"
+#include "SimPlatformIOGroup.hpp"
+#include "ModelRegion.hpp"
+#include "BenchPlatform.hpp"
+#include "contrib/json11/json11.hpp"
+
+using geopm::Exception;
+using json11::Json;
+
+enum bench_const_e {
+    M_NUM_API_CALL = 10000,
+    M_NUM_TRANSITION_REGION = 2000,
+    M_NUM_SEARCH_INVOCATION = 200,
+};
+
+/// Summary of a set of durations in seconds as microseconds.
+static Json distribution(std::vector<double> sample)
+{
+    Json::object result {{"count", (int)sample.size()}};
+    if (sample.size()) {
+        std::sort(sample.begin(), sample.end());
+        auto percentile = [&sample] (double pp) {
+            return 1e6 * sample[(size_t)(pp * (sample.size() - 1) + 0.5)];
+        };
+        result["mean_usec"] = 1e6 * std::accumulate(sample.begin(), sample.end(), 0.0) / sample.size();
+        result["min_usec"] = 1e6 * sample.front();
+        result["p50_usec"] = percentile(0.50);
+        result["p90_usec"] = percentile(0.90);
+        result["p99_usec"] = percentile(0.99);
+        result["max_usec"] = 1e6 * sample.back();
+    }
+    return result;
+}
+
+static double max_rss_kb(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static std::vector<std::string> split(const std::string &str)
+{
+    std::vector<std::string> result;
+    std::istringstream stream(str);
+    std::string token;
+    while (std::getline(stream, token, ',')) {
+        if (!token.empty()) {
+            result.push_back(token);
+        }
+    }
+    return result;
+}
+
+/// Run each model region with and without its profile API calls,
+/// then time each of the calls on their own.
+static Json run_profile(const std::vector<std::string> &region_name, double big_o, int loop_count)
+{
+    Json::object region_result;
+    for (const auto &name : region_name) {
+        std::unique_ptr<geopm::ModelRegionBase> marked(
+            geopm::model_region_factory(name + "-progress", big_o, 0));
+        std::unique_ptr<geopm::ModelRegionBase> unmarked(
+            geopm::model_region_factory(name + "-unmarked", big_o, 0));
+        double marked_sec = 0.0;
+        double unmarked_sec = 0.0;
+        MPI_Barrier(MPI_COMM_WORLD);
+        for (int loop_idx = 0; loop_idx < loop_count; ++loop_idx) {
+            struct geopm_time_s begin, middle, end;
+            geopm_time(&begin);
+            marked->run();
+            geopm_time(&middle);
+            unmarked->run();
+            geopm_time(&end);
+            marked_sec += geopm_time_diff(&begin, &middle);
+            unmarked_sec += geopm_time_diff(&middle, &end);
+        }
+        region_result[name] = Json::object {
+            {"marked_sec", marked_sec / loop_count},
+            {"unmarked_sec", unmarked_sec / loop_count},
+            {"overhead_percent", unmarked_sec > 0.0 ? 100.0 * (marked_sec - unmarked_sec) / unmarked_sec : 0.0}};
+    }
+
+    enum {
+        M_CALL_ENTER,
+        M_CALL_PROGRESS,
+        M_CALL_EXIT,
+        M_CALL_EPOCH,
+        M_NUM_CALL,
+    };
+    std::vector<std::vector<double> > latency(M_NUM_CALL);
+    for (auto &it : latency) {
+        it.reserve(M_NUM_API_CALL);
+    }
+    uint64_t region_id = 0;
+    (void)geopm_prof_region("geopm_bench_api", GEOPM_REGION_HINT_UNKNOWN, &region_id);
+    MPI_Barrier(MPI_COMM_WORLD);
+    for (int call_idx = 0; call_idx < M_NUM_API_CALL; ++call_idx) {
+        struct geopm_time_s time[M_NUM_CALL + 1];
+        geopm_time(time + M_CALL_ENTER);
+        (void)geopm_prof_enter(region_id);
+        geopm_time(time + M_CALL_PROGRESS);
+        (void)geopm_prof_progress(region_id, 0.5);
+        geopm_time(time + M_CALL_EXIT);
+        (void)geopm_prof_exit(region_id);
+        geopm_time(time + M_CALL_EPOCH);
+        (void)geopm_prof_epoch();
+        geopm_time(time + M_NUM_CALL);
+        for (int call = 0; call < M_NUM_CALL; ++call) {
+            latency[call].push_back(geopm_time_diff(time + call, time + call + 1));
+        }
+    }
+    return Json::object {
+        {"enabled", (bool)geopm_env_do_profile()},
+        {"region", region_result},
+        {"latency", Json::object {
+            {"geopm_prof_enter", distribution(latency[M_CALL_ENTER])},
+            {"geopm_prof_progress", distribution(latency[M_CALL_PROGRESS])},
+            {"geopm_prof_exit", distribution(latency[M_CALL_EXIT])},
+            {"geopm_prof_epoch", distribution(latency[M_CALL_EPOCH])}}}};
+}
+
+static std::unique_ptr<geopm::Agent> make_agent(const std::string &agent_name, geopm::IPlatformIO &platform_io,
+                                                geopm::IPlatformTopo &platform_topo)
+{
+    std::unique_ptr<geopm::Agent> result;
+    if (agent_name == geopm::MonitorAgent::plugin_name()) {
+        result = geopm::make_unique<geopm::MonitorAgent>(platform_io, platform_topo);
+    }
+    else if (agent_name == geopm::PowerGovernorAgent::plugin_name()) {
+        result = geopm::make_unique<geopm::PowerGovernorAgent>(platform_io, platform_topo);
+    }
+    else {
+        throw Exception("geopm_bench: agent not supported: " + agent_name,
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+    return result;
+}
+
+/// Topology of the server described by bench_lscpu().
+static std::unique_ptr<geopm::PlatformTopo> bench_topo(const std::string &work_dir)
+{
+    std::string lscpu_path = work_dir + "/lscpu";
+    std::ofstream lscpu_stream(lscpu_path);
+    lscpu_stream << bench_lscpu();
+    lscpu_stream.close();
+    auto result = geopm::make_unique<geopm::PlatformTopo>(lscpu_path);
+    unlink(lscpu_path.c_str());
+    return result;
+}
+
+/// Step a Kontroller at the root of a tree with the given fan out.
+/// All platform signals are synthetic and the samples of the
+/// children are copies of the local sample, so only the cost of the
+/// controller itself is measured.  Agent::wait() returns immediately.
+///
+/// If replay_path is not empty the signals are instead played back
+/// from a log recorded with GEOPM_RECORD, the run is limited to the
+/// recorded steps, and the writes that differ from the recorded
+/// settings are reported.  The topology of the recording node is
+/// read from lscpu_path, or from the host if it is empty.
+static Json run_controller(const std::string &agent_name, const std::vector<int> &fan_out,
+                           const std::vector<double> &policy, int step_count, const std::string &work_dir,
+                           const std::string &replay_path, const std::string &lscpu_path)
+{
+    const bool is_replay = !replay_path.empty();
+    std::unique_ptr<geopm::PlatformTopo> lscpu_topo;
+    if (!is_replay) {
+        lscpu_topo = bench_topo(work_dir);
+    }
+    else if (!lscpu_path.empty()) {
+        lscpu_topo = geopm::make_unique<geopm::PlatformTopo>(lscpu_path);
+    }
+    geopm::IPlatformTopo &platform_topo = lscpu_topo ? *lscpu_topo : geopm::platform_topo();
+
+    std::shared_ptr<geopm::IOGroup> iogroup;
+    std::shared_ptr<geopm::ReplayIOGroup> replay_iogroup;
+    if (is_replay) {
+        replay_iogroup = std::make_shared<geopm::ReplayIOGroup>(replay_path);
+        if (replay_iogroup->num_read_record() < 2) {
+            throw Exception("geopm_bench: replay log has fewer than two read records: " + replay_path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        step_count = std::min((size_t)step_count, replay_iogroup->num_read_record() - 1);
+        iogroup = replay_iogroup;
+    }
+    else {
+        iogroup = std::make_shared<BenchIOGroup>(platform_topo);
+    }
+
+    // A synthetic run is recorded if GEOPM_RECORD is set
+    geopm::PlatformIO platform_io({iogroup}, platform_topo, is_replay ? "" : geopm_env_record());
+
+    auto dictionary = geopm::agent_factory().dictionary(agent_name);
+    int num_policy = geopm::Agent::num_policy(dictionary);
+    int num_sample = geopm::Agent::num_sample(dictionary);
+    std::vector<double> agent_policy(policy);
+    agent_policy.resize(num_policy, policy.empty() ? NAN : policy.back());
+
+    std::unique_ptr<geopm::ITreeComm> tree_comm = geopm::make_unique<BenchTreeComm>(fan_out);
+    std::vector<int> fan_in(tree_comm->root_level());
+    for (size_t level = 0; level < fan_in.size(); ++level) {
+        fan_in[level] = tree_comm->level_size(level);
+    }
+    std::vector<std::unique_ptr<geopm::Agent> > level_agent;
+    for (int level = 0; level <= tree_comm->num_level_controlled(); ++level) {
+        auto agent = make_agent(agent_name, platform_io, platform_topo);
+        agent->init(level, fan_in, level < tree_comm->num_level_controlled());
+        level_agent.push_back(geopm::make_unique<NoWaitAgent>(std::move(agent)));
+    }
+
+    const std::string trace_path = work_dir + "/trace";
+    std::unique_ptr<geopm::ITracer> tracer(
+        new geopm::Tracer(trace_path, "bench", !is_replay, platform_io, {}, 16, false, 0.0, 0, ""));
+    geopm::ITracer *tracer_ptr = tracer.get();
+    std::unique_ptr<geopm::ITraceRollup> trace_rollup(
+        new geopm::TraceRollup(nullptr, "", false, 1.0, platform_io, {}, 16, nullptr));
+
+    geopm::Kontroller controller(nullptr, platform_io, agent_name, num_policy, num_sample,
+                                 std::move(tree_comm),
+                                 std::make_shared<BenchApplicationIO>(),
+                                 nullptr,
+                                 std::move(tracer),
+                                 std::move(trace_rollup),
+                                 std::move(level_agent),
+                                 geopm::make_unique<BenchManagerIOSampler>(
+                                     geopm::Agent::policy_names(dictionary), agent_policy),
+                                 nullptr);
+    controller.setup_trace();
+    // Kontroller::run() reads once before the first step; not timed
+    platform_io.read_batch();
+    double rss_setup = max_rss_kb();
+
+    for (int step_idx = 0; step_idx < step_count; ++step_idx) {
+        controller.step();
+    }
+    struct geopm_time_s begin, end;
+    geopm_time(&begin);
+    tracer_ptr->flush();
+    geopm_time(&end);
+    unlink((trace_path + "-bench").c_str());
+
+    // The phase breakdown is the one the Kontroller keeps for the
+    // report and the CONTROLLER IOGroup.
+    std::shared_ptr<const geopm::KontrollerTimer> timer = controller.timer();
+    Json::object phase_result;
+    for (int phase = 0; phase < geopm::KontrollerTimer::M_NUM_PHASE; ++phase) {
+        Json::object stat_result {{"count", (int)timer->num_step()}};
+        for (int stat = geopm::KontrollerTimer::M_STAT_MEAN; stat < geopm::KontrollerTimer::M_NUM_STAT; ++stat) {
+            stat_result[geopm::KontrollerTimer::stat_name(stat) + "_usec"] = 1e6 * timer->stat(phase, stat);
+        }
+        phase_result[geopm::KontrollerTimer::phase_name(phase)] = stat_result;
+    }
+    std::vector<Json> fan_out_json(fan_out.begin(), fan_out.end());
+    Json::object result {
+        {"agent", agent_name},
+        {"fan_out", fan_out_json},
+        {"num_signal", platform_io.num_signal()},
+        {"num_control", platform_io.num_control()},
+        {"latency", phase_result},
+        {"trace_flush_sec", geopm_time_diff(&begin, &end)},
+        {"max_rss_kb_setup", rss_setup}};
+    if (is_replay) {
+        result["replay"] = Json::object {
+            {"path", replay_path},
+            {"step_count", step_count},
+            {"control_write", (int)replay_iogroup->num_write()},
+            {"control_mismatch", (int)replay_iogroup->num_mismatch()}};
+    }
+    return result;
+}
+
+/// Latency from region entry to the write of the region's
+/// frequency by the EnergyEfficientAgent.  The Kontroller steps the
+/// agent on the wall clock, paced by the agent's own wait(), while a
+/// repeating sequence of regions shorter than the control period
+/// runs.  The BenchRegionIOGroup records when each frequency is
+/// written by write_batch().  A region whose frequency is already in
+/// effect when it is entered has zero latency, and a region that
+/// ends before its frequency is written counts its whole duration.
+/// Regions of the first pass through the sequence are not counted,
+/// as the agent has not seen their transitions yet.
+static Json run_transition(bool is_predict, int region_count, const std::string &work_dir)
+{
+    const double freq_min = 1.0e9;
+    const double freq_max = 2.0e9;
+    const double freq_step = 1.0e8;
+    const std::vector<std::pair<uint64_t, double> > cycle {
+        {geopm_region_id_set_hint(GEOPM_REGION_HINT_COMPUTE, geopm_crc32_str(0, "bench_transition_0")), 0.002},
+        {geopm_region_id_set_hint(GEOPM_REGION_HINT_MEMORY, geopm_crc32_str(0, "bench_transition_1")), 0.007},
+        {geopm_region_id_set_hint(GEOPM_REGION_HINT_COMPUTE, geopm_crc32_str(0, "bench_transition_2")), 0.001},
+        {geopm_region_id_set_hint(GEOPM_REGION_HINT_MEMORY, geopm_crc32_str(0, "bench_transition_3")), 0.004}};
+    std::unique_ptr<geopm::PlatformTopo> platform_topo = bench_topo(work_dir);
+    auto schedule = std::make_shared<BenchRegionSchedule>(cycle);
+    auto iogroup = std::make_shared<BenchRegionIOGroup>(schedule, freq_min, freq_max, freq_step);
+    geopm::PlatformIO platform_io({iogroup}, *platform_topo, "");
+
+    // The agent reads its mode from the environment when constructed
+    const char *predict_env = getenv("GEOPM_EFFICIENT_FREQ_PREDICT");
+    std::string predict_env_value = predict_env ? predict_env : "";
+    if (is_predict) {
+        setenv("GEOPM_EFFICIENT_FREQ_PREDICT", "1", 1);
+    }
+    else {
+        unsetenv("GEOPM_EFFICIENT_FREQ_PREDICT");
+    }
+    std::vector<std::unique_ptr<geopm::Agent> > level_agent;
+    level_agent.push_back(geopm::make_unique<geopm::EnergyEfficientAgent>(platform_io, *platform_topo));
+    if (predict_env) {
+        setenv("GEOPM_EFFICIENT_FREQ_PREDICT", predict_env_value.c_str(), 1);
+    }
+    else {
+        unsetenv("GEOPM_EFFICIENT_FREQ_PREDICT");
+    }
+    level_agent[0]->init(0, {}, false);
+
+    const std::string agent_name = geopm::EnergyEfficientAgent::plugin_name();
+    auto dictionary = geopm::agent_factory().dictionary(agent_name);
+    std::unique_ptr<geopm::ITracer> tracer(
+        new geopm::Tracer("", "bench", false, platform_io, {}, 16, false, 0.0, 0, ""));
+    std::unique_ptr<geopm::ITraceRollup> trace_rollup(
+        new geopm::TraceRollup(nullptr, "", false, 1.0, platform_io, {}, 16, nullptr));
+    geopm::Kontroller controller(nullptr, platform_io, agent_name,
+                                 geopm::Agent::num_policy(dictionary),
+                                 geopm::Agent::num_sample(dictionary),
+                                 geopm::make_unique<BenchTreeComm>(std::vector<int>{}),
+                                 std::make_shared<BenchApplicationIO>(schedule),
+                                 nullptr,
+                                 std::move(tracer),
+                                 std::move(trace_rollup),
+                                 std::move(level_agent),
+                                 geopm::make_unique<BenchManagerIOSampler>(
+                                     geopm::Agent::policy_names(dictionary),
+                                     std::vector<double> {freq_min, freq_max}),
+                                 nullptr);
+    platform_io.read_batch();
+    const uint64_t begin_idx = cycle.size();
+    const uint64_t end_idx = begin_idx + region_count;
+    while (schedule->num_entry(schedule->time()) <= end_idx) {
+        controller.step();
+    }
+
+    const auto &frequency_write = iogroup->frequency_write();
+    std::vector<double> latency;
+    int num_at_entry = 0;
+    int num_not_applied = 0;
+    auto write_it = frequency_write.begin();
+    double freq_in_effect = NAN;
+    for (uint64_t region_idx = begin_idx; region_idx < end_idx; ++region_idx) {
+        double entry = schedule->entry_time(region_idx);
+        double exit = entry + schedule->duration(region_idx);
+        double target = geopm_region_id_hint_is_equal(GEOPM_REGION_HINT_MEMORY, schedule->region_id(region_idx)) ?
+                        freq_min : freq_max;
+        for (; write_it != frequency_write.end() && write_it->first <= entry; ++write_it) {
+            freq_in_effect = write_it->second;
+        }
+        double region_latency = schedule->duration(region_idx);
+        if (freq_in_effect == target) {
+            region_latency = 0.0;
+            ++num_at_entry;
+        }
+        else {
+            auto applied_it = std::find_if(write_it, frequency_write.end(),
+                [exit, target](const std::pair<double, double> &write) {
+                    return write.first >= exit || write.second == target;
+                });
+            if (applied_it != frequency_write.end() && applied_it->first < exit) {
+                region_latency = applied_it->first - entry;
+            }
+            else {
+                ++num_not_applied;
+            }
+        }
+        latency.push_back(region_latency);
+    }
+    Json::object result = distribution(latency).object_items();
+    result["applied_before_entry"] = num_at_entry;
+    result["not_applied"] = num_not_applied;
+    result["num_step"] = (int)controller.timer()->num_step();
+    return result;
+}
+
+/// Number of invocations the search for the most energy efficient
+/// frequency of a region takes.  The region runs once per epoch of
+/// the SimPlatformIOGroup on a simulated clock, with the fraction of
+/// its runtime that scales with the core frequency given by
+/// freq_sensitivity.  The search is the bisection of
+/// EnergyEfficientRegion, optionally warm started from warm_freq, or
+/// the linear search it replaced.  The result holds the invocations
+/// made before learning stopped, the invocations made before the
+/// frequency stopped changing, and the final frequency.
+static Json run_freq_search(geopm::IPlatformTopo &topo, double freq_sensitivity,
+                            bool is_linear, double warm_freq)
+{
+    const double freq_step = 1.0e8;
+    const double clock_tick = 1.0e-3;
+    geopm::SimPlatformIOGroup::m_model_s model;
+    model.freq_sensitivity = freq_sensitivity;
+    double sim_time = 0.0;
+    auto sim = std::make_shared<geopm::SimPlatformIOGroup>(topo, model, 0, [&sim_time]() {return sim_time;});
+    geopm::PlatformIO platform_io({sim}, topo, "");
+    int runtime_idx = platform_io.push_signal("EPOCH_RUNTIME", geopm::IPlatformTopo::M_DOMAIN_BOARD, 0);
+    int count_idx = platform_io.push_signal("EPOCH_COUNT", geopm::IPlatformTopo::M_DOMAIN_BOARD, 0);
+    int pkg_energy_idx = platform_io.push_signal("ENERGY_PACKAGE", geopm::IPlatformTopo::M_DOMAIN_BOARD, 0);
+    int dram_energy_idx = platform_io.push_signal("ENERGY_DRAM", geopm::IPlatformTopo::M_DOMAIN_BOARD, 0);
+    std::vector<int> freq_idx;
+    for (int pkg_idx = 0; pkg_idx < topo.num_domain(geopm::IPlatformTopo::M_DOMAIN_PACKAGE); ++pkg_idx) {
+        freq_idx.push_back(platform_io.push_control("FREQUENCY", geopm::IPlatformTopo::M_DOMAIN_PACKAGE, pkg_idx));
+    }
+    std::unique_ptr<BenchLinearFreqSearch> linear;
+    std::unique_ptr<geopm::EnergyEfficientRegion> region;
+    if (is_linear) {
+        linear = geopm::make_unique<BenchLinearFreqSearch>(model.freq_min, model.freq_max, freq_step);
+    }
+    else {
+        region = geopm::make_unique<geopm::EnergyEfficientRegion>(platform_io, model.freq_min, model.freq_max,
+                                                                  freq_step, runtime_idx, pkg_energy_idx,
+                                                                  dram_energy_idx);
+        region->warm_start(warm_freq);
+    }
+    platform_io.read_batch();
+    double epoch_count = platform_io.sample(count_idx);
+    // Each invocation begins where the epoch before it ended
+    auto run_epoch = [&]() {
+        do {
+            sim_time += clock_tick;
+            platform_io.read_batch();
+        } while (platform_io.sample(count_idx) == epoch_count);
+        epoch_count = platform_io.sample(count_idx);
+    };
+    run_epoch();
+    int num_learning = -1;
+    int num_settled = 0;
+    double last_freq = NAN;
+    for (int invoke_idx = 0; invoke_idx < M_NUM_SEARCH_INVOCATION; ++invoke_idx) {
+        bool is_learning = is_linear ? linear->is_learning() : region->is_learning();
+        double freq = is_linear ? linear->freq() : region->freq();
+        if (!is_learning && num_learning == -1) {
+            num_learning = invoke_idx;
+        }
+        if (freq != last_freq) {
+            num_settled = invoke_idx;
+            last_freq = freq;
+        }
+        for (int idx : freq_idx) {
+            platform_io.adjust(idx, freq);
+        }
+        platform_io.write_batch();
+        platform_io.read_batch();
+        double energy = platform_io.sample(pkg_energy_idx) + platform_io.sample(dram_energy_idx);
+        if (!is_linear) {
+            region->update_entry();
+        }
+        run_epoch();
+        if (is_linear) {
+            linear->update(platform_io.sample(runtime_idx),
+                           platform_io.sample(pkg_energy_idx) + platform_io.sample(dram_energy_idx) - energy);
+        }
+        else {
+            region->update_exit();
+        }
+    }
+    return Json::object {
+        {"learning_invocations", num_learning},
+        {"settled_invocations", num_settled},
+        {"freq", last_freq}};
+}
+
+/// Convergence of the frequency search on the regions of the
+/// tutorial model application.  The fraction of the runtime of each
+/// region that scales with frequency is an estimate of how it runs:
+/// dgemm is compute bound, stream is memory bound, all2all waits on
+/// the network and spin waits on the clock.
+static Json run_freq_search(const std::string &work_dir)
+{
+    const std::vector<std::pair<std::string, double> > region_sensitivity {
+        {"dgemm", 1.0},
+        {"stream", 0.3},
+        {"all2all", 0.1},
+        {"spin", 0.0}};
+    std::unique_ptr<geopm::PlatformTopo> platform_topo = bench_topo(work_dir);
+    Json::object result;
+    for (const auto &region : region_sensitivity) {
+        Json bisection = run_freq_search(*platform_topo, region.second, false, NAN);
+        result[region.first] = Json::object {
+            {"freq_sensitivity", region.second},
+            {"bisection", bisection},
+            {"warm_start", run_freq_search(*platform_topo, region.second, false,
+                                           bisection["freq"].number_value())},
+            {"linear", run_freq_search(*platform_topo, region.second, true, NAN)}};
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const char *usage = "\nUsage:\n"
+                        "       geopm_bench [--region NAME[,NAME...]] [--big-o VALUE] [--loop-count N]\n"
+                        "                   [--agent NAME] [--fan-out N[,N...]] [--policy VALUE[,VALUE...]]\n"
+                        "                   [--step-count N] [--output PATH] [--replay PATH [--lscpu PATH]]\n"
+                        "       geopm_bench [--help]\n"
+                        "\n"
+                        "  Measures the overhead of GEOPM and writes the results as JSON.\n"
+                        "\n"
+                        "  -r, --region          model regions run with and without profiling:\n"
+                        "                        sleep, spin, dgemm, stream, all2all or nested\n"
+                        "                        (default: spin,dgemm,stream,all2all,nested)\n"
+                        "  -b, --big-o           big-o of each model region (default: 0.01)\n"
+                        "  -l, --loop-count      number of times each region is run (default: 20)\n"
+                        "  -a, --agent           agent stepped by the controller benchmark:\n"
+                        "                        monitor or power_governor (default: power_governor)\n"
+                        "  -f, --fan-out         fan out of the simulated tree from the root down,\n"
+                        "                        empty for a single node (default: 16,8)\n"
+                        "  -p, --policy          policy sent to the agent (default: 300)\n"
+                        "  -s, --step-count      number of controller steps (default: 10000)\n"
+                        "  -o, --output          file for the results (default: standard output)\n"
+                        "  -R, --replay          run the controller benchmark on the signals of a\n"
+                        "                        log recorded with GEOPM_RECORD rather than\n"
+                        "                        synthetic ones, and count the controls written\n"
+                        "                        that differ from the log (default fan out: none)\n"
+                        "  -L, --lscpu           output of lscpu(1) on the node the replay log was\n"
+                        "                        recorded on (default: topology of this node)\n"
+                        "  -h, --help            print brief summary of the command line\n"
+                        "                        usage information, then exit\n"
+                        "\n"
+                        "  The profile API is active when run with the GEOPM runtime, e.g. by\n"
+                        "  geopmlaunch; otherwise the calls measured are those made with profiling\n"
+                        "  disabled.  The controller benchmark runs on rank zero only with a\n"
+                        "  synthetic platform and does not need root or an msr driver.  The\n"
+                        "  region transition benchmark then steps the energy_efficient agent\n"
+                        "  for a few seconds, with and without GEOPM_EFFICIENT_FREQ_PREDICT,\n"
+                        "  while a sequence of 2, 7, 1 and 4 ms regions repeats, and measures\n"
+                        "  how long after entry each region's frequency is written.\n"
+                        "  Last, the frequency search of the energy_efficient agent is run on\n"
+                        "  the dgemm, stream, all2all and spin regions of the tutorial model,\n"
+                        "  simulated by the SIM IOGroup, and the number of region invocations\n"
+                        "  it takes is reported for the bisection, a warm start from its\n"
+                        "  result and the linear step down it replaced.\n"
+                        "\n"
+                        "Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation. All rights reserved.\n"
+                        "\n";
+
+    static struct option long_options[] = {
+        {"region", required_argument, NULL, 'r'},
+        {"big-o", required_argument, NULL, 'b'},
+        {"loop-count", required_argument, NULL, 'l'},
+        {"agent", required_argument, NULL, 'a'},
+        {"fan-out", required_argument, NULL, 'f'},
+        {"policy", required_argument, NULL, 'p'},
+        {"step-count", required_argument, NULL, 's'},
+        {"output", required_argument, NULL, 'o'},
+        {"replay", required_argument, NULL, 'R'},
+        {"lscpu", required_argument, NULL, 'L'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    std::vector<std::string> region_name {"spin", "dgemm", "stream", "all2all", "nested"};
+    double big_o = 0.01;
+    int loop_count = 20;
+    std::string agent_name = geopm::PowerGovernorAgent::plugin_name();
+    std::vector<int> fan_out {16, 8};
+    std::vector<double> policy {300.0};
+    int step_count = 10000;
+    std::string output_path;
+    std::string replay_path;
+    std::string lscpu_path;
+    bool is_fan_out_set = false;
+
+    int opt;
+    int err = 0;
+    while (!err && (opt = getopt_long(argc, argv, "r:b:l:a:f:p:s:o:R:L:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'r':
+                region_name = split(optarg);
+                break;
+            case 'b':
+                big_o = atof(optarg);
+                break;
+            case 'l':
+                loop_count = atoi(optarg);
+                break;
+            case 'a':
+                agent_name = optarg;
+                break;
+            case 'f':
+                is_fan_out_set = true;
+                fan_out.clear();
+                for (const auto &it : split(optarg)) {
+                    fan_out.push_back(atoi(it.c_str()));
+                }
+                break;
+            case 'p':
+                policy.clear();
+                for (const auto &it : split(optarg)) {
+                    policy.push_back(atof(it.c_str()));
+                }
+                break;
+            case 's':
+                step_count = atoi(optarg);
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'R':
+                replay_path = optarg;
+                break;
+            case 'L':
+                lscpu_path = optarg;
+                break;
+            case 'h':
+                printf("%s", usage);
+                return 0;
+            default:
+                fprintf(stderr, "%s", usage);
+                err = EINVAL;
+                break;
+        }
+    }
+    if (!replay_path.empty() && !is_fan_out_set) {
+        // A log is recorded by a single node
+        fan_out.clear();
+    }
+    if (!err && (loop_count <= 0 || step_count <= 0 ||
+                 std::any_of(fan_out.begin(), fan_out.end(), [](int size) {return size <= 0;}))) {
+        fprintf(stderr, "Error: loop count, step count and fan out must be positive\n");
+        err = EINVAL;
+    }
+    if (!err && agent_name != geopm::MonitorAgent::plugin_name() &&
+        agent_name != geopm::PowerGovernorAgent::plugin_name()) {
+        fprintf(stderr, "Error: agent not supported: %s\n", agent_name.c_str());
+        err = EINVAL;
+    }
+    if (err) {
+        return err;
+    }
+
+    err = MPI_Init(&argc, &argv);
+    if (err) {
+        return err;
+    }
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    try {
+        double rss_begin = max_rss_kb();
+        Json profile_result;
+        try {
+            profile_result = run_profile(region_name, big_o, loop_count);
+        }
+        catch (const geopm::Exception &ex) {
+            // The profile API is unusable, e.g. the platform
+            // topology cannot be determined; still run the
+            // controller benchmark.
+            profile_result = Json::object {{"error", ex.what()}};
+        }
+        double rss_profile = max_rss_kb();
+        if (!rank) {
+            char work_dir[] = "/tmp/geopm_bench_XXXXXX";
+            if (!mkdtemp(work_dir)) {
+                throw Exception("geopm_bench: unable to create temporary directory",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            Json controller_result = run_controller(agent_name, fan_out, policy, step_count, work_dir,
+                                                   replay_path, lscpu_path);
+            Json transition_result = Json::object {
+                {"method", "energy_efficient agent stepped by the Kontroller on the wall clock"},
+                {"region_duration_sec", Json::array {0.002, 0.007, 0.001, 0.004}},
+                {"reactive", run_transition(false, M_NUM_TRANSITION_REGION, work_dir)},
+                {"predictive", run_transition(true, M_NUM_TRANSITION_REGION, work_dir)}};
+            Json search_result = run_freq_search(work_dir);
+            rmdir(work_dir);
+            Json result = Json::object {
+                {"geopm_version", geopm_version()},
+                {"profile", profile_result},
+                {"controller", controller_result},
+                {"region_transition", transition_result},
+                {"freq_search", search_result},
+                {"max_rss_kb", Json::object {
+                    {"begin", rss_begin},
+                    {"profile", rss_profile},
+                    {"controller", max_rss_kb()}}}};
+            if (output_path.empty()) {
+                std::cout << result.dump() << std::endl;
+            }
+            else {
+                std::ofstream output(output_path);
+                output << result.dump() << std::endl;
+            }
+        }
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        err = ex.err_value();
+    }
+    int err_fin = MPI_Finalize();
+    return err ? err : err_fin;
+}
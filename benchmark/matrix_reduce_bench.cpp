@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <functional>
+
+#include "geopm_time.h"
+#include "PlatformIO.hpp"
+#include "MatrixReduce.hpp"
+
+/// Compare the cost of reducing the samples received from all
+/// children of a tree node with the per signal IPlatformIO::agg_*()
+/// functions applied to a vector of vectors against a single
+/// MatrixReduce pass over a packed matrix.  The reductions are those
+/// used by the PowerBalancerAgent.  Output is CSV: fan in, time per
+/// reduction in microseconds for each method, and speedup.
+int main(int argc, char **argv)
+{
+    using geopm::IPlatformIO;
+    using geopm::MatrixReduce;
+    using geopm::MatrixView;
+
+    int num_iter = 10000;
+    if (argc > 1) {
+        num_iter = atoi(argv[1]);
+    }
+    const size_t num_sample = 3;
+    const std::vector<std::function<double(const std::vector<double> &)> > agg_func {
+        IPlatformIO::agg_max, IPlatformIO::agg_average, IPlatformIO::agg_and};
+    const std::vector<int> reduce_type {
+        MatrixReduce::M_REDUCE_MAX, MatrixReduce::M_REDUCE_AVERAGE, MatrixReduce::M_REDUCE_AND};
+    MatrixReduce reduce;
+    std::vector<double> out_sample(num_sample);
+    double check = 0.0;
+
+    std::cout << "fan_in,agg_func_usec,matrix_reduce_usec,speedup" << std::endl;
+    for (size_t fan_in = 8; fan_in <= 1024; fan_in *= 2) {
+        std::vector<std::vector<double> > in_sample(fan_in, std::vector<double>(num_sample));
+        std::vector<double> in_matrix(fan_in * num_sample);
+        for (size_t child_idx = 0; child_idx < fan_in; ++child_idx) {
+            in_sample[child_idx] = {1.0 + child_idx % 13, 100.0 + child_idx % 7, 1.0};
+            std::copy(in_sample[child_idx].begin(), in_sample[child_idx].end(),
+                      in_matrix.begin() + child_idx * num_sample);
+        }
+
+        struct geopm_time_s begin, end;
+        geopm_time(&begin);
+        for (int iter = 0; iter < num_iter; ++iter) {
+            std::vector<double> child_sample(fan_in);
+            for (size_t sig_idx = 0; sig_idx < num_sample; ++sig_idx) {
+                for (size_t child_idx = 0; child_idx < fan_in; ++child_idx) {
+                    child_sample[child_idx] = in_sample[child_idx][sig_idx];
+                }
+                out_sample[sig_idx] = agg_func[sig_idx](child_sample);
+            }
+            check += out_sample[0];
+        }
+        geopm_time(&end);
+        double agg_time = geopm_time_diff(&begin, &end) / num_iter;
+
+        MatrixView<const double> matrix(in_matrix.data(), fan_in, num_sample);
+        geopm_time(&begin);
+        for (int iter = 0; iter < num_iter; ++iter) {
+            reduce.reduce(matrix, reduce_type, out_sample);
+            check -= out_sample[0];
+        }
+        geopm_time(&end);
+        double reduce_time = geopm_time_diff(&begin, &end) / num_iter;
+
+        std::cout << fan_in << ","
+                  << agg_time * 1e6 << ","
+                  << reduce_time * 1e6 << ","
+                  << agg_time / reduce_time << std::endl;
+    }
+    // Both methods must produce the same result
+    return check == 0.0 ? 0 : -1;
+}
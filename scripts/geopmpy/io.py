@@ -41,7 +41,10 @@ import numpy
 import glob
 import json
 import sys
+import struct
 import subprocess
+from cStringIO import StringIO
+from multiprocessing.pool import ThreadPool
 from natsort import natsorted
 from geopmpy import __version__
 
@@ -746,6 +749,164 @@ class Region(dict):
         return self['count']
 
 
+def lz4_block_decompress(data, raw_size):
+    """Decompresses one block in the LZ4 block format.
+
+    Used when the lz4 python module is not installed.
+
+    Args:
+        data: The compressed block.
+        raw_size: The size of the block after decompression.
+
+    Returns:
+        str: The decompressed block.
+    """
+    src = bytearray(data)
+    out = bytearray()
+    ip = 0
+    while ip < len(src):
+        token = src[ip]
+        ip += 1
+        length = token >> 4
+        if length == 15:
+            while True:
+                extra = src[ip]
+                ip += 1
+                length += extra
+                if extra != 255:
+                    break
+        out += src[ip:ip + length]
+        ip += length
+        if ip == len(src):
+            break
+        offset = src[ip] | (src[ip + 1] << 8)
+        ip += 2
+        length = token & 0xF
+        if length == 15:
+            while True:
+                extra = src[ip]
+                ip += 1
+                length += extra
+                if extra != 255:
+                    break
+        length += 4
+        if offset == 0 or offset > len(out):
+            raise RuntimeError('LZ4 block is corrupt')
+        begin = len(out) - offset
+        if offset >= length:
+            out += out[begin:begin + length]
+        else:
+            for idx in range(length):
+                out.append(out[begin + idx])
+    if len(out) != raw_size:
+        raise RuntimeError('LZ4 block is corrupt')
+    return str(out)
+
+
+class TraceBlocks(object):
+    """Index of a block compressed trace file.
+
+    Files written with GEOPM_TRACE_CODEC set begin with the line
+    "GEOPM_TRACE_BLOCKS <codec>" followed by independently compressed
+    blocks of trace text.  Each block is preceded by three little
+    endian uint32 values: a magic number, the uncompressed size and
+    the compressed size.  The index allows any block to be read
+    without the blocks that precede it.
+
+    Attributes:
+        trace_path: The path to the compressed trace file.
+
+    """
+    _MAGIC = 0x42545447
+    _HEADER = struct.Struct('<III')
+
+    def __init__(self, trace_path):
+        self._path = trace_path
+        self._index = []
+        self._stats = None
+        with open(trace_path, 'rb') as fid:
+            line = fid.readline()
+            if not line.startswith('GEOPM_TRACE_BLOCKS '):
+                raise SyntaxError('Trace file is not block compressed: {}'.format(trace_path))
+            self._codec = line.split()[1]
+            while True:
+                offset = fid.tell()
+                header = fid.read(self._HEADER.size)
+                if len(header) < self._HEADER.size:
+                    break
+                magic, raw_size, size = self._HEADER.unpack(header)
+                if magic != self._MAGIC:
+                    fid.seek(offset)
+                    self._stats = fid.read().strip()
+                    break
+                self._index.append((offset + self._HEADER.size, raw_size, size))
+                fid.seek(size, os.SEEK_CUR)
+        self._decompress = self._decompress_func(self._codec)
+
+    @staticmethod
+    def is_block_file(trace_path):
+        with open(trace_path, 'rb') as fid:
+            return fid.read(19) == 'GEOPM_TRACE_BLOCKS '
+
+    @staticmethod
+    def _decompress_func(codec):
+        if codec == 'lz4':
+            try:
+                import lz4.block
+                return lambda data, raw_size: lz4.block.decompress(data, uncompressed_size=raw_size)
+            except ImportError:
+                return lz4_block_decompress
+        elif codec == 'zstd':
+            import zstandard
+            return lambda data, raw_size: zstandard.ZstdDecompressor().decompress(data, max_output_size=raw_size)
+        raise SyntaxError('Unknown trace codec: {}'.format(codec))
+
+    def __len__(self):
+        return len(self._index)
+
+    def get_codec(self):
+        return self._codec
+
+    def get_stats(self):
+        """Returns the compression statistics line written after the
+        last block, or None if the trace was not closed.
+        """
+        return self._stats
+
+    def read_block(self, block_idx):
+        """Decompresses a single block.
+
+        Args:
+            block_idx: Index of the block in the file.
+
+        Returns:
+            str: The trace text held by the block.
+        """
+        offset, raw_size, size = self._index[block_idx]
+        with open(self._path, 'rb') as fid:
+            fid.seek(offset)
+            data = fid.read(size)
+        return self._decompress(data, raw_size)
+
+    def read(self, num_thread=None):
+        """Decompresses all blocks in parallel.
+
+        Args:
+            num_thread: Number of threads used, defaults to the
+                        number of CPUs.
+
+        Returns:
+            str: The full trace text.
+        """
+        if len(self._index) == 0:
+            return ''
+        pool = ThreadPool(num_thread)
+        try:
+            return ''.join(pool.map(self.read_block, range(len(self._index))))
+        finally:
+            pool.close()
+
+
 class Trace(object):
     """Creates a pandas DataFrame comprised of the trace file data.
 
@@ -759,13 +920,23 @@ class Trace(object):
     Using the raw object in a list and calling concat will cause an
     error.
 
+    Block compressed traces (see TraceBlocks) are decompressed before
+    they are parsed.
+
     Attributes:
         trace_path: The path to the trace file to parse.
 
     """
     def __init__(self, trace_path):
         self._path = trace_path
-        self._df = pandas.read_csv(trace_path, sep='|', comment='#', dtype={'region_id': str})  # region_id must be a string because pandas can't handle 64-bit integers
+        if TraceBlocks.is_block_file(trace_path):
+            trace_text = TraceBlocks(trace_path).read()
+            trace_csv = StringIO(trace_text)
+        else:
+            with open(trace_path) as fid:
+                trace_text = fid.read()
+            trace_csv = trace_path
+        self._df = pandas.read_csv(trace_csv, sep='|', comment='#', dtype={'region_id': str})  # region_id must be a string because pandas can't handle 64-bit integers
         self._df.columns = list(map(str.strip, self._df[:0]))  # Strip whitespace from column names
         self._df['region_id'] = self._df['region_id'].astype(str).map(str.strip)  # Strip whitespace from region ID's
         self._version = None
@@ -774,7 +945,9 @@ class Trace(object):
         self._tree_decider = None
         self._leaf_decider = None
         self._node_name = None
-        self._parse_header(trace_path)
+        trace_lines = trace_text.splitlines()
+        self._parse_header(trace_lines)
+        self._gaps = self._parse_gaps(trace_lines)
 
     def __repr__(self):
         return self._df.__repr__()
@@ -810,21 +983,18 @@ class Trace(object):
         """
         return self._df.__getitem__(key)
 
-    def _parse_header(self, trace_path):
+    def _parse_header(self, trace_lines):
         """Parses the configuration header out of the top of the trace file.
 
         Args:
-            trace_path: The path to the trace file to parse.t
+            trace_lines: The lines of the trace file to parse.
         """
-        done = False
         out = []
-        with open(trace_path) as fid:
-            while not done:
-                ll = fid.readline()
-                if ll.startswith('#'):
-                    out.append(ll[1:])
-                else:
-                    done = True
+        for ll in trace_lines:
+            if ll.startswith('#'):
+                out.append(ll[1:] + '\n')
+            else:
+                break
         out.insert(0, '{')
         out.append('}')
         json_str = ''.join(out)
@@ -839,9 +1009,33 @@ class Trace(object):
         except KeyError:
             raise SyntaxError('Trace file header could not be parsed!')
 
+    def _parse_gaps(self, trace_lines):
+        """Parses the gap markers written by the adaptive trace mode.
+
+        Each marker records a run of rows that were not written
+        because all columns stayed within the configured tolerance.
+
+        Args:
+            trace_lines: The lines of the trace file to parse.
+
+        Returns:
+            pandas.DataFrame: One row per gap with the number of rows
+                              dropped and the time of the first and
+                              last dropped rows.
+        """
+        gaps = []
+        for ll in trace_lines:
+            if ll.startswith('# gap '):
+                fields = ll.split()
+                gaps.append((int(fields[2]), float(fields[3]), float(fields[4])))
+        return pandas.DataFrame(gaps, columns=['num_row', 'begin', 'end'])
+
     def get_df(self):
         return self._df
 
+    def get_gaps(self):
+        return self._gaps
+
     def get_version(self):
         return self._version
 
@@ -31,6 +31,7 @@
  */
 
 #include <sstream>
+#include <algorithm>
 
 #include "geopm_agent.h"
 #include "string.h"
@@ -39,6 +40,7 @@
 #include "PowerBalancerAgent.hpp"
 #include "PowerGovernorAgent.hpp"
 #include "EnergyEfficientAgent.hpp"
+#include "ThreadPool.hpp"
 #include "config.h"
 
 namespace geopm
@@ -78,6 +80,65 @@ namespace geopm
     const std::string Agent::m_sample_prefix = "SAMPLE_";
     const std::string Agent::m_policy_prefix = "POLICY_";
 
+    bool Agent::descend_view(const std::vector<double> &in_policy,
+                             MatrixView<double> out_policy)
+    {
+        m_adapt_policy.resize(out_policy.num_row());
+        for (size_t child_idx = 0; child_idx != out_policy.num_row(); ++child_idx) {
+            const double *child_policy = out_policy.row(child_idx);
+            m_adapt_policy[child_idx].assign(child_policy, child_policy + out_policy.num_col());
+        }
+        bool result = descend(in_policy, m_adapt_policy);
+        // Copy back even if nothing is sent so that the values are
+        // preserved for the next call.
+        for (size_t child_idx = 0; child_idx != out_policy.num_row(); ++child_idx) {
+#ifdef GEOPM_DEBUG
+            if (m_adapt_policy[child_idx].size() != out_policy.num_col()) {
+                throw Exception("Agent::descend_view(): descend() resized the policy vector.",
+                                GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+            }
+#endif
+            std::copy(m_adapt_policy[child_idx].begin(),
+                      m_adapt_policy[child_idx].end(),
+                      out_policy.row(child_idx));
+        }
+        return result;
+    }
+
+    void Agent::update_region_info(const std::list<geopm_region_info_s> &region_info)
+    {
+
+    }
+
+    void Agent::thread_pool(std::shared_ptr<ThreadPool> pool)
+    {
+        m_thread_pool = pool;
+    }
+
+    void Agent::parallel_for(size_t begin, size_t end,
+                             const std::function<void(size_t)> &func)
+    {
+        if (m_thread_pool) {
+            m_thread_pool->parallel_for(begin, end, func);
+        }
+        else {
+            for (size_t idx = begin; idx < end; ++idx) {
+                func(idx);
+            }
+        }
+    }
+
+    bool Agent::ascend_view(MatrixView<const double> in_signal,
+                            std::vector<double> &out_signal)
+    {
+        m_adapt_signal.resize(in_signal.num_row());
+        for (size_t child_idx = 0; child_idx != in_signal.num_row(); ++child_idx) {
+            const double *child_signal = in_signal.row(child_idx);
+            m_adapt_signal[child_idx].assign(child_signal, child_signal + in_signal.num_col());
+        }
+        return ascend(m_adapt_signal, out_signal);
+    }
+
     int Agent::num_sample(const std::map<std::string, std::string> &dictionary)
     {
         auto it = dictionary.find(m_num_sample_string);
@@ -34,14 +34,21 @@
 #define AGENT_HPP_INCLUDE
 
 #include <string>
+#include <list>
 #include <map>
 #include <vector>
+#include <memory>
+#include <functional>
 
+#include "geopm_message.h"
 #include "PluginFactory.hpp"
 #include "PlatformIO.hpp"
+#include "MatrixView.hpp"
 
 namespace geopm
 {
+    class ThreadPool;
+
     class Agent
     {
         public:
@@ -74,6 +81,31 @@ namespace geopm
             ///        sent up to the parent.
             virtual bool ascend(const std::vector<std::vector<double> > &in_signal,
                                 std::vector<double> &out_signal) = 0;
+            /// @brief Called by Kontroller to split policy for
+            ///        children at next level down the tree.  The
+            ///        policies are written directly into a contiguous
+            ///        matrix that is sent to the children without
+            ///        further copies.  The default implementation
+            ///        adapts the call to descend(); Agents may
+            ///        override it to avoid the intermediate vectors.
+            /// @param [in] in_policy Policy values from the parent.
+            /// @param [in,out] out_policy Matrix with one row of
+            ///        policy values for each child.  Values written
+            ///        by the previous call are preserved.
+            virtual bool descend_view(const std::vector<double> &in_policy,
+                                      MatrixView<double> out_policy);
+            /// @brief Aggregate signals from children for the next
+            ///        level up the tree.  The samples are read
+            ///        directly from a contiguous matrix filled by the
+            ///        TreeComm.  The default implementation adapts
+            ///        the call to ascend(); Agents may override it
+            ///        to avoid the intermediate vectors.
+            /// @param [in] in_signal Matrix with one row of signal
+            ///        values from each child.
+            /// @param [out] out_signal Aggregated signal values to be
+            ///        sent up to the parent.
+            virtual bool ascend_view(MatrixView<const double> in_signal,
+                                     std::vector<double> &out_signal);
             /// @brief Adjust the platform settings based the policy
             ///        from above.
             /// @param [in] policy Settings for each control in the
@@ -100,6 +132,18 @@ namespace geopm
             /// @brief Called by Kontroller to get latest values to be
             ///        added to the trace.
             virtual void trace_values(std::vector<double> &values) = 0;
+            /// @brief Called by Kontroller on every step with the
+            ///        region entries and exits reported by the
+            ///        application since the last step, the same
+            ///        data given to the Tracer.  The default
+            ///        implementation ignores them.
+            /// @param [in] region_info Entries and exits in the
+            ///        order they occurred.
+            virtual void update_region_info(const std::list<geopm_region_info_s> &region_info);
+            /// @brief Called by Kontroller to provide the thread
+            ///        pool used by parallel_for().
+            /// @param [in] pool Thread pool owned by the Kontroller.
+            void thread_pool(std::shared_ptr<ThreadPool> pool);
             /// @brief Used to look up the number of values in the
             ///        policy vector sent down the tree for a specific
             ///        Agent.  This should be called with the
@@ -136,7 +180,22 @@ namespace geopm
             ///        to be passed to this method.
             static std::map<std::string, std::string> make_dictionary(const std::vector<std::string> &policy_names,
                                                                       const std::vector<std::string> &sample_names);
+        protected:
+            /// @brief Call func(idx) for every idx in [begin, end).
+            ///        The calls are spread over the thread pool of
+            ///        the Kontroller if one was provided, and are
+            ///        made serially in the calling thread otherwise
+            ///        or when the pool has one thread.  The order of
+            ///        the calls is unspecified, so func may only
+            ///        write state that is private to idx.
+            void parallel_for(size_t begin, size_t end,
+                              const std::function<void(size_t)> &func);
         private:
+            std::shared_ptr<ThreadPool> m_thread_pool;
+            /// Storage used to adapt descend_view() to descend().
+            std::vector<std::vector<double> > m_adapt_policy;
+            /// Storage used to adapt ascend_view() to ascend().
+            std::vector<std::vector<double> > m_adapt_signal;
             static const std::string m_num_sample_string;
             static const std::string m_num_policy_string;
             static const std::string m_sample_prefix;
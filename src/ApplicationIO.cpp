@@ -31,6 +31,7 @@
  */
 
 #include <utility>
+#include <numeric>
 
 #include "ApplicationIO.hpp"
 #include "EpochRuntimeRegulator.hpp"
@@ -243,16 +244,18 @@ namespace geopm
 
     double ApplicationIO::current_energy(void) const
     {
-        double energy = 0.0;
+        std::vector<IPlatformIO::m_request_s> request;
         int num_package = m_platform_topo.num_domain(IPlatformTopo::M_DOMAIN_PACKAGE);
         for (int pkg = 0; pkg < num_package; ++pkg) {
-            energy += m_platform_io.read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+            request.push_back({"ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, pkg});
         }
         int num_dram = m_platform_topo.num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY);
         for (int dram = 0; dram < num_dram; ++dram) {
-            energy += m_platform_io.read_signal("ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 0);
+            request.push_back({"ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, dram});
         }
-        return energy;
+        std::vector<double> value;
+        m_platform_io.read_signal_batch(request, value);
+        return std::accumulate(value.begin(), value.end(), 0.0);
     }
 
     double ApplicationIO::total_app_energy(void) const
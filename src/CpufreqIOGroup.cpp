@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "CpufreqIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "MSRIO.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+#define GEOPM_CPUFREQ_IO_GROUP_PLUGIN_NAME "CPUFREQ"
+
+namespace geopm
+{
+    CpufreqIOGroup::CpufreqIOGroup()
+        : CpufreqIOGroup(platform_topo(), "/sys/devices/system/cpu", !MSRIO::is_available())
+    {
+
+    }
+
+    CpufreqIOGroup::CpufreqIOGroup(IPlatformTopo &topo, const std::string &cpu_path, bool is_alias)
+        : m_platform_topo(topo)
+        , m_num_cpu(topo.num_domain(IPlatformTopo::M_DOMAIN_CPU))
+        , m_is_active(false)
+        , m_is_read(false)
+        , m_cpu_file_idx(M_NUM_FILE_TYPE)
+    {
+        scan_policies(cpu_path, is_alias);
+    }
+
+    CpufreqIOGroup::~CpufreqIOGroup()
+    {
+        for (auto &file : m_file) {
+            if (file.read_fd != -1) {
+                (void)close(file.read_fd);
+            }
+            if (file.write_fd != -1) {
+                (void)close(file.write_fd);
+            }
+        }
+    }
+
+    void CpufreqIOGroup::scan_policies(const std::string &cpu_path, bool is_alias)
+    {
+        // Each cpu<N>/cpufreq is usually a link to a policy
+        // directory that may be shared by several CPUs, so resolve
+        // the links to find the CPUs that share files.
+        std::vector<std::string> policy_path(m_num_cpu);
+        bool is_userspace = m_num_cpu > 0;
+        for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+            std::string path = cpu_path + "/cpu" + std::to_string(cpu_idx) + "/cpufreq";
+            char real_path[PATH_MAX];
+            if (!realpath(path.c_str(), real_path)) {
+                throw Exception("CpufreqIOGroup: no cpufreq policy found at " + path,
+                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            policy_path[cpu_idx] = real_path;
+            std::ifstream governor_file(policy_path[cpu_idx] + "/scaling_governor");
+            std::string governor;
+            std::getline(governor_file, governor);
+            is_userspace = is_userspace && governor == "userspace";
+        }
+
+        struct m_file_info_s {
+            int file_type;
+            std::string attribute;
+            bool is_signal;
+            bool is_control;
+        };
+        std::vector<m_file_info_s> file_info {
+            {M_FILE_SCALING_CUR_FREQ, "scaling_cur_freq", true, false},
+            {M_FILE_CPUINFO_CUR_FREQ, "cpuinfo_cur_freq", true, false},
+            {M_FILE_SCALING_MIN_FREQ, "scaling_min_freq", true, true},
+            {M_FILE_SCALING_MAX_FREQ, "scaling_max_freq", true, true},
+            // Only meaningful with the userspace governor
+            {M_FILE_SCALING_SETSPEED, "scaling_setspeed", false, is_userspace},
+        };
+        std::map<std::string, int> path_file_idx;
+        for (const auto &info : file_info) {
+            // Only provide a file type if every CPU has it
+            bool is_readable = info.is_signal && m_num_cpu > 0;
+            bool is_writable = info.is_control && m_num_cpu > 0;
+            for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+                std::string path = policy_path[cpu_idx] + "/" + info.attribute;
+                is_readable = is_readable && access(path.c_str(), R_OK) == 0;
+                is_writable = is_writable && access(path.c_str(), W_OK) == 0;
+            }
+            if (!is_readable && !is_writable) {
+                continue;
+            }
+            std::string name = info.attribute;
+            std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+            name = plugin_name() + "::" + name;
+            if (is_readable) {
+                m_signal_file_type[name] = info.file_type;
+            }
+            if (is_writable) {
+                m_control_file_type[name] = info.file_type;
+            }
+            m_cpu_file_idx[info.file_type].resize(m_num_cpu);
+            for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+                std::string path = policy_path[cpu_idx] + "/" + info.attribute;
+                auto it = path_file_idx.find(path);
+                if (it == path_file_idx.end()) {
+                    it = path_file_idx.emplace(path, m_file.size()).first;
+                    m_file.push_back({path, -1, -1, NAN});
+                }
+                m_cpu_file_idx[info.file_type][cpu_idx] = it->second;
+            }
+        }
+        if (m_signal_file_type.empty()) {
+            throw Exception("CpufreqIOGroup: no readable cpufreq files found in " + cpu_path,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (is_alias) {
+            auto it = m_signal_file_type.find(plugin_name() + "::SCALING_CUR_FREQ");
+            if (it != m_signal_file_type.end()) {
+                m_signal_file_type["FREQUENCY"] = it->second;
+            }
+            it = m_control_file_type.find(plugin_name() + "::SCALING_SETSPEED");
+            if (it == m_control_file_type.end()) {
+                it = m_control_file_type.find(plugin_name() + "::SCALING_MAX_FREQ");
+            }
+            if (it != m_control_file_type.end()) {
+                m_control_file_type["FREQUENCY"] = it->second;
+            }
+        }
+    }
+
+    std::set<std::string> CpufreqIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_signal_file_type) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> CpufreqIOGroup::control_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_control_file_type) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    bool CpufreqIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_file_type.find(signal_name) != m_signal_file_type.end();
+    }
+
+    bool CpufreqIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return m_control_file_type.find(control_name) != m_control_file_type.end();
+    }
+
+    int CpufreqIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = PlatformTopo::M_DOMAIN_INVALID;
+        if (is_valid_signal(signal_name)) {
+            result = PlatformTopo::M_DOMAIN_CPU;
+        }
+        return result;
+    }
+
+    int CpufreqIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        int result = PlatformTopo::M_DOMAIN_INVALID;
+        if (is_valid_control(control_name)) {
+            result = PlatformTopo::M_DOMAIN_CORE;
+        }
+        return result;
+    }
+
+    int CpufreqIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        int file_type = signal_file_type("push_signal", signal_name, domain_type, domain_idx);
+        if (m_is_active) {
+            throw Exception("CpufreqIOGroup::push_signal(): cannot push signal after call to read_batch() or write_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int file_idx = m_cpu_file_idx[file_type][domain_idx];
+        auto it = std::find(m_active_signal.begin(), m_active_signal.end(), file_idx);
+        int result = it - m_active_signal.begin();
+        if (it == m_active_signal.end()) {
+            m_active_signal.push_back(file_idx);
+            m_signal_value.push_back(NAN);
+        }
+        return result;
+    }
+
+    int CpufreqIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        std::vector<int> file_idx = control_file_idx("push_control", control_name, domain_type, domain_idx);
+        if (m_is_active) {
+            throw Exception("CpufreqIOGroup::push_control(): cannot push control after call to read_batch() or write_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        auto it = std::find(m_active_control.begin(), m_active_control.end(), file_idx);
+        int result = it - m_active_control.begin();
+        if (it == m_active_control.end()) {
+            m_active_control.push_back(file_idx);
+            m_control_value.push_back(NAN);
+        }
+        return result;
+    }
+
+    void CpufreqIOGroup::read_batch(void)
+    {
+        m_is_active = true;
+        for (size_t signal_idx = 0; signal_idx < m_active_signal.size(); ++signal_idx) {
+            m_signal_value[signal_idx] = read_file(m_file[m_active_signal[signal_idx]]);
+        }
+        m_is_read = true;
+    }
+
+    void CpufreqIOGroup::write_batch(void)
+    {
+        m_is_active = true;
+        for (size_t control_idx = 0; control_idx < m_active_control.size(); ++control_idx) {
+            double setting = m_control_value[control_idx];
+            if (std::isnan(setting)) {
+                continue;
+            }
+            for (int file_idx : m_active_control[control_idx]) {
+                // Each write is a trip through the cpufreq driver
+                // and may take a policy lock, so skip unchanged
+                // values.
+                if (m_file[file_idx].last_write != setting) {
+                    write_file(m_file[file_idx], setting);
+                }
+            }
+        }
+    }
+
+    double CpufreqIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_active_signal.size()) {
+            throw Exception("CpufreqIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!m_is_read) {
+            throw Exception("CpufreqIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_signal_value[batch_idx];
+    }
+
+    void CpufreqIOGroup::adjust(int batch_idx, double setting)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_active_control.size()) {
+            throw Exception("CpufreqIOGroup::adjust(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_control_value[batch_idx] = setting;
+    }
+
+    double CpufreqIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        int file_type = signal_file_type("read_signal", signal_name, domain_type, domain_idx);
+        return read_file(m_file[m_cpu_file_idx[file_type][domain_idx]]);
+    }
+
+    void CpufreqIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        for (int file_idx : control_file_idx("write_control", control_name, domain_type, domain_idx)) {
+            write_file(m_file[file_idx], setting);
+        }
+    }
+
+    void CpufreqIOGroup::save_control(void)
+    {
+        m_saved_value.clear();
+        for (const auto &it : m_control_file_type) {
+            for (int file_idx : m_cpu_file_idx[it.second]) {
+                if (m_saved_value.find(file_idx) == m_saved_value.end()) {
+                    m_saved_value[file_idx] = read_file(m_file[file_idx]);
+                }
+            }
+        }
+    }
+
+    void CpufreqIOGroup::restore_control(void)
+    {
+        for (const auto &it : m_saved_value) {
+            write_file(m_file[it.first], it.second);
+        }
+    }
+
+    std::string CpufreqIOGroup::plugin_name(void)
+    {
+        return GEOPM_CPUFREQ_IO_GROUP_PLUGIN_NAME;
+    }
+
+    std::unique_ptr<IOGroup> CpufreqIOGroup::make_plugin(void)
+    {
+        return std::unique_ptr<IOGroup>(new CpufreqIOGroup);
+    }
+
+    int CpufreqIOGroup::signal_file_type(const std::string &func_name, const std::string &signal_name,
+                                         int domain_type, int domain_idx) const
+    {
+        auto it = m_signal_file_type.find(signal_name);
+        if (it == m_signal_file_type.end()) {
+            throw Exception("CpufreqIOGroup::" + func_name + "(): signal_name " + signal_name +
+                            " not valid for CpufreqIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != PlatformTopo::M_DOMAIN_CPU) {
+            throw Exception("CpufreqIOGroup::" + func_name + "(): domain_type must be M_DOMAIN_CPU",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= m_num_cpu) {
+            throw Exception("CpufreqIOGroup::" + func_name + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second;
+    }
+
+    std::vector<int> CpufreqIOGroup::control_file_idx(const std::string &func_name, const std::string &control_name,
+                                                      int domain_type, int domain_idx) const
+    {
+        auto it = m_control_file_type.find(control_name);
+        if (it == m_control_file_type.end()) {
+            throw Exception("CpufreqIOGroup::" + func_name + "(): control_name " + control_name +
+                            " not valid for CpufreqIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != PlatformTopo::M_DOMAIN_CORE &&
+            domain_type != PlatformTopo::M_DOMAIN_CPU) {
+            throw Exception("CpufreqIOGroup::" + func_name + "(): domain_type must be M_DOMAIN_CORE or M_DOMAIN_CPU",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= m_platform_topo.num_domain(domain_type)) {
+            throw Exception("CpufreqIOGroup::" + func_name + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::vector<int> result;
+        for (int cpu_idx : m_platform_topo.domain_cpu_list(domain_type, domain_idx)) {
+            result.push_back(m_cpu_file_idx[it->second][cpu_idx]);
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    double CpufreqIOGroup::read_file(m_file_s &file)
+    {
+        if (file.read_fd == -1) {
+            file.read_fd = open(file.path.c_str(), O_RDONLY);
+            if (file.read_fd == -1) {
+                throw Exception("CpufreqIOGroup: unable to open " + file.path + " for reading",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        }
+        char buffer[64];
+        ssize_t num_byte = pread(file.read_fd, buffer, sizeof(buffer) - 1, 0);
+        if (num_byte <= 0) {
+            throw Exception("CpufreqIOGroup: unable to read " + file.path,
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        buffer[num_byte] = '\0';
+        char *end = NULL;
+        errno = 0;
+        unsigned long long value = strtoull(buffer, &end, 10);
+        if (errno || end == buffer || (*end != '\0' && *end != '\n')) {
+            throw Exception("CpufreqIOGroup: unable to parse " + file.path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        // Files are in kHz
+        return value * 1e3;
+    }
+
+    void CpufreqIOGroup::write_file(m_file_s &file, double setting)
+    {
+        if (!(setting >= 0.0)) {
+            throw Exception("CpufreqIOGroup: invalid setting for " + file.path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (file.write_fd == -1) {
+            file.write_fd = open(file.path.c_str(), O_WRONLY);
+            if (file.write_fd == -1) {
+                throw Exception("CpufreqIOGroup: unable to open " + file.path + " for writing",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        }
+        std::string value = std::to_string((unsigned long long)(setting * 1e-3 + 0.5)) + "\n";
+        if (pwrite(file.write_fd, value.c_str(), value.size(), 0) != (ssize_t)value.size()) {
+            throw Exception("CpufreqIOGroup: unable to write " + file.path,
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        // Discard any longer previous value; this is a no-op for
+        // sysfs attributes and only matters for regular files.
+        int err = ftruncate(file.write_fd, value.size());
+        (void)err;
+        file.last_write = setting;
+    }
+}
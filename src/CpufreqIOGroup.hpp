@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CPUFREQIOGROUP_HPP_INCLUDE
+#define CPUFREQIOGROUP_HPP_INCLUDE
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "IOGroup.hpp"
+
+namespace geopm
+{
+    class IPlatformTopo;
+
+    /// @brief IOGroup that provides CPU frequency signals and
+    ///        controls through the Linux cpufreq sysfs interface,
+    ///        for systems where the scaling governor rather than
+    ///        the PERF_CTL MSR is the sanctioned way to set the
+    ///        frequency.
+    ///
+    /// Signals are provided per CPU.  Controls are provided per
+    /// core and also accept the CPU domain; the core domain matches
+    /// the FREQUENCY control of the MSRIOGroup.  CPUs that share a
+    /// cpufreq policy share the underlying files, so each policy is
+    /// written at most once per write_batch(), and only when its
+    /// value changed since the last write.  File descriptors are
+    /// opened on first use and kept open.
+    ///
+    /// The FREQUENCY signal and control aliases are only provided
+    /// when the MSR driver is not usable.  The FREQUENCY control
+    /// maps to scaling_setspeed if every CPU uses the userspace
+    /// governor and to scaling_max_freq otherwise.
+    class CpufreqIOGroup : public IOGroup
+    {
+        public:
+            CpufreqIOGroup();
+            /// @brief Constructor used for testing.
+            /// @param [in] topo Platform topology.
+            /// @param [in] cpu_path Directory that holds the
+            ///        cpu<N>/cpufreq directories, normally
+            ///        /sys/devices/system/cpu.
+            /// @param [in] is_alias If true provide the FREQUENCY
+            ///        signal and control aliases.
+            CpufreqIOGroup(IPlatformTopo &topo, const std::string &cpu_path, bool is_alias);
+            virtual ~CpufreqIOGroup();
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            static std::string plugin_name(void);
+            static std::unique_ptr<IOGroup> make_plugin(void);
+        private:
+            enum m_file_type_e {
+                M_FILE_SCALING_CUR_FREQ,
+                M_FILE_CPUINFO_CUR_FREQ,
+                M_FILE_SCALING_MIN_FREQ,
+                M_FILE_SCALING_MAX_FREQ,
+                M_FILE_SCALING_SETSPEED,
+                M_NUM_FILE_TYPE,
+            };
+            /// @brief One cpufreq attribute of one policy.
+            struct m_file_s {
+                std::string path;
+                int read_fd;
+                int write_fd;
+                /// Last value written in Hz, NAN if never written.
+                double last_write;
+            };
+            void scan_policies(const std::string &cpu_path, bool is_alias);
+            int signal_file_type(const std::string &func_name, const std::string &signal_name,
+                                 int domain_type, int domain_idx) const;
+            std::vector<int> control_file_idx(const std::string &func_name, const std::string &control_name,
+                                              int domain_type, int domain_idx) const;
+            double read_file(m_file_s &file);
+            void write_file(m_file_s &file, double setting);
+
+            IPlatformTopo &m_platform_topo;
+            const int m_num_cpu;
+            bool m_is_active;
+            bool m_is_read;
+            /// Files shared by all CPUs of a cpufreq policy
+            std::vector<m_file_s> m_file;
+            /// Index into m_file by [file type][cpu index]
+            std::vector<std::vector<int> > m_cpu_file_idx;
+            std::map<std::string, int> m_signal_file_type;
+            std::map<std::string, int> m_control_file_type;
+            /// Pushed signals as index into m_file
+            std::vector<int> m_active_signal;
+            std::vector<double> m_signal_value;
+            /// Pushed controls as the list of indices into m_file
+            std::vector<std::vector<int> > m_active_control;
+            std::vector<double> m_control_value;
+            /// Values saved by save_control() keyed on index into m_file
+            std::map<int, double> m_saved_value;
+    };
+}
+
+#endif
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+
+#include "EndpointAggregator.hpp"
+#include "ManagerIO.hpp"
+#include "SharedMemory.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    static size_t endpoint_row_size(size_t num_field)
+    {
+        return sizeof(struct geopm_endpoint_row_s) + num_field * sizeof(double);
+    }
+
+    size_t EndpointAggregator::table_size(size_t num_field, size_t max_job)
+    {
+        return sizeof(struct geopm_endpoint_table_s) + max_job * endpoint_row_size(num_field);
+    }
+
+    EndpointAggregator::EndpointAggregator(const std::string &table_key,
+                                           const std::vector<std::string> &field_names,
+                                           size_t max_job)
+        : EndpointAggregator(geopm::make_unique<SharedMemory>(table_key, table_size(field_names.size(), max_job)),
+                             field_names, max_job)
+    {
+
+    }
+
+    EndpointAggregator::EndpointAggregator(std::unique_ptr<ISharedMemory> table,
+                                           const std::vector<std::string> &field_names,
+                                           size_t max_job)
+        : m_shmem(std::move(table))
+        , m_table(nullptr)
+        , m_field_names(field_names)
+        , m_max_job(max_job)
+    {
+        if (field_names.size() > GEOPM_SAMPLE_RING_MAX_FIELD) {
+            throw Exception("EndpointAggregator: at most " + std::to_string(GEOPM_SAMPLE_RING_MAX_FIELD) +
+                            " fields are supported", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_shmem->size() < table_size(field_names.size(), max_job)) {
+            throw Exception("EndpointAggregator: shared memory region is too small",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        memset(m_shmem->pointer(), 0, table_size(field_names.size(), max_job));
+        m_table = (struct geopm_endpoint_table_s *)m_shmem->pointer();
+        m_table->max_job = max_job;
+        m_table->num_field = field_names.size();
+        for (size_t field_idx = 0; field_idx != field_names.size(); ++field_idx) {
+            if (field_names[field_idx].size() >= GEOPM_SAMPLE_RING_NAME_MAX) {
+                throw Exception("EndpointAggregator: field name too long: " + field_names[field_idx],
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            strncpy(m_table->field_name[field_idx], field_names[field_idx].c_str(),
+                    GEOPM_SAMPLE_RING_NAME_MAX - 1);
+        }
+        __atomic_store_n(&m_table->magic, (uint64_t)GEOPM_ENDPOINT_TABLE_MAGIC, __ATOMIC_RELEASE);
+    }
+
+    EndpointAggregator::~EndpointAggregator() = default;
+
+    void EndpointAggregator::add_job(const std::string &job_name,
+                                     const std::string &agent_name,
+                                     const std::string &policy_key,
+                                     const std::string &sample_key)
+    {
+        add_job(job_name,
+                geopm::make_unique<ManagerIO>(policy_key, true, agent_name),
+                geopm::make_unique<SampleRingReader>(sample_key, m_field_names));
+    }
+
+    void EndpointAggregator::add_job(const std::string &job_name,
+                                     std::unique_ptr<IManagerIO> policy,
+                                     std::unique_ptr<ISampleRingReader> sample)
+    {
+        if (job_name.empty() || job_name.size() >= GEOPM_ENDPOINT_JOB_NAME_MAX) {
+            throw Exception("EndpointAggregator::add_job(): invalid job name \"" + job_name + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_job_idx.find(job_name) != m_job_idx.end()) {
+            throw Exception("EndpointAggregator::add_job(): job \"" + job_name + "\" is already tracked",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_job.size() == m_max_job) {
+            throw Exception("EndpointAggregator::add_job(): table is full",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (sample->field_names() != m_field_names) {
+            throw Exception("EndpointAggregator::add_job(): sample reader for job \"" + job_name +
+                            "\" does not provide the fields of the table",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_job_idx[job_name] = m_job.size();
+        m_job.push_back({job_name, std::move(policy), std::move(sample), {}, false,
+                         0.0, std::vector<double>(m_field_names.size(), NAN), 0, 0});
+        write_table();
+    }
+
+    void EndpointAggregator::remove_job(const std::string &job_name)
+    {
+        auto job_it = m_job_idx.find(job_name);
+        if (job_it == m_job_idx.end()) {
+            throw Exception("EndpointAggregator::remove_job(): job \"" + job_name + "\" is not tracked",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_job.erase(m_job.begin() + job_it->second);
+        m_job_idx.clear();
+        for (size_t job_idx = 0; job_idx != m_job.size(); ++job_idx) {
+            m_job_idx[m_job[job_idx].name] = job_idx;
+        }
+        write_table();
+    }
+
+    std::vector<std::string> EndpointAggregator::job_names(void) const
+    {
+        std::vector<std::string> result;
+        for (const auto &job : m_job) {
+            result.push_back(job.name);
+        }
+        return result;
+    }
+
+    void EndpointAggregator::adjust(const std::string &job_name, const std::vector<double> &policy)
+    {
+        auto job_it = m_job_idx.find(job_name);
+        if (job_it == m_job_idx.end()) {
+            throw Exception("EndpointAggregator::adjust(): job \"" + job_name + "\" is not tracked",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_job_s &job = m_job[job_it->second];
+        job.pending_policy = policy;
+        job.is_policy_pending = true;
+    }
+
+    int EndpointAggregator::write_batch(void)
+    {
+        int result = 0;
+        for (auto &job : m_job) {
+            if (job.is_policy_pending) {
+                job.policy->adjust(job.pending_policy);
+                job.policy->write_batch();
+                job.is_policy_pending = false;
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    void EndpointAggregator::update(void)
+    {
+        for (auto &job : m_job) {
+            job.num_lost += job.sample->read(m_timestamp_buffer, m_sample_buffer);
+            if (!m_sample_buffer.empty()) {
+                job.timestamp = m_timestamp_buffer.back();
+                job.last_sample = m_sample_buffer.back();
+                job.num_sample += m_sample_buffer.size();
+            }
+        }
+        write_table();
+    }
+
+    void EndpointAggregator::write_table(void)
+    {
+        uint64_t generation = m_table->generation;
+        __atomic_store_n(&m_table->generation, generation + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        char *row_ptr = (char *)m_table + sizeof(struct geopm_endpoint_table_s);
+        size_t row_size = endpoint_row_size(m_field_names.size());
+        for (const auto &job : m_job) {
+            struct geopm_endpoint_row_s *row = (struct geopm_endpoint_row_s *)row_ptr;
+            memset(row->job_name, 0, GEOPM_ENDPOINT_JOB_NAME_MAX);
+            strncpy(row->job_name, job.name.c_str(), GEOPM_ENDPOINT_JOB_NAME_MAX - 1);
+            row->timestamp = job.timestamp;
+            row->num_sample = job.num_sample;
+            row->num_lost = job.num_lost;
+            memcpy(row_ptr + sizeof(struct geopm_endpoint_row_s), job.last_sample.data(),
+                   job.last_sample.size() * sizeof(double));
+            row_ptr += row_size;
+        }
+        m_table->num_job = m_job.size();
+        __atomic_store_n(&m_table->generation, generation + 2, __ATOMIC_RELEASE);
+    }
+
+    EndpointTableReader::EndpointTableReader(const std::string &table_key)
+        : EndpointTableReader(geopm::make_unique<SharedMemoryUser>(table_key))
+    {
+
+    }
+
+    EndpointTableReader::EndpointTableReader(std::unique_ptr<ISharedMemoryUser> table)
+        : m_shmem(std::move(table))
+        , m_table((const struct geopm_endpoint_table_s *)m_shmem->pointer())
+        , m_max_job(0)
+        , m_num_field(0)
+    {
+        if (m_shmem->size() < sizeof(struct geopm_endpoint_table_s) ||
+            __atomic_load_n(&m_table->magic, __ATOMIC_ACQUIRE) != GEOPM_ENDPOINT_TABLE_MAGIC) {
+            throw Exception("EndpointTableReader: shared memory region is not an endpoint table",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_max_job = m_table->max_job;
+        m_num_field = m_table->num_field;
+        if (m_num_field > GEOPM_SAMPLE_RING_MAX_FIELD ||
+            m_shmem->size() < EndpointAggregator::table_size(m_num_field, m_max_job)) {
+            throw Exception("EndpointTableReader: endpoint table header is corrupt",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        for (size_t field_idx = 0; field_idx != m_num_field; ++field_idx) {
+            m_field_names.emplace_back(m_table->field_name[field_idx],
+                                       strnlen(m_table->field_name[field_idx],
+                                               GEOPM_SAMPLE_RING_NAME_MAX));
+        }
+    }
+
+    EndpointTableReader::~EndpointTableReader() = default;
+
+    std::vector<std::string> EndpointTableReader::field_names(void) const
+    {
+        return m_field_names;
+    }
+
+    bool EndpointTableReader::read(std::vector<std::string> &job_name,
+                                   std::vector<double> &timestamp,
+                                   std::vector<std::vector<double> > &sample)
+    {
+        size_t row_size = endpoint_row_size(m_num_field);
+        const char *rows = (const char *)m_table + sizeof(struct geopm_endpoint_table_s);
+        std::vector<char> buffer;
+        size_t num_job = 0;
+        bool is_valid = false;
+        for (int retry = 0; !is_valid && retry != M_MAX_RETRY; ++retry) {
+            uint64_t generation = __atomic_load_n(&m_table->generation, __ATOMIC_ACQUIRE);
+            if (generation % 2) {
+                continue;
+            }
+            num_job = std::min((size_t)m_table->num_job, m_max_job);
+            buffer.assign(rows, rows + num_job * row_size);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            is_valid = generation == __atomic_load_n(&m_table->generation, __ATOMIC_RELAXED);
+        }
+        if (is_valid) {
+            job_name.resize(num_job);
+            timestamp.resize(num_job);
+            sample.resize(num_job);
+            for (size_t job_idx = 0; job_idx != num_job; ++job_idx) {
+                const char *row_ptr = buffer.data() + job_idx * row_size;
+                const struct geopm_endpoint_row_s *row = (const struct geopm_endpoint_row_s *)row_ptr;
+                job_name[job_idx] = std::string(row->job_name, strnlen(row->job_name, GEOPM_ENDPOINT_JOB_NAME_MAX));
+                timestamp[job_idx] = row->timestamp;
+                const double *values = (const double *)(row_ptr + sizeof(struct geopm_endpoint_row_s));
+                sample[job_idx].assign(values, values + m_num_field);
+            }
+        }
+        return is_valid;
+    }
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ENDPOINTAGGREGATOR_HPP_INCLUDE
+#define ENDPOINTAGGREGATOR_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "SampleRing.hpp"
+
+namespace geopm
+{
+    class IManagerIO;
+    class ISharedMemory;
+    class ISharedMemoryUser;
+
+    enum geopm_endpoint_table_e {
+        GEOPM_ENDPOINT_TABLE_MAGIC = 0x74706e65,
+        GEOPM_ENDPOINT_JOB_NAME_MAX = 64,
+    };
+
+    /// @brief Header of the shared memory table holding the latest
+    ///        sample of every job tracked by an EndpointAggregator.
+    ///
+    /// The header is followed by max_job rows, each a
+    /// geopm_endpoint_row_s followed by num_field double values.
+    /// Rows [0, num_job) are in use.  The single writer updates the
+    /// table under a sequence lock: generation is odd while rows are
+    /// written and even otherwise, and a reader keeps a copy only if
+    /// the generation was the same even value before and after it.
+    struct geopm_endpoint_table_s {
+        uint64_t magic;
+        uint64_t generation;
+        uint64_t max_job;
+        uint64_t num_field;
+        uint64_t num_job;
+        char field_name[GEOPM_SAMPLE_RING_MAX_FIELD][GEOPM_SAMPLE_RING_NAME_MAX];
+    };
+
+    struct geopm_endpoint_row_s {
+        /// @brief Null terminated name of the job.
+        char job_name[GEOPM_ENDPOINT_JOB_NAME_MAX];
+        /// @brief Time of the sample on the clock used by
+        ///        geopm_time(), or zero before the first sample.
+        double timestamp;
+        /// @brief Number of samples read from the job.
+        uint64_t num_sample;
+        /// @brief Number of samples overwritten in the job's ring
+        ///        before they were read.
+        uint64_t num_lost;
+        /// @brief Reserved to keep the values eight byte aligned.
+        uint64_t padding;
+    };
+
+    /// @brief Tracks the policy and sample endpoints of many jobs
+    ///        on a node for a resource manager.
+    ///
+    /// Policies for any number of jobs are staged with adjust() and
+    /// written together by write_batch().  The update() method
+    /// drains the SampleRing of every job and stores the latest
+    /// sample of each in one shared memory table, so that a site
+    /// power manager can observe all jobs with a single scan of an
+    /// EndpointTableReader instead of attaching to every job.
+    class EndpointAggregator
+    {
+        public:
+            EndpointAggregator() = delete;
+            EndpointAggregator(const EndpointAggregator &other) = delete;
+            /// @brief Create the shared memory table.
+            /// @param [in] table_key Shared memory key of the table.
+            /// @param [in] field_names Sample fields stored for
+            ///        every job; each job must publish all of them.
+            /// @param [in] max_job Maximum number of jobs tracked at
+            ///        the same time.
+            EndpointAggregator(const std::string &table_key,
+                               const std::vector<std::string> &field_names,
+                               size_t max_job);
+            EndpointAggregator(std::unique_ptr<ISharedMemory> table,
+                               const std::vector<std::string> &field_names,
+                               size_t max_job);
+            virtual ~EndpointAggregator();
+            /// @brief Begin tracking a job.
+            /// @param [in] job_name Unique name of the job.
+            /// @param [in] agent_name Agent run by the job, which
+            ///        determines its policy.
+            /// @param [in] policy_key Shared memory key created for
+            ///        the policy read by the job's controller.
+            /// @param [in] sample_key Shared memory key of the
+            ///        SampleRing published by the job's controller.
+            void add_job(const std::string &job_name,
+                         const std::string &agent_name,
+                         const std::string &policy_key,
+                         const std::string &sample_key);
+            /// @brief Begin tracking a job with the given endpoints.
+            void add_job(const std::string &job_name,
+                         std::unique_ptr<IManagerIO> policy,
+                         std::unique_ptr<ISampleRingReader> sample);
+            /// @brief Stop tracking a job and remove its row from
+            ///        the table.
+            void remove_job(const std::string &job_name);
+            /// @brief Names of the jobs in the order of the rows of
+            ///        the table.
+            std::vector<std::string> job_names(void) const;
+            /// @brief Stage a new policy for a job.
+            void adjust(const std::string &job_name, const std::vector<double> &policy);
+            /// @brief Write all policies staged since the last call.
+            /// @return Number of jobs whose policy was written.
+            int write_batch(void);
+            /// @brief Read the samples published by every job and
+            ///        update the table.
+            void update(void);
+            /// @brief Size in bytes of the shared memory table.
+            static size_t table_size(size_t num_field, size_t max_job);
+        private:
+            struct m_job_s {
+                std::string name;
+                std::unique_ptr<IManagerIO> policy;
+                std::unique_ptr<ISampleRingReader> sample;
+                std::vector<double> pending_policy;
+                bool is_policy_pending;
+                double timestamp;
+                std::vector<double> last_sample;
+                uint64_t num_sample;
+                uint64_t num_lost;
+            };
+            void write_table(void);
+
+            std::unique_ptr<ISharedMemory> m_shmem;
+            struct geopm_endpoint_table_s *m_table;
+            std::vector<std::string> m_field_names;
+            size_t m_max_job;
+            std::vector<m_job_s> m_job;
+            std::map<std::string, size_t> m_job_idx;
+            std::vector<double> m_timestamp_buffer;
+            std::vector<std::vector<double> > m_sample_buffer;
+    };
+
+    /// @brief Reads the table written by an EndpointAggregator.
+    class EndpointTableReader
+    {
+        public:
+            EndpointTableReader() = delete;
+            EndpointTableReader(const EndpointTableReader &other) = delete;
+            EndpointTableReader(const std::string &table_key);
+            EndpointTableReader(std::unique_ptr<ISharedMemoryUser> table);
+            virtual ~EndpointTableReader();
+            /// @brief Names of the sample fields of every row.
+            std::vector<std::string> field_names(void) const;
+            /// @brief Copy a consistent snapshot of the table.
+            /// @param [out] job_name Name of each job.
+            /// @param [out] timestamp Time of the latest sample of
+            ///        each job.
+            /// @param [out] sample Latest sample of each job.
+            /// @return False if the table was being written for the
+            ///         whole of a bounded number of attempts.
+            bool read(std::vector<std::string> &job_name,
+                      std::vector<double> &timestamp,
+                      std::vector<std::vector<double> > &sample);
+        private:
+            enum m_const_e {
+                M_MAX_RETRY = 4096,
+            };
+            std::unique_ptr<ISharedMemoryUser> m_shmem;
+            const struct geopm_endpoint_table_s *m_table;
+            size_t m_max_job;
+            size_t m_num_field;
+            std::vector<std::string> m_field_names;
+    };
+}
+
+#endif
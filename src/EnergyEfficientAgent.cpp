@@ -31,6 +31,7 @@
  */
 
 #include <sstream>
+#include <iomanip>
 #include <cmath>
 
 #include "geopm.h"
@@ -53,21 +54,45 @@ namespace geopm
     }
 
     EnergyEfficientAgent::EnergyEfficientAgent(IPlatformIO &plat_io, IPlatformTopo &topo)
+        : EnergyEfficientAgent(plat_io, topo, nullptr)
+    {
+
+    }
+
+    EnergyEfficientAgent::EnergyEfficientAgent(IPlatformIO &plat_io, IPlatformTopo &topo,
+                                               std::unique_ptr<IRegionFreqCache> freq_cache)
         : m_platform_io(plat_io)
         , m_platform_topo(topo)
         , m_freq_min(cpu_freq_min())
         , m_freq_max(cpu_freq_max())
         , M_FREQ_STEP(get_limit("CPUINFO::FREQ_STEP"))
         , M_SEND_PERIOD(10)
+        , M_WAIT_SEC(0.005)
         , m_last_freq(NAN)
         , m_curr_adapt_freq(NAN)
+        , m_freq_cache(std::move(freq_cache))
         , m_last_wait{{0, 0}}
+        , m_region_entry_time{{0, 0}}
     {
         parse_env_map();
         const char* env_freq_online_str = getenv("GEOPM_EFFICIENT_FREQ_ONLINE");
         if (env_freq_online_str) {
             m_is_online = true;
         }
+        if (getenv("GEOPM_EFFICIENT_FREQ_PER_CORE")) {
+            m_is_per_domain = true;
+        }
+        if (getenv("GEOPM_EFFICIENT_FREQ_PREDICT")) {
+            m_is_predict = true;
+        }
+        const char *env_freq_cache_str = getenv("GEOPM_EFFICIENT_FREQ_CACHE");
+        if (!m_freq_cache && m_is_online && env_freq_cache_str) {
+            uint64_t host_class = RegionFreqCache::host_class(get_limit("CPUINFO::FREQ_MIN"),
+                                                              get_limit("CPUINFO::FREQ_MAX"),
+                                                              M_FREQ_STEP,
+                                                              m_platform_topo.num_domain(IPlatformTopo::M_DOMAIN_CPU));
+            m_freq_cache = geopm::make_unique<RegionFreqCache>(env_freq_cache_str, host_class);
+        }
         init_platform_io();
     }
 
@@ -156,13 +181,15 @@ namespace geopm
 #endif
         bool result = false;
         if (m_num_ascend == 0) {
-            std::vector<double> child_sample(in_sample.size());
-            for (size_t sig_idx = 0; sig_idx < m_num_sample; ++sig_idx) {
+            m_child_sample.resize(m_num_sample);
+            parallel_for(0, m_num_sample, [this, &in_sample, &out_sample](size_t sig_idx) {
+                std::vector<double> &child_sample = m_child_sample[sig_idx];
+                child_sample.resize(in_sample.size());
                 for (size_t child_idx = 0; child_idx < in_sample.size(); ++child_idx) {
                     child_sample[child_idx] = in_sample[child_idx][sig_idx];
                 }
                 out_sample[sig_idx] = m_agg_func[sig_idx](child_sample);
-            }
+            });
             result = true;
         }
         ++m_num_ascend;
@@ -172,25 +199,23 @@ namespace geopm
         return result;
     }
 
-    bool EnergyEfficientAgent::adjust_platform(const std::vector<double> &in_policy)
+    double EnergyEfficientAgent::region_freq(uint64_t region_id, double adapt_freq) const
     {
-        update_freq_range(in_policy);
-        bool result = false;
-        double freq = m_last_freq;
-        auto it = m_rid_freq_map.find(geopm_region_id_hash(m_last_region_id));
+        double freq = NAN;
+        auto it = m_rid_freq_map.find(geopm_region_id_hash(region_id));
         if (it != m_rid_freq_map.end()) {
             freq = it->second;
         }
         else if (m_is_online) {
-            if (!std::isnan(m_curr_adapt_freq)) {
-                freq = m_curr_adapt_freq;
+            if (!std::isnan(adapt_freq)) {
+                freq = adapt_freq;
             }
             else {
                 freq = m_freq_max - M_FREQ_STEP;
             }
         }
         else {
-            switch(geopm_region_id_hint(m_last_region_id)) {
+            switch(geopm_region_id_hint(region_id)) {
                 // Hints for low CPU frequency
                 case GEOPM_REGION_HINT_MEMORY:
                 case GEOPM_REGION_HINT_NETWORK:
@@ -212,6 +237,19 @@ namespace geopm
                     break;
             }
         }
+        return freq;
+    }
+
+    bool EnergyEfficientAgent::adjust_platform(const std::vector<double> &in_policy)
+    {
+        update_freq_range(in_policy);
+        if (m_is_per_domain) {
+            return adjust_platform_domain();
+        }
+        bool result = false;
+        double adapt_freq = m_curr_adapt_freq;
+        uint64_t region_id = target_region(adapt_freq);
+        double freq = region_freq(region_id, adapt_freq);
 
         if (freq != m_last_freq) {
             /// freq initialized to m_last_freq but frequency bounds may have changed since
@@ -231,6 +269,59 @@ namespace geopm
         return result;
     }
 
+    uint64_t EnergyEfficientAgent::target_region(double &adapt_freq) const
+    {
+        uint64_t result = m_last_region_id;
+        if (m_is_predict) {
+            uint64_t curr_region_id = geopm_region_id_unset_hint(GEOPM_MASK_REGION_HINT, m_last_region_id);
+            geopm_time_s now;
+            geopm_time(&now);
+            uint64_t next_region_id = m_transition_graph.predict(curr_region_id,
+                                                                 geopm_time_diff(&m_region_entry_time, &now),
+                                                                 M_WAIT_SEC);
+            if (next_region_id != curr_region_id) {
+                auto hint_it = m_hint_region_id.find(next_region_id);
+                result = hint_it != m_hint_region_id.end() ? hint_it->second : next_region_id;
+                auto region_it = m_region_map.find(result);
+                adapt_freq = region_it != m_region_map.end() ? region_it->second->freq() : NAN;
+            }
+        }
+        return result;
+    }
+
+    bool EnergyEfficientAgent::adjust_platform_domain(void)
+    {
+        // Select the frequency of each domain in parallel; the
+        // adjustments are made serially and written together by the
+        // Kontroller's single write_batch().
+        std::vector<double> target(m_control_idx.size());
+        parallel_for(0, m_control_idx.size(), [this, &target](size_t dom_idx) {
+            uint64_t region_id = m_domain_region_id[dom_idx];
+            double adapt_freq = NAN;
+            auto region_it = m_region_map.find(region_id);
+            if (region_it != m_region_map.end()) {
+                adapt_freq = region_it->second->freq();
+            }
+            double freq = region_freq(region_id, adapt_freq);
+            if (m_freq_min > freq) {
+                freq = m_freq_min;
+            }
+            else if (m_freq_max < freq) {
+                freq = m_freq_max;
+            }
+            target[dom_idx] = freq;
+        });
+        bool result = false;
+        for (size_t dom_idx = 0; dom_idx != m_control_idx.size(); ++dom_idx) {
+            if (target[dom_idx] != m_domain_freq[dom_idx]) {
+                m_platform_io.adjust(m_control_idx[dom_idx], target[dom_idx]);
+                m_domain_freq[dom_idx] = target[dom_idx];
+                result = true;
+            }
+        }
+        return result;
+    }
+
     bool EnergyEfficientAgent::sample_platform(std::vector<double> &out_sample)
     {
 #ifdef GEOPM_DEBUG
@@ -243,43 +334,32 @@ namespace geopm
             out_sample[sample_idx] = m_platform_io.sample(m_sample_idx[sample_idx]);
         }
         const uint64_t current_region_id = geopm_signal_to_field(m_platform_io.sample(m_signal_idx[M_SIGNAL_REGION_ID]));
+        for (size_t dom_idx = 0; dom_idx < m_domain_region_idx.size(); ++dom_idx) {
+            m_domain_region_id[dom_idx] = geopm_signal_to_field(m_platform_io.sample(m_domain_region_idx[dom_idx]));
+        }
+        if (current_region_id != m_last_region_id) {
+            geopm_time(&m_region_entry_time);
+            m_hint_region_id[geopm_region_id_unset_hint(GEOPM_MASK_REGION_HINT, current_region_id)] = current_region_id;
+        }
         if (m_is_online) {
             if (current_region_id != GEOPM_REGION_ID_UNMARKED &&
                 current_region_id != GEOPM_REGION_ID_UNDEFINED) {
                 bool is_region_boundary = m_last_region_id != current_region_id;
                 if (is_region_boundary) {
                     // set the freq for the current region (entry)
-                    auto region_it = m_region_map.find(current_region_id);
-                    if (region_it == m_region_map.end()) {
-                        auto tmp = m_region_map.emplace(
-                            current_region_id,
-                            std::unique_ptr<EnergyEfficientRegion>(
-                                new EnergyEfficientRegion(m_platform_io, m_freq_min,
-                                    m_freq_max, M_FREQ_STEP,
-                                    m_signal_idx[M_SIGNAL_RUNTIME],
-                                    m_signal_idx[M_SIGNAL_PKG_ENERGY],
-                                    m_signal_idx[M_SIGNAL_DRAM_ENERGY])));
-                        region_it = tmp.first;
-                    }
-                    region_it->second->update_entry();
-
-                    m_curr_adapt_freq = region_it->second->freq();
+                    auto &curr_region = region(current_region_id);
+                    curr_region.update_entry();
+                    m_curr_adapt_freq = curr_region.freq();
                 }
                 if (m_last_region_id != 0 && is_region_boundary) {
                     // update previous region (exit)
-                    auto region_it = m_region_map.find(m_last_region_id);
-                    if (region_it == m_region_map.end()) {
-                        auto tmp = m_region_map.emplace(
-                            m_last_region_id,
-                            std::unique_ptr<EnergyEfficientRegion>(
-                                new EnergyEfficientRegion(m_platform_io, m_freq_min,
-                                    m_freq_max, M_FREQ_STEP,
-                                    m_signal_idx[M_SIGNAL_RUNTIME],
-                                    m_signal_idx[M_SIGNAL_PKG_ENERGY],
-                                    m_signal_idx[M_SIGNAL_DRAM_ENERGY])));
-                        region_it = tmp.first;
+                    auto &last_region = region(m_last_region_id);
+                    last_region.update_exit();
+                    if (m_freq_cache && !last_region.is_learning() &&
+                        m_cached_region.insert(m_last_region_id).second) {
+                        m_freq_cache->update(geopm_region_id_hash(m_last_region_id),
+                                             last_region.freq());
                     }
-                    region_it->second->update_exit();
                 }
             }
         }
@@ -287,9 +367,31 @@ namespace geopm
         return true;
     }
 
+    EnergyEfficientRegion &EnergyEfficientAgent::region(uint64_t region_id)
+    {
+        auto region_it = m_region_map.find(region_id);
+        if (region_it == m_region_map.end()) {
+            auto tmp = m_region_map.emplace(
+                region_id,
+                std::unique_ptr<EnergyEfficientRegion>(
+                    new EnergyEfficientRegion(m_platform_io, m_freq_min,
+                        m_freq_max, M_FREQ_STEP,
+                        m_signal_idx[M_SIGNAL_RUNTIME],
+                        m_signal_idx[M_SIGNAL_PKG_ENERGY],
+                        m_signal_idx[M_SIGNAL_DRAM_ENERGY])));
+            region_it = tmp.first;
+            if (m_freq_cache) {
+                double cached_freq = m_freq_cache->freq(geopm_region_id_hash(region_id));
+                if (!std::isnan(cached_freq)) {
+                    region_it->second->warm_start(cached_freq);
+                }
+            }
+        }
+        return *(region_it->second);
+    }
+
     void EnergyEfficientAgent::wait(void)
     {
-        static double M_WAIT_SEC = 0.005;
         geopm_time_s current_time;
         geopm_time(&current_time);
         while(geopm_time_diff(&m_last_wait, &current_time) < M_WAIT_SEC) {
@@ -332,10 +434,28 @@ namespace geopm
         for (const auto &region : m_region_map) {
             result[region.first] = {std::make_pair("REQUESTED_FREQUENCY", std::to_string(region.second->freq()))};
         }
+        for (auto region_id : m_transition_graph.region_ids()) {
+            uint64_t next_region_id = m_transition_graph.next_region(region_id);
+            if (next_region_id != GEOPM_REGION_ID_UNDEFINED) {
+                std::ostringstream next_region_str;
+                next_region_str << "0x" << std::hex << std::setfill('0') << std::setw(16) << next_region_id;
+                auto &region_report = result[region_id];
+                region_report.emplace_back("NEXT_REGION", next_region_str.str());
+                region_report.emplace_back("NEXT_REGION_PROBABILITY",
+                                           std::to_string(m_transition_graph.probability(region_id, next_region_id)));
+                region_report.emplace_back("MEAN_DURATION",
+                                           std::to_string(m_transition_graph.mean_duration(region_id)));
+            }
+        }
 
         return result;
     }
 
+    void EnergyEfficientAgent::update_region_info(const std::list<geopm_region_info_s> &region_info)
+    {
+        m_transition_graph.update(region_info);
+    }
+
     std::vector<std::string> EnergyEfficientAgent::trace_names(void) const
     {
         return {};
@@ -401,6 +521,14 @@ namespace geopm
         for (int ctl_dom_idx = 0; ctl_dom_idx != num_freq_ctl_domain; ++ctl_dom_idx) {
             m_control_idx.push_back(m_platform_io.push_control("FREQUENCY",
                                                                freq_ctl_domain_type, ctl_dom_idx));
+            if (m_is_per_domain) {
+                m_domain_region_idx.push_back(m_platform_io.push_signal("REGION_ID#",
+                                                                        freq_ctl_domain_type, ctl_dom_idx));
+            }
+        }
+        if (m_is_per_domain) {
+            m_domain_region_id.resize(num_freq_ctl_domain, GEOPM_REGION_ID_UNMARKED);
+            m_domain_freq.resize(num_freq_ctl_domain, NAN);
         }
         std::vector<std::string> signal_names = {"REGION_ID#", "REGION_RUNTIME",
                                                  "ENERGY_PACKAGE", "ENERGY_DRAM",};
@@ -35,6 +35,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <string>
 #include <memory>
 #include <functional>
@@ -43,6 +44,8 @@
 
 #include "Agent.hpp"
 #include "EnergyEfficientRegion.hpp"
+#include "RegionFreqCache.hpp"
+#include "RegionTransitionGraph.hpp"
 
 namespace geopm
 {
@@ -54,6 +57,12 @@ namespace geopm
         public:
             EnergyEfficientAgent();
             EnergyEfficientAgent(IPlatformIO &plat_io, IPlatformTopo &topo);
+            /// @brief Constructor with an injected region frequency
+            ///        cache.  If freq_cache is nullptr a cache is
+            ///        opened when GEOPM_EFFICIENT_FREQ_CACHE is set
+            ///        in online mode.
+            EnergyEfficientAgent(IPlatformIO &plat_io, IPlatformTopo &topo,
+                                 std::unique_ptr<IRegionFreqCache> freq_cache);
             virtual ~EnergyEfficientAgent() = default;
             void init(int level, const std::vector<int> &fan_in, bool is_level_root) override;
             bool descend(const std::vector<double> &in_policy,
@@ -68,6 +77,7 @@ namespace geopm
             std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > report_region(void) const override;
             std::vector<std::string> trace_names(void) const override;
             void trace_values(std::vector<double> &values) override;
+            void update_region_info(const std::list<geopm_region_info_s> &region_info) override;
 
             static std::string plugin_name(void);
             static std::unique_ptr<Agent> make_plugin(void);
@@ -75,6 +85,23 @@ namespace geopm
             static std::vector<std::string> sample_names(void);
         private:
             bool update_freq_range(const std::vector<double> &in_policy);
+            /// @brief Frequency selected for a region from the
+            ///        region map, the online mode or the region hint.
+            /// @param [in] region_id Region to select a frequency
+            ///        for.
+            /// @param [in] adapt_freq Frequency learned by the online
+            ///        mode for the region, or NAN if none.
+            double region_freq(uint64_t region_id, double adapt_freq) const;
+            bool adjust_platform_domain(void);
+            /// @brief Online learning state of a region, created on
+            ///        first use and warm started from the frequency
+            ///        cache when it holds the region.
+            EnergyEfficientRegion &region(uint64_t region_id);
+            /// @brief Region whose frequency should be applied now:
+            ///        the region running, or in prediction mode its
+            ///        likely successor when it is expected to begin
+            ///        before the next control step.
+            uint64_t target_region(double &adapt_freq) const;
             double cpu_freq_min(void) const;
             double cpu_freq_max(void) const;
             double get_limit(const std::string &sig_name) const;
@@ -101,6 +128,7 @@ namespace geopm
             double m_freq_max;
             const double M_FREQ_STEP;
             const size_t M_SEND_PERIOD;
+            const double M_WAIT_SEC;
             std::vector<int> m_control_idx;
             double m_last_freq;
             double m_curr_adapt_freq;
@@ -108,6 +136,11 @@ namespace geopm
             // for online adaptive mode
             bool m_is_online = false;
             std::map<uint64_t, std::unique_ptr<EnergyEfficientRegion> > m_region_map;
+            /// Frequencies learned by earlier jobs, or nullptr.
+            std::unique_ptr<IRegionFreqCache> m_freq_cache;
+            /// Regions whose frequency was stored in the cache by
+            /// this job, once learned or validated.
+            std::set<uint64_t> m_cached_region;
             geopm_time_s m_last_wait;
             std::vector<int> m_sample_idx;
             std::vector<int> m_signal_idx;
@@ -117,6 +150,29 @@ namespace geopm
             int m_num_children = 0;
             uint64_t m_last_region_id = 0;
             size_t m_num_ascend = 0;
+            /// Frequency is selected for each frequency control
+            /// domain from the region running on it rather than once
+            /// for the board.
+            bool m_is_per_domain = false;
+            /// Index of the REGION_ID# signal for each frequency
+            /// control domain in per domain mode.
+            std::vector<int> m_domain_region_idx;
+            std::vector<uint64_t> m_domain_region_id;
+            std::vector<double> m_domain_freq;
+            /// Transitions between regions learned from the region
+            /// entries and exits of the application.
+            RegionTransitionGraph m_transition_graph;
+            /// Frequency of the predicted next region is applied
+            /// ahead of its entry.
+            bool m_is_predict = false;
+            geopm_time_s m_region_entry_time;
+            /// Region ID including hint for each region ID without
+            /// hint, as the transition graph learns IDs without
+            /// hints.
+            std::map<uint64_t, uint64_t> m_hint_region_id;
+            /// Values of each signal from every child, one vector per
+            /// signal so that signals can be aggregated in parallel.
+            std::vector<std::vector<double> > m_child_sample;
     };
 }
 
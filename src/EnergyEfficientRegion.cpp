@@ -30,6 +30,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include <cmath>
+#include <algorithm>
 
 #include "EnergyEfficientRegion.hpp"
 #include "PlatformIO.hpp"
@@ -58,8 +59,7 @@ namespace geopm
     {
         /// @todo m_freq_step == freq_step else we have to re-key our map
         ///       or make m_freq_step const
-        const struct m_freq_ctx_s freq_ctx_stub = {.num_increase = 0,
-                                                   .perf_max = 0.0,
+        const struct m_freq_ctx_s freq_ctx_stub = {.perf_max = 0.0,
                                                    .energy_min = 0.0,
                                                    .num_sample = 0,};
         // set up allowed frequency range
@@ -69,25 +69,32 @@ namespace geopm
         double freq = 0.0;
         for (double step = 0; step < num_freq_step; ++step) {
             freq = freq_min + (step * m_freq_step);
-            m_allowed_freq.insert(freq);
+            m_allowed_freq.push_back(freq);
             m_freq_ctx_map.emplace(std::piecewise_construct,
                                    std::make_tuple(freq / m_freq_step),
                                    std::make_tuple(freq_ctx_stub));
         }
         m_curr_freq_max = freq;
+        // The bounds of the search are indices into the allowed
+        // frequencies, so restart it over the new range.  The new
+        // upper bound may not have been measured, and is then
+        // compared through the baseline energy.
+        m_search_good_idx = m_allowed_freq.size() - 1;
+        m_search_bad_idx = -1;
+        m_warm_idx = -1;
         if (isnan(m_curr_freq)) {
             m_is_learning = true;
             m_curr_freq = m_curr_freq_max;
-        } else if (m_curr_freq < *m_allowed_freq.begin()) {
-            m_curr_freq = *m_allowed_freq.begin();
-            if (m_freq_ctx_map[m_curr_freq / m_freq_step].num_increase == M_MAX_INCREASE) {
-                m_is_learning = false;
-            }
+        } else if (m_is_learning && m_target == 0.0) {
+            // The baseline is measured at the maximum frequency
+            m_curr_freq = m_curr_freq_max;
+        } else if (m_curr_freq < m_allowed_freq.front()) {
+            m_curr_freq = m_allowed_freq.front();
         } else if (m_curr_freq > m_curr_freq_max) {
             m_curr_freq = m_curr_freq_max;
-            if (m_freq_ctx_map[m_curr_freq / m_freq_step].num_increase == M_MAX_INCREASE) {
-                m_is_learning = false;
-            }
+        }
+        if (m_is_learning && m_target != 0.0) {
+            next_probe();
         }
     }
 
@@ -121,70 +128,116 @@ namespace geopm
 
     void EnergyEfficientRegion::update_exit()
     {
+        if (!m_is_learning) {
+            return;
+        }
         auto &curr_freq_ctx = m_freq_ctx_map[m_curr_freq / m_freq_step];
-        auto step_up_freq_ctx_it = m_freq_ctx_map.find((m_curr_freq + m_freq_step) / m_freq_step);
-        if (m_is_learning) {
-            double perf = perf_metric();
-            double energy = energy_metric() - m_start_energy;
-            if (!std::isnan(perf) && !std::isnan(energy)) {
-                if (curr_freq_ctx.num_sample == 0 ||
-                    curr_freq_ctx.perf_max < perf) {
-                    curr_freq_ctx.perf_max = perf;
-                }
-                if (curr_freq_ctx.num_sample == 0 ||
-                    curr_freq_ctx.energy_min > energy) {
-                    curr_freq_ctx.energy_min = energy;
-                }
-                ++curr_freq_ctx.num_sample;
+        double perf = perf_metric();
+        double energy = energy_metric() - m_start_energy;
+        if (!std::isnan(perf) && !std::isnan(energy)) {
+            if (curr_freq_ctx.num_sample == 0 ||
+                curr_freq_ctx.perf_max < perf) {
+                curr_freq_ctx.perf_max = perf;
             }
+            if (curr_freq_ctx.num_sample == 0 ||
+                curr_freq_ctx.energy_min > energy) {
+                curr_freq_ctx.energy_min = energy;
+            }
+            ++curr_freq_ctx.num_sample;
+        }
+        if (curr_freq_ctx.num_sample == 0) {
+            return;
+        }
 
-            if (curr_freq_ctx.num_sample > 0) {
-                if (curr_freq_ctx.num_sample >= M_MIN_BASE_SAMPLE &&
-                    m_target == 0.0 &&
-                    m_curr_freq == m_curr_freq_max) {
-
-                    if (curr_freq_ctx.perf_max > 0.0) {
-                        m_target = (1.0 - M_PERF_MARGIN) * curr_freq_ctx.perf_max;
-                    }
-                    else {
-                        m_target = (1.0 + M_PERF_MARGIN) * curr_freq_ctx.perf_max;
-                    }
-                }
-
-                bool do_increase = false;
-                // assume best min energy is at highest freq if energy follows cpu-bound
-                // pattern; otherwise, energy should decrease with frequency.
-                auto step_up_freq_ctx = step_up_freq_ctx_it->second;
-                if (m_curr_freq != m_curr_freq_max &&
-                    step_up_freq_ctx.energy_min < (1.0 - M_ENERGY_MARGIN) * curr_freq_ctx.energy_min) {
-                    do_increase = true;
+        if (m_target == 0.0) {
+            if (m_curr_freq != m_curr_freq_max) {
+                // Warm started: run at the cached frequency until it
+                // is measured, then measure the baseline
+                if (curr_freq_ctx.num_sample >= M_MIN_BASE_SAMPLE) {
+                    m_curr_freq = m_curr_freq_max;
                 }
-                else if (m_target != 0.0) {
-                    if (curr_freq_ctx.perf_max > m_target) {
-                        double next_freq = m_curr_freq - m_freq_step;
-                        if (m_allowed_freq.find(next_freq) != m_allowed_freq.end()) {
-                            // Performance is in range; lower frequency
-                            m_curr_freq = next_freq;
-                        }
-                    }
-                    else {
-                        double next_freq = m_curr_freq + m_freq_step;
-                        if (m_allowed_freq.find(next_freq) != m_allowed_freq.end()) {
-                            do_increase = true;
-                        }
-                    }
+                return;
+            }
+            if (curr_freq_ctx.num_sample >= M_MIN_BASE_SAMPLE) {
+                if (curr_freq_ctx.perf_max > 0.0) {
+                    m_target = (1.0 - M_PERF_MARGIN) * curr_freq_ctx.perf_max;
                 }
-                if (do_increase) {
-                    // Performance degraded too far; increase freq
-                    ++curr_freq_ctx.num_increase;
-                    // If the frequency has been lowered too far too
-                    // many times, stop learning
-                    if (curr_freq_ctx.num_increase == M_MAX_INCREASE) {
-                        m_is_learning = false;
-                    }
-                    m_curr_freq += m_freq_step;
+                else {
+                    m_target = (1.0 + M_PERF_MARGIN) * curr_freq_ctx.perf_max;
                 }
+                m_base_energy = curr_freq_ctx.energy_min;
+            }
+            if (m_target == 0.0) {
+                return;
+            }
+            if (m_warm_idx != -1) {
+                // Validate the cached frequency against the baseline
+                classify(m_warm_idx);
+                m_warm_idx = -1;
+            }
+        }
+        else {
+            // Classify the frequency just probed
+            auto probe_it = std::find(m_allowed_freq.begin() + m_search_bad_idx + 1,
+                                      m_allowed_freq.begin() + m_search_good_idx,
+                                      m_curr_freq);
+            classify(probe_it - m_allowed_freq.begin());
+        }
+        next_probe();
+    }
+
+    void EnergyEfficientRegion::classify(int freq_idx)
+    {
+        if (freq_idx <= m_search_bad_idx || freq_idx >= m_search_good_idx) {
+            return;
+        }
+        const auto &freq_ctx = m_freq_ctx_map[m_allowed_freq[freq_idx] / m_freq_step];
+        const auto &good_freq_ctx = m_freq_ctx_map[m_allowed_freq[m_search_good_idx] / m_freq_step];
+        double good_energy = good_freq_ctx.num_sample != 0 ?
+                             good_freq_ctx.energy_min : m_base_energy;
+        // assume best min energy is at highest freq if energy follows cpu-bound
+        // pattern; otherwise, energy should decrease with frequency.
+        bool is_energy_worse = good_energy < (1.0 - M_ENERGY_MARGIN) * freq_ctx.energy_min;
+        if (freq_ctx.perf_max > m_target && !is_energy_worse) {
+            m_search_good_idx = freq_idx;
+            if (freq_idx == m_warm_idx) {
+                // The cached frequency is still acceptable
+                m_search_bad_idx = freq_idx - 1;
             }
         }
+        else {
+            m_search_bad_idx = freq_idx;
+        }
+    }
+
+    void EnergyEfficientRegion::next_probe(void)
+    {
+        if (m_search_good_idx - m_search_bad_idx > 1) {
+            m_curr_freq = m_allowed_freq[m_search_bad_idx + (m_search_good_idx - m_search_bad_idx) / 2];
+        }
+        else {
+            m_curr_freq = m_allowed_freq[m_search_good_idx];
+            m_is_learning = false;
+        }
+    }
+
+    void EnergyEfficientRegion::warm_start(double freq)
+    {
+        if (std::isnan(freq)) {
+            return;
+        }
+        auto it = std::lower_bound(m_allowed_freq.begin(), m_allowed_freq.end(), freq);
+        if (it == m_allowed_freq.end()) {
+            --it;
+        }
+        m_curr_freq = *it;
+        if (m_is_learning && m_target == 0.0) {
+            m_warm_idx = it - m_allowed_freq.begin();
+        }
+    }
+
+    bool EnergyEfficientRegion::is_learning(void) const
+    {
+        return m_is_learning;
     }
 }
@@ -34,7 +34,6 @@
 #define ENERGYEFFICIENTREGION_HPP_INCLUDE
 
 #include <map>
-#include <set>
 #include <vector>
 
 #include "geopm_time.h"
@@ -44,7 +43,15 @@ namespace geopm
 
     class IPlatformIO;
 
-    /// @brief Holds the performance history of a Region.
+    /// @brief Holds the performance history of a Region and
+    ///        searches for its most energy efficient frequency.
+    ///
+    /// After a baseline is measured at the maximum frequency the
+    /// search bisects the allowed frequencies: each probe that keeps
+    /// performance within the margin of the baseline without using
+    /// more energy becomes the new upper bound, otherwise it becomes
+    /// the new lower bound.  The search converges in a number of
+    /// probes logarithmic in the number of allowed frequencies.
     class EnergyEfficientRegion
     {
         public:
@@ -58,14 +65,35 @@ namespace geopm
             void update_freq_range(const double freq_min, const double freq_max, const double freq_step);
             void update_entry(void);
             void update_exit(void);
+            /// @brief Start from a frequency learned by a previous
+            ///        run instead of searching.  The frequency is
+            ///        clamped to the allowed range.  The region runs
+            ///        at that frequency until it is measured, and
+            ///        then measures the baseline at the maximum
+            ///        frequency.  If the cached frequency still meets
+            ///        the performance and energy margins the search
+            ///        ends there; otherwise it continues above it.
+            /// @param [in] freq Previously learned frequency.
+            void warm_start(double freq);
+            /// @brief Returns true until the search has converged,
+            ///        including while a warm started frequency is
+            ///        validated.
+            bool is_learning(void) const;
         private:
             // Used to determine whether performance degraded or not.
             // Higher is better.
             virtual double perf_metric();
             virtual double energy_metric();
+            /// @brief Move to the next probe of the search, or to the
+            ///        lowest acceptable frequency once converged.
+            void next_probe(void);
+            /// @brief Move one bound of the search to a measured
+            ///        frequency.
+            /// @param [in] freq_idx Index into m_allowed_freq of the
+            ///        frequency.
+            void classify(int freq_idx);
 
             IPlatformIO &m_platform_io;
-            size_t m_curr_idx;
             double m_curr_freq = NAN;
             double m_target = 0.0;
             const double M_PERF_MARGIN = 0.10;  // up to 10% degradation allowed
@@ -74,19 +102,30 @@ namespace geopm
 
             bool m_is_learning;
             struct m_freq_ctx_s {
-                size_t num_increase;
                 double perf_max;
                 double energy_min;
                 size_t num_sample;
             };
 
             std::map<size_t, struct m_freq_ctx_s> m_freq_ctx_map;
-            const size_t M_MAX_INCREASE = 4;
 
             double m_freq_step;
-            std::set<double> m_allowed_freq;
+            /// Allowed frequencies in increasing order.
+            std::vector<double> m_allowed_freq;
             double m_curr_freq_max;
             double m_start_energy = 0.0;
+            /// Index into m_allowed_freq of the lowest frequency
+            /// known to be acceptable.
+            int m_search_good_idx;
+            /// Index into m_allowed_freq of the highest frequency
+            /// known to be unacceptable, or -1 if none.
+            int m_search_bad_idx;
+            /// Energy measured for the baseline at the maximum
+            /// frequency.
+            double m_base_energy = 0.0;
+            /// Index into m_allowed_freq of the warm started
+            /// frequency while it is validated, or -1.
+            int m_warm_idx = -1;
 
             int m_runtime_idx;
             int m_pkg_energy_idx;
@@ -64,6 +64,13 @@ namespace geopm
             const char *policy(void) const;
             const char *shmkey(void) const;
             const char *trace(void) const;
+            const char *trace_rollup(void) const;
+            const char *trace_codec(void) const;
+            const char *sample_ring(void) const;
+            const char *topo_cache(void) const;
+            const char *record(void) const;
+            const char *sim(void) const;
+            const char *perf_event_pid(void) const;
             const char *plugin_path(void) const;
             const char *profile(void) const;
             const char *agent(void) const;
@@ -73,28 +80,48 @@ namespace geopm
             int pmpi_ctl(void) const;
             int do_region_barrier(void) const;
             int do_trace(void) const;
+            int do_trace_rollup(void) const;
+            int trace_rollup_period(void) const;
+            int do_trace_adaptive(void) const;
+            double trace_adaptive(void) const;
+            int trace_adaptive_burst(void) const;
             int do_profile() const;
             int profile_timeout(void) const;
             int debug_attach(void) const;
+            int agent_threads(void) const;
             int do_kontroller(void) const;
         private:
             bool get_env(const char *name, std::string &env_string) const;
             bool get_env(const char *name, int &value) const;
+            bool get_env(const char *name, double &value) const;
             std::string m_report;
             std::string m_comm;
             std::string m_policy;
             std::string m_agent;
             std::string m_shmkey;
             std::string m_trace;
+            std::string m_trace_rollup;
+            std::string m_trace_codec;
+            std::string m_sample_ring;
+            std::string m_topo_cache;
+            std::string m_record;
+            std::string m_sim;
+            std::string m_perf_event_pid;
             std::string m_plugin_path;
             std::string m_profile;
             int m_report_verbosity;
             int m_pmpi_ctl;
             bool m_do_region_barrier;
             bool m_do_trace;
+            bool m_do_trace_rollup;
+            int m_trace_rollup_period;
+            bool m_do_trace_adaptive;
+            double m_trace_adaptive;
+            int m_trace_adaptive_burst;
             bool m_do_profile;
             int m_profile_timeout;
             int m_debug_attach;
+            int m_agent_threads;
             bool m_do_kontroller;
             std::vector<std::string> m_trace_signal;
     };
@@ -123,15 +150,28 @@ namespace geopm
         m_agent = "monitor";
         m_shmkey = "/geopm-shm-" + std::to_string(geteuid());
         m_trace = "";
+        m_trace_rollup = "";
+        m_trace_codec = "";
+        m_sample_ring = "";
+        m_topo_cache = "";
+        m_record = "";
+        m_sim = "";
+        m_perf_event_pid = "";
         m_plugin_path = "";
         m_profile = "";
         m_report_verbosity = 0;
         m_pmpi_ctl = GEOPM_PMPI_CTL_NONE;
         m_do_region_barrier = false;
         m_do_trace = false;
+        m_do_trace_rollup = false;
+        m_trace_rollup_period = 1000;
+        m_do_trace_adaptive = false;
+        m_trace_adaptive = 0.0;
+        m_trace_adaptive_burst = 10;
         m_do_profile = false;
         m_profile_timeout = 30;
         m_debug_attach = -1;
+        m_agent_threads = 1;
         m_do_kontroller = false;
         m_trace_signal.clear();
 
@@ -146,6 +186,19 @@ namespace geopm
             m_shmkey = "/" + m_shmkey;
         }
         m_do_trace = get_env("GEOPM_TRACE", m_trace);
+        m_do_trace_rollup = get_env("GEOPM_TRACE_ROLLUP", m_trace_rollup);
+        (void)get_env("GEOPM_TRACE_ROLLUP_PERIOD", m_trace_rollup_period);
+        m_do_trace_adaptive = get_env("GEOPM_TRACE_ADAPTIVE", m_trace_adaptive);
+        (void)get_env("GEOPM_TRACE_ADAPTIVE_BURST", m_trace_adaptive_burst);
+        (void)get_env("GEOPM_TRACE_CODEC", m_trace_codec);
+        if (get_env("GEOPM_SAMPLE_RING", m_sample_ring) &&
+            m_sample_ring.size() && m_sample_ring[0] != '/') {
+            m_sample_ring = "/" + m_sample_ring;
+        }
+        (void)get_env("GEOPM_TOPO_CACHE", m_topo_cache);
+        (void)get_env("GEOPM_RECORD", m_record);
+        (void)get_env("GEOPM_SIM", m_sim);
+        (void)get_env("GEOPM_PERF_EVENT_PID", m_perf_event_pid);
         (void)get_env("GEOPM_PLUGIN_PATH", m_plugin_path);
         if (!get_env("GEOPM_REPORT_VERBOSITY", m_report_verbosity) && m_report.size()) {
             m_report_verbosity = 1;
@@ -161,9 +214,14 @@ namespace geopm
             }
         }
         get_env("GEOPM_DEBUG_ATTACH", m_debug_attach);
+        (void)get_env("GEOPM_AGENT_THREADS", m_agent_threads);
+        if (m_agent_threads < 1) {
+            m_agent_threads = 1;
+        }
         m_do_profile = get_env("GEOPM_PROFILE", m_profile);
         if (m_report.length() ||
             m_do_trace ||
+            m_do_trace_rollup ||
             m_pmpi_ctl != GEOPM_PMPI_CTL_NONE) {
             m_do_profile = true;
         }
@@ -222,6 +280,23 @@ namespace geopm
         return result;
     }
 
+    bool Environment::get_env(const char *name, double &value) const
+    {
+        bool result = false;
+        std::string tmp_str("");
+        char *end_ptr = NULL;
+
+        if (get_env(name, tmp_str)) {
+            value = strtod(tmp_str.c_str(), &end_ptr);
+            if (tmp_str.c_str() == end_ptr) {
+                throw Exception("Environment::Environment(): Value could not be converted to a double",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            result = true;
+        }
+        return result;
+    }
+
     const char *Environment::report(void) const
     {
         return m_report.c_str();
@@ -257,6 +332,41 @@ namespace geopm
         return m_profile.c_str();
     }
 
+    const char *Environment::trace_rollup(void) const
+    {
+        return m_trace_rollup.c_str();
+    }
+
+    const char *Environment::trace_codec(void) const
+    {
+        return m_trace_codec.c_str();
+    }
+
+    const char *Environment::sample_ring(void) const
+    {
+        return m_sample_ring.c_str();
+    }
+
+    const char *Environment::topo_cache(void) const
+    {
+        return m_topo_cache.c_str();
+    }
+
+    const char *Environment::record(void) const
+    {
+        return m_record.c_str();
+    }
+
+    const char *Environment::sim(void) const
+    {
+        return m_sim.c_str();
+    }
+
+    const char *Environment::perf_event_pid(void) const
+    {
+        return m_perf_event_pid.c_str();
+    }
+
     const char *Environment::plugin_path(void) const
     {
         return m_plugin_path.c_str();
@@ -297,6 +407,31 @@ namespace geopm
         return m_do_trace;
     }
 
+    int Environment::do_trace_rollup(void) const
+    {
+        return m_do_trace_rollup;
+    }
+
+    int Environment::trace_rollup_period(void) const
+    {
+        return m_trace_rollup_period;
+    }
+
+    int Environment::do_trace_adaptive(void) const
+    {
+        return m_do_trace_adaptive;
+    }
+
+    double Environment::trace_adaptive(void) const
+    {
+        return m_trace_adaptive;
+    }
+
+    int Environment::trace_adaptive_burst(void) const
+    {
+        return m_trace_adaptive_burst;
+    }
+
     int Environment::do_profile(void) const
     {
         return m_do_profile;
@@ -312,6 +447,11 @@ namespace geopm
         return m_debug_attach;
     }
 
+    int Environment::agent_threads(void) const
+    {
+        return m_agent_threads;
+    }
+
     int Environment::do_kontroller(void) const
     {
         return m_do_kontroller;
@@ -345,6 +485,41 @@ extern "C"
         return geopm::environment().trace();
     }
 
+    const char *geopm_env_trace_rollup(void)
+    {
+        return geopm::environment().trace_rollup();
+    }
+
+    const char *geopm_env_trace_codec(void)
+    {
+        return geopm::environment().trace_codec();
+    }
+
+    const char *geopm_env_sample_ring(void)
+    {
+        return geopm::environment().sample_ring();
+    }
+
+    const char *geopm_env_topo_cache(void)
+    {
+        return geopm::environment().topo_cache();
+    }
+
+    const char *geopm_env_record(void)
+    {
+        return geopm::environment().record();
+    }
+
+    const char *geopm_env_sim(void)
+    {
+        return geopm::environment().sim();
+    }
+
+    const char *geopm_env_perf_event_pid(void)
+    {
+        return geopm::environment().perf_event_pid();
+    }
+
     const char *geopm_env_plugin_path(void)
     {
         return geopm::environment().plugin_path();
@@ -394,6 +569,31 @@ extern "C"
         return geopm::environment().do_trace();
     }
 
+    int geopm_env_do_trace_rollup(void)
+    {
+        return geopm::environment().do_trace_rollup();
+    }
+
+    int geopm_env_trace_rollup_period(void)
+    {
+        return geopm::environment().trace_rollup_period();
+    }
+
+    int geopm_env_do_trace_adaptive(void)
+    {
+        return geopm::environment().do_trace_adaptive();
+    }
+
+    double geopm_env_trace_adaptive(void)
+    {
+        return geopm::environment().trace_adaptive();
+    }
+
+    int geopm_env_trace_adaptive_burst(void)
+    {
+        return geopm::environment().trace_adaptive_burst();
+    }
+
     int geopm_env_do_profile(void)
     {
         return geopm::environment().do_profile();
@@ -409,6 +609,11 @@ extern "C"
         return geopm::environment().debug_attach();
     }
 
+    int geopm_env_agent_threads(void)
+    {
+        return geopm::environment().agent_threads();
+    }
+
     int geopm_env_do_kontroller(void)
     {
         return geopm::environment().do_kontroller();
@@ -31,6 +31,7 @@
  */
 
 #include <algorithm>
+#include <numeric>
 
 #include "geopm.h"
 #include "geopm_message.h"
@@ -92,16 +93,18 @@ namespace geopm
     /// @todo temporarily repeated here and in ApplicationIO, until these classes are combined.
     double EpochRuntimeRegulator::current_energy(void) const
     {
-        double energy = 0.0;
+        std::vector<IPlatformIO::m_request_s> request;
         int num_package = m_platform_topo.num_domain(IPlatformTopo::M_DOMAIN_PACKAGE);
         for (int pkg = 0; pkg < num_package; ++pkg) {
-            energy += m_platform_io.read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+            request.push_back({"ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, pkg});
         }
         int num_dram = m_platform_topo.num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY);
         for (int dram = 0; dram < num_dram; ++dram) {
-            energy += m_platform_io.read_signal("ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 0);
+            request.push_back({"ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, dram});
         }
-        return energy;
+        std::vector<double> value;
+        m_platform_io.read_signal_batch(request, value);
+        return std::accumulate(value.begin(), value.end(), 0.0);
     }
 
     void EpochRuntimeRegulator::epoch(int rank, struct geopm_time_s epoch_time)
@@ -33,7 +33,12 @@
 #include "IOGroup.hpp"
 #include "MSRIOGroup.hpp"
 #include "CpuinfoIOGroup.hpp"
+#include "CpufreqIOGroup.hpp"
 #include "TimeIOGroup.hpp"
+#include "PerfEventIOGroup.hpp"
+#include "PowercapIOGroup.hpp"
+#include "SimPlatformIOGroup.hpp"
+#include "Exception.hpp"
 #include "config.h"
 
 namespace geopm
@@ -48,6 +53,40 @@ namespace geopm
                                           TimeIOGroup::make_plugin);
         g_plugin_factory->register_plugin(CpuinfoIOGroup::plugin_name(),
                                           CpuinfoIOGroup::make_plugin);
+        g_plugin_factory->register_plugin(CpufreqIOGroup::plugin_name(),
+                                          CpufreqIOGroup::make_plugin);
+        g_plugin_factory->register_plugin(PerfEventIOGroup::plugin_name(),
+                                          PerfEventIOGroup::make_plugin);
+        g_plugin_factory->register_plugin(PowercapIOGroup::plugin_name(),
+                                          PowercapIOGroup::make_plugin);
+        g_plugin_factory->register_plugin(SimPlatformIOGroup::plugin_name(),
+                                          SimPlatformIOGroup::make_plugin);
+    }
+
+    void IOGroup::read_signal_batch(const std::vector<IPlatformIO::m_request_s> &request,
+                                    std::vector<double> &result)
+    {
+        result.resize(request.size());
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            result[req_idx] = read_signal(request[req_idx].name,
+                                          request[req_idx].domain_type,
+                                          request[req_idx].domain_idx);
+        }
+    }
+
+    void IOGroup::write_control_batch(const std::vector<IPlatformIO::m_request_s> &request,
+                                      const std::vector<double> &setting)
+    {
+        if (request.size() != setting.size()) {
+            throw Exception("IOGroup::write_control_batch(): number of settings does not match number of requests",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            write_control(request[req_idx].name,
+                          request[req_idx].domain_type,
+                          request[req_idx].domain_idx,
+                          setting[req_idx]);
+        }
     }
 
     PluginFactory<IOGroup> &iogroup_factory(void)
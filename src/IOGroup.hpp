@@ -38,6 +38,7 @@
 #include <set>
 
 #include "PluginFactory.hpp"
+#include "PlatformIO.hpp"
 
 namespace geopm
 {
@@ -152,6 +153,25 @@ namespace geopm
                                        int domain_type,
                                        int domain_idx,
                                        double setting) = 0;
+            /// @brief Read several signals in one call.  The default
+            ///        implementation calls read_signal() once for
+            ///        each request; IOGroups that can combine the
+            ///        hardware accesses should override it.
+            /// @param [in] request Signal name, domain type and
+            ///        domain index for each signal to be read.
+            /// @param [out] result Value in SI units of each signal
+            ///        in the same order as the requests.
+            virtual void read_signal_batch(const std::vector<IPlatformIO::m_request_s> &request,
+                                           std::vector<double> &result);
+            /// @brief Write several controls in one call.  The
+            ///        default implementation calls write_control()
+            ///        once for each request.
+            /// @param [in] request Control name, domain type and
+            ///        domain index for each control to be written.
+            /// @param [in] setting Value in SI units for each
+            ///        control in the same order as the requests.
+            virtual void write_control_batch(const std::vector<IPlatformIO::m_request_s> &request,
+                                             const std::vector<double> &setting);
             /// @brief Save the state of all controls so that any
             ///        subsequent changes made through the IOGroup
             ///        can be undone with a call to the restore()
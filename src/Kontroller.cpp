@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <string.h>
 
 #include "geopm_env.h"
 #include "geopm_signal_handler.h"
@@ -41,6 +42,7 @@
 #include "ApplicationIO.hpp"
 #include "Reporter.hpp"
 #include "Tracer.hpp"
+#include "TraceRollup.hpp"
 #include "Exception.hpp"
 #include "Comm.hpp"
 #include "PlatformTopo.hpp"
@@ -48,6 +50,12 @@
 #include "Agent.hpp"
 #include "TreeComm.hpp"
 #include "ManagerIO.hpp"
+#include "SampleRing.hpp"
+#include "MatrixView.hpp"
+#include "KontrollerTimer.hpp"
+#include "KontrollerIOGroup.hpp"
+#include "ThreadPool.hpp"
+#include "Helper.hpp"
 #include "config.h"
 
 extern "C"
@@ -81,10 +89,16 @@ namespace geopm
                      std::shared_ptr<IApplicationIO>(new ApplicationIO(geopm_env_shmkey())),
                      std::unique_ptr<IReporter>(new Reporter(geopm_env_report(), platform_io(), ppn1_comm->rank())),
                      std::unique_ptr<ITracer>(new Tracer()),
+                     std::unique_ptr<ITraceRollup>(new TraceRollup(ppn1_comm)),
                      std::vector<std::unique_ptr<Agent> >{},
-                     std::unique_ptr<IManagerIOSampler>(new ManagerIOSampler(global_policy_path, true)))
+                     std::unique_ptr<IManagerIOSampler>(new ManagerIOSampler(global_policy_path, true)),
+                     nullptr)
     {
-
+        if (m_is_root && strlen(geopm_env_sample_ring())) {
+            m_manager_io = geopm::make_unique<SampleRing>(geopm_env_sample_ring(),
+                                                          Agent::sample_names(agent_factory().dictionary(m_agent_name)),
+                                                          (size_t)SampleRing::M_DEFAULT_CAPACITY);
+        }
     }
 
     Kontroller::Kontroller(std::shared_ptr<Comm> comm,
@@ -96,8 +110,10 @@ namespace geopm
                            std::shared_ptr<IApplicationIO> application_io,
                            std::unique_ptr<IReporter> reporter,
                            std::unique_ptr<ITracer> tracer,
+                           std::unique_ptr<ITraceRollup> trace_rollup,
                            std::vector<std::unique_ptr<Agent> > level_agent,
-                           std::unique_ptr<IManagerIOSampler> manager_io_sampler)
+                           std::unique_ptr<IManagerIOSampler> manager_io_sampler,
+                           std::unique_ptr<IManagerIO> manager_io)
         : m_comm(comm)
         , m_platform_io(plat_io)
         , m_agent_name(agent_name)
@@ -110,24 +126,29 @@ namespace geopm
         , m_application_io(std::move(application_io))
         , m_reporter(std::move(reporter))
         , m_tracer(std::move(tracer))
+        , m_trace_rollup(std::move(trace_rollup))
         , m_agent(std::move(level_agent))
         , m_is_root(m_num_level_ctl == m_root_level)
         , m_in_policy(m_num_send_down)
+        , m_is_root_policy_valid(false)
+        , m_num_child(m_num_level_ctl)
         , m_out_policy(m_num_level_ctl)
         , m_in_sample(m_num_level_ctl)
         , m_out_sample(m_num_send_up)
         , m_manager_io_sampler(std::move(manager_io_sampler))
+        , m_manager_io(std::move(manager_io))
+        , m_timer(std::make_shared<KontrollerTimer>())
+        , m_thread_pool(std::make_shared<ThreadPool>(geopm_env_agent_threads()))
     {
-        // Three dimensional vector over levels, children, and message
-        // index.  These are used as temporary storage when passing
-        // messages up and down the tree.
+        // For each level a child by message index matrix stored
+        // contiguously.  These are allocated once and used as
+        // storage when passing messages up and down the tree.
         for (int level = 0; level != m_num_level_ctl; ++level) {
-            int num_children = m_tree_comm->level_size(level);
-            m_out_policy[level] = std::vector<std::vector<double> >(num_children,
-                                                                    std::vector<double>(m_num_send_down));
-            m_in_sample[level] = std::vector<std::vector<double> >(num_children,
-                                                                   std::vector<double>(m_num_send_up));
+            m_num_child[level] = m_tree_comm->level_size(level);
+            m_out_policy[level].resize(m_num_child[level] * m_num_send_down);
+            m_in_sample[level].resize(m_num_child[level] * m_num_send_up);
         }
+        m_platform_io.register_iogroup(std::make_shared<KontrollerIOGroup>(m_timer));
     }
 
     Kontroller::~Kontroller()
@@ -147,12 +168,19 @@ namespace geopm
         }
         if (m_agent.size() == 0) {
             m_agent.push_back(agent_factory().make_plugin(m_agent_name));
+            m_agent.back()->thread_pool(m_thread_pool);
             m_agent.back()->init(0, fan_in, (0 < m_tree_comm->num_level_controlled()));
             for (level = 1; level < m_max_level; ++level) {
                 m_agent.push_back(agent_factory().make_plugin(m_agent_name));
+                m_agent.back()->thread_pool(m_thread_pool);
                 m_agent.back()->init(level, fan_in, (level < m_tree_comm->num_level_controlled()));
             }
         }
+        else {
+            for (auto &agent : m_agent) {
+                agent->thread_pool(m_thread_pool);
+            }
+        }
 
         /// @todo move somewhere else: need to happen after Agents are constructed
         // sanity checks
@@ -225,75 +253,125 @@ namespace geopm
                              m_comm,
                              *m_tree_comm);
         m_tracer->flush();
+        m_trace_rollup->flush();
     }
 
     void Kontroller::step(void)
     {
+        struct geopm_time_s time;
+        m_timer->begin_step(time);
         walk_down();
         geopm_signal_handler_check();
 
         walk_up();
         geopm_signal_handler_check();
+        geopm_time(&time);
         m_agent[0]->wait();
+        m_timer->lap(KontrollerTimer::M_PHASE_AGENT_WAIT, time);
+        m_timer->end_step();
         geopm_signal_handler_check();
     }
 
     void Kontroller::walk_down(void)
     {
+        struct geopm_time_s time;
+        geopm_time(&time);
         bool do_send = false;
         if (m_is_root) {
-            /// @todo Pass m_in_policy by reference into the sampler, and return an is_updated bool.
-            m_in_policy = m_manager_io_sampler->sample();
+            // The sampler reads the policy when it is constructed;
+            // after that it is re-read only when the resource
+            // manager has changed it.
+            if (!m_is_root_policy_valid) {
+                m_root_policy = m_manager_io_sampler->sample();
+                m_is_root_policy_valid = true;
+            }
+            else if (m_manager_io_sampler->is_update_available()) {
+                m_manager_io_sampler->read_batch();
+                m_root_policy = m_manager_io_sampler->sample();
+            }
+            m_in_policy = m_root_policy;
             do_send = true;
+            m_timer->lap(KontrollerTimer::M_PHASE_MANAGER_IO, time);
         }
         else {
             do_send = m_tree_comm->receive_down(m_num_level_ctl, m_in_policy);
+            m_timer->lap(KontrollerTimer::M_PHASE_TREE_RECEIVE, time);
         }
         for (int level = m_num_level_ctl - 1; level != -1; --level) {
+            MatrixView<double> out_policy(m_out_policy[level].data(),
+                                          m_num_child[level], m_num_send_down);
             if (do_send) {
-                do_send = m_agent[level]->descend(m_in_policy, m_out_policy[level]);
+                do_send = m_agent[level]->descend_view(m_in_policy, out_policy);
+                m_timer->lap(KontrollerTimer::M_PHASE_AGENT_DESCEND, time);
             }
             if (do_send) {
-                m_tree_comm->send_down(level, m_out_policy[level]);
+                m_tree_comm->send_down_view(level, out_policy);
+                m_timer->lap(KontrollerTimer::M_PHASE_TREE_SEND, time);
             }
             do_send = m_tree_comm->receive_down(level, m_in_policy);
+            m_timer->lap(KontrollerTimer::M_PHASE_TREE_RECEIVE, time);
         }
-        if (std::none_of(m_in_policy.begin(), m_in_policy.end(),
-                         [](double val){return std::isnan(val);}) &&
-            m_agent[0]->adjust_platform(m_in_policy)) {
+        bool do_write = std::none_of(m_in_policy.begin(), m_in_policy.end(),
+                                     [](double val){return std::isnan(val);}) &&
+                        m_agent[0]->adjust_platform(m_in_policy);
+        m_timer->lap(KontrollerTimer::M_PHASE_AGENT_ADJUST, time);
+        if (do_write) {
             m_platform_io.write_batch();
+            m_timer->lap(KontrollerTimer::M_PHASE_WRITE_BATCH, time);
         }
     }
 
     void Kontroller::walk_up(void)
     {
+        struct geopm_time_s time;
+        geopm_time(&time);
         m_application_io->update(m_comm);
+        m_timer->lap(KontrollerTimer::M_PHASE_APPLICATION_IO, time);
         m_platform_io.read_batch();
+        m_timer->lap(KontrollerTimer::M_PHASE_READ_BATCH, time);
+        std::list<geopm_region_info_s> region_info = m_application_io->region_info();
+        m_agent[0]->update_region_info(region_info);
         bool do_send = m_agent[0]->sample_platform(m_out_sample);
         m_agent[0]->trace_values(m_trace_sample);
-        m_tracer->update(m_trace_sample, m_application_io->region_info());
+        m_timer->lap(KontrollerTimer::M_PHASE_AGENT_SAMPLE, time);
+        m_tracer->update(m_trace_sample, region_info);
+        m_trace_rollup->update(m_trace_sample);
+        m_timer->lap(KontrollerTimer::M_PHASE_TRACER, time);
         m_application_io->clear_region_info();
+        m_timer->lap(KontrollerTimer::M_PHASE_APPLICATION_IO, time);
 
         for (int level = 0; level != m_num_level_ctl; ++level) {
             if (do_send) {
                 m_tree_comm->send_up(level, m_out_sample);
+                m_timer->lap(KontrollerTimer::M_PHASE_TREE_SEND, time);
             }
-            do_send = m_tree_comm->receive_up(level, m_in_sample[level]);
+            MatrixView<double> in_sample(m_in_sample[level].data(),
+                                         m_num_child[level], m_num_send_up);
+            do_send = m_tree_comm->receive_up_view(level, in_sample);
+            m_timer->lap(KontrollerTimer::M_PHASE_TREE_RECEIVE, time);
             if (do_send) {
-                do_send = m_agent[level]->ascend(m_in_sample[level], m_out_sample);
+                do_send = m_agent[level]->ascend_view(in_sample, m_out_sample);
+                m_timer->lap(KontrollerTimer::M_PHASE_AGENT_ASCEND, time);
             }
         }
         if (do_send) {
             if (!m_is_root) {
                 m_tree_comm->send_up(m_num_level_ctl, m_out_sample);
+                m_timer->lap(KontrollerTimer::M_PHASE_TREE_SEND, time);
             }
-            else {
-                /// @todo At the root of the tree, send signals up to the
-                /// resource manager.
+            else if (m_manager_io) {
+                m_manager_io->adjust(m_out_sample);
+                m_manager_io->write_batch();
+                m_timer->lap(KontrollerTimer::M_PHASE_MANAGER_IO, time);
             }
         }
     }
 
+    std::shared_ptr<const KontrollerTimer> Kontroller::timer(void) const
+    {
+        return m_timer;
+    }
+
     void Kontroller::pthread(const pthread_attr_t *attr, pthread_t *thread)
     {
         int err = pthread_create(thread, attr, geopm_threaded_run, (void *)this);
@@ -307,6 +385,7 @@ namespace geopm
     {
         auto agent_cols = m_agent[0]->trace_names();
         m_tracer->columns(agent_cols);
+        m_trace_rollup->columns(agent_cols);
         m_trace_sample.resize(agent_cols.size());
     }
 
@@ -51,8 +51,11 @@ namespace geopm
     class IApplicationIO;
     class IReporter;
     class ITracer;
+    class ITraceRollup;
     class ITreeComm;
     class Agent;
+    class KontrollerTimer;
+    class ThreadPool;
 
     class Kontroller
     {
@@ -76,8 +79,10 @@ namespace geopm
                        std::shared_ptr<IApplicationIO> application_io,
                        std::unique_ptr<IReporter> reporter,
                        std::unique_ptr<ITracer> tracer,
+                       std::unique_ptr<ITraceRollup> trace_rollup,
                        std::vector<std::unique_ptr<Agent> > level_agent,
-                       std::unique_ptr<IManagerIOSampler> manager_io_sampler);
+                       std::unique_ptr<IManagerIOSampler> manager_io_sampler,
+                       std::unique_ptr<IManagerIO> manager_io);
             virtual ~Kontroller();
             /// @brief Run control algorithm.
             ///
@@ -131,6 +136,9 @@ namespace geopm
             /// @brief Called upon failure to facilitate graceful destruction
             ///        of the Kontroller and notify application.
             void abort(void);
+            /// @brief Time spent in each phase of the steps taken
+            ///        so far.
+            std::shared_ptr<const KontrollerTimer> timer(void) const;
         private:
             void init_agents(void);
 
@@ -146,15 +154,35 @@ namespace geopm
             std::shared_ptr<IApplicationIO> m_application_io;
             std::unique_ptr<IReporter> m_reporter;
             std::unique_ptr<ITracer> m_tracer;
+            std::unique_ptr<ITraceRollup> m_trace_rollup;
             std::vector<std::unique_ptr<Agent> > m_agent;
             const bool m_is_root;
             std::vector<double> m_in_policy;
-            std::vector<std::vector<std::vector<double> > > m_out_policy;
-            std::vector<std::vector<std::vector<double> > > m_in_sample;
+            /// Policy from the resource manager, updated when the
+            /// manager IO sampler reports a change.
+            std::vector<double> m_root_policy;
+            bool m_is_root_policy_valid;
+            /// Number of children at each controlled level.
+            std::vector<int> m_num_child;
+            /// Policies for children at each controlled level packed
+            /// into a contiguous child by policy matrix.
+            std::vector<std::vector<double> > m_out_policy;
+            /// Samples from children at each controlled level packed
+            /// into a contiguous child by sample matrix.
+            std::vector<std::vector<double> > m_in_sample;
             std::vector<double> m_out_sample;
             std::vector<double> m_trace_sample;
 
             std::unique_ptr<IManagerIOSampler> m_manager_io_sampler;
+            /// Publishes the samples aggregated at the root of the
+            /// tree to the resource manager, or null if disabled.
+            std::unique_ptr<IManagerIO> m_manager_io;
+            /// Time spent in each phase of step(), shared with the
+            /// KontrollerIOGroup registered with the PlatformIO.
+            std::shared_ptr<KontrollerTimer> m_timer;
+            /// Threads available to the Agents through
+            /// Agent::parallel_for(), sized by GEOPM_AGENT_THREADS.
+            std::shared_ptr<ThreadPool> m_thread_pool;
 
             std::vector<std::string> m_agent_policy_names;
             std::vector<std::string> m_agent_sample_names;
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "KontrollerIOGroup.hpp"
+#include "KontrollerTimer.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+#define GEOPM_KONTROLLER_IO_GROUP_PLUGIN_NAME "CONTROLLER"
+
+namespace geopm
+{
+    KontrollerIOGroup::KontrollerIOGroup(std::shared_ptr<const KontrollerTimer> timer)
+        : m_timer(timer)
+        , m_is_batch_read(false)
+    {
+        const std::string prefix = plugin_name() + "::";
+        for (int phase = 0; phase < KontrollerTimer::M_NUM_PHASE; ++phase) {
+            for (int stat = 0; stat < KontrollerTimer::M_NUM_STAT; ++stat) {
+                std::string name = prefix + KontrollerTimer::phase_name(phase) + "_" +
+                                   KontrollerTimer::stat_name(stat);
+                std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+                m_signal_idx[name] = phase * KontrollerTimer::M_NUM_STAT + stat;
+            }
+        }
+        m_signal_idx[prefix + "STEP_COUNT"] = M_SIGNAL_STEP_COUNT;
+        m_signal_idx[prefix + "BUSY_FRACTION"] = M_SIGNAL_BUSY_FRACTION;
+    }
+
+    std::set<std::string> KontrollerIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &kv : m_signal_idx) {
+            result.insert(kv.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> KontrollerIOGroup::control_names(void) const
+    {
+        return {};
+    }
+
+    bool KontrollerIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_idx.find(signal_name) != m_signal_idx.end();
+    }
+
+    bool KontrollerIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return false;
+    }
+
+    int KontrollerIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = PlatformTopo::M_DOMAIN_INVALID;
+        if (is_valid_signal(signal_name)) {
+            result = PlatformTopo::M_DOMAIN_BOARD;
+        }
+        return result;
+    }
+
+    int KontrollerIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        return PlatformTopo::M_DOMAIN_INVALID;
+    }
+
+    int KontrollerIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        auto it = m_signal_idx.find(signal_name);
+        if (it == m_signal_idx.end()) {
+            throw Exception("KontrollerIOGroup::push_signal(): signal_name " + signal_name +
+                            " not valid for KontrollerIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != PlatformTopo::M_DOMAIN_BOARD || domain_idx != 0) {
+            throw Exception("KontrollerIOGroup::push_signal(): signals are only provided for board domain 0",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_is_batch_read) {
+            throw Exception("KontrollerIOGroup::push_signal(): cannot push signal after call to read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = std::find(m_pushed_idx.begin(), m_pushed_idx.end(), it->second) - m_pushed_idx.begin();
+        if (result == (int)m_pushed_idx.size()) {
+            m_pushed_idx.push_back(it->second);
+        }
+        return result;
+    }
+
+    int KontrollerIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        throw Exception("KontrollerIOGroup::push_control(): there are no controls supported by the KontrollerIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    void KontrollerIOGroup::read_batch(void)
+    {
+        m_value.resize(m_pushed_idx.size());
+        for (size_t batch_idx = 0; batch_idx < m_pushed_idx.size(); ++batch_idx) {
+            m_value[batch_idx] = read(m_pushed_idx[batch_idx]);
+        }
+        m_is_batch_read = true;
+    }
+
+    void KontrollerIOGroup::write_batch(void)
+    {
+
+    }
+
+    double KontrollerIOGroup::sample(int batch_idx)
+    {
+        if (!m_is_batch_read) {
+            throw Exception("KontrollerIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (batch_idx < 0 || batch_idx >= (int)m_value.size()) {
+            throw Exception("KontrollerIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_value[batch_idx];
+    }
+
+    void KontrollerIOGroup::adjust(int batch_idx, double setting)
+    {
+        throw Exception("KontrollerIOGroup::adjust(): there are no controls supported by the KontrollerIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    double KontrollerIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        auto it = m_signal_idx.find(signal_name);
+        if (it == m_signal_idx.end()) {
+            throw Exception("KontrollerIOGroup:read_signal(): " + signal_name +
+                            " not valid for KontrollerIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != PlatformTopo::M_DOMAIN_BOARD || domain_idx != 0) {
+            throw Exception("KontrollerIOGroup::read_signal(): signals are only provided for board domain 0",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return read(it->second);
+    }
+
+    void KontrollerIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        throw Exception("KontrollerIOGroup::write_control(): there are no controls supported by the KontrollerIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    void KontrollerIOGroup::save_control(void)
+    {
+
+    }
+
+    void KontrollerIOGroup::restore_control(void)
+    {
+
+    }
+
+    std::string KontrollerIOGroup::plugin_name(void)
+    {
+        return GEOPM_KONTROLLER_IO_GROUP_PLUGIN_NAME;
+    }
+
+    double KontrollerIOGroup::read(int signal_idx) const
+    {
+        double result = NAN;
+        if (signal_idx == M_SIGNAL_STEP_COUNT) {
+            result = m_timer->num_step();
+        }
+        else if (signal_idx == M_SIGNAL_BUSY_FRACTION) {
+            result = m_timer->busy_fraction();
+        }
+        else {
+            result = m_timer->stat(signal_idx / KontrollerTimer::M_NUM_STAT,
+                                   signal_idx % KontrollerTimer::M_NUM_STAT);
+        }
+        return result;
+    }
+}
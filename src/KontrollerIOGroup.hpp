@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KONTROLLERIOGROUP_HPP_INCLUDE
+#define KONTROLLERIOGROUP_HPP_INCLUDE
+
+#include <set>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "IOGroup.hpp"
+
+namespace geopm
+{
+    class KontrollerTimer;
+
+    /// @brief IOGroup that provides signals for the time the
+    ///        controller spends in each phase of its control step.
+    ///
+    /// For each phase named by KontrollerTimer::phase_name() there
+    /// are signals CONTROLLER::<PHASE>_<STAT> for the statistics
+    /// LAST, MEAN, MIN, MAX, P50, P90 and P99 in seconds, e.g.
+    /// CONTROLLER::READ_BATCH_P99.  CONTROLLER::STEP_COUNT gives the
+    /// number of steps and CONTROLLER::BUSY_FRACTION the fraction of
+    /// the step time not spent waiting.  All signals are board
+    /// domain.  The IOGroup is registered with the PlatformIO by the
+    /// Kontroller that owns the timer.
+    class KontrollerIOGroup : public IOGroup
+    {
+        public:
+            KontrollerIOGroup(std::shared_ptr<const KontrollerTimer> timer);
+            virtual ~KontrollerIOGroup() = default;
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            static std::string plugin_name(void);
+        private:
+            enum m_signal_e {
+                M_SIGNAL_STEP_COUNT = -1,
+                M_SIGNAL_BUSY_FRACTION = -2,
+            };
+            /// Value of a signal given the index encoding used in
+            /// m_signal_idx: phase * M_NUM_STAT + stat, or one of
+            /// the m_signal_e values.
+            double read(int signal_idx) const;
+
+            std::shared_ptr<const KontrollerTimer> m_timer;
+            std::map<std::string, int> m_signal_idx;
+            std::vector<int> m_pushed_idx;
+            std::vector<double> m_value;
+            bool m_is_batch_read;
+    };
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+
+#include "KontrollerTimer.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    KontrollerTimer::KontrollerTimer()
+        : m_current(M_NUM_PHASE, 0.0)
+        , m_phase_stat(M_NUM_PHASE, {0.0, 0.0, LogHistogram()})
+        , m_step_begin({{0, 0}})
+        , m_is_step_begun(false)
+    {
+
+    }
+
+    void KontrollerTimer::record(m_phase_stat_s &phase_stat, double value)
+    {
+        phase_stat.last = value;
+        phase_stat.total += value;
+        phase_stat.hist.insert(value);
+    }
+
+    void KontrollerTimer::begin_step(struct geopm_time_s &time)
+    {
+        geopm_time(&time);
+        if (m_is_step_begun) {
+            record(m_phase_stat[M_PHASE_PERIOD], geopm_time_diff(&m_step_begin, &time));
+        }
+        m_step_begin = time;
+        m_is_step_begun = true;
+    }
+
+    void KontrollerTimer::lap(int phase, struct geopm_time_s &time)
+    {
+        struct geopm_time_s end;
+        geopm_time(&end);
+        m_current[phase] += geopm_time_diff(&time, &end);
+        time = end;
+    }
+
+    void KontrollerTimer::end_step(void)
+    {
+        struct geopm_time_s end;
+        geopm_time(&end);
+        m_current[M_PHASE_STEP] = geopm_time_diff(&m_step_begin, &end);
+        for (int phase = 0; phase < M_NUM_PHASE; ++phase) {
+            if (phase != M_PHASE_PERIOD) {
+                record(m_phase_stat[phase], m_current[phase]);
+            }
+            m_current[phase] = 0.0;
+        }
+    }
+
+    uint64_t KontrollerTimer::num_step(void) const
+    {
+        return m_phase_stat[M_PHASE_STEP].hist.count();
+    }
+
+    double KontrollerTimer::stat(int phase, int stat) const
+    {
+        if (phase < 0 || phase >= M_NUM_PHASE ||
+            stat < 0 || stat >= M_NUM_STAT) {
+            throw Exception("KontrollerTimer::stat(): phase or stat out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const m_phase_stat_s &phase_stat = m_phase_stat[phase];
+        double result = NAN;
+        if (phase_stat.hist.count()) {
+            switch (stat) {
+                case M_STAT_LAST:
+                    result = phase_stat.last;
+                    break;
+                case M_STAT_MEAN:
+                    result = phase_stat.total / phase_stat.hist.count();
+                    break;
+                case M_STAT_MIN:
+                    result = phase_stat.hist.min();
+                    break;
+                case M_STAT_MAX:
+                    result = phase_stat.hist.max();
+                    break;
+                case M_STAT_P50:
+                    result = phase_stat.hist.percentile(50);
+                    break;
+                case M_STAT_P90:
+                    result = phase_stat.hist.percentile(90);
+                    break;
+                case M_STAT_P99:
+                    result = phase_stat.hist.percentile(99);
+                    break;
+            }
+        }
+        return result;
+    }
+
+    double KontrollerTimer::busy_fraction(void) const
+    {
+        double result = NAN;
+        const m_phase_stat_s &step = m_phase_stat[M_PHASE_STEP];
+        if (step.total > 0.0) {
+            result = 1.0 - m_phase_stat[M_PHASE_AGENT_WAIT].total / step.total;
+        }
+        return result;
+    }
+
+    std::string KontrollerTimer::phase_name(int phase)
+    {
+        static const std::vector<std::string> result {
+            "step",
+            "period",
+            "manager_io",
+            "application_io",
+            "read_batch",
+            "write_batch",
+            "agent_descend",
+            "agent_ascend",
+            "agent_adjust",
+            "agent_sample",
+            "agent_wait",
+            "tree_send",
+            "tree_receive",
+            "tracer",
+        };
+        if (phase < 0 || phase >= M_NUM_PHASE) {
+            throw Exception("KontrollerTimer::phase_name(): phase out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result[phase];
+    }
+
+    std::string KontrollerTimer::stat_name(int stat)
+    {
+        static const std::vector<std::string> result {
+            "last",
+            "mean",
+            "min",
+            "max",
+            "p50",
+            "p90",
+            "p99",
+        };
+        if (stat < 0 || stat >= M_NUM_STAT) {
+            throw Exception("KontrollerTimer::stat_name(): stat out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result[stat];
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KONTROLLERTIMER_HPP_INCLUDE
+#define KONTROLLERTIMER_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "geopm_time.h"
+#include "LogHistogram.hpp"
+
+namespace geopm
+{
+    /// @brief Accumulates the time the Kontroller spends in each
+    ///        phase of a control step.
+    ///
+    /// The time of each phase is summed over a step and, at the end
+    /// of the step, inserted into a LogHistogram.  Recording a phase
+    /// costs one clock read, so the timers are always enabled.  The
+    /// mean, minimum and maximum are exact and the percentiles are
+    /// estimated by the histogram.
+    class KontrollerTimer
+    {
+        public:
+            enum m_phase_e {
+                /// Whole step from its start to the end of the wait.
+                M_PHASE_STEP,
+                /// Time between the start of consecutive steps.
+                M_PHASE_PERIOD,
+                M_PHASE_MANAGER_IO,
+                M_PHASE_APPLICATION_IO,
+                M_PHASE_READ_BATCH,
+                M_PHASE_WRITE_BATCH,
+                M_PHASE_AGENT_DESCEND,
+                M_PHASE_AGENT_ASCEND,
+                M_PHASE_AGENT_ADJUST,
+                M_PHASE_AGENT_SAMPLE,
+                M_PHASE_AGENT_WAIT,
+                M_PHASE_TREE_SEND,
+                M_PHASE_TREE_RECEIVE,
+                M_PHASE_TRACER,
+                M_NUM_PHASE,
+            };
+            enum m_stat_e {
+                M_STAT_LAST,
+                M_STAT_MEAN,
+                M_STAT_MIN,
+                M_STAT_MAX,
+                M_STAT_P50,
+                M_STAT_P90,
+                M_STAT_P99,
+                M_NUM_STAT,
+            };
+            KontrollerTimer();
+            virtual ~KontrollerTimer() = default;
+            /// @brief Start a control step.
+            /// @param [out] time Set to the current time, to be
+            ///        passed to lap() by the first phase of the step.
+            void begin_step(struct geopm_time_s &time);
+            /// @brief Add the time elapsed since time to a phase of
+            ///        the current step.
+            /// @param [in] phase One of the m_phase_e values.
+            /// @param [in,out] time Start of the phase, updated to
+            ///        the current time so that it can be used as the
+            ///        start of the next phase.
+            void lap(int phase, struct geopm_time_s &time);
+            /// @brief Record the time of each phase of the current
+            ///        step.
+            void end_step(void);
+            /// @brief Number of steps recorded.
+            uint64_t num_step(void) const;
+            /// @brief Statistic of the per-step time of a phase.
+            /// @param [in] phase One of the m_phase_e values.
+            /// @param [in] stat One of the m_stat_e values.
+            /// @return Time in seconds, or NAN if the phase has not
+            ///         been recorded.
+            double stat(int phase, int stat) const;
+            /// @brief Fraction of the step time not spent waiting for
+            ///        the next control period.  Values near one
+            ///        indicate that the control loop is not able to
+            ///        keep up with the period requested by the Agent.
+            double busy_fraction(void) const;
+            /// @brief Name of a phase, e.g. "read_batch".
+            static std::string phase_name(int phase);
+            /// @brief Name of a statistic, e.g. "p99".
+            static std::string stat_name(int stat);
+        private:
+            struct m_phase_stat_s {
+                double last;
+                double total;
+                LogHistogram hist;
+            };
+            static void record(m_phase_stat_s &phase_stat, double value);
+
+            std::vector<double> m_current;
+            std::vector<m_phase_stat_s> m_phase_stat;
+            struct geopm_time_s m_step_begin;
+            bool m_is_step_begun;
+    };
+}
+
+#endif
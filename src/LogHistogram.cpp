@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+
+#include "LogHistogram.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    // Exponent bias and number of mantissa bits of a double
+    static const int64_t M_EXP_BIAS = 1023;
+    static const int M_NUM_MANTISSA_BITS = 52;
+
+    LogHistogram::LogHistogram()
+    {
+        reset();
+    }
+
+    void LogHistogram::insert(double value)
+    {
+        if (!std::isfinite(value)) {
+            return;
+        }
+        if (value > 0.0) {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            // Biased exponent and leading mantissa bits of a positive
+            // double, offset so that 2^M_MIN_EXP is bucket zero
+            int64_t bucket_idx = (int64_t)(bits >> (M_NUM_MANTISSA_BITS - M_NUM_SUB_BUCKET_BITS)) -
+                                 ((M_EXP_BIAS + M_MIN_EXP) << M_NUM_SUB_BUCKET_BITS);
+            bucket_idx = std::min(std::max(bucket_idx, (int64_t)0), (int64_t)M_NUM_BUCKET - 1);
+            ++m_bucket[bucket_idx];
+        }
+        else {
+            ++m_num_non_positive;
+        }
+        ++m_count;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    void LogHistogram::reset(void)
+    {
+        m_bucket.fill(0);
+        m_num_non_positive = 0;
+        m_count = 0;
+        m_min = INFINITY;
+        m_max = -INFINITY;
+    }
+
+    uint64_t LogHistogram::count(void) const
+    {
+        return m_count;
+    }
+
+    double LogHistogram::min(void) const
+    {
+        return m_count ? m_min : NAN;
+    }
+
+    double LogHistogram::max(void) const
+    {
+        return m_count ? m_max : NAN;
+    }
+
+    double LogHistogram::bucket_lower(int bucket_idx)
+    {
+        int exp = bucket_idx / M_NUM_SUB_BUCKET + M_MIN_EXP;
+        int sub_idx = bucket_idx % M_NUM_SUB_BUCKET;
+        return std::ldexp(1.0 + (double)sub_idx / M_NUM_SUB_BUCKET, exp);
+    }
+
+    double LogHistogram::percentile(double percentile) const
+    {
+        if (!(percentile >= 0.0 && percentile <= 100.0)) {
+            throw Exception("LogHistogram::percentile(): percentile must be between 0 and 100",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!m_count) {
+            return NAN;
+        }
+        // Rank of the sample in one based order
+        uint64_t rank = std::max((uint64_t)std::ceil(percentile / 100.0 * m_count), (uint64_t)1);
+        double result = m_max;
+        uint64_t num_below = m_num_non_positive;
+        if (rank == m_count) {
+            // The largest sample is known exactly
+        }
+        else if (rank == 1 || rank <= num_below) {
+            result = m_min;
+        }
+        else {
+            for (int bucket_idx = 0; bucket_idx < M_NUM_BUCKET; ++bucket_idx) {
+                num_below += m_bucket[bucket_idx];
+                if (rank <= num_below) {
+                    result = 0.5 * (bucket_lower(bucket_idx) + bucket_lower(bucket_idx + 1));
+                    break;
+                }
+            }
+        }
+        return std::min(std::max(result, m_min), m_max);
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LOGHISTOGRAM_HPP_INCLUDE
+#define LOGHISTOGRAM_HPP_INCLUDE
+
+#include <stdint.h>
+#include <array>
+
+namespace geopm
+{
+    /// @brief Streaming histogram of a signal with buckets on a log
+    ///        scale, used to estimate percentiles in fixed memory.
+    ///
+    /// Each power of two is split into M_NUM_SUB_BUCKET buckets of
+    /// equal width, so the bucket of a positive value is read from
+    /// the exponent and leading mantissa bits of its IEEE 754
+    /// representation.  A percentile is reported as the center of
+    /// its bucket, which is within 1 / (2 * M_NUM_SUB_BUCKET) of
+    /// the exact value relative to the value, and is clamped to the
+    /// minimum and maximum inserted, which are kept exactly.  Values below 2^M_MIN_EXP or at
+    /// or above 2^M_MAX_EXP are counted in the first or last bucket,
+    /// and values that are not positive are counted together and
+    /// reported as the minimum.
+    class LogHistogram
+    {
+        public:
+            LogHistogram();
+            virtual ~LogHistogram() = default;
+            /// @brief Add a sample to the histogram.  Values that
+            ///        are not finite, e.g. NAN before a derived
+            ///        signal has two samples, are ignored.
+            void insert(double value);
+            /// @brief Remove all samples.
+            void reset(void);
+            /// @brief Number of samples inserted.
+            uint64_t count(void) const;
+            /// @brief Smallest sample inserted, NAN if empty.
+            double min(void) const;
+            /// @brief Largest sample inserted, NAN if empty.
+            double max(void) const;
+            /// @brief Estimate a percentile of the samples.
+            /// @param [in] percentile Value between 0 and 100,
+            ///        e.g. 99 for the p99.
+            /// @return Estimated value below which the given percent
+            ///         of the samples fall, or NAN if empty.
+            double percentile(double percentile) const;
+        private:
+            enum m_bucket_e {
+                M_NUM_SUB_BUCKET_BITS = 4,
+                M_NUM_SUB_BUCKET = 1 << M_NUM_SUB_BUCKET_BITS,
+                M_MIN_EXP = -24,
+                M_MAX_EXP = 56,
+                M_NUM_BUCKET = (M_MAX_EXP - M_MIN_EXP) * M_NUM_SUB_BUCKET,
+            };
+            /// @brief Lower bound of a bucket.
+            static double bucket_lower(int bucket_idx);
+            std::array<uint32_t, M_NUM_BUCKET> m_bucket;
+            uint64_t m_num_non_positive;
+            uint64_t m_count;
+            double m_min;
+            double m_max;
+    };
+}
+
+#endif
@@ -100,7 +100,9 @@ namespace geopm
                     << " write_mask=0x" << write_mask;
             throw Exception(err_str.str(), GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        uint64_t write_value = read_msr(cpu_idx, offset);
+        int shadow_idx = write_shadow_idx(cpu_idx, offset);
+        uint64_t write_value = shadow_idx != -1 && m_write_shadow[shadow_idx].is_valid ?
+                               m_write_shadow[shadow_idx].value : read_msr(cpu_idx, offset);
         write_value &= ~write_mask;
         write_value |= raw_value;
         size_t num_write = pwrite(msr_desc(cpu_idx), &write_value, sizeof(write_value), offset);
@@ -110,6 +112,97 @@ namespace geopm
                     << " system error: " << strerror(errno);
             throw Exception(err_str.str(), GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
         }
+        if (shadow_idx != -1) {
+            m_write_shadow[shadow_idx].value = write_value;
+            m_write_shadow[shadow_idx].is_valid = true;
+        }
+    }
+
+    void MSRIO::read_msr(const std::vector<int> &cpu_idx,
+                         const std::vector<uint64_t> &offset,
+                         std::vector<uint64_t> &raw_value)
+    {
+        if (cpu_idx.size() != offset.size()) {
+            throw Exception("MSRIO::read_msr(): Input vector length mismatch",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        raw_value.resize(cpu_idx.size());
+        open_msr_batch();
+        if (m_is_batch_enabled && cpu_idx.size()) {
+            std::vector<struct m_msr_batch_op_s> batch_op(cpu_idx.size());
+            for (size_t op_idx = 0; op_idx != cpu_idx.size(); ++op_idx) {
+                batch_op[op_idx] = {(uint16_t)cpu_idx[op_idx], 1, 0, (uint32_t)offset[op_idx], 0, 0};
+            }
+            struct m_msr_batch_array_s batch {(uint32_t)batch_op.size(), batch_op.data()};
+            msr_ioctl(batch);
+            for (size_t op_idx = 0; op_idx != cpu_idx.size(); ++op_idx) {
+                raw_value[op_idx] = batch_op[op_idx].msrdata;
+            }
+        }
+        else {
+            for (size_t op_idx = 0; op_idx != cpu_idx.size(); ++op_idx) {
+                raw_value[op_idx] = read_msr(cpu_idx[op_idx], offset[op_idx]);
+            }
+        }
+    }
+
+    void MSRIO::write_msr(const std::vector<int> &cpu_idx,
+                          const std::vector<uint64_t> &offset,
+                          const std::vector<uint64_t> &raw_value,
+                          const std::vector<uint64_t> &write_mask)
+    {
+        if (cpu_idx.size() != offset.size() ||
+            offset.size() != raw_value.size() ||
+            raw_value.size() != write_mask.size()) {
+            throw Exception("MSRIO::write_msr(): Input vector length mismatch",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        // Merge the fields written to each MSR
+        std::map<std::pair<int, uint64_t>, std::pair<uint64_t, uint64_t> > merged;
+        for (size_t op_idx = 0; op_idx != cpu_idx.size(); ++op_idx) {
+            if ((raw_value[op_idx] & write_mask[op_idx]) != raw_value[op_idx]) {
+                std::ostringstream err_str;
+                err_str << "MSRIO::write_msr(): raw_value does not obey write_mask, "
+                        << "raw_value=0x" << std::hex << raw_value[op_idx]
+                        << " write_mask=0x" << write_mask[op_idx];
+                throw Exception(err_str.str(), GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            auto &value_mask = merged[std::make_pair(cpu_idx[op_idx], offset[op_idx])];
+            value_mask.first &= ~write_mask[op_idx];
+            value_mask.first |= raw_value[op_idx];
+            value_mask.second |= write_mask[op_idx];
+        }
+#ifdef GEOPM_ENABLE_MSRSAFE_IOCTL_WRITE
+        open_msr_batch();
+        if (m_is_batch_enabled && merged.size()) {
+            // The driver applies the write mask, so no read is needed
+            std::vector<struct m_msr_batch_op_s> batch_op;
+            batch_op.reserve(merged.size());
+            for (const auto &it : merged) {
+                batch_op.push_back({(uint16_t)it.first.first, 0, 0, (uint32_t)it.first.second,
+                                    it.second.first, it.second.second});
+            }
+            struct m_msr_batch_array_s batch {(uint32_t)batch_op.size(), batch_op.data()};
+            msr_ioctl(batch);
+            for (const auto &it : merged) {
+                int shadow_idx = write_shadow_idx(it.first.first, it.first.second);
+                if (shadow_idx != -1 && m_write_shadow[shadow_idx].is_valid) {
+                    m_write_shadow[shadow_idx].value &= ~it.second.second;
+                    m_write_shadow[shadow_idx].value |= it.second.first;
+                }
+            }
+            return;
+        }
+#endif
+        for (const auto &it : merged) {
+            write_msr(it.first.first, it.first.second, it.second.first, it.second.second);
+        }
+    }
+
+    int MSRIO::write_shadow_idx(int cpu_idx, uint64_t offset) const
+    {
+        auto it = m_write_shadow_map.find(std::make_pair(cpu_idx, offset));
+        return it == m_write_shadow_map.end() ? -1 : it->second;
     }
 
     void MSRIO::config_batch(const std::vector<int> &read_cpu_idx,
@@ -160,24 +253,43 @@ namespace geopm
         }
         m_write_batch.numops = m_write_batch_op.size();
         m_write_batch.ops = m_write_batch_op.data();
+
+        // Operations on different fields of the same MSR are merged
+        // into one write of the MSR.
+        m_write_shadow.clear();
+        m_write_shadow_map.clear();
+        m_write_shadow_idx.resize(write_cpu_idx.size());
+        for (size_t op_idx = 0; op_idx != write_cpu_idx.size(); ++op_idx) {
+            auto key = std::make_pair(write_cpu_idx[op_idx], write_offset[op_idx]);
+            auto it = m_write_shadow_map.find(key);
+            if (it == m_write_shadow_map.end()) {
+                it = m_write_shadow_map.emplace(key, m_write_shadow.size()).first;
+                m_write_shadow.push_back({write_cpu_idx[op_idx], write_offset[op_idx], 0, 0, false});
+            }
+            m_write_shadow[it->second].mask |= write_mask[op_idx];
+            m_write_shadow_idx[op_idx] = it->second;
+        }
+        m_write_next.resize(m_write_shadow.size());
+        m_write_dirty_op.reserve(m_write_shadow.size());
     }
 
-    void MSRIO::msr_ioctl(bool is_read)
+    void MSRIO::msr_ioctl(struct m_msr_batch_array_s &batch)
     {
-        struct m_msr_batch_array_s *batch_ptr = is_read ? &m_read_batch : &m_write_batch;
-        int err = ioctl(msr_batch_desc(), GEOPM_IOC_MSR_BATCH, batch_ptr);
+        int err = ioctl(msr_batch_desc(), GEOPM_IOC_MSR_BATCH, &batch);
         if (err) {
             throw Exception("MSRIO::msr_ioctl(): call to ioctl() for /dev/cpu/msr_batch failed: " +
                             std::string(" system error: ") + strerror(errno),
                             GEOPM_ERROR_MSR_READ, __FILE__, __LINE__);
         }
-        for (uint32_t batch_idx = 0; batch_idx != m_write_batch.numops; ++batch_idx) {
-            if (m_write_batch.ops[batch_idx].err) {
+        for (uint32_t batch_idx = 0; batch_idx != batch.numops; ++batch_idx) {
+            if (batch.ops[batch_idx].err) {
                 std::ostringstream err_str;
                 err_str << "MSRIO::msr_ioctl(): operation failed at offset 0x"
-                        << std::hex << m_write_batch.ops[batch_idx].msr
-                        << " system error: " << strerror(m_write_batch.ops[batch_idx].err);
-                throw Exception(err_str.str(), GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
+                        << std::hex << batch.ops[batch_idx].msr
+                        << " system error: " << strerror(batch.ops[batch_idx].err);
+                throw Exception(err_str.str(),
+                                batch.ops[batch_idx].isrdmsr ? GEOPM_ERROR_MSR_READ : GEOPM_ERROR_MSR_WRITE,
+                                __FILE__, __LINE__);
             }
         }
     }
@@ -189,7 +301,7 @@ namespace geopm
         }
         open_msr_batch();
         if (m_is_batch_enabled) {
-            msr_ioctl(true);
+            msr_ioctl(m_read_batch);
             uint32_t batch_idx = 0;
             for (auto raw_it = raw_value.begin();
                  batch_idx != m_read_batch.numops;
@@ -210,34 +322,63 @@ namespace geopm
 
     void MSRIO::write_batch(const std::vector<uint64_t> &raw_value)
     {
-        if (raw_value.size() < m_write_batch.numops) {
+        if (raw_value.size() < m_write_batch_op.size()) {
             throw Exception("MSRIO::write_batch(): input vector smaller than configured number of operations",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         open_msr_batch();
-#ifdef GEOPM_ENABLE_MSRSAFE_IOCTL_WRITE
-        if (m_is_batch_enabled) {
-            uint32_t batch_idx = 0;
-            for (auto raw_it = raw_value.begin();
-                 batch_idx != m_write_batch.numops;
-                 ++raw_it, ++batch_idx) {
-                m_write_batch.ops[batch_idx].msrdata = *raw_it;
+        for (size_t shadow_idx = 0; shadow_idx != m_write_shadow.size(); ++shadow_idx) {
+            const m_write_shadow_s &shadow = m_write_shadow[shadow_idx];
+            // Only the first write of each MSR needs to read it
+            m_write_next[shadow_idx] = shadow.is_valid ?
+                                       shadow.value : read_msr(shadow.cpu, shadow.offset);
+        }
+        for (size_t op_idx = 0; op_idx != m_write_batch_op.size(); ++op_idx) {
+            uint64_t write_mask = m_write_batch_op[op_idx].wmask;
+            if ((raw_value[op_idx] & write_mask) != raw_value[op_idx]) {
+                std::ostringstream err_str;
+                err_str << "MSRIO::write_batch(): raw_value does not obey write_mask, "
+                        << "raw_value=0x" << std::hex << raw_value[op_idx]
+                        << " write_mask=0x" << write_mask;
+                throw Exception(err_str.str(), GEOPM_ERROR_INVALID, __FILE__, __LINE__);
             }
-            msr_ioctl(false);
+            uint64_t &write_value = m_write_next[m_write_shadow_idx[op_idx]];
+            write_value &= ~write_mask;
+            write_value |= raw_value[op_idx];
         }
-        else
+        m_write_dirty_op.clear();
+        for (size_t shadow_idx = 0; shadow_idx != m_write_shadow.size(); ++shadow_idx) {
+            m_write_shadow_s &shadow = m_write_shadow[shadow_idx];
+            uint64_t write_value = m_write_next[shadow_idx];
+            if (shadow.is_valid && shadow.value == write_value) {
+                continue;
+            }
+#ifdef GEOPM_ENABLE_MSRSAFE_IOCTL_WRITE
+            if (m_is_batch_enabled) {
+                m_write_dirty_op.push_back({(uint16_t)shadow.cpu, 0, 0, (uint32_t)shadow.offset,
+                                            write_value & shadow.mask, shadow.mask});
+            }
+            else
 #endif
-        {
-            uint32_t batch_idx = 0;
-            for (auto raw_it = raw_value.begin();
-                 batch_idx != m_write_batch.numops;
-                 ++raw_it, ++batch_idx) {
-                write_msr(m_write_batch_op[batch_idx].cpu,
-                          m_write_batch_op[batch_idx].msr,
-                          *raw_it,
-                          m_write_batch_op[batch_idx].wmask);
+            {
+                size_t num_write = pwrite(msr_desc(shadow.cpu), &write_value, sizeof(write_value), shadow.offset);
+                if (num_write != sizeof(write_value)) {
+                    std::ostringstream err_str;
+                    err_str << "MSRIO::write_batch(): pwrite() failed at offset 0x" << std::hex << shadow.offset
+                            << " system error: " << strerror(errno);
+                    throw Exception(err_str.str(), GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
+                }
             }
+            shadow.value = write_value;
+            shadow.is_valid = true;
+        }
+#ifdef GEOPM_ENABLE_MSRSAFE_IOCTL_WRITE
+        if (m_write_dirty_op.size()) {
+            m_write_batch.numops = m_write_dirty_op.size();
+            m_write_batch.ops = m_write_dirty_op.data();
+            msr_ioctl(m_write_batch);
         }
+#endif
     }
 
     int MSRIO::msr_desc(int cpu_idx)
@@ -276,6 +417,12 @@ namespace geopm
         path = "/dev/cpu/msr_batch";
     }
 
+    bool MSRIO::is_available(void)
+    {
+        return access("/dev/cpu/0/msr_safe", R_OK | W_OK) == 0 ||
+               access("/dev/cpu/0/msr", R_OK | W_OK) == 0;
+    }
+
     void MSRIO::open_msr(int cpu_idx)
     {
         if (m_file_desc[cpu_idx] == -1) {
@@ -36,6 +36,7 @@
 #include <stdint.h>
 #include <string>
 #include <vector>
+#include <map>
 
 namespace geopm
 {
@@ -65,6 +66,33 @@ namespace geopm
                                    uint64_t offset,
                                    uint64_t raw_value,
                                    uint64_t write_mask) = 0;
+            /// @brief Read a list of MSRs in one call, without the
+            ///        set up required by config_batch().  When the
+            ///        msr_batch driver is available all of the reads
+            ///        are made with a single ioctl().
+            /// @param [in] cpu_idx Logical Linux CPU index for each
+            ///        MSR to read.
+            /// @param [in] offset Offset of each MSR to read.
+            /// @param [out] raw_value The raw encoded value read
+            ///        from each MSR.
+            virtual void read_msr(const std::vector<int> &cpu_idx,
+                                  const std::vector<uint64_t> &offset,
+                                  std::vector<uint64_t> &raw_value) = 0;
+            /// @brief Write a list of MSRs in one call, without the
+            ///        set up required by config_batch().  Writes to
+            ///        different fields of the same MSR are merged
+            ///        into one write of the MSR.
+            /// @param [in] cpu_idx Logical Linux CPU index for each
+            ///        MSR to write.
+            /// @param [in] offset Offset of each MSR to write.
+            /// @param [in] raw_value The raw encoded value to write
+            ///        under each write mask.
+            /// @param [in] write_mask The bits of each MSR that will
+            ///        be modified.
+            virtual void write_msr(const std::vector<int> &cpu_idx,
+                                   const std::vector<uint64_t> &offset,
+                                   const std::vector<uint64_t> &raw_value,
+                                   const std::vector<uint64_t> &write_mask) = 0;
             /// @brief initialize internal data structures to batch
             ///        read/write from MSRs.
             /// @param [in] read_cpu_idx A vector of logical Linux CPU
@@ -95,6 +123,8 @@ namespace geopm
             virtual void read_batch(std::vector<uint64_t> &raw_value) = 0;
             /// @brief Batch write a set of MSRs configured by a
             ///        previous call to the batch_config() method.
+            ///        MSRs whose value would not change since the
+            ///        last write through this object are skipped.
             /// @param [in] raw_value The raw encoded MSR values to be
             ///        written.
             virtual void write_batch(const std::vector<uint64_t> &raw_value) = 0;
@@ -112,6 +142,13 @@ namespace geopm
                            uint64_t offset,
                            uint64_t raw_value,
                            uint64_t write_mask) override;
+            void read_msr(const std::vector<int> &cpu_idx,
+                          const std::vector<uint64_t> &offset,
+                          std::vector<uint64_t> &raw_value) override;
+            void write_msr(const std::vector<int> &cpu_idx,
+                           const std::vector<uint64_t> &offset,
+                           const std::vector<uint64_t> &raw_value,
+                           const std::vector<uint64_t> &write_mask) override;
             void config_batch(const std::vector<int> &read_cpu_idx,
                               const std::vector<uint64_t> &read_offset,
                               const std::vector<int> &write_cpu_idx,
@@ -119,7 +156,23 @@ namespace geopm
                               const std::vector<uint64_t> &write_mask) override;
             void read_batch(std::vector<uint64_t> &raw_value) override;
             void write_batch(const std::vector<uint64_t> &raw_value) override;
+            /// @brief Check if the msr-safe or msr driver files can
+            ///        be opened for reading and writing.
+            /// @return True if the MSR driver is usable.
+            static bool is_available(void);
         private:
+            /// @brief Last value written to an MSR configured for
+            ///        batch writes.  All bits outside of the write
+            ///        masks are assumed not to change between
+            ///        writes, so a masked write needs no read.
+            struct m_write_shadow_s {
+                int cpu;
+                uint64_t offset;
+                uint64_t mask;     /// @brief Union of the write masks
+                uint64_t value;
+                bool is_valid;     /// @brief False until first read
+            };
+
             struct m_msr_batch_op_s {
                 uint16_t cpu;      /// @brief In: CPU to execute {rd/wr}msr ins.
                 uint16_t isrdmsr;  /// @brief In: 0=wrmsr, non-zero=rdmsr
@@ -140,7 +193,10 @@ namespace geopm
             void close_msr_batch(void);
             int msr_desc(int cpu_idx);
             int msr_batch_desc(void);
-            void msr_ioctl(bool is_read);
+            void msr_ioctl(struct m_msr_batch_array_s &batch);
+            /// @brief Index of the batch write shadow for an MSR or
+            ///        -1 if it is not configured for batch writes.
+            int write_shadow_idx(int cpu_idx, uint64_t offset) const;
             virtual void msr_path(int cpu_idx,
                                   bool is_fallback,
                                   std::string &path);
@@ -153,6 +209,16 @@ namespace geopm
             struct m_msr_batch_array_s m_write_batch;
             std::vector<struct m_msr_batch_op_s> m_read_batch_op;
             std::vector<struct m_msr_batch_op_s> m_write_batch_op;
+            /// Unique MSRs written by write_batch() and the index
+            /// into them of each write operation.
+            std::vector<struct m_write_shadow_s> m_write_shadow;
+            std::vector<int> m_write_shadow_idx;
+            std::map<std::pair<int, uint64_t>, int> m_write_shadow_map;
+            /// Value written to each MSR by the current write_batch().
+            std::vector<uint64_t> m_write_next;
+            /// Operations for the MSRs that changed, used with the
+            /// batch ioctl.
+            std::vector<struct m_msr_batch_op_s> m_write_dirty_op;
     };
 }
 
@@ -184,8 +184,7 @@ namespace geopm
             throw Exception("MSRIOGroup::push_signal(): domain_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::set<int> cpu_idx;
-        m_platform_topo.domain_cpus(domain_type, domain_idx, cpu_idx);
+        const std::vector<int> &cpu_idx = m_platform_topo.domain_cpu_list(domain_type, domain_idx);
 
         int result = -1;
         bool is_found = false;
@@ -198,9 +197,9 @@ namespace geopm
             }
 #endif
             // signal_name may be alias, so use active signal MSR name
-            std::string registered_name = ncsm_it->second[*(cpu_idx.begin())]->name();
+            std::string registered_name = ncsm_it->second[cpu_idx.front()]->name();
             if (m_active_signal[ii]->name() == registered_name &&
-                m_active_signal[ii]->cpu_idx() == *(cpu_idx.begin())) {
+                m_active_signal[ii]->cpu_idx() == cpu_idx.front()) {
                 result = ii;
                 is_found = true;
             }
@@ -208,7 +207,7 @@ namespace geopm
 
         if (!is_found) {
             result = m_active_signal.size();
-            m_active_signal.push_back(ncsm_it->second[*(cpu_idx.begin())]);
+            m_active_signal.push_back(ncsm_it->second[cpu_idx.front()]);
             MSRSignal *msr_sig = m_active_signal[result];
 #ifdef GEOPM_DEBUG
             if (!msr_sig) {
@@ -217,7 +216,7 @@ namespace geopm
             }
 #endif
             uint64_t offset = msr_sig->offset();
-            m_read_cpu_idx.push_back(*(cpu_idx.begin()));
+            m_read_cpu_idx.push_back(cpu_idx.front());
             m_read_offset.push_back(offset);
         }
         return result;
@@ -243,10 +242,9 @@ namespace geopm
             throw Exception("MSRIOGroup::push_control(): domain_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::set<int> cpu_idx;
-        m_platform_topo.domain_cpus(domain_type, domain_idx, cpu_idx);
+        const std::vector<int> &cpu_idx = m_platform_topo.domain_cpu_list(domain_type, domain_idx);
 #ifdef GEOPM_DEBUG
-        if (cpu_idx.size() == 0) {
+        if (cpu_idx.empty()) {
             throw Exception("MSRIOGroup::push_control(): no cpus for domain",
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
         }
@@ -265,9 +263,9 @@ namespace geopm
                 write_control("MSR::PKG_POWER_LIMIT:SOFT_LIMIT_ENABLE", domain_type, domain_idx, 1.0);
             }
             // control_name may be alias, so use active control MSR name
-            std::string registered_name = nccm_it->second[*(cpu_idx.begin())]->name();
+            std::string registered_name = nccm_it->second[cpu_idx.front()]->name();
             if (m_active_control[ii][0]->name() == registered_name &&
-                m_active_control[ii][0]->cpu_idx() == *(cpu_idx.begin())) {
+                m_active_control[ii][0]->cpu_idx() == cpu_idx.front()) {
                 result = ii;
                 is_found = true;
             }
@@ -292,6 +290,7 @@ namespace geopm
                 m_write_mask.push_back(mask);
             }
             m_is_adjusted.push_back(false);
+            m_is_dirty.push_back(false);
         }
         return result;
     }
@@ -314,7 +313,10 @@ namespace geopm
                 throw Exception("MSRIOGroup::write_batch() called before all controls were adjusted",
                                 GEOPM_ERROR_INVALID, __FILE__, __LINE__);
             }
-            m_msrio->write_batch(m_write_field);
+            if (std::any_of(m_is_dirty.begin(), m_is_dirty.end(), [](bool it) {return it;})) {
+                m_msrio->write_batch(m_write_field);
+                std::fill(m_is_dirty.begin(), m_is_dirty.end(), false);
+            }
         }
     }
 
@@ -342,10 +344,18 @@ namespace geopm
         if (!m_is_active) {
             activate();
         }
+        bool is_dirty = !m_is_adjusted[control_idx];
+        size_t field_idx = m_control_field_idx[control_idx];
         for (auto control : m_active_control[control_idx]) {
+            uint64_t last_field = m_write_field[field_idx];
             control->adjust(setting);
+            is_dirty = is_dirty || m_write_field[field_idx] != last_field;
+            ++field_idx;
         }
         m_is_adjusted[control_idx] = true;
+        if (is_dirty) {
+            m_is_dirty[control_idx] = true;
+        }
     }
 
     double MSRIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
@@ -364,15 +374,14 @@ namespace geopm
             throw Exception("MSRIOGroup::read_signal(): domain_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::set<int> cpu_idx;
-        m_platform_topo.domain_cpus(domain_type, domain_idx, cpu_idx);
+        const std::vector<int> &cpu_idx = m_platform_topo.domain_cpu_list(domain_type, domain_idx);
 
         // Copy of existing signal but map own memory
-        MSRSignal signal {*(ncsm_it->second[*(cpu_idx.begin())])};
+        MSRSignal signal {*(ncsm_it->second[cpu_idx.front()])};
         uint64_t offset = signal.offset();
         uint64_t field = 0;
         signal.map_field(&field);
-        field = m_msrio->read_msr(*(cpu_idx.begin()), offset);
+        field = m_msrio->read_msr(cpu_idx.front(), offset);
         // @todo last value can only get updated with read batch. This means that
         // multiple calls to read_signal for a 64-bit counter will return 0
         // unless read_batch is called for those counters.
@@ -406,8 +415,7 @@ namespace geopm
             write_control("MSR::PERF_CTL:ENABLE", domain_type, domain_idx, 1.0);
         }
 
-        std::set<int> cpu_idx;
-        m_platform_topo.domain_cpus(domain_type, domain_idx, cpu_idx);
+        const std::vector<int> &cpu_idx = m_platform_topo.domain_cpu_list(domain_type, domain_idx);
         for (auto cpu : cpu_idx) {
             MSRControl control = *(nccm_it->second[cpu]);
             uint64_t offset = control.offset();
@@ -417,6 +425,106 @@ namespace geopm
             control.adjust(setting);
             m_msrio->write_msr(cpu, offset, field, mask);
         }
+        // The next write_batch() must restore any active control that
+        // shares an MSR with the one written.
+        std::fill(m_is_dirty.begin(), m_is_dirty.end(), true);
+    }
+
+    void MSRIOGroup::read_signal_batch(const std::vector<IPlatformIO::m_request_s> &request,
+                                       std::vector<double> &result)
+    {
+        std::vector<const MSRSignal *> signal_list(request.size());
+        std::vector<int> cpu_list(request.size());
+        std::vector<uint64_t> offset_list(request.size());
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            const IPlatformIO::m_request_s &req = request[req_idx];
+            auto ncsm_it = m_name_cpu_signal_map.find(req.name);
+            if (ncsm_it == m_name_cpu_signal_map.end()) {
+                throw Exception("MSRIOGroup::read_signal_batch(): signal name \"" +
+                                req.name + "\" not found",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (req.domain_type != signal_domain_type(req.name)) {
+                throw Exception("MSRIOGroup::read_signal_batch(): domain_type requested does not match the domain of the signal.",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (req.domain_idx < 0 || req.domain_idx >= m_platform_topo.num_domain(req.domain_type)) {
+                throw Exception("MSRIOGroup::read_signal_batch(): domain_idx out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            const std::vector<int> &cpu_idx = m_platform_topo.domain_cpu_list(req.domain_type, req.domain_idx);
+            cpu_list[req_idx] = cpu_idx.front();
+            signal_list[req_idx] = ncsm_it->second[cpu_list[req_idx]];
+            offset_list[req_idx] = signal_list[req_idx]->offset();
+        }
+        std::vector<uint64_t> raw_value;
+        m_msrio->read_msr(cpu_list, offset_list, raw_value);
+        result.resize(request.size());
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            // Copy of existing signal but map own memory, as in
+            // read_signal()
+            MSRSignal signal {*(signal_list[req_idx])};
+            uint64_t field = 0;
+            signal.map_field(&field);
+            field = raw_value[req_idx];
+            result[req_idx] = signal.sample();
+        }
+    }
+
+    void MSRIOGroup::write_control_batch(const std::vector<IPlatformIO::m_request_s> &request,
+                                         const std::vector<double> &setting)
+    {
+        if (request.size() != setting.size()) {
+            throw Exception("MSRIOGroup::write_control_batch(): number of settings does not match number of requests",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::vector<int> cpu_list;
+        std::vector<uint64_t> offset_list;
+        std::vector<uint64_t> field_list;
+        std::vector<uint64_t> mask_list;
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            const IPlatformIO::m_request_s &req = request[req_idx];
+            auto nccm_it = m_name_cpu_control_map.find(req.name);
+            if (nccm_it == m_name_cpu_control_map.end()) {
+                throw Exception("MSRIOGroup::write_control_batch(): control name \"" +
+                                req.name + "\" not found",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (req.domain_type != control_domain_type(req.name)) {
+                throw Exception("MSRIOGroup::write_control_batch(): domain_type does not match the domain of the control.",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (req.domain_idx < 0 || req.domain_idx >= m_platform_topo.num_domain(req.domain_type)) {
+                throw Exception("MSRIOGroup::write_control_batch(): domain_idx out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            // Enable bits are written ahead of the alias they belong
+            // to, as in write_control().
+            std::vector<std::pair<const std::vector<MSRControl *> *, double> > control_setting;
+            if (req.name == "POWER_PACKAGE") {
+                control_setting.emplace_back(&m_name_cpu_control_map.at("MSR::PKG_POWER_LIMIT:SOFT_LIMIT_ENABLE"), 1.0);
+            }
+            if (req.name == "FREQUENCY") {
+                control_setting.emplace_back(&m_name_cpu_control_map.at("MSR::PERF_CTL:ENABLE"), 1.0);
+            }
+            control_setting.emplace_back(&(nccm_it->second), setting[req_idx]);
+            const std::vector<int> &cpu_idx = m_platform_topo.domain_cpu_list(req.domain_type, req.domain_idx);
+            for (const auto &cs : control_setting) {
+                for (auto cpu : cpu_idx) {
+                    MSRControl control = *((*cs.first)[cpu]);
+                    uint64_t field = 0;
+                    uint64_t mask = 0;
+                    control.map_field(&field, &mask);
+                    control.adjust(cs.second);
+                    cpu_list.push_back(cpu);
+                    offset_list.push_back(control.offset());
+                    field_list.push_back(field);
+                    mask_list.push_back(mask);
+                }
+            }
+        }
+        m_msrio->write_msr(cpu_list, offset_list, field_list, mask_list);
+        std::fill(m_is_dirty.begin(), m_is_dirty.end(), true);
     }
 
     void MSRIOGroup::save_control(void)
@@ -458,6 +566,7 @@ namespace geopm
             }
             ++cpu_idx;
         }
+        std::fill(m_is_dirty.begin(), m_is_dirty.end(), true);
     }
 
     std::string MSRIOGroup::msr_whitelist(void) const
@@ -541,7 +650,9 @@ namespace geopm
             ++msr_idx;
         }
         msr_idx = 0;
+        m_control_field_idx.clear();
         for (auto control : m_active_control) {
+            m_control_field_idx.push_back(msr_idx);
             for (auto &msr_ctl : control) {
                 uint64_t *field_ptr = &(m_write_field[msr_idx]);
                 uint64_t *mask_ptr = &(m_write_mask[msr_idx]);
@@ -88,6 +88,10 @@ namespace geopm
                                int domain_type,
                                int domain_idx,
                                double setting) override;
+            void read_signal_batch(const std::vector<IPlatformIO::m_request_s> &request,
+                                   std::vector<double> &result) override;
+            void write_control_batch(const std::vector<IPlatformIO::m_request_s> &request,
+                                     const std::vector<double> &setting) override;
             void save_control(void) override;
             void restore_control(void) override;
             /// @brief Fill string with the msr-safe whitelist file contents
@@ -138,6 +142,12 @@ namespace geopm
             std::unique_ptr<IMSRIO> m_msrio;
             int m_cpuid;
             std::vector<bool> m_is_adjusted;
+            /// Whether each active control changed since the last
+            /// write_batch().
+            std::vector<bool> m_is_dirty;
+            /// Index into m_write_field of the first CPU of each
+            /// active control.
+            std::vector<size_t> m_control_field_idx;
             // Mappings from names to all valid signals and controls
             std::map<std::string, const IMSR &> m_name_msr_map;
             std::map<std::string, std::vector<MSRSignal *> > m_name_cpu_signal_map;
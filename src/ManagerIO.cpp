@@ -36,6 +36,7 @@
 #include <string>
 #include <cmath>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "contrib/json11/json11.hpp"
 
@@ -174,9 +175,15 @@ namespace geopm
             throw Exception("ManagerIOSampler::pthread_mutex_lock()", err, __FILE__, __LINE__);
         }
 
-        m_data->is_updated = true;
+        uint64_t generation = m_data->generation;
+        __atomic_store_n(&m_data->generation, generation + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
         m_data->count = m_samples_up.size();
         std::copy(m_samples_up.begin(), m_samples_up.end(), m_data->values);
+        // Readers built before the generation was added wait for
+        // is_updated
+        m_data->is_updated = 1;
+        __atomic_store_n(&m_data->generation, generation + 2, __ATOMIC_RELEASE);
 
         pthread_mutex_unlock(&m_data->lock);
     }
@@ -202,6 +209,7 @@ namespace geopm
         , m_shmem(std::move(shmem))
         , m_data(nullptr)
         , m_is_shm_data(m_path[0] == '/' && m_path.find_last_of('/') == 0)
+        , m_generation(0)
     {
         read_batch();
     }
@@ -276,6 +284,17 @@ namespace geopm
 
         m_data = (struct geopm_manager_shmem_s *) m_shmem->pointer(); // Managed by shmem subsystem.
 
+        if (__atomic_load_n(&m_data->generation, __ATOMIC_ACQUIRE) == 0) {
+            read_shmem_locked();
+        }
+        else if (!read_shmem_seqlock() && m_generation == 0) {
+            throw Exception("ManagerIOSampler::" + std::string(__func__) + "(): unable to read a consistent copy of the shm region.",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    void ManagerIOSampler::read_shmem_locked(void)
+    {
         int err = pthread_mutex_lock(&m_data->lock); // Default mutex will block until this completes.
         if (err) {
             throw Exception("ManagerIOSampler::pthread_mutex_lock()", err, __FILE__, __LINE__);
@@ -297,6 +316,48 @@ namespace geopm
         }
     }
 
+    bool ManagerIOSampler::read_shmem_seqlock(void)
+    {
+        const size_t max_count = sizeof(m_data->values) / sizeof(m_data->values[0]);
+        bool is_consistent = false;
+        uint64_t generation = 0;
+        size_t count = 0;
+        for (int retry = 0; !is_consistent && retry < M_MAX_SEQLOCK_RETRY; ++retry) {
+            generation = __atomic_load_n(&m_data->generation, __ATOMIC_ACQUIRE);
+            if (generation % 2) {
+                // writer is part way through an update
+                continue;
+            }
+            count = std::min(m_data->count, max_count);
+            m_read_buffer.resize(count);
+            std::copy(m_data->values, m_data->values + count, m_read_buffer.begin());
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            is_consistent = generation == __atomic_load_n(&m_data->generation, __ATOMIC_RELAXED);
+        }
+        if (is_consistent) {
+            if (count != m_signal_names.size()) {
+                throw Exception("ManagerIOSampler::" + std::string(__func__) + "(): Data read from shmem does not match size of signal names.",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            m_signals_down.swap(m_read_buffer);
+            m_generation = generation;
+        }
+        return is_consistent;
+    }
+
+    std::vector<uint64_t> ManagerIOSampler::file_state(void) const
+    {
+        std::vector<uint64_t> result;
+        struct stat file_stat;
+        if (!stat(m_path.c_str(), &file_stat)) {
+            result = {(uint64_t)file_stat.st_mtim.tv_sec,
+                      (uint64_t)file_stat.st_mtim.tv_nsec,
+                      (uint64_t)file_stat.st_size,
+                      (uint64_t)file_stat.st_ino};
+        }
+        return result;
+    }
+
     bool ManagerIOSampler::is_valid_signal(const std::string &signal_name) const
     {
         return std::find(m_signal_names.begin(), m_signal_names.end(), signal_name) != m_signal_names.end();
@@ -308,16 +369,38 @@ namespace geopm
             read_shmem();
         }
         else {
-            std::map<std::string, double> signal_value_map = parse_json();
-            m_signals_down.clear();
-            for (auto signal : m_signal_names) {
-                try {
-                    m_signals_down.emplace_back(signal_value_map.at(signal));
+            // Record the state before reading so that an update
+            // made during the read is detected by the next call to
+            // is_update_available().
+            std::vector<uint64_t> state = file_state();
+            std::map<std::string, double> signal_value_map;
+            bool is_parsed = false;
+            try {
+                signal_value_map = parse_json();
+                is_parsed = true;
+            }
+            catch (const Exception &) {
+                // After the first read the file may be caught part
+                // way through an update by the resource manager:
+                // keep the previous values and try again on the next
+                // call.
+                if (m_file_state.empty()) {
+                    throw;
                 }
-                catch (const std::out_of_range&) {
-                    throw Exception("ManagerIOSampler::" + std::string(__func__) + "(): Signal \"" + signal + "\" not found.",
-                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (is_parsed) {
+                std::vector<double> signals_down;
+                for (auto signal : m_signal_names) {
+                    try {
+                        signals_down.emplace_back(signal_value_map.at(signal));
+                    }
+                    catch (const std::out_of_range&) {
+                        throw Exception("ManagerIOSampler::" + std::string(__func__) + "(): Signal \"" + signal + "\" not found.",
+                                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                    }
                 }
+                m_signals_down.swap(signals_down);
+                m_file_state = state;
             }
         }
     }
@@ -341,10 +424,23 @@ namespace geopm
 
     bool ManagerIOSampler::is_update_available(void)
     {
-        if(m_data == nullptr) {
+        bool result = false;
+        if (!m_is_shm_data) {
+            result = file_state() != m_file_state;
+        }
+        else if (m_data == nullptr) {
             throw Exception("ManagerIOSampler::" + std::string(__func__) + "(): m_data is null", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        return m_data->is_updated != 0;
+        else {
+            uint64_t generation = __atomic_load_n(&m_data->generation, __ATOMIC_ACQUIRE);
+            if (generation == 0) {
+                result = m_data->is_updated != 0;
+            }
+            else {
+                result = generation % 2 == 0 && generation != m_generation;
+            }
+        }
+        return result;
     }
 
     std::vector<std::string> ManagerIOSampler::signal_names(void) const
@@ -38,6 +38,7 @@
 #include <vector>
 #include <map>
 #include <cstddef>
+#include <stdint.h>
 #include <pthread.h>
 
 namespace geopm
@@ -52,18 +53,46 @@ namespace geopm
         double values;        // 8 bytes
     };
 
+    /// @brief Layout of the shared memory region used to pass
+    ///        policies and samples between GEOPM and the resource
+    ///        manager.
+    ///
+    /// Writers that update the generation follow the sequence lock
+    /// protocol: while holding the lock they increment the
+    /// generation to an odd value, write count and values, then
+    /// increment the generation to the next even value.  They also
+    /// set is_updated for readers built before the generation was
+    /// added, which take the lock and clear it.  Current readers
+    /// take no lock; they copy the values and retry if the
+    /// generation was odd or changed during the copy, and re-read
+    /// only when the generation differs from the one last read.
+    /// Writers that leave the generation at zero instead set
+    /// is_updated while holding the lock, and the reader takes the
+    /// lock as well.  The generation occupies the last eight bytes
+    /// of the region so that the offsets of the other fields are
+    /// the same as for writers built before it was added, which
+    /// never write it as long as they use fewer than the maximum
+    /// number of values.
     struct geopm_manager_shmem_s {
-        /// @brief Lock to ensure r/w consistency between GEOPM and the resource manager.
+        /// @brief Lock to serialize writers, and readers of writers
+        ///        that do not update the generation.
         pthread_mutex_t lock;
-        /// @brief Enables notification of updates to GEOPM.
+        /// @brief Enables notification of updates to GEOPM
+        ///        readers that do not use the generation.
         uint8_t is_updated;
         /// @brief Specifies the size of the following array.
         size_t count;
         /// @brief Holds resource manager data.
-        double values[(4096 - offsetof(struct geopm_manager_shmem_header, values)) / sizeof(double)];
+        double values[(4096 - offsetof(struct geopm_manager_shmem_header, values) - sizeof(uint64_t)) / sizeof(double)];
+        /// @brief Sequence lock generation, odd while an update is
+        ///        in progress and zero if never used.
+        uint64_t generation;
     };
 
     static_assert(sizeof(struct geopm_manager_shmem_s) == 4096, "Alignment issue with geopm_manager_shmem_s.");
+    static_assert(offsetof(struct geopm_manager_shmem_s, values) ==
+                  offsetof(struct geopm_manager_shmem_header, values),
+                  "Layout of geopm_manager_shmem_s differs from geopm_manager_shmem_header.");
 
     class IManagerIO
     {
@@ -134,7 +163,10 @@ namespace geopm
             /// @return Vector of signal or policy values.
             virtual std::vector<double> sample(void) const = 0;
             /// @brief Indicates whether or not the values have been
-            ///        updated.
+            ///        updated since the last read_batch().  This is
+            ///        cheap enough to call every control step: it
+            ///        compares the shared memory generation or the
+            ///        file modification time with those last read.
             virtual bool is_update_available(void) = 0;
             /// @brief Returns the signal or policy names expected by
             ///        the resource manager.
@@ -162,17 +194,33 @@ namespace geopm
             std::vector<std::string> signal_names(void) const override;
 
         private:
+            enum m_const_e {
+                /// Number of attempts to read a consistent copy of
+                /// the shared memory before giving up.
+                M_MAX_SEQLOCK_RETRY = 4096,
+            };
             bool is_valid_signal(const std::string &signal_name) const;
             std::map<std::string, double> parse_json(void);
             const std::string read_file(void);
             void read_shmem(void);
+            void read_shmem_locked(void);
+            bool read_shmem_seqlock(void);
+            /// @brief Modification time, size and inode of the file
+            ///        at m_path, or empty if it cannot be accessed.
+            std::vector<uint64_t> file_state(void) const;
 
             std::string m_path;
             std::vector<std::string> m_signal_names;
             std::unique_ptr<ISharedMemoryUser> m_shmem;
             struct geopm_manager_shmem_s *m_data;
             std::vector<double> m_signals_down;
+            std::vector<double> m_read_buffer;
             const bool m_is_shm_data;
+            /// Generation of the shared memory when last read, zero
+            /// before the first read.
+            uint64_t m_generation;
+            /// Result of file_state() when the file was last read.
+            std::vector<uint64_t> m_file_state;
     };
 }
 
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "MatrixReduce.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    MatrixReduce::MatrixReduce()
+    {
+
+    }
+
+    void MatrixReduce::resize(size_t num_col)
+    {
+        size_t lane_size = M_NUM_LANE * num_col;
+        m_lane_sum.resize(lane_size);
+        m_lane_sum_sq.resize(lane_size);
+        m_lane_min.resize(lane_size);
+        m_lane_max.resize(lane_size);
+        m_lane_num_zero.resize(lane_size);
+        m_sum.resize(num_col);
+        m_sum_sq.resize(num_col);
+        m_min.resize(num_col);
+        m_max.resize(num_col);
+        m_num_zero.resize(num_col);
+    }
+
+    void MatrixReduce::reduce(MatrixView<const double> matrix)
+    {
+        m_matrix = matrix;
+        size_t num_row = matrix.num_row();
+        size_t num_col = matrix.num_col();
+        resize(num_col);
+        std::fill(m_lane_sum.begin(), m_lane_sum.end(), 0.0);
+        std::fill(m_lane_sum_sq.begin(), m_lane_sum_sq.end(), 0.0);
+        std::fill(m_lane_min.begin(), m_lane_min.end(), std::numeric_limits<double>::infinity());
+        std::fill(m_lane_max.begin(), m_lane_max.end(), -std::numeric_limits<double>::infinity());
+        std::fill(m_lane_num_zero.begin(), m_lane_num_zero.end(), 0.0);
+        double *lane_sum = m_lane_sum.data();
+        double *lane_sum_sq = m_lane_sum_sq.data();
+        double *lane_min = m_lane_min.data();
+        double *lane_max = m_lane_max.data();
+        double *lane_num_zero = m_lane_num_zero.data();
+
+        size_t row_idx = 0;
+        if (matrix.stride() == num_col) {
+            // Rows are packed: each block of M_NUM_LANE rows is a
+            // contiguous array that maps element for element onto
+            // the lane accumulators.
+            size_t block_size = M_NUM_LANE * num_col;
+            for (; row_idx + M_NUM_LANE <= num_row; row_idx += M_NUM_LANE) {
+                const double *block = matrix.row(row_idx);
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                for (size_t elem_idx = 0; elem_idx < block_size; ++elem_idx) {
+                    double val = block[elem_idx];
+                    lane_sum[elem_idx] += val;
+                    lane_sum_sq[elem_idx] += val * val;
+                    lane_min[elem_idx] = val < lane_min[elem_idx] ? val : lane_min[elem_idx];
+                    lane_max[elem_idx] = val > lane_max[elem_idx] ? val : lane_max[elem_idx];
+                    lane_num_zero[elem_idx] += (val == 0.0) ? 1.0 : 0.0;
+                }
+            }
+        }
+        for (; row_idx < num_row; ++row_idx) {
+            const double *row = matrix.row(row_idx);
+            size_t lane_off = (row_idx % M_NUM_LANE) * num_col;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (size_t col_idx = 0; col_idx < num_col; ++col_idx) {
+                double val = row[col_idx];
+                size_t elem_idx = lane_off + col_idx;
+                lane_sum[elem_idx] += val;
+                lane_sum_sq[elem_idx] += val * val;
+                lane_min[elem_idx] = val < lane_min[elem_idx] ? val : lane_min[elem_idx];
+                lane_max[elem_idx] = val > lane_max[elem_idx] ? val : lane_max[elem_idx];
+                lane_num_zero[elem_idx] += (val == 0.0) ? 1.0 : 0.0;
+            }
+        }
+        // Combine the lanes
+        for (size_t col_idx = 0; col_idx < num_col; ++col_idx) {
+            m_sum[col_idx] = 0.0;
+            m_sum_sq[col_idx] = 0.0;
+            m_min[col_idx] = std::numeric_limits<double>::infinity();
+            m_max[col_idx] = -std::numeric_limits<double>::infinity();
+            m_num_zero[col_idx] = 0.0;
+            for (size_t lane_idx = 0; lane_idx < M_NUM_LANE; ++lane_idx) {
+                size_t elem_idx = lane_idx * num_col + col_idx;
+                m_sum[col_idx] += lane_sum[elem_idx];
+                m_sum_sq[col_idx] += lane_sum_sq[elem_idx];
+                m_min[col_idx] = std::min(m_min[col_idx], lane_min[elem_idx]);
+                m_max[col_idx] = std::max(m_max[col_idx], lane_max[elem_idx]);
+                m_num_zero[col_idx] += lane_num_zero[elem_idx];
+            }
+        }
+    }
+
+    void MatrixReduce::reduce(MatrixView<const double> matrix,
+                              const std::vector<int> &reduce_type,
+                              std::vector<double> &result)
+    {
+        if (reduce_type.size() != matrix.num_col()) {
+            throw Exception("MatrixReduce::reduce(): number of aggregation types does not match number of columns.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        reduce(matrix);
+        result.resize(matrix.num_col());
+        for (size_t col_idx = 0; col_idx < matrix.num_col(); ++col_idx) {
+            result[col_idx] = value(reduce_type[col_idx], col_idx);
+        }
+    }
+
+    size_t MatrixReduce::num_row(void) const
+    {
+        return m_matrix.num_row();
+    }
+
+    size_t MatrixReduce::num_col(void) const
+    {
+        return m_matrix.num_col();
+    }
+
+    double MatrixReduce::sum(size_t col_idx) const
+    {
+        double result = NAN;
+        if (num_row()) {
+            result = m_sum[col_idx];
+        }
+        return result;
+    }
+
+    double MatrixReduce::average(size_t col_idx) const
+    {
+        double result = NAN;
+        if (num_row()) {
+            result = m_sum[col_idx] / num_row();
+        }
+        return result;
+    }
+
+    double MatrixReduce::min(size_t col_idx) const
+    {
+        double result = NAN;
+        if (num_row()) {
+            result = m_min[col_idx];
+        }
+        return result;
+    }
+
+    double MatrixReduce::max(size_t col_idx) const
+    {
+        double result = NAN;
+        if (num_row()) {
+            result = m_max[col_idx];
+        }
+        return result;
+    }
+
+    double MatrixReduce::stddev(size_t col_idx) const
+    {
+        double result = NAN;
+        size_t num_op = num_row();
+        if (num_op > 1) {
+            double aa = 1.0 / (num_op - 1);
+            double bb = aa / num_op;
+            result = std::sqrt(aa * m_sum_sq[col_idx] - bb * m_sum[col_idx] * m_sum[col_idx]);
+        }
+        else if (num_op == 1) {
+            result = 0.0;
+        }
+        return result;
+    }
+
+    double MatrixReduce::logical_and(size_t col_idx) const
+    {
+        double result = NAN;
+        if (num_row()) {
+            result = (m_num_zero[col_idx] == 0.0);
+        }
+        return result;
+    }
+
+    double MatrixReduce::logical_or(size_t col_idx) const
+    {
+        double result = NAN;
+        if (num_row()) {
+            result = (m_num_zero[col_idx] < num_row());
+        }
+        return result;
+    }
+
+    double MatrixReduce::median(size_t col_idx)
+    {
+        double result = NAN;
+        size_t num_op = num_row();
+        if (num_op) {
+            m_column.resize(num_op);
+            for (size_t row_idx = 0; row_idx < num_op; ++row_idx) {
+                m_column[row_idx] = m_matrix(row_idx, col_idx);
+            }
+            size_t mid_idx = num_op / 2;
+            std::nth_element(m_column.begin(), m_column.begin() + mid_idx, m_column.end());
+            result = m_column[mid_idx];
+            if ((num_op % 2) == 0) {
+                // Elements before mid_idx are not greater than the
+                // nth element, the largest of them is the lower median.
+                result += *std::max_element(m_column.begin(), m_column.begin() + mid_idx);
+                result /= 2.0;
+            }
+        }
+        return result;
+    }
+
+    double MatrixReduce::value(int reduce_type, size_t col_idx)
+    {
+        double result = NAN;
+        switch (reduce_type) {
+            case M_REDUCE_SUM:
+                result = sum(col_idx);
+                break;
+            case M_REDUCE_AVERAGE:
+                result = average(col_idx);
+                break;
+            case M_REDUCE_MEDIAN:
+                result = median(col_idx);
+                break;
+            case M_REDUCE_AND:
+                result = logical_and(col_idx);
+                break;
+            case M_REDUCE_OR:
+                result = logical_or(col_idx);
+                break;
+            case M_REDUCE_MIN:
+                result = min(col_idx);
+                break;
+            case M_REDUCE_MAX:
+                result = max(col_idx);
+                break;
+            case M_REDUCE_STDDEV:
+                result = stddev(col_idx);
+                break;
+            default:
+                throw Exception("MatrixReduce::value(): invalid aggregation type",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MATRIXREDUCE_HPP_INCLUDE
+#define MATRIXREDUCE_HPP_INCLUDE
+
+#include <vector>
+
+#include "MatrixView.hpp"
+
+namespace geopm
+{
+    /// @brief Column wise reductions over a child by signal matrix.
+    ///
+    /// A single call to reduce() computes the sum, sum of squares,
+    /// minimum, maximum and number of zero values for every column
+    /// of the matrix in one pass over the rows.  Blocks of rows that
+    /// are stored contiguously are accumulated into independent
+    /// lanes so that the inner loop runs over unit stride memory and
+    /// can be vectorized.  The statistics that are equivalent to the
+    /// IPlatformIO::agg_*() functions applied to a column are then
+    /// available through the accessors without further passes over
+    /// the data.  The median is the only statistic that requires the
+    /// column to be gathered, and this is done only on request into
+    /// storage that is reused between calls.
+    class MatrixReduce
+    {
+        public:
+            /// @brief Aggregation types, each is equivalent to the
+            ///        IPlatformIO::agg_*() function of the same name.
+            enum m_reduce_e {
+                M_REDUCE_SUM,
+                M_REDUCE_AVERAGE,
+                M_REDUCE_MEDIAN,
+                M_REDUCE_AND,
+                M_REDUCE_OR,
+                M_REDUCE_MIN,
+                M_REDUCE_MAX,
+                M_REDUCE_STDDEV,
+                M_NUM_REDUCE,
+            };
+            MatrixReduce();
+            virtual ~MatrixReduce() = default;
+            /// @brief Compute the statistics for every column of the
+            ///        matrix.  The matrix must remain valid until
+            ///        the next call to reduce() if median() is used.
+            /// @param [in] matrix Child by signal matrix to reduce.
+            void reduce(MatrixView<const double> matrix);
+            /// @brief Number of rows in the last reduced matrix.
+            size_t num_row(void) const;
+            /// @brief Number of columns in the last reduced matrix.
+            size_t num_col(void) const;
+            /// @brief Sum of the values in a column.
+            double sum(size_t col_idx) const;
+            /// @brief Arithmetic mean of the values in a column.
+            double average(size_t col_idx) const;
+            /// @brief Minimum of the values in a column.
+            double min(size_t col_idx) const;
+            /// @brief Maximum of the values in a column.
+            double max(size_t col_idx) const;
+            /// @brief Sample standard deviation of the values in a
+            ///        column.
+            double stddev(size_t col_idx) const;
+            /// @brief 1.0 if all values in a column are non-zero,
+            ///        0.0 otherwise.
+            double logical_and(size_t col_idx) const;
+            /// @brief 1.0 if any value in a column is non-zero,
+            ///        0.0 otherwise.
+            double logical_or(size_t col_idx) const;
+            /// @brief Median of the values in a column.
+            double median(size_t col_idx);
+            /// @brief Value of a column reduced with the given
+            ///        aggregation type.
+            /// @param [in] reduce_type One of the m_reduce_e values.
+            /// @param [in] col_idx Column of the matrix.
+            double value(int reduce_type, size_t col_idx);
+            /// @brief Reduce every column of the matrix with the
+            ///        aggregation type at the same index.
+            /// @param [in] matrix Child by signal matrix to reduce.
+            /// @param [in] reduce_type Vector of m_reduce_e values,
+            ///        one for each column.
+            /// @param [out] result Vector of reduced values, one
+            ///        for each column.
+            void reduce(MatrixView<const double> matrix,
+                        const std::vector<int> &reduce_type,
+                        std::vector<double> &result);
+        private:
+            enum m_matrix_reduce_const_e {
+                /// Number of rows accumulated in independent lanes.
+                M_NUM_LANE = 8,
+            };
+            void resize(size_t num_col);
+            MatrixView<const double> m_matrix;
+            std::vector<double> m_lane_sum;
+            std::vector<double> m_lane_sum_sq;
+            std::vector<double> m_lane_min;
+            std::vector<double> m_lane_max;
+            std::vector<double> m_lane_num_zero;
+            std::vector<double> m_sum;
+            std::vector<double> m_sum_sq;
+            std::vector<double> m_min;
+            std::vector<double> m_max;
+            std::vector<double> m_num_zero;
+            std::vector<double> m_column;
+    };
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MATRIXVIEW_HPP_INCLUDE
+#define MATRIXVIEW_HPP_INCLUDE
+
+#include <stddef.h>
+
+namespace geopm
+{
+    /// @brief Non-owning view of a row major matrix stored in
+    ///        contiguous memory.
+    ///
+    /// The MatrixView is used to pass per-child policies and samples
+    /// between the Kontroller, the TreeComm and the Agents without
+    /// allocating a vector for each child.  Rows are separated by a
+    /// fixed stride which may be larger than the number of columns
+    /// to allow the view to skip over per-row header values.
+    template <class type>
+    class MatrixView
+    {
+        public:
+            /// @brief Construct an empty view with no rows.
+            MatrixView()
+                : MatrixView(nullptr, 0, 0, 0)
+            {
+
+            }
+            /// @brief Construct a view over densely packed rows.
+            ///
+            /// @param [in] data Pointer to the first element of the
+            ///        first row.
+            ///
+            /// @param [in] num_row Number of rows in the matrix.
+            ///
+            /// @param [in] num_col Number of columns in each row.
+            MatrixView(type *data, size_t num_row, size_t num_col)
+                : MatrixView(data, num_row, num_col, num_col)
+            {
+
+            }
+            /// @brief Construct a view over rows separated by a
+            ///        stride.
+            ///
+            /// @param [in] data Pointer to the first element of the
+            ///        first row.
+            ///
+            /// @param [in] num_row Number of rows in the matrix.
+            ///
+            /// @param [in] num_col Number of columns in each row.
+            ///
+            /// @param [in] stride Number of elements between the
+            ///        start of consecutive rows.
+            MatrixView(type *data, size_t num_row, size_t num_col, size_t stride)
+                : m_data(data)
+                , m_num_row(num_row)
+                , m_num_col(num_col)
+                , m_stride(stride)
+            {
+
+            }
+            /// @brief Implicit conversion to a read only view.
+            operator MatrixView<const type>() const
+            {
+                return MatrixView<const type>(m_data, m_num_row, m_num_col, m_stride);
+            }
+            /// @brief Number of rows in the matrix.
+            size_t num_row(void) const
+            {
+                return m_num_row;
+            }
+            /// @brief Number of columns in each row of the matrix.
+            size_t num_col(void) const
+            {
+                return m_num_col;
+            }
+            /// @brief Number of elements between the start of
+            ///        consecutive rows.
+            size_t stride(void) const
+            {
+                return m_stride;
+            }
+            /// @brief Pointer to the first element of a row.
+            type *row(size_t row_idx) const
+            {
+                return m_data + row_idx * m_stride;
+            }
+            /// @brief Reference to a single element of the matrix.
+            type &operator()(size_t row_idx, size_t col_idx) const
+            {
+                return m_data[row_idx * m_stride + col_idx];
+            }
+        private:
+            type *m_data;
+            size_t m_num_row;
+            size_t m_num_col;
+            size_t m_stride;
+    };
+}
+
+#endif
@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+#include "PerfEventIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "geopm_env.h"
+#include "config.h"
+
+#define GEOPM_PERF_EVENT_IO_GROUP_PLUGIN_NAME "PERF_EVENT"
+
+namespace geopm
+{
+    PerfEventIOGroup::PerfEventIOGroup()
+        : PerfEventIOGroup(platform_topo(), -1, env_task_pid())
+    {
+
+    }
+
+    PerfEventIOGroup::PerfEventIOGroup(IPlatformTopo &topo, int pid)
+        : PerfEventIOGroup(topo, pid, {})
+    {
+
+    }
+
+    PerfEventIOGroup::PerfEventIOGroup(IPlatformTopo &topo, const std::vector<int> &task_pid)
+        : PerfEventIOGroup(topo, -1, !task_pid.empty() ? task_pid :
+                           throw Exception("PerfEventIOGroup: no process to count",
+                                           GEOPM_ERROR_INVALID, __FILE__, __LINE__))
+    {
+
+    }
+
+    PerfEventIOGroup::PerfEventIOGroup(IPlatformTopo &topo, int pid, const std::vector<int> &task_pid)
+        : m_event_info(event_info())
+        , m_pid(pid)
+        , m_task_pid(task_pid)
+        , m_domain_type(task_pid.empty() ? IPlatformTopo::M_DOMAIN_CPU : IPlatformTopo::M_DOMAIN_BOARD)
+        // There is one board
+        , m_num_domain(task_pid.empty() ? topo.num_domain(IPlatformTopo::M_DOMAIN_CPU) : 1)
+        , m_exclude_kernel(false)
+        , m_is_active(false)
+        , m_is_read(false)
+    {
+        // Probe each event on the first CPU or task and only expose
+        // the events that the kernel, the PMU and the caller's
+        // privileges allow.
+        int probe_pid = m_task_pid.empty() ? m_pid : m_task_pid[0];
+        int probe_cpu = m_task_pid.empty() ? 0 : -1;
+        int err = 0;
+        for (int event_idx = 0; event_idx < (int)m_event_info.size(); ++event_idx) {
+            int fd = open_event(event_idx, probe_pid, probe_cpu, -1);
+            if (fd == -1 && !m_exclude_kernel &&
+                (errno == EACCES || errno == EPERM)) {
+                // perf_event_paranoid may restrict counting to user
+                // space; this only helps when monitoring a process
+                m_exclude_kernel = true;
+                fd = open_event(event_idx, probe_pid, probe_cpu, -1);
+            }
+            if (fd == -1) {
+                err = errno;
+            }
+            else {
+                (void)close(fd);
+                m_signal_event_idx[plugin_name() + "::" + m_event_info[event_idx].name] = event_idx;
+            }
+        }
+        if (m_signal_event_idx.empty()) {
+            std::string message = "PerfEventIOGroup: unable to open any event with perf_event_open(): " +
+                                  std::string(strerror(err));
+            if (m_pid == -1 && m_task_pid.empty() && (err == EACCES || err == EPERM)) {
+                message += "; counting all tasks on a CPU requires /proc/sys/kernel/perf_event_paranoid "
+                           "to be 0 or less, or the CAP_PERFMON or CAP_SYS_ADMIN capability, "
+                           "otherwise list the processes to count in GEOPM_PERF_EVENT_PID";
+            }
+#ifdef GEOPM_DEBUG
+            std::cerr << "Warning: <geopm> " << message << ".  The "
+                      << plugin_name() << " IOGroup is not loaded." << std::endl;
+#endif
+            throw Exception(message, GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    PerfEventIOGroup::~PerfEventIOGroup()
+    {
+        for (auto &group : m_group) {
+            // Close members before the leader
+            for (auto fd_it = group.file_desc.rbegin(); fd_it != group.file_desc.rend(); ++fd_it) {
+                (void)close(*fd_it);
+            }
+        }
+        for (auto &it : m_read_file_desc) {
+            for (int fd : it.second) {
+                (void)close(fd);
+            }
+        }
+    }
+
+    const std::vector<PerfEventIOGroup::m_event_s> &PerfEventIOGroup::event_info(void)
+    {
+        static const std::vector<m_event_s> instance {
+            {"CYCLES", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 1.0},
+            {"REF_CYCLES", PERF_TYPE_HARDWARE, PERF_COUNT_HW_REF_CPU_CYCLES, 1.0},
+            {"INSTRUCTIONS", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 1.0},
+            {"LLC_REFERENCES", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES, 1.0},
+            {"LLC_MISSES", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, 1.0},
+            // Last level cache misses split by operation are a proxy
+            // for the memory read and write bandwidth of the CPU.
+            {"LLC_LOAD_MISSES", PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_LL |
+             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), 1.0},
+            {"LLC_STORE_MISSES", PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_LL |
+             (PERF_COUNT_HW_CACHE_OP_WRITE << 8) |
+             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), 1.0},
+            // Reported in seconds
+            {"TASK_CLOCK", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, 1e-9},
+            {"CONTEXT_SWITCHES", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, 1.0},
+            {"PAGE_FAULTS", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, 1.0},
+        };
+        return instance;
+    }
+
+    std::vector<int> PerfEventIOGroup::env_task_pid(void)
+    {
+        std::vector<int> result;
+        std::istringstream pid_list(geopm_env_perf_event_pid());
+        std::string pid_str;
+        while (std::getline(pid_list, pid_str, ',')) {
+            if (pid_str.empty()) {
+                continue;
+            }
+            size_t end = 0;
+            int pid = -1;
+            try {
+                pid = std::stoi(pid_str, &end);
+            }
+            catch (const std::exception &) {
+                end = 0;
+            }
+            if (end != pid_str.size() || pid <= 0) {
+                throw Exception("PerfEventIOGroup: invalid process id in GEOPM_PERF_EVENT_PID: " + pid_str,
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            result.push_back(pid);
+        }
+        return result;
+    }
+
+    std::vector<int> PerfEventIOGroup::task_tid(int pid)
+    {
+        std::vector<int> result;
+        std::string task_path = "/proc/" + std::to_string(pid) + "/task";
+        DIR *did = opendir(task_path.c_str());
+        if (!did) {
+            throw Exception("PerfEventIOGroup: unable to open " + task_path,
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        struct dirent *entry;
+        while ((entry = readdir(did))) {
+            if (entry->d_name[0] != '.') {
+                result.push_back(atoi(entry->d_name));
+            }
+        }
+        closedir(did);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::set<std::string> PerfEventIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_signal_event_idx) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> PerfEventIOGroup::control_names(void) const
+    {
+        return {};
+    }
+
+    bool PerfEventIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_event_idx.find(signal_name) != m_signal_event_idx.end();
+    }
+
+    bool PerfEventIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return false;
+    }
+
+    int PerfEventIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = PlatformTopo::M_DOMAIN_INVALID;
+        if (is_valid_signal(signal_name)) {
+            result = m_domain_type;
+        }
+        return result;
+    }
+
+    int PerfEventIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        return PlatformTopo::M_DOMAIN_INVALID;
+    }
+
+    int PerfEventIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        int event_idx = event_index("push_signal", signal_name);
+        check_domain("push_signal", domain_type, domain_idx);
+        if (m_is_active) {
+            throw Exception("PerfEventIOGroup::push_signal(): cannot push signal after call to read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::pair<int, int> signal(event_idx, domain_idx);
+        auto it = std::find(m_active_signal.begin(), m_active_signal.end(), signal);
+        int result = it - m_active_signal.begin();
+        if (it == m_active_signal.end()) {
+            m_active_signal.push_back(signal);
+        }
+        return result;
+    }
+
+    int PerfEventIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        throw Exception("PerfEventIOGroup::push_control(): there are no controls supported by the PerfEventIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    std::vector<std::pair<int, int> > PerfEventIOGroup::target(int domain_idx) const
+    {
+        std::vector<std::pair<int, int> > result;
+        if (m_task_pid.empty()) {
+            result.emplace_back(m_pid, domain_idx);
+        }
+        else {
+            for (int pid : m_task_pid) {
+                for (int tid : task_tid(pid)) {
+                    result.emplace_back(tid, -1);
+                }
+            }
+        }
+        return result;
+    }
+
+    void PerfEventIOGroup::activate(void)
+    {
+        std::map<int, std::vector<int> > domain_signal_idx;
+        for (int signal_idx = 0; signal_idx < (int)m_active_signal.size(); ++signal_idx) {
+            domain_signal_idx[m_active_signal[signal_idx].second].push_back(signal_idx);
+        }
+        for (const auto &domain_it : domain_signal_idx) {
+            for (const auto &target_it : target(domain_it.first)) {
+                m_group_s group {target_it.first, target_it.second, {}, {}, domain_it.second};
+                for (int signal_idx : group.signal_idx) {
+                    group.event_idx.push_back(m_active_signal[signal_idx].first);
+                }
+                for (int event_idx : group.event_idx) {
+                    int leader_fd = group.file_desc.empty() ? -1 : group.file_desc[0];
+                    int fd = open_event(event_idx, group.pid, group.cpu_idx, leader_fd);
+                    if (fd == -1 && errno == ESRCH && !m_task_pid.empty()) {
+                        // The thread exited after it was listed
+                        break;
+                    }
+                    if (fd == -1) {
+                        std::string target_name = m_task_pid.empty() ?
+                                                  "CPU " + std::to_string(group.cpu_idx) :
+                                                  "task " + std::to_string(group.pid);
+                        int err = errno;
+                        for (int open_fd : group.file_desc) {
+                            (void)close(open_fd);
+                        }
+                        throw Exception("PerfEventIOGroup::read_batch(): unable to open " +
+                                        m_event_info[event_idx].name + " for " + target_name +
+                                        ": " + strerror(err),
+                                        err ? err : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                    }
+                    group.file_desc.push_back(fd);
+                }
+                if (group.file_desc.size() == group.event_idx.size()) {
+                    m_group.push_back(group);
+                }
+                else {
+                    for (int open_fd : group.file_desc) {
+                        (void)close(open_fd);
+                    }
+                }
+            }
+        }
+        m_signal_value.resize(m_active_signal.size(), 0.0);
+        m_is_active = true;
+    }
+
+    void PerfEventIOGroup::read_batch(void)
+    {
+        if (!m_is_active) {
+            activate();
+        }
+        // Signals counted per task are the sum over the groups of
+        // all threads
+        std::fill(m_signal_value.begin(), m_signal_value.end(), 0.0);
+        std::vector<double> value;
+        for (const auto &group : m_group) {
+            read_group(group.file_desc[0], group.file_desc.size(), value);
+            for (size_t member_idx = 0; member_idx < value.size(); ++member_idx) {
+                m_signal_value[group.signal_idx[member_idx]] +=
+                    value[member_idx] * m_event_info[group.event_idx[member_idx]].scalar;
+            }
+        }
+        m_is_read = true;
+    }
+
+    void PerfEventIOGroup::write_batch(void)
+    {
+
+    }
+
+    double PerfEventIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_active_signal.size()) {
+            throw Exception("PerfEventIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!m_is_read) {
+            throw Exception("PerfEventIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_signal_value[batch_idx];
+    }
+
+    void PerfEventIOGroup::adjust(int batch_idx, double setting)
+    {
+        throw Exception("PerfEventIOGroup::adjust(): there are no controls supported by the PerfEventIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    double PerfEventIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        int event_idx = event_index("read_signal", signal_name);
+        check_domain("read_signal", domain_type, domain_idx);
+        // The counter is opened on first use and kept open so that
+        // later calls report the total since the first call.
+        auto key = std::make_pair(event_idx, domain_idx);
+        auto it = m_read_file_desc.find(key);
+        if (it == m_read_file_desc.end()) {
+            std::vector<int> file_desc;
+            for (const auto &target_it : target(domain_idx)) {
+                int fd = open_event(event_idx, target_it.first, target_it.second, -1);
+                if (fd == -1 && errno == ESRCH && !m_task_pid.empty()) {
+                    // The thread exited after it was listed
+                    continue;
+                }
+                if (fd == -1) {
+                    std::string target_name = m_task_pid.empty() ?
+                                              "CPU " + std::to_string(domain_idx) :
+                                              "task " + std::to_string(target_it.first);
+                    int err = errno;
+                    for (int open_fd : file_desc) {
+                        (void)close(open_fd);
+                    }
+                    throw Exception("PerfEventIOGroup::read_signal(): unable to open " +
+                                    signal_name + " for " + target_name + ": " + strerror(err),
+                                    err ? err : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+                file_desc.push_back(fd);
+            }
+            it = m_read_file_desc.emplace(key, file_desc).first;
+        }
+        double result = 0.0;
+        std::vector<double> value;
+        for (int fd : it->second) {
+            read_group(fd, 1, value);
+            result += value[0];
+        }
+        return result * m_event_info[event_idx].scalar;
+    }
+
+    void PerfEventIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        throw Exception("PerfEventIOGroup::write_control(): there are no controls supported by the PerfEventIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    void PerfEventIOGroup::save_control(void)
+    {
+
+    }
+
+    void PerfEventIOGroup::restore_control(void)
+    {
+
+    }
+
+    std::string PerfEventIOGroup::plugin_name(void)
+    {
+        return GEOPM_PERF_EVENT_IO_GROUP_PLUGIN_NAME;
+    }
+
+    std::unique_ptr<IOGroup> PerfEventIOGroup::make_plugin(void)
+    {
+        return std::unique_ptr<IOGroup>(new PerfEventIOGroup);
+    }
+
+    void PerfEventIOGroup::check_domain(const std::string &func_name, int domain_type, int domain_idx) const
+    {
+        if (domain_type != m_domain_type) {
+            throw Exception("PerfEventIOGroup::" + func_name + "(): domain_type must be " +
+                            (m_task_pid.empty() ? "M_DOMAIN_CPU" : "M_DOMAIN_BOARD"),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= m_num_domain) {
+            throw Exception("PerfEventIOGroup::" + func_name + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    int PerfEventIOGroup::event_index(const std::string &func_name, const std::string &signal_name) const
+    {
+        auto it = m_signal_event_idx.find(signal_name);
+        if (it == m_signal_event_idx.end()) {
+            throw Exception("PerfEventIOGroup::" + func_name + "(): signal_name " + signal_name +
+                            " not valid for PerfEventIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second;
+    }
+
+    int PerfEventIOGroup::open_event(int event_idx, int pid, int cpu_idx, int group_fd) const
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = m_event_info[event_idx].type;
+        attr.config = m_event_info[event_idx].config;
+        attr.read_format = PERF_FORMAT_GROUP |
+                           PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_kernel = m_exclude_kernel;
+        attr.exclude_hv = 1;
+        unsigned long flags = 0;
+#ifdef PERF_FLAG_FD_CLOEXEC
+        flags |= PERF_FLAG_FD_CLOEXEC;
+#endif
+        return syscall(__NR_perf_event_open, &attr, pid, cpu_idx, group_fd, flags);
+    }
+
+    void PerfEventIOGroup::read_group(int leader_fd, size_t num_event, std::vector<double> &value)
+    {
+        // Layout with PERF_FORMAT_GROUP and both time fields:
+        // nr, time_enabled, time_running, value[nr]
+        enum {
+            M_NUM_EVENT,
+            M_TIME_ENABLED,
+            M_TIME_RUNNING,
+            M_VALUE_BEGIN,
+        };
+        m_read_buffer.resize(M_VALUE_BEGIN + num_event);
+        ssize_t num_byte = m_read_buffer.size() * sizeof(uint64_t);
+        if (read(leader_fd, m_read_buffer.data(), num_byte) != num_byte ||
+            m_read_buffer[M_NUM_EVENT] != num_event) {
+            throw Exception("PerfEventIOGroup: read() of event group failed",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        // Scale up counts when the PMU was time multiplexed between
+        // more events than it has counters.
+        double scale = 1.0;
+        uint64_t time_enabled = m_read_buffer[M_TIME_ENABLED];
+        uint64_t time_running = m_read_buffer[M_TIME_RUNNING];
+        if (time_running != 0 && time_running < time_enabled) {
+            scale = (double)time_enabled / time_running;
+        }
+        value.resize(num_event);
+        for (size_t event_idx = 0; event_idx < num_event; ++event_idx) {
+            value[event_idx] = m_read_buffer[M_VALUE_BEGIN + event_idx] * scale;
+        }
+    }
+}
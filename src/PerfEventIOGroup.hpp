@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PERFEVENTIOGROUP_HPP_INCLUDE
+#define PERFEVENTIOGROUP_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "IOGroup.hpp"
+
+namespace geopm
+{
+    class IPlatformTopo;
+
+    /// @brief IOGroup that provides hardware and software event
+    ///        counters through the Linux perf_event_open(2)
+    ///        interface.
+    ///
+    /// Only events that can be opened at construction time are
+    /// exposed as signals.  All events pushed for one CPU or task
+    /// are opened as a single event group on the first call to
+    /// read_batch() so that each group is sampled with one read(2)
+    /// of the group leader, and all counters in the group are
+    /// scheduled together.  Counter values are scaled for time
+    /// multiplexed sharing of the PMU and are reported as totals
+    /// since the group was opened.
+    ///
+    /// By default the plugin counts every task running on each CPU
+    /// and provides signals in the CPU domain.  The kernel only
+    /// allows that when /proc/sys/kernel/perf_event_paranoid is 0 or
+    /// less, or when the process has CAP_PERFMON or CAP_SYS_ADMIN,
+    /// and this applies to the software events as well as the
+    /// hardware events.  Without that privilege no event can be
+    /// opened, the constructor throws and PlatformIO does not load
+    /// the group.
+    ///
+    /// When GEOPM_PERF_EVENT_PID is set to a comma separated list of
+    /// process ids, the plugin instead counts the threads of those
+    /// processes on any CPU and provides signals in the board domain
+    /// that are summed over all of the threads.  An unprivileged user
+    /// may count their own processes this way at the default
+    /// perf_event_paranoid level of 2, in which case only user space
+    /// is counted.  The threads are listed when the events are
+    /// opened; threads created after that are not counted.
+    class PerfEventIOGroup : public IOGroup
+    {
+        public:
+            /// @brief Count events from the processes listed in
+            ///        GEOPM_PERF_EVENT_PID if it is set, otherwise
+            ///        from all tasks running on each CPU of the
+            ///        platform.
+            PerfEventIOGroup();
+            /// @brief Constructor used for testing.
+            /// @param [in] topo Platform topology that provides the
+            ///        number of CPUs.
+            /// @param [in] pid Process to monitor as passed to
+            ///        perf_event_open(2): -1 for all tasks on each
+            ///        CPU, 0 for the calling process.
+            PerfEventIOGroup(IPlatformTopo &topo, int pid);
+            /// @brief Constructor used for testing.
+            /// @param [in] topo Platform topology.
+            /// @param [in] task_pid Processes whose threads are
+            ///        counted on any CPU.
+            PerfEventIOGroup(IPlatformTopo &topo, const std::vector<int> &task_pid);
+            virtual ~PerfEventIOGroup();
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            static std::string plugin_name(void);
+            static std::unique_ptr<IOGroup> make_plugin(void);
+        private:
+            struct m_event_s {
+                std::string name;
+                uint32_t type;
+                uint64_t config;
+                double scalar;
+            };
+            /// @brief Events from one CPU or one task opened as a
+            ///        group.
+            struct m_group_s {
+                int pid;
+                int cpu_idx;
+                std::vector<int> file_desc;
+                /// Index into m_event_info for each group member.
+                std::vector<int> event_idx;
+                /// Index into m_signal_value for each group member.
+                std::vector<int> signal_idx;
+            };
+            PerfEventIOGroup(IPlatformTopo &topo, int pid, const std::vector<int> &task_pid);
+            void activate(void);
+            /// @brief The (pid, cpu) pairs passed to
+            ///        perf_event_open(2) to count a signal in the
+            ///        given domain.
+            std::vector<std::pair<int, int> > target(int domain_idx) const;
+            void check_domain(const std::string &func_name, int domain_type, int domain_idx) const;
+            int event_index(const std::string &func_name, const std::string &signal_name) const;
+            int open_event(int event_idx, int pid, int cpu_idx, int group_fd) const;
+            void read_group(int leader_fd, size_t num_event, std::vector<double> &value);
+            static const std::vector<m_event_s> &event_info(void);
+            static std::vector<int> env_task_pid(void);
+            static std::vector<int> task_tid(int pid);
+
+            const std::vector<m_event_s> &m_event_info;
+            const int m_pid;
+            /// Processes counted on any CPU; empty when counting
+            /// per CPU.
+            const std::vector<int> m_task_pid;
+            const int m_domain_type;
+            const int m_num_domain;
+            bool m_exclude_kernel;
+            bool m_is_active;
+            bool m_is_read;
+            std::map<std::string, int> m_signal_event_idx;
+            /// Pushed signals as (event index, cpu index).
+            std::vector<std::pair<int, int> > m_active_signal;
+            std::vector<double> m_signal_value;
+            std::vector<m_group_s> m_group;
+            /// Events opened by read_signal() keyed on (event,
+            /// domain index).
+            std::map<std::pair<int, int>, std::vector<int> > m_read_file_desc;
+            std::vector<uint64_t> m_read_buffer;
+    };
+}
+
+#endif
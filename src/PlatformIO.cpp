@@ -31,6 +31,8 @@
  */
 
 #include <cpuid.h>
+#include <limits.h>
+#include <unistd.h>
 #include <iomanip>
 #include <cmath>
 #include <algorithm>
@@ -41,11 +43,13 @@
 #include "geopm_message.h"
 #include "geopm_hash.h"
 #include "geopm.h"
+#include "geopm_env.h"
 #include "PlatformIO.hpp"
 #include "PlatformIOInternal.hpp"
 #include "PlatformTopo.hpp"
 #include "MSRIOGroup.hpp"
 #include "TimeIOGroup.hpp"
+#include "ReplayLog.hpp"
 #include "Exception.hpp"
 #include "Helper.hpp"
 
@@ -59,18 +63,41 @@ namespace geopm
         return instance;
     }
 
+    static std::string env_record_path(void)
+    {
+        std::string result = geopm_env_record();
+        if (!result.empty()) {
+            char hostname[NAME_MAX];
+            int err = gethostname(hostname, NAME_MAX);
+            if (err) {
+                throw Exception("PlatformIO: gethostname() failed", err, __FILE__, __LINE__);
+            }
+            result += "-" + std::string(hostname);
+        }
+        return result;
+    }
+
     PlatformIO::PlatformIO()
-        : PlatformIO({}, platform_topo())
+        : PlatformIO({}, platform_topo(), env_record_path())
     {
 
     }
 
     PlatformIO::PlatformIO(std::list<std::shared_ptr<IOGroup> > iogroup_list,
                            IPlatformTopo &topo)
+        : PlatformIO(iogroup_list, topo, "")
+    {
+
+    }
+
+    PlatformIO::PlatformIO(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                           IPlatformTopo &topo,
+                           const std::string &record_path)
         : m_is_active(false)
         , m_platform_topo(topo)
         , m_iogroup_list(iogroup_list)
         , m_do_restore(false)
+        , m_record_path(record_path)
     {
         if (m_iogroup_list.size() == 0) {
             for (const auto &it : iogroup_factory().plugin_names()) {
@@ -91,6 +118,8 @@ namespace geopm
         }
     }
 
+    PlatformIO::~PlatformIO() = default;
+
     void PlatformIO::register_iogroup(std::shared_ptr<IOGroup> iogroup)
     {
         if (m_do_restore) {
@@ -190,6 +219,8 @@ namespace geopm
                 int group_signal_idx = (*it)->push_signal(signal_name, domain_type, domain_idx);
                 result = m_active_signal.size();
                 m_active_signal.emplace_back((*it).get(), group_signal_idx);
+                m_record_signal.push_back({signal_name, domain_type, domain_idx});
+                m_record_signal_idx.push_back(result);
             }
         }
         if (result == -1 && signal_name.find("POWER") != std::string::npos) {
@@ -241,8 +272,7 @@ namespace geopm
         int result = -1;
         int base_domain_type = signal_domain_type(signal_name);
         if (m_platform_topo.is_domain_within(base_domain_type, domain_type)) {
-            std::set<int> cpus;
-            m_platform_topo.domain_cpus(domain_type, domain_idx, cpus);
+            const std::vector<int> &cpus = m_platform_topo.domain_cpu_list(domain_type, domain_idx);
             std::set<int> base_domain_idx;
             for (auto it : cpus) {
                 base_domain_idx.insert(m_platform_topo.domain_idx(base_domain_type, it));
@@ -282,6 +312,21 @@ namespace geopm
         m_region_id_idx[signal_idx] = push_signal("REGION_ID#", domain_type, domain_idx);
     }
 
+    void PlatformIO::push_region_signal_histogram(int signal_idx, int domain_type, int domain_idx)
+    {
+        if (signal_idx < 0 || signal_idx >= num_signal()) {
+            throw Exception("PlatformIO::push_region_signal_histogram(): signal_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        for (const auto &it : m_region_hist_signal) {
+            if (it.signal_idx == signal_idx) {
+                return;
+            }
+        }
+        int region_id_idx = push_signal("REGION_ID#", domain_type, domain_idx);
+        m_region_hist_signal.push_back({signal_idx, region_id_idx, 0, nullptr});
+    }
+
     int PlatformIO::push_control(const std::string &control_name,
                                  int domain_type,
                                  int domain_idx)
@@ -299,6 +344,8 @@ namespace geopm
                 int group_control_idx = (*it)->push_control(control_name, domain_type, domain_idx);
                 result = m_active_control.size();
                 m_active_control.emplace_back((*it).get(), group_control_idx);
+                m_record_control.push_back({control_name, domain_type, domain_idx});
+                m_record_setting.push_back(NAN);
                 is_found = true;
             }
         }
@@ -359,6 +406,29 @@ namespace geopm
         return current_value;
     }
 
+    double PlatformIO::sample_region_percentile(int signal_idx, uint64_t region_id,
+                                                double percentile)
+    {
+        auto it = std::find_if(m_region_hist_signal.begin(), m_region_hist_signal.end(),
+                               [signal_idx] (const m_region_hist_signal_s &hist_signal) {
+                                   return hist_signal.signal_idx == signal_idx;
+                               });
+        if (it == m_region_hist_signal.end()) {
+            throw Exception("PlatformIO::sample_region_percentile(): signal_idx was not passed to push_region_signal_histogram()",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!(percentile >= 0.0 && percentile <= 100.0)) {
+            throw Exception("PlatformIO::sample_region_percentile(): percentile must be between 0 and 100",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        double result = NAN;
+        auto hist_it = m_region_hist.find(std::make_pair(signal_idx, region_id));
+        if (hist_it != m_region_hist.end()) {
+            result = hist_it->second.percentile(percentile);
+        }
+        return result;
+    }
+
     double PlatformIO::sample_combined(int signal_idx)
     {
         double result = NAN;
@@ -386,15 +456,65 @@ namespace geopm
         }
         auto &group_idx_pair = m_active_control[control_idx];
         group_idx_pair.first->adjust(group_idx_pair.second, setting);
+        m_record_setting[control_idx] = setting;
         m_is_active = true;
     }
 
+    void PlatformIO::record_open(void)
+    {
+        if (!m_record) {
+            m_record = geopm::make_unique<ReplayLogWriter>(m_record_path, m_record_signal,
+                                                           m_record_control);
+            m_record_value.resize(m_record_signal.size());
+            for (const auto &it : m_record_read_signal) {
+                m_record->read_signal(it.first, it.second);
+            }
+            m_record_read_signal.clear();
+            for (const auto &it : m_record_write_control) {
+                m_record->write_control(it.first, it.second);
+            }
+            m_record_write_control.clear();
+        }
+    }
+
+    void PlatformIO::record_read_signal(const m_request_s &request, double value)
+    {
+        if (!m_record_path.empty()) {
+            if (m_record) {
+                m_record->read_signal(request, value);
+            }
+            else {
+                m_record_read_signal.push_back({request, value});
+            }
+        }
+    }
+
+    void PlatformIO::record_write_control(const m_request_s &request, double setting)
+    {
+        if (!m_record_path.empty()) {
+            if (m_record) {
+                m_record->write_control(request, setting);
+            }
+            else {
+                m_record_write_control.push_back({request, setting});
+            }
+        }
+    }
+
     void PlatformIO::read_batch(void)
     {
         for (auto &it : m_iogroup_list) {
             it->read_batch();
         }
         m_is_active = true;
+        if (!m_record_path.empty()) {
+            record_open();
+            for (size_t rec_idx = 0; rec_idx < m_record_signal_idx.size(); ++rec_idx) {
+                auto &group_idx_pair = m_active_signal[m_record_signal_idx[rec_idx]];
+                m_record_value[rec_idx] = group_idx_pair.first->sample(group_idx_pair.second);
+            }
+            m_record->read(m_record_value);
+        }
 
         // aggregate region totals
         for (const auto &it : m_region_id_idx) {
@@ -420,6 +540,22 @@ namespace geopm
                 }
             }
         }
+
+        // add samples to region histograms
+        for (auto &it : m_region_hist_signal) {
+            double region_sample = sample(it.region_id_idx);
+            if (std::isnan(region_sample)) {
+                // no region until the application connects
+                continue;
+            }
+            uint64_t region_id = geopm_signal_to_field(region_sample);
+            region_id = geopm_region_id_unset_hint(GEOPM_MASK_REGION_HINT, region_id);
+            if (!it.hist || region_id != it.region_id) {
+                it.hist = &m_region_hist[std::make_pair(it.signal_idx, region_id)];
+                it.region_id = region_id;
+            }
+            it.hist->insert(sample(it.signal_idx));
+        }
     }
 
     void PlatformIO::write_batch(void)
@@ -427,6 +563,11 @@ namespace geopm
         for (auto &it : m_iogroup_list) {
             it->write_batch();
         }
+        if (!m_record_path.empty()) {
+            record_open();
+            m_record->write(m_record_setting);
+            std::fill(m_record_setting.begin(), m_record_setting.end(), NAN);
+        }
     }
 
     double PlatformIO::read_signal(const std::string &signal_name,
@@ -447,6 +588,7 @@ namespace geopm
             throw Exception("PlatformIO::read_signal(): signal name \"" + signal_name + "\" not found",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        record_read_signal({signal_name, domain_type, domain_idx}, result);
         return result;
     }
 
@@ -468,6 +610,102 @@ namespace geopm
             throw Exception("PlatformIO::write_control(): control name \"" + control_name + "\" not found",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        record_write_control({control_name, domain_type, domain_idx}, setting);
+    }
+
+    void PlatformIO::group_request(const std::vector<m_request_s> &request,
+                                   bool is_signal,
+                                   std::vector<IOGroup *> &group_list,
+                                   std::vector<std::vector<size_t> > &group_req_idx) const
+    {
+        // Resolve each distinct name once and gather the requests
+        // that go to each IOGroup in the order they were first seen.
+        group_list.clear();
+        group_req_idx.clear();
+        std::map<std::string, size_t> name_group;
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            const std::string &name = request[req_idx].name;
+            auto name_it = name_group.find(name);
+            if (name_it == name_group.end()) {
+                IOGroup *group = nullptr;
+                for (auto it = m_iogroup_list.rbegin();
+                     group == nullptr && it != m_iogroup_list.rend();
+                     ++it) {
+                    if (is_signal ? (*it)->is_valid_signal(name) :
+                                    (*it)->is_valid_control(name)) {
+                        group = (*it).get();
+                    }
+                }
+                if (group == nullptr) {
+                    throw Exception(std::string("PlatformIO::") +
+                                    (is_signal ? "read_signal_batch(): signal" : "write_control_batch(): control") +
+                                    " name \"" + name + "\" not found",
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+                auto group_it = std::find(group_list.begin(), group_list.end(), group);
+                size_t group_idx = group_it - group_list.begin();
+                if (group_it == group_list.end()) {
+                    group_list.push_back(group);
+                    group_req_idx.emplace_back();
+                }
+                name_it = name_group.emplace(name, group_idx).first;
+            }
+            group_req_idx[name_it->second].push_back(req_idx);
+        }
+    }
+
+    void PlatformIO::read_signal_batch(const std::vector<m_request_s> &request,
+                                       std::vector<double> &result)
+    {
+        std::vector<IOGroup *> group_list;
+        std::vector<std::vector<size_t> > group_req_idx;
+        group_request(request, true, group_list, group_req_idx);
+        result.assign(request.size(), NAN);
+        std::vector<m_request_s> sub_request;
+        std::vector<double> sub_result;
+        for (size_t group_idx = 0; group_idx < group_list.size(); ++group_idx) {
+            sub_request.clear();
+            for (auto req_idx : group_req_idx[group_idx]) {
+                sub_request.push_back(request[req_idx]);
+            }
+            group_list[group_idx]->read_signal_batch(sub_request, sub_result);
+            if (sub_result.size() != sub_request.size()) {
+                throw Exception("PlatformIO::read_signal_batch(): IOGroup returned wrong number of results",
+                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            for (size_t sub_idx = 0; sub_idx < sub_result.size(); ++sub_idx) {
+                result[group_req_idx[group_idx][sub_idx]] = sub_result[sub_idx];
+            }
+        }
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            record_read_signal(request[req_idx], result[req_idx]);
+        }
+    }
+
+    void PlatformIO::write_control_batch(const std::vector<m_request_s> &request,
+                                         const std::vector<double> &setting)
+    {
+        if (request.size() != setting.size()) {
+            throw Exception("PlatformIO::write_control_batch(): number of settings does not match number of requests",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::vector<IOGroup *> group_list;
+        std::vector<std::vector<size_t> > group_req_idx;
+        group_request(request, false, group_list, group_req_idx);
+        std::vector<m_request_s> sub_request;
+        std::vector<double> sub_setting;
+        for (size_t group_idx = 0; group_idx < group_list.size(); ++group_idx) {
+            sub_request.clear();
+            sub_setting.clear();
+            for (auto req_idx : group_req_idx[group_idx]) {
+                sub_request.push_back(request[req_idx]);
+                sub_setting.push_back(setting[req_idx]);
+            }
+            group_list[group_idx]->write_control_batch(sub_request, sub_setting);
+        }
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            record_write_control(request[req_idx], setting[req_idx]);
+        }
     }
 
     void PlatformIO::save_control(void)
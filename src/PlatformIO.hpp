@@ -49,6 +49,13 @@ namespace geopm
     class IPlatformIO
     {
         public:
+            /// @brief Structure describing the values required to
+            ///        push a signal or control.
+            struct m_request_s {
+                std::string name;
+                int domain_type;
+                int domain_idx;
+            };
             IPlatformIO() = default;
             virtual ~IPlatformIO() = default;
             /// @brief Registers an IOGroup with the PlatformIO so
@@ -120,6 +127,29 @@ namespace geopm
             virtual void push_region_signal_total(int signal_idx,
                                                   int domain_type,
                                                   int domain_idx) = 0;
+            /// @brief Push a previously registered signal to be
+            ///        gathered into a histogram per region, so that
+            ///        the tail of signals such as power or frequency
+            ///        within a region can be queried with
+            ///        sample_region_percentile().  Each call to
+            ///        read_batch() adds the value of the signal to
+            ///        the histogram of the region given by the
+            ///        REGION_ID# signal at that time.  The
+            ///        histograms use a fixed amount of memory per
+            ///        region, see LogHistogram.
+            /// @param [in] signal_idx Index returned by a previous
+            ///        call to push_signal.  If the signal_idx is
+            ///        not a previously registered signal, this
+            ///        function throws.
+            /// @param [in] domain_type Domain type over which the
+            ///        region ID should be sampled. This must match
+            ///        the domain type of the signal.
+            /// @param [in] domain_idx Domain over which the region ID
+            ///        should be sampled. This must match the domain
+            ///        index of the signal.
+            virtual void push_region_signal_histogram(int signal_idx,
+                                                      int domain_type,
+                                                      int domain_idx) = 0;
             /// @brief Push a signal that aggregated values sampled
             ///        from other signals.  The aggregation function
             ///        used is determined by a call to agg_function()
@@ -179,6 +209,20 @@ namespace geopm
             /// @param [in] region_id The region ID to look up data for.
             /// @return Total accumulated value for the signal for one region.
             virtual double sample_region_total(int signal_idx, uint64_t region_id) = 0;
+            /// @brief Estimate a percentile of the values a signal
+            ///        took in one region, e.g. the p99 of package
+            ///        power.  The estimate is within a few percent of
+            ///        the exact value.
+            /// @param [in] signal_idx Index returned by a previous call to
+            ///        push_signal.  It must also have been passed to
+            ///        push_region_signal_histogram to start the
+            ///        accumulation.
+            /// @param [in] region_id The region ID to look up data for.
+            /// @param [in] percentile Value between 0 and 100.
+            /// @return Estimated percentile of the signal within the
+            ///         region, or NAN if the region was not sampled.
+            virtual double sample_region_percentile(int signal_idx, uint64_t region_id,
+                                                    double percentile) = 0;
             /// @brief Adjust a single control that has been pushed on
             ///        to the control stack.  This control will not
             ///        take effect until the next call to
@@ -226,6 +270,28 @@ namespace geopm
                                        int domain_type,
                                        int domain_idx,
                                        double setting) = 0;
+            /// @brief Read several signals in one call.  Each
+            ///        distinct signal name is resolved to its IOGroup
+            ///        once and the requests are handed to each
+            ///        IOGroup together so that it may combine the
+            ///        hardware accesses.  Does not modify the values
+            ///        stored by calling read_batch().
+            /// @param [in] request Signal name, domain type and
+            ///        domain index for each signal to be read.
+            /// @param [out] result Value in SI units of each signal
+            ///        in the same order as the requests.
+            virtual void read_signal_batch(const std::vector<m_request_s> &request,
+                                           std::vector<double> &result) = 0;
+            /// @brief Write several controls in one call, grouping
+            ///        the requests by IOGroup as read_signal_batch()
+            ///        does.  Does not modify the values stored by
+            ///        calling adjust().
+            /// @param [in] request Control name, domain type and
+            ///        domain index for each control to be written.
+            /// @param [in] setting Value in SI units for each
+            ///        control in the same order as the requests.
+            virtual void write_control_batch(const std::vector<m_request_s> &request,
+                                             const std::vector<double> &setting) = 0;
             /// @brief Save the state of all controls so that any
             ///        subsequent changes made through PlatformIO
             ///        can be undone with a call to the restore()
@@ -270,13 +336,6 @@ namespace geopm
             ///        in the same region to exert control for that
             ///        region.
             static double agg_region_id(const std::vector<double> &operand);
-            /// @brief Structure describing the values required to
-            ///        push a signal or control.
-            struct m_request_s {
-                std::string name;
-                int domain_type;
-                int domain_idx;
-            };
     };
 
     IPlatformIO &platform_io(void);
@@ -41,12 +41,14 @@
 
 #include "PlatformIO.hpp"
 #include "CombinedSignal.hpp"
+#include "LogHistogram.hpp"
 
 namespace geopm
 {
     class IOGroup;
     class CombinedSignal;
     class IPlatformTopo;
+    class ReplayLogWriter;
 
     class PlatformIO : public IPlatformIO
     {
@@ -55,10 +57,17 @@ namespace geopm
             PlatformIO();
             PlatformIO(std::list<std::shared_ptr<IOGroup> > iogroup_list,
                        IPlatformTopo &topo);
+            /// @brief Constructor that records the signals read and
+            ///        the controls written in a replay log.
+            /// @param [in] record_path Path of the ReplayLogWriter
+            ///        output, or empty to disable recording.
+            PlatformIO(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                       IPlatformTopo &topo,
+                       const std::string &record_path);
             PlatformIO(const PlatformIO &other) = delete;
             PlatformIO & operator=(const PlatformIO&) = delete;
             /// @brief Virtual destructor for the PlatformIO class.
-            virtual ~PlatformIO() = default;
+            virtual ~PlatformIO();
             void register_iogroup(std::shared_ptr<IOGroup> iogroup) override;
             std::set<std::string> signal_names(void) const override;
             std::set<std::string> control_names(void) const override;
@@ -70,6 +79,9 @@ namespace geopm
             void push_region_signal_total(int signal_idx,
                                           int domain_type,
                                           int domain_idx) override;
+            void push_region_signal_histogram(int signal_idx,
+                                              int domain_type,
+                                              int domain_idx) override;
             int push_combined_signal(const std::string &signal_name,
                                      int domain_type,
                                      int domain_idx,
@@ -81,6 +93,8 @@ namespace geopm
             int num_control(void) const override;
             double sample(int signal_idx) override;
             double sample_region_total(int signal_idx, uint64_t region_id) override;
+            double sample_region_percentile(int signal_idx, uint64_t region_id,
+                                            double percentile) override;
             void adjust(int control_idx, double setting) override;
             void read_batch(void) override;
             void write_batch(void) override;
@@ -91,6 +105,10 @@ namespace geopm
                                int domain_type,
                                int domain_idx,
                                double setting) override;
+            void read_signal_batch(const std::vector<m_request_s> &request,
+                                   std::vector<double> &result) override;
+            void write_control_batch(const std::vector<m_request_s> &request,
+                                     const std::vector<double> &setting) override;
             void save_control(void) override;
             void restore_control(void) override;
             std::function<double(const std::vector<double> &)> agg_function(std::string signal_name) const override;
@@ -110,8 +128,32 @@ namespace geopm
             int push_signal_convert_domain(const std::string &signal_name,
                                            int domain_type,
                                            int domain_idx);
+            /// @brief Find the IOGroup that provides each distinct
+            ///        name in a batch request.
+            /// @param [in] request Requests passed to
+            ///        read_signal_batch() or write_control_batch().
+            /// @param [in] is_signal True if the names are signals,
+            ///        false if they are controls.
+            /// @param [out] group_list Each IOGroup referenced by
+            ///        the requests.
+            /// @param [out] group_req_idx For each IOGroup in
+            ///        group_list the indices into request that it
+            ///        serves.
+            void group_request(const std::vector<m_request_s> &request,
+                               bool is_signal,
+                               std::vector<IOGroup *> &group_list,
+                               std::vector<std::vector<size_t> > &group_req_idx) const;
             /// @brief Sample a combined signal using the saved function and operands.
             double sample_combined(int signal_idx);
+            /// @brief Open the replay log on the first batch
+            ///        operation, after all requests are pushed.
+            void record_open(void);
+            /// @brief Record the result of read_signal() or of one
+            ///        request of read_signal_batch().
+            void record_read_signal(const m_request_s &request, double value);
+            /// @brief Record the setting of write_control() or of
+            ///        one request of write_control_batch().
+            void record_write_control(const m_request_s &request, double setting);
             bool m_is_active;
             IPlatformTopo &m_platform_topo;
             std::list<std::shared_ptr<IOGroup> > m_iogroup_list;
@@ -129,7 +171,36 @@ namespace geopm
             // map for last region id seen in each signal's domain
             // only used for comparison, so can leave as a double
             std::map<int, uint64_t> m_last_region_id;
+            /// @brief Signal gathered into per region histograms.
+            struct m_region_hist_signal_s
+            {
+                int signal_idx;
+                int region_id_idx;
+                /// Region of the last sample and its histogram,
+                /// so the map is only searched at region boundaries
+                uint64_t region_id;
+                LogHistogram *hist;
+            };
+            std::vector<m_region_hist_signal_s> m_region_hist_signal;
+            std::map<std::pair<int, uint64_t>, LogHistogram> m_region_hist;
             bool m_do_restore;
+            std::string m_record_path;
+            std::unique_ptr<ReplayLogWriter> m_record;
+            /// Requests and active signal indices of the signals
+            /// pushed directly to an IOGroup
+            std::vector<m_request_s> m_record_signal;
+            std::vector<int> m_record_signal_idx;
+            std::vector<m_request_s> m_record_control;
+            std::vector<double> m_record_value;
+            /// Setting of each control adjusted since the last
+            /// write_batch(), NAN if not adjusted
+            std::vector<double> m_record_setting;
+            /// Results of read_signal() called before the log is
+            /// opened
+            std::vector<std::pair<m_request_s, double> > m_record_read_signal;
+            /// Settings of write_control() called before the log is
+            /// opened
+            std::vector<std::pair<m_request_s, double> > m_record_write_control;
     };
 }
 
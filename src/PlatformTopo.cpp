@@ -30,11 +30,21 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include <signal.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <map>
+#include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "geopm_sched.h"
+#include "geopm_env.h"
+#include "geopm_hash.h"
 #include "PlatformTopo.hpp"
 #include "Exception.hpp"
 
@@ -48,19 +58,332 @@ namespace geopm
         return instance;
     }
 
-    PlatformTopo::PlatformTopo()
-        : PlatformTopo("")
+    enum m_topo_snapshot_e {
+        M_TOPO_SNAPSHOT_MAGIC = 0x706f7468,
+    };
+
+    /// Layout of the snapshot file written by
+    /// PlatformTopo::write_snapshot().  The header is followed by
+    /// the package index and the core index of each CPU, the offset
+    /// of each NUMA node into the NUMA CPU list plus the total
+    /// length, and the NUMA CPU list.  The host hash ties the
+    /// snapshot to the node that wrote it so that a path on a
+    /// shared file system is not mapped by another node.
+    struct geopm_topo_snapshot_s {
+        uint32_t magic;
+        uint32_t num_cpu;
+        uint64_t online_hash;
+        uint64_t host_hash;
+        int32_t num_package;
+        int32_t core_per_package;
+        int32_t thread_per_core;
+        int32_t num_numa;
+        int32_t num_numa_cpu;
+    };
+
+    static uint64_t topo_host_hash(void)
     {
+        char hostname[NAME_MAX];
+        if (gethostname(hostname, NAME_MAX)) {
+            throw Exception("PlatformTopo: gethostname() failed",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        hostname[NAME_MAX - 1] = '\0';
+        return geopm_crc32_str(0, hostname);
+    }
 
+    PlatformTopo::PlatformTopo()
+        : m_lscpu_file_name("")
+    {
+        try {
+            load_sysfs("/sys/devices/system", geopm_env_topo_cache());
+        }
+        catch (const Exception &ex) {
+            load_lscpu();
+        }
     }
 
     PlatformTopo::PlatformTopo(const std::string &lscpu_file_name)
         : m_lscpu_file_name(lscpu_file_name)
+    {
+        load_lscpu();
+    }
+
+    PlatformTopo::PlatformTopo(const std::string &sysfs_path,
+                               const std::string &snapshot_path)
+        : m_lscpu_file_name("")
+    {
+        load_sysfs(sysfs_path, snapshot_path);
+    }
+
+    void PlatformTopo::load_lscpu(void)
     {
         std::map<std::string, std::string> lscpu_map;
         lscpu(lscpu_map);
         parse_lscpu(lscpu_map, m_num_package, m_core_per_package, m_thread_per_core);
+        m_numa_map.clear();
         parse_lscpu_numa(lscpu_map, m_numa_map);
+        // lscpu does not give the core of each CPU; assume the Linux
+        // numbering where the hyper-threads of all cores follow each
+        // other and cores are numbered by package.
+        int num_core = m_num_package * m_core_per_package;
+        int num_cpu = num_core * m_thread_per_core;
+        std::vector<int> cpu_package(num_cpu);
+        std::vector<int> cpu_core(num_cpu);
+        for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+            cpu_core[cpu_idx] = cpu_idx % num_core;
+            cpu_package[cpu_idx] = cpu_core[cpu_idx] / m_core_per_package;
+        }
+        build_table(cpu_package, cpu_core);
+    }
+
+    void PlatformTopo::load_sysfs(const std::string &sysfs_path,
+                                  const std::string &snapshot_path)
+    {
+        uint64_t online_hash = geopm_crc32_str(0, read_line(sysfs_path + "/cpu/online").c_str());
+        uint64_t host_hash = snapshot_path.empty() ? 0 : topo_host_hash();
+        std::vector<int> cpu_package;
+        std::vector<int> cpu_core;
+        if (snapshot_path.empty() ||
+            !read_snapshot(snapshot_path, online_hash, host_hash, cpu_package, cpu_core)) {
+            read_sysfs(sysfs_path, cpu_package, cpu_core);
+            build_table(cpu_package, cpu_core);
+            if (!snapshot_path.empty()) {
+                write_snapshot(snapshot_path, online_hash, host_hash);
+            }
+        }
+        else {
+            build_table(cpu_package, cpu_core);
+        }
+    }
+
+    void PlatformTopo::read_sysfs(const std::string &sysfs_path,
+                                  std::vector<int> &cpu_package,
+                                  std::vector<int> &cpu_core)
+    {
+        std::set<int> online = parse_cpu_list(read_line(sysfs_path + "/cpu/online"));
+        int num_cpu = online.size();
+        if (!num_cpu || *online.begin() != 0 || *online.rbegin() != num_cpu - 1) {
+            throw Exception("PlatformTopo::read_sysfs(): online CPUs are not numbered contiguously from zero",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        // Number packages by physical ID and cores by package and
+        // then core ID, which agrees with the lscpu assumption on
+        // Linux numbered systems.
+        std::vector<std::pair<int, int> > cpu_id(num_cpu);
+        std::map<int, int> package_map;
+        std::map<std::pair<int, int>, int> core_map;
+        for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+            std::string topo_path = sysfs_path + "/cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+            try {
+                cpu_id[cpu_idx].first = std::stoi(read_line(topo_path + "physical_package_id"));
+                cpu_id[cpu_idx].second = std::stoi(read_line(topo_path + "core_id"));
+            }
+            catch (const std::logic_error &ex) {
+                throw Exception("PlatformTopo::read_sysfs(): invalid topology for CPU " + std::to_string(cpu_idx),
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            package_map[cpu_id[cpu_idx].first] = 0;
+            core_map[cpu_id[cpu_idx]] = 0;
+        }
+        int idx = 0;
+        for (auto &it : package_map) {
+            it.second = idx++;
+        }
+        idx = 0;
+        for (auto &it : core_map) {
+            it.second = idx++;
+        }
+        m_num_package = package_map.size();
+        m_core_per_package = core_map.size() / m_num_package;
+        m_thread_per_core = num_cpu / core_map.size();
+        if (m_num_package * m_core_per_package * m_thread_per_core != num_cpu) {
+            throw Exception("PlatformTopo::read_sysfs(): CPUs are not evenly divided between packages and cores",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        cpu_package.resize(num_cpu);
+        cpu_core.resize(num_cpu);
+        for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+            cpu_package[cpu_idx] = package_map[cpu_id[cpu_idx].first];
+            cpu_core[cpu_idx] = core_map[cpu_id[cpu_idx]];
+        }
+
+        m_numa_map.clear();
+        std::string node_online;
+        try {
+            node_online = read_line(sysfs_path + "/node/online");
+        }
+        catch (const Exception &ex) {
+            // Kernel built without NUMA support
+            m_numa_map.push_back(online);
+        }
+        for (int node_idx : parse_cpu_list(node_online)) {
+            m_numa_map.push_back(parse_cpu_list(
+                read_line(sysfs_path + "/node/node" + std::to_string(node_idx) + "/cpulist")));
+        }
+    }
+
+    bool PlatformTopo::read_snapshot(const std::string &snapshot_path,
+                                     uint64_t online_hash,
+                                     uint64_t host_hash,
+                                     std::vector<int> &cpu_package,
+                                     std::vector<int> &cpu_core)
+    {
+        bool result = false;
+        int fd = open(snapshot_path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return result;
+        }
+        struct stat stat_struct;
+        void *map_ptr = MAP_FAILED;
+        if (!fstat(fd, &stat_struct) &&
+            (size_t)stat_struct.st_size >= sizeof(geopm_topo_snapshot_s)) {
+            map_ptr = mmap(NULL, stat_struct.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (map_ptr == MAP_FAILED) {
+            return result;
+        }
+        const geopm_topo_snapshot_s *snapshot = (const geopm_topo_snapshot_s *)map_ptr;
+        size_t num_data = (stat_struct.st_size - sizeof(geopm_topo_snapshot_s)) / sizeof(int32_t);
+        if (snapshot->magic == M_TOPO_SNAPSHOT_MAGIC &&
+            snapshot->online_hash == online_hash &&
+            snapshot->host_hash == host_hash &&
+            snapshot->num_package > 0 &&
+            snapshot->core_per_package > 0 &&
+            snapshot->thread_per_core > 0 &&
+            snapshot->num_numa >= 0 &&
+            snapshot->num_numa_cpu >= 0 &&
+            snapshot->num_cpu == (uint32_t)(snapshot->num_package *
+                                            snapshot->core_per_package *
+                                            snapshot->thread_per_core) &&
+            num_data == 2 * (size_t)snapshot->num_cpu +
+                        snapshot->num_numa + 1 + snapshot->num_numa_cpu) {
+            const int32_t *package_ptr = (const int32_t *)(snapshot + 1);
+            const int32_t *core_ptr = package_ptr + snapshot->num_cpu;
+            const int32_t *offset_ptr = core_ptr + snapshot->num_cpu;
+            const int32_t *numa_cpu_ptr = offset_ptr + snapshot->num_numa + 1;
+            int num_cpu = snapshot->num_cpu;
+            int num_core = snapshot->num_package * snapshot->core_per_package;
+            // A snapshot whose indices are out of range would fail in
+            // build_table(); read sysfs instead.
+            bool is_valid = offset_ptr[0] == 0 &&
+                            offset_ptr[snapshot->num_numa] == snapshot->num_numa_cpu;
+            for (int cpu_idx = 0; is_valid && cpu_idx != num_cpu; ++cpu_idx) {
+                is_valid = package_ptr[cpu_idx] >= 0 && package_ptr[cpu_idx] < snapshot->num_package &&
+                           core_ptr[cpu_idx] >= 0 && core_ptr[cpu_idx] < num_core;
+            }
+            for (int node_idx = 0; is_valid && node_idx != snapshot->num_numa; ++node_idx) {
+                is_valid = offset_ptr[node_idx] <= offset_ptr[node_idx + 1];
+            }
+            for (int numa_cpu_idx = 0; is_valid && numa_cpu_idx != snapshot->num_numa_cpu; ++numa_cpu_idx) {
+                is_valid = numa_cpu_ptr[numa_cpu_idx] >= 0 && numa_cpu_ptr[numa_cpu_idx] < num_cpu;
+            }
+            if (is_valid) {
+                cpu_package.assign(package_ptr, core_ptr);
+                cpu_core.assign(core_ptr, offset_ptr);
+                m_numa_map.clear();
+                for (int node_idx = 0; node_idx != snapshot->num_numa; ++node_idx) {
+                    m_numa_map.emplace_back(numa_cpu_ptr + offset_ptr[node_idx],
+                                            numa_cpu_ptr + offset_ptr[node_idx + 1]);
+                }
+                m_num_package = snapshot->num_package;
+                m_core_per_package = snapshot->core_per_package;
+                m_thread_per_core = snapshot->thread_per_core;
+                result = true;
+            }
+        }
+        munmap(map_ptr, stat_struct.st_size);
+        return result;
+    }
+
+    void PlatformTopo::write_snapshot(const std::string &snapshot_path,
+                                      uint64_t online_hash,
+                                      uint64_t host_hash) const
+    {
+        geopm_topo_snapshot_s header;
+        header.magic = M_TOPO_SNAPSHOT_MAGIC;
+        const std::vector<int> &cpu_package = m_cpu_domain_idx[M_DOMAIN_PACKAGE];
+        const std::vector<int> &cpu_core = m_cpu_domain_idx[M_DOMAIN_CORE];
+        header.num_cpu = cpu_package.size();
+        header.online_hash = online_hash;
+        header.host_hash = host_hash;
+        header.num_package = m_num_package;
+        header.core_per_package = m_core_per_package;
+        header.thread_per_core = m_thread_per_core;
+        header.num_numa = m_numa_map.size();
+        std::vector<int32_t> data(cpu_package.begin(), cpu_package.end());
+        data.insert(data.end(), cpu_core.begin(), cpu_core.end());
+        int32_t offset = 0;
+        for (const auto &numa_cpus : m_numa_map) {
+            data.push_back(offset);
+            offset += numa_cpus.size();
+        }
+        data.push_back(offset);
+        for (const auto &numa_cpus : m_numa_map) {
+            data.insert(data.end(), numa_cpus.begin(), numa_cpus.end());
+        }
+        header.num_numa_cpu = offset;
+
+        // The snapshot is only an optimization: if it cannot be
+        // written the next process will read sysfs instead.  Write
+        // to a private file and rename it so that concurrent readers
+        // never map a partial snapshot.
+        std::string tmp_path = snapshot_path + "." + std::to_string(getpid());
+        int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (fd == -1) {
+            return;
+        }
+        size_t data_size = data.size() * sizeof(int32_t);
+        bool is_written = write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+                          write(fd, data.data(), data_size) == (ssize_t)data_size;
+        is_written = !close(fd) && is_written;
+        if (!is_written || rename(tmp_path.c_str(), snapshot_path.c_str())) {
+            (void)unlink(tmp_path.c_str());
+        }
+    }
+
+    void PlatformTopo::build_table(const std::vector<int> &cpu_package,
+                                   const std::vector<int> &cpu_core)
+    {
+        int num_cpu = cpu_package.size();
+        // Domain types without a table are left empty and rejected
+        // by the accessors.
+        m_cpu_domain_idx.assign(M_NUM_DOMAIN, {});
+        m_domain_cpu_list.assign(M_NUM_DOMAIN, {});
+
+        m_cpu_domain_idx[M_DOMAIN_BOARD].assign(num_cpu, 0);
+        m_cpu_domain_idx[M_DOMAIN_PACKAGE] = cpu_package;
+        m_cpu_domain_idx[M_DOMAIN_CORE] = cpu_core;
+        std::vector<int> &cpu_cpu = m_cpu_domain_idx[M_DOMAIN_CPU];
+        cpu_cpu.resize(num_cpu);
+        std::vector<int> &cpu_numa = m_cpu_domain_idx[M_DOMAIN_BOARD_MEMORY];
+        cpu_numa.assign(num_cpu, -1);
+
+        m_domain_cpu_list[M_DOMAIN_PACKAGE].resize(m_num_package);
+        m_domain_cpu_list[M_DOMAIN_CORE].resize(m_num_package * m_core_per_package);
+        m_domain_cpu_list[M_DOMAIN_CPU].resize(num_cpu);
+        for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+            cpu_cpu[cpu_idx] = cpu_idx;
+            m_domain_cpu_list[M_DOMAIN_PACKAGE].at(cpu_package[cpu_idx]).push_back(cpu_idx);
+            m_domain_cpu_list[M_DOMAIN_CORE].at(cpu_core[cpu_idx]).push_back(cpu_idx);
+            m_domain_cpu_list[M_DOMAIN_CPU][cpu_idx].push_back(cpu_idx);
+        }
+        // Walk in reverse so that each CPU records the lowest index
+        // NUMA node that contains it.
+        std::set<int> board_cpus;
+        auto &numa_cpus = m_domain_cpu_list[M_DOMAIN_BOARD_MEMORY];
+        numa_cpus.resize(m_numa_map.size());
+        for (int numa_idx = (int)m_numa_map.size() - 1; numa_idx >= 0; --numa_idx) {
+            for (int cpu_idx : m_numa_map[numa_idx]) {
+                if (cpu_idx >= 0 && cpu_idx < num_cpu) {
+                    cpu_numa[cpu_idx] = numa_idx;
+                }
+            }
+            numa_cpus[numa_idx].assign(m_numa_map[numa_idx].begin(), m_numa_map[numa_idx].end());
+            board_cpus.insert(m_numa_map[numa_idx].begin(), m_numa_map[numa_idx].end());
+        }
+        m_domain_cpu_list[M_DOMAIN_BOARD].emplace_back(board_cpus.begin(), board_cpus.end());
     }
 
     int PlatformTopo::num_domain(int domain_type) const
@@ -116,44 +439,41 @@ namespace geopm
                                    int domain_idx,
                                    std::set<int> &cpu_idx) const
     {
+        const std::vector<int> &cpu_list = domain_cpu_list(domain_type, domain_idx);
         cpu_idx.clear();
-        switch (domain_type) {
-            case M_DOMAIN_BOARD:
-                for (auto numa_cpus : m_numa_map) {
-                    cpu_idx.insert(numa_cpus.begin(), numa_cpus.end());
-                }
-                break;
-            case M_DOMAIN_PACKAGE:
-                for (int thread_idx = 0;
-                     thread_idx != m_thread_per_core;
-                     ++thread_idx) {
-                    for (int core_idx = domain_idx * m_core_per_package;
-                         core_idx != (domain_idx + 1) * m_core_per_package;
-                         ++core_idx) {
-                        cpu_idx.insert(core_idx + thread_idx * m_core_per_package * m_num_package);
-                    }
-                }
-                break;
-            case M_DOMAIN_CORE:
-                for (int thread_idx = 0;
-                     thread_idx != m_thread_per_core;
-                     ++thread_idx) {
-                    cpu_idx.insert(domain_idx + thread_idx * m_core_per_package * m_num_package);
-                }
-                break;
-            case M_DOMAIN_CPU:
-                cpu_idx.insert(domain_idx);
-                break;
-            case M_DOMAIN_BOARD_MEMORY:
-                cpu_idx = m_numa_map[domain_idx];
-                break;
-            default:
-                throw Exception("PlatformTopo::domain_cpus(domain_type=" +
-                                std::to_string(domain_type) +
-                                ") support not yet implemented",
-                                GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
-                break;
+        cpu_idx.insert(cpu_list.begin(), cpu_list.end());
+    }
+
+    const std::vector<int> &PlatformTopo::domain_cpu_list(int domain_type,
+                                                          int domain_idx) const
+    {
+        if (domain_type < 0 || domain_type >= M_NUM_DOMAIN ||
+            m_domain_cpu_list[domain_type].empty()) {
+            throw Exception("PlatformTopo::domain_cpus(domain_type=" +
+                            std::to_string(domain_type) +
+                            ") support not yet implemented",
+                            GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
         }
+        const auto &domain_list = m_domain_cpu_list[domain_type];
+        if (domain_idx < 0 || (size_t)domain_idx >= domain_list.size()) {
+            throw Exception("PlatformTopo::domain_cpus(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return domain_list[domain_idx];
+    }
+
+    const std::vector<int> &PlatformTopo::cpu_domain_idx(int domain_type) const
+    {
+        if (domain_type <= M_DOMAIN_INVALID || domain_type >= M_NUM_DOMAIN) {
+            throw Exception("PlatformTopo::domain_idx() invalid domain specified",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_cpu_domain_idx[domain_type].empty()) {
+            /// @todo Add support for package memory NIC and accelerators to domain_idx() method.
+            throw Exception("PlatformTopo::domain_idx() no support yet for PACKAGE_MEMORY, NIC, or ACCELERATOR",
+                            GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+        }
+        return m_cpu_domain_idx[domain_type];
     }
 
     int PlatformTopo::define_cpu_group(const std::vector<int> &cpu_domain_idx)
@@ -166,63 +486,12 @@ namespace geopm
     int PlatformTopo::domain_idx(int domain_type,
                                  int cpu_idx) const
     {
-        int result = -1;
-        int num_cpu = num_domain(M_DOMAIN_CPU);
-        int core_idx = 0;
-        int numa_idx = 0;
-        if (cpu_idx >= 0 && cpu_idx < num_cpu) {
-            switch (domain_type) {
-                case M_DOMAIN_BOARD:
-                    result = 0;
-                    break;
-                case M_DOMAIN_PACKAGE:
-                    core_idx = cpu_idx % (m_num_package * m_core_per_package);
-                    result = core_idx / m_core_per_package;
-                    break;
-                case M_DOMAIN_CORE:
-                    result = cpu_idx % (m_num_package * m_core_per_package);
-                    break;
-                case M_DOMAIN_CPU:
-                    result = cpu_idx;
-                    break;
-                case M_DOMAIN_BOARD_MEMORY:
-                    numa_idx = 0;
-                    for (const auto &set_it : m_numa_map) {
-                        for (const auto &cpu_it : set_it) {
-                            if (cpu_it == cpu_idx) {
-                                result = numa_idx;
-                                // Find the lowest index numa node that contains the cpu.
-                                break;
-                            }
-                        }
-                        if (result != -1) {
-                            // Find the lowest index numa node that contains the cpu.
-                            break;
-                        }
-                        ++numa_idx;
-                    }
-                    break;
-                case M_DOMAIN_PACKAGE_MEMORY:
-                case M_DOMAIN_BOARD_NIC:
-                case M_DOMAIN_PACKAGE_NIC:
-                case M_DOMAIN_BOARD_ACCELERATOR:
-                case M_DOMAIN_PACKAGE_ACCELERATOR:
-                    /// @todo Add support for package memory NIC and accelerators to domain_idx() method.
-                    throw Exception("PlatformTopo::domain_idx() no support yet for PACKAGE_MEMORY, NIC, or ACCELERATOR",
-                                    GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
-                    break;
-                case M_DOMAIN_INVALID:
-                default:
-                    throw Exception("PlatformTopo::domain_idx() invalid domain specified",
-                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-                    break;
-            }
-        }
-        else {
+        const std::vector<int> &cpu_idx_map = cpu_domain_idx(domain_type);
+        if (cpu_idx < 0 || (size_t)cpu_idx >= cpu_idx_map.size()) {
             throw Exception("PlatformTopo::domain_idx() cpu index (cpu_idx) out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        return result;
+        return cpu_idx_map[cpu_idx];
     }
 
     bool PlatformTopo::is_domain_within(int inner_domain, int outer_domain) const
@@ -483,4 +752,42 @@ namespace geopm
         }
         close_lscpu(fid);
     }
+
+    std::set<int> PlatformTopo::parse_cpu_list(const std::string &cpu_list)
+    {
+        std::set<int> result;
+        std::istringstream list_stream(cpu_list);
+        std::string range;
+        while (std::getline(list_stream, range, ',')) {
+            if (range.find_first_not_of(" \t\n") == std::string::npos) {
+                continue;
+            }
+            size_t dash_pos = range.find('-');
+            try {
+                int first = std::stoi(range.substr(0, dash_pos));
+                int last = dash_pos == std::string::npos ?
+                           first : std::stoi(range.substr(dash_pos + 1));
+                for (int cpu_idx = first; cpu_idx <= last; ++cpu_idx) {
+                    result.insert(cpu_idx);
+                }
+            }
+            catch (const std::logic_error &ex) {
+                throw Exception("PlatformTopo::parse_cpu_list(): invalid CPU list: \"" + cpu_list + "\"",
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+        }
+        return result;
+    }
+
+    std::string PlatformTopo::read_line(const std::string &path)
+    {
+        std::ifstream file(path);
+        std::string result;
+        if (!file.good()) {
+            throw Exception("PlatformTopo::read_line(): unable to open " + path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        std::getline(file, result);
+        return result;
+    }
 }
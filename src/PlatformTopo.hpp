@@ -39,6 +39,7 @@
 #include <map>
 #include <string>
 #include <stdio.h>
+#include <stdint.h>
 
 namespace geopm
 {
@@ -93,6 +94,18 @@ namespace geopm
             ///        index
             virtual int domain_idx(int domain_type,
                                    int cpu_idx) const = 0;
+            /// @brief Get the Linux logical CPUs associated with the
+            ///        indexed domain in ascending order.  Unlike
+            ///        domain_cpus() this does not copy.
+            /// @return Reference to a list that is valid for the
+            ///         lifetime of the object.
+            virtual const std::vector<int> &domain_cpu_list(int domain_type,
+                                                            int domain_idx) const = 0;
+            /// @brief Get the domain index of every Linux logical
+            ///        CPU for a particular domain type.
+            /// @return Reference to a vector over CPUs that is valid
+            ///         for the lifetime of the object.
+            virtual const std::vector<int> &cpu_domain_idx(int domain_type) const = 0;
             /// @brief Define a new domain type that is a group of
             ///        Linux logical CPUs by assigning a domain index
             ///        to each.
@@ -130,8 +143,26 @@ namespace geopm
     class PlatformTopo : public IPlatformTopo
     {
         public:
+            /// @brief Discover the topology from the files under
+            ///        /sys/devices/system.  If the GEOPM_TOPO_CACHE
+            ///        environment variable is set the snapshot it
+            ///        names is used when valid and written
+            ///        otherwise.  Falls back to lscpu if sysfs
+            ///        cannot be read.
             PlatformTopo();
+            /// @brief Parse the output of "lscpu -x" recorded in a
+            ///        file, or run lscpu if the file name is empty.
             PlatformTopo(const std::string &lscpu_file_name);
+            /// @brief Discover the topology from a sysfs tree.
+            /// @param [in] sysfs_path Directory laid out like
+            ///        /sys/devices/system.
+            /// @param [in] snapshot_path Binary snapshot of the
+            ///        topology that is mapped if it was written on
+            ///        this host and matches the online CPUs in
+            ///        sysfs, and written otherwise.
+            ///        The snapshot is not used if empty.
+            PlatformTopo(const std::string &sysfs_path,
+                         const std::string &snapshot_path);
             virtual ~PlatformTopo() = default;
             int num_domain(int domain_type) const override;
             void domain_cpus(int domain_type,
@@ -139,9 +170,31 @@ namespace geopm
                              std::set<int> &cpu_idx) const override;
             int domain_idx(int domain_type,
                            int cpu_idx) const override;
+            const std::vector<int> &domain_cpu_list(int domain_type,
+                                                    int domain_idx) const override;
+            const std::vector<int> &cpu_domain_idx(int domain_type) const override;
             int define_cpu_group(const std::vector<int> &cpu_domain_idx) override;
             bool is_domain_within(int inner_domain, int outer_domain) const override;
         private:
+            void load_lscpu(void);
+            void load_sysfs(const std::string &sysfs_path,
+                            const std::string &snapshot_path);
+            void read_sysfs(const std::string &sysfs_path,
+                            std::vector<int> &cpu_package,
+                            std::vector<int> &cpu_core);
+            bool read_snapshot(const std::string &snapshot_path,
+                               uint64_t online_hash,
+                               uint64_t host_hash,
+                               std::vector<int> &cpu_package,
+                               std::vector<int> &cpu_core);
+            void write_snapshot(const std::string &snapshot_path,
+                                uint64_t online_hash,
+                                uint64_t host_hash) const;
+            /// @brief Fill the per CPU and per domain lookup tables
+            ///        from the package and core index of each CPU
+            ///        and from m_numa_map.
+            void build_table(const std::vector<int> &cpu_package,
+                             const std::vector<int> &cpu_core);
             void lscpu(std::map<std::string, std::string> &lscpu_map);
             void parse_lscpu(const std::map<std::string, std::string> &lscpu_map,
                              int &num_package,
@@ -151,12 +204,21 @@ namespace geopm
                                   std::vector<std::set<int> > &numa_map);
             FILE *open_lscpu(void);
             void close_lscpu(FILE *fid);
+            /// @brief Parse a sysfs CPU list such as "0-3,8,10-11".
+            static std::set<int> parse_cpu_list(const std::string &cpu_list);
+            /// @brief Read the first line of a sysfs file.
+            static std::string read_line(const std::string &path);
 
             const std::string m_lscpu_file_name;
             int m_num_package;
             int m_core_per_package;
             int m_thread_per_core;
             std::vector<std::set<int> > m_numa_map;
+            /// Domain index of each CPU by domain type: the lowest
+            /// NUMA node is used for board memory.
+            std::vector<std::vector<int> > m_cpu_domain_idx;
+            /// Ascending CPU list of each domain by domain type.
+            std::vector<std::vector<std::vector<int> > > m_domain_cpu_list;
     };
 
 }
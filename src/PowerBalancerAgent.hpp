@@ -43,6 +43,7 @@ namespace geopm
     class IPlatformTopo;
     template <class type>
     class ICircularBuffer;
+    class MatrixReduce;
 
     class PowerBalancerAgent : public Agent
     {
@@ -82,6 +83,8 @@ namespace geopm
                          std::vector<std::vector<double> >&out_policy) override;
             bool ascend(const std::vector<std::vector<double> > &in_sample,
                         std::vector<double> &out_sample) override;
+            bool ascend_view(MatrixView<const double> in_sample,
+                             std::vector<double> &out_sample) override;
             bool adjust_platform(const std::vector<double> &in_policy) override;
             bool sample_platform(std::vector<double> &out_sample) override;
             void wait(void) override;
@@ -121,7 +124,12 @@ namespace geopm
 
             std::vector<int> m_control_idx;
 
-            std::vector<std::function<double(const std::vector<double>&)> > m_agg_func;
+            /// MatrixReduce aggregation type for each tree sample.
+            const std::vector<int> m_reduce_type;
+            std::unique_ptr<MatrixReduce> m_reduce;
+            /// Tree samples from the vector interface packed for
+            /// ascend_view().
+            std::vector<double> m_ascend_pack;
 
             int m_num_children;
             bool m_is_root;
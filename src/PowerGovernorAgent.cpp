@@ -39,6 +39,7 @@
 #include "PlatformTopo.hpp"
 #include "Exception.hpp"
 #include "CircularBuffer.hpp"
+#include "MatrixReduce.hpp"
 
 #include "Helper.hpp"
 #include "config.h"
@@ -62,7 +63,9 @@ namespace geopm
         , m_max_power_setting(m_platform_io.read_signal("POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE, 0))
         , m_policy(M_NUM_POLICY, NAN)
         , m_pio_idx(M_PLAT_NUM_SIGNAL)
-        , m_agg_func(M_NUM_SAMPLE)
+        , m_reduce_type({MatrixReduce::M_REDUCE_AVERAGE, // POWER
+                         MatrixReduce::M_REDUCE_AND})    // IS_CONVERGED
+        , m_reduce(geopm::make_unique<MatrixReduce>())
         , m_num_children(0)
         , m_last_power_budget(NAN)
         , m_epoch_power_buf(geopm::make_unique<CircularBuffer<double> >(16)) // Magic number...
@@ -100,10 +103,6 @@ namespace geopm
         else {
             m_num_children = fan_in[level];
         }
-
-        // Setup sample aggregation for data going up the tree
-        m_agg_func[M_SAMPLE_POWER] = IPlatformIO::agg_average;
-        m_agg_func[M_SAMPLE_IS_CONVERGED] = IPlatformIO::agg_and;
     }
 
     void PowerGovernorAgent::init_platform_io(void)
@@ -173,35 +172,48 @@ namespace geopm
     }
 
     bool PowerGovernorAgent::ascend(const std::vector<std::vector<double> > &in_sample, std::vector<double> &out_sample)
+    {
+        m_ascend_pack.resize(in_sample.size() * M_NUM_SAMPLE);
+        for (size_t child_idx = 0; child_idx != in_sample.size(); ++child_idx) {
+#ifdef GEOPM_DEBUG
+            if (in_sample[child_idx].size() != M_NUM_SAMPLE) {
+                throw Exception("PowerGovernorAgent::" + std::string(__func__) + "(): in_sample vector not correctly sized.",
+                                GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+            }
+#endif
+            std::copy(in_sample[child_idx].begin(), in_sample[child_idx].end(),
+                      m_ascend_pack.begin() + child_idx * M_NUM_SAMPLE);
+        }
+        return ascend_view(MatrixView<const double>(m_ascend_pack.data(), in_sample.size(), M_NUM_SAMPLE),
+                           out_sample);
+    }
+
+    bool PowerGovernorAgent::ascend_view(MatrixView<const double> in_sample, std::vector<double> &out_sample)
     {
 #ifdef GEOPM_DEBUG
         if (out_sample.size() != M_NUM_SAMPLE) {
             throw Exception("PowerGovernorAgent::" + std::string(__func__) + "(): out_sample vector not correctly sized.",
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
         }
-        if (in_sample.size() != (size_t)m_num_children) {
-            throw Exception("PowerGovernorAgent::" + std::string(__func__) + "(): in_sample vector not correctly sized.",
+        if (in_sample.num_row() != (size_t)m_num_children ||
+            in_sample.num_col() != M_NUM_SAMPLE) {
+            throw Exception("PowerGovernorAgent::" + std::string(__func__) + "(): in_sample matrix not correctly sized.",
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
         }
 #endif
         bool result = false;
-        m_is_sample_stable = std::all_of(in_sample.begin(), in_sample.end(),
-            [](const std::vector<double> &val)
-            {
-                return val[M_SAMPLE_IS_CONVERGED];
-            });
+        // One pass over the child samples computes the statistics
+        // for every signal.
+        m_reduce->reduce(in_sample);
+        m_is_sample_stable = m_reduce->logical_and(M_SAMPLE_IS_CONVERGED);
 
         // If all children report that they are converged for the last
         // ascend period times, then aggregate the samples and send
         // them up the tree.
         if (m_is_sample_stable && m_ascend_count == 0) {
             result = true;
-            std::vector<double> child_sample(m_num_children);
             for (size_t sig_idx = 0; sig_idx < out_sample.size(); ++sig_idx) {
-                for (int child_idx = 0; child_idx < m_num_children; ++child_idx) {
-                    child_sample[child_idx] = in_sample[child_idx][sig_idx];
-                }
-                out_sample[sig_idx] = m_agg_func[sig_idx](child_sample);
+                out_sample[sig_idx] = m_reduce->value(m_reduce_type[sig_idx], sig_idx);
             }
         }
         // Increment the ascend counter if the children are stable.
@@ -43,6 +43,7 @@ namespace geopm
     class IPlatformTopo;
     template <class type>
     class ICircularBuffer;
+    class MatrixReduce;
 
     class PowerGovernorAgent : public Agent
     {
@@ -76,6 +77,8 @@ namespace geopm
                          std::vector<std::vector<double> >&out_policy) override;
             bool ascend(const std::vector<std::vector<double> > &in_sample,
                         std::vector<double> &out_sample) override;
+            bool ascend_view(MatrixView<const double> in_sample,
+                             std::vector<double> &out_sample) override;
             bool adjust_platform(const std::vector<double> &in_policy) override;
             bool sample_platform(std::vector<double> &out_sample) override;
             void wait(void) override;
@@ -103,7 +106,12 @@ namespace geopm
             std::vector<double> m_policy;
             std::vector<int> m_pio_idx;
             std::vector<int> m_control_idx;
-            std::vector<std::function<double(const std::vector<double>&)> > m_agg_func;
+            /// MatrixReduce aggregation type for each tree sample.
+            const std::vector<int> m_reduce_type;
+            std::unique_ptr<MatrixReduce> m_reduce;
+            /// Tree samples from the vector interface packed for
+            /// ascend_view().
+            std::vector<double> m_ascend_pack;
             int m_num_children;
             double m_last_power_budget;
             std::unique_ptr<ICircularBuffer<double> > m_epoch_power_buf;
@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/types.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "PowercapIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "MSRIO.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+#define GEOPM_POWERCAP_IO_GROUP_PLUGIN_NAME "POWERCAP"
+
+namespace geopm
+{
+    PowercapIOGroup::PowercapIOGroup()
+        : PowercapIOGroup(platform_topo(), "/sys/class/powercap", !MSRIO::is_available())
+    {
+
+    }
+
+    PowercapIOGroup::PowercapIOGroup(IPlatformTopo &topo, const std::string &powercap_path, bool is_alias)
+        : m_num_package(topo.num_domain(IPlatformTopo::M_DOMAIN_PACKAGE))
+        , m_num_memory(topo.num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY))
+        , m_is_active(false)
+        , m_is_read(false)
+        , m_file(M_NUM_FILE_TYPE)
+        , m_file_domain {IPlatformTopo::M_DOMAIN_PACKAGE,
+                         IPlatformTopo::M_DOMAIN_BOARD_MEMORY,
+                         IPlatformTopo::M_DOMAIN_PACKAGE,
+                         IPlatformTopo::M_DOMAIN_PACKAGE,
+                         IPlatformTopo::M_DOMAIN_PACKAGE}
+        , m_is_limit_enabled(m_num_package, false)
+    {
+        scan_zones(powercap_path, is_alias);
+    }
+
+    PowercapIOGroup::~PowercapIOGroup()
+    {
+        for (auto &file_list : m_file) {
+            for (auto &file : file_list) {
+                if (file.read_fd != -1) {
+                    (void)close(file.read_fd);
+                }
+                if (file.write_fd != -1) {
+                    (void)close(file.write_fd);
+                }
+            }
+        }
+    }
+
+    void PowercapIOGroup::scan_zones(const std::string &powercap_path, bool is_alias)
+    {
+        // Zones are named intel-rapl:<pkg zone> and subzones are
+        // named intel-rapl:<pkg zone>:<subzone>.  The zone number
+        // need not match the package, so map through the name
+        // attribute which is "package-<idx>" or "dram".
+        const std::string prefix = "intel-rapl:";
+        std::vector<std::string> zone_list;
+        DIR *did = opendir(powercap_path.c_str());
+        if (!did) {
+            throw Exception("PowercapIOGroup: unable to open " + powercap_path,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        struct dirent *entry;
+        while ((entry = readdir(did))) {
+            std::string name(entry->d_name);
+            if (name.compare(0, prefix.size(), prefix) == 0) {
+                zone_list.push_back(name);
+            }
+        }
+        closedir(did);
+
+        std::map<std::string, int> zone_package;
+        for (const auto &zone : zone_list) {
+            if (zone.find(':', prefix.size()) == std::string::npos) {
+                std::string zone_name = read_line(powercap_path + "/" + zone + "/name");
+                int package_idx = -1;
+                if (sscanf(zone_name.c_str(), "package-%d", &package_idx) == 1 &&
+                    package_idx >= 0) {
+                    zone_package[zone] = package_idx;
+                }
+            }
+        }
+        std::map<int, std::string> package_path;
+        std::map<int, std::string> dram_path;
+        for (const auto &zone : zone_list) {
+            size_t colon = zone.find(':', prefix.size());
+            std::string parent = zone.substr(0, colon);
+            auto parent_it = zone_package.find(parent);
+            if (parent_it == zone_package.end()) {
+                continue;
+            }
+            std::string zone_path = powercap_path + "/" + zone + "/";
+            if (colon == std::string::npos) {
+                package_path[parent_it->second] = zone_path;
+            }
+            else if (read_line(zone_path + "name") == "dram") {
+                dram_path[parent_it->second] = zone_path;
+            }
+        }
+
+        struct m_file_info_s {
+            int file_type;
+            const std::map<int, std::string> &zone_path;
+            std::string attribute;
+            double scale;
+            int num_domain;
+            std::vector<std::string> signal_name;
+            std::vector<std::string> control_name;
+        };
+        std::vector<m_file_info_s> file_info {
+            {M_FILE_ENERGY_PACKAGE, package_path, "energy_uj", 1e-6, m_num_package,
+             {plugin_name() + "::ENERGY_PACKAGE"}, {}},
+            {M_FILE_ENERGY_DRAM, dram_path, "energy_uj", 1e-6, m_num_memory,
+             {plugin_name() + "::ENERGY_DRAM"}, {}},
+            // Constraint zero is the long term power limit
+            {M_FILE_POWER_LIMIT, package_path, "constraint_0_power_limit_uw", 1e-6, m_num_package,
+             {plugin_name() + "::POWER_PACKAGE_LIMIT"},
+             {plugin_name() + "::POWER_PACKAGE_LIMIT"}},
+            {M_FILE_POWER_MAX, package_path, "constraint_0_max_power_uw", 1e-6, m_num_package,
+             {plugin_name() + "::POWER_PACKAGE_MAX"}, {}},
+            // Not exposed, written along with the power limit
+            {M_FILE_POWER_ENABLE, package_path, "enabled", 1.0, m_num_package, {}, {}},
+        };
+        if (is_alias) {
+            file_info[M_FILE_ENERGY_PACKAGE].signal_name.push_back("ENERGY_PACKAGE");
+            file_info[M_FILE_ENERGY_DRAM].signal_name.push_back("ENERGY_DRAM");
+            file_info[M_FILE_POWER_LIMIT].control_name.push_back("POWER_PACKAGE");
+        }
+        for (const auto &info : file_info) {
+            // Only provide a file type if every domain has it
+            bool is_readable = info.num_domain > 0;
+            bool is_writable = is_readable;
+            std::vector<m_file_s> file_list;
+            for (int domain_idx = 0; is_readable && domain_idx < info.num_domain; ++domain_idx) {
+                auto it = info.zone_path.find(domain_idx);
+                if (it == info.zone_path.end()) {
+                    is_readable = false;
+                    break;
+                }
+                std::string path = it->second + info.attribute;
+                is_readable = access(path.c_str(), R_OK) == 0;
+                is_writable = is_writable && access(path.c_str(), W_OK) == 0;
+                uint64_t max_range = 0;
+                if (info.file_type == M_FILE_ENERGY_PACKAGE ||
+                    info.file_type == M_FILE_ENERGY_DRAM) {
+                    std::string range_path = it->second + "max_energy_range_uj";
+                    if (access(range_path.c_str(), R_OK) == 0) {
+                        max_range = strtoull(read_line(range_path).c_str(), NULL, 10);
+                    }
+                }
+                file_list.push_back({path, -1, -1, info.scale, max_range, false, 0, 0});
+            }
+            if (info.file_type == M_FILE_POWER_ENABLE) {
+                is_readable = is_readable && is_writable;
+            }
+            if (is_readable) {
+                m_file[info.file_type] = file_list;
+                for (const auto &name : info.signal_name) {
+                    m_signal_file_type[name] = info.file_type;
+                }
+                if (is_writable) {
+                    for (const auto &name : info.control_name) {
+                        m_control_file_type[name] = info.file_type;
+                    }
+                }
+            }
+        }
+        if (m_file[M_FILE_ENERGY_PACKAGE].empty()) {
+            throw Exception("PowercapIOGroup: no readable intel-rapl package zones found in " + powercap_path,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    std::set<std::string> PowercapIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_signal_file_type) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> PowercapIOGroup::control_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_control_file_type) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    bool PowercapIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_file_type.find(signal_name) != m_signal_file_type.end();
+    }
+
+    bool PowercapIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return m_control_file_type.find(control_name) != m_control_file_type.end();
+    }
+
+    int PowercapIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = PlatformTopo::M_DOMAIN_INVALID;
+        auto it = m_signal_file_type.find(signal_name);
+        if (it != m_signal_file_type.end()) {
+            result = m_file_domain[it->second];
+        }
+        return result;
+    }
+
+    int PowercapIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        int result = PlatformTopo::M_DOMAIN_INVALID;
+        auto it = m_control_file_type.find(control_name);
+        if (it != m_control_file_type.end()) {
+            result = m_file_domain[it->second];
+        }
+        return result;
+    }
+
+    int PowercapIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        check_signal("push_signal", signal_name, domain_type, domain_idx);
+        if (m_is_active) {
+            throw Exception("PowercapIOGroup::push_signal(): cannot push signal after call to read_batch() or write_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::pair<int, int> signal(m_signal_file_type.at(signal_name), domain_idx);
+        auto it = std::find(m_active_signal.begin(), m_active_signal.end(), signal);
+        int result = it - m_active_signal.begin();
+        if (it == m_active_signal.end()) {
+            m_active_signal.push_back(signal);
+            m_signal_value.push_back(NAN);
+        }
+        return result;
+    }
+
+    int PowercapIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        check_control("push_control", control_name, domain_type, domain_idx);
+        if (m_is_active) {
+            throw Exception("PowercapIOGroup::push_control(): cannot push control after call to read_batch() or write_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::pair<int, int> control(m_control_file_type.at(control_name), domain_idx);
+        auto it = std::find(m_active_control.begin(), m_active_control.end(), control);
+        int result = it - m_active_control.begin();
+        if (it == m_active_control.end()) {
+            m_active_control.push_back(control);
+            m_control_value.push_back(NAN);
+            m_is_adjusted.push_back(false);
+        }
+        return result;
+    }
+
+    void PowercapIOGroup::read_batch(void)
+    {
+        m_is_active = true;
+        for (size_t signal_idx = 0; signal_idx < m_active_signal.size(); ++signal_idx) {
+            const auto &signal = m_active_signal[signal_idx];
+            m_signal_value[signal_idx] = read_file(m_file[signal.first][signal.second]);
+        }
+        m_is_read = true;
+    }
+
+    void PowercapIOGroup::write_batch(void)
+    {
+        m_is_active = true;
+        for (size_t control_idx = 0; control_idx < m_active_control.size(); ++control_idx) {
+            // Only write the controls that were adjusted since the
+            // last batch; each write is a round trip through the
+            // kernel's RAPL driver.
+            if (m_is_adjusted[control_idx]) {
+                const auto &control = m_active_control[control_idx];
+                if (control.first == M_FILE_POWER_LIMIT) {
+                    enable_limit(control.second);
+                }
+                write_file(m_file[control.first][control.second], m_control_value[control_idx]);
+                m_is_adjusted[control_idx] = false;
+            }
+        }
+    }
+
+    double PowercapIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_active_signal.size()) {
+            throw Exception("PowercapIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!m_is_read) {
+            throw Exception("PowercapIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_signal_value[batch_idx];
+    }
+
+    void PowercapIOGroup::adjust(int batch_idx, double setting)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_active_control.size()) {
+            throw Exception("PowercapIOGroup::adjust(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_control_value[batch_idx] != setting) {
+            m_control_value[batch_idx] = setting;
+            m_is_adjusted[batch_idx] = true;
+        }
+    }
+
+    double PowercapIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        check_signal("read_signal", signal_name, domain_type, domain_idx);
+        return read_file(m_file[m_signal_file_type.at(signal_name)][domain_idx]);
+    }
+
+    void PowercapIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        check_control("write_control", control_name, domain_type, domain_idx);
+        if (m_control_file_type.at(control_name) == M_FILE_POWER_LIMIT) {
+            enable_limit(domain_idx);
+        }
+        write_file(m_file[m_control_file_type.at(control_name)][domain_idx], setting);
+        // Keep the batch value in step with the file so that a later
+        // adjust() back to the previous batch setting is written.
+        std::pair<int, int> control(m_control_file_type.at(control_name), domain_idx);
+        auto it = std::find(m_active_control.begin(), m_active_control.end(), control);
+        if (it != m_active_control.end()) {
+            size_t control_idx = it - m_active_control.begin();
+            m_control_value[control_idx] = setting;
+            m_is_adjusted[control_idx] = false;
+        }
+    }
+
+    void PowercapIOGroup::save_control(void)
+    {
+        if (is_valid_control(plugin_name() + "::POWER_PACKAGE_LIMIT")) {
+            m_saved_limit.clear();
+            for (auto &file : m_file[M_FILE_POWER_LIMIT]) {
+                m_saved_limit.push_back(read_file(file));
+            }
+            m_saved_enable.clear();
+            for (auto &file : m_file[M_FILE_POWER_ENABLE]) {
+                m_saved_enable.push_back(read_file(file));
+            }
+        }
+    }
+
+    void PowercapIOGroup::restore_control(void)
+    {
+        for (size_t package_idx = 0; package_idx < m_saved_limit.size(); ++package_idx) {
+            write_file(m_file[M_FILE_POWER_LIMIT][package_idx], m_saved_limit[package_idx]);
+        }
+        for (size_t package_idx = 0; package_idx < m_saved_enable.size(); ++package_idx) {
+            write_file(m_file[M_FILE_POWER_ENABLE][package_idx], m_saved_enable[package_idx]);
+            m_is_limit_enabled[package_idx] = false;
+        }
+        // The files no longer hold the batch values; write the next
+        // adjusted value even if it matches the last one.
+        std::fill(m_control_value.begin(), m_control_value.end(), NAN);
+        std::fill(m_is_adjusted.begin(), m_is_adjusted.end(), false);
+    }
+
+    void PowercapIOGroup::enable_limit(int package_idx)
+    {
+        if (!m_file[M_FILE_POWER_ENABLE].empty() &&
+            !m_is_limit_enabled[package_idx]) {
+            write_file(m_file[M_FILE_POWER_ENABLE][package_idx], 1.0);
+            m_is_limit_enabled[package_idx] = true;
+        }
+    }
+
+    std::string PowercapIOGroup::plugin_name(void)
+    {
+        return GEOPM_POWERCAP_IO_GROUP_PLUGIN_NAME;
+    }
+
+    std::unique_ptr<IOGroup> PowercapIOGroup::make_plugin(void)
+    {
+        return std::unique_ptr<IOGroup>(new PowercapIOGroup);
+    }
+
+    void PowercapIOGroup::check_signal(const std::string &func_name, const std::string &signal_name,
+                                       int domain_type, int domain_idx) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("PowercapIOGroup::" + func_name + "(): signal_name " + signal_name +
+                            " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != signal_domain_type(signal_name)) {
+            throw Exception("PowercapIOGroup::" + func_name + "(): domain_type does not match the domain of " +
+                            signal_name, GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= (int)m_file[m_signal_file_type.at(signal_name)].size()) {
+            throw Exception("PowercapIOGroup::" + func_name + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void PowercapIOGroup::check_control(const std::string &func_name, const std::string &control_name,
+                                        int domain_type, int domain_idx) const
+    {
+        if (!is_valid_control(control_name)) {
+            throw Exception("PowercapIOGroup::" + func_name + "(): control_name " + control_name +
+                            " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != control_domain_type(control_name)) {
+            throw Exception("PowercapIOGroup::" + func_name + "(): domain_type does not match the domain of " +
+                            control_name, GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= (int)m_file[m_control_file_type.at(control_name)].size()) {
+            throw Exception("PowercapIOGroup::" + func_name + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    double PowercapIOGroup::read_file(m_file_s &file)
+    {
+        if (file.read_fd == -1) {
+            file.read_fd = open(file.path.c_str(), O_RDONLY);
+            if (file.read_fd == -1) {
+                throw Exception("PowercapIOGroup: unable to open " + file.path + " for reading",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        }
+        uint64_t value = read_uint(file.read_fd, file.path);
+        if (file.max_range) {
+            // The counter wraps to zero after reaching max_range
+            if (file.is_read && value < file.last_value) {
+                file.overflow_offset += file.max_range + 1;
+            }
+            file.last_value = value;
+            file.is_read = true;
+            value += file.overflow_offset;
+        }
+        // Energy and power files are in micro-joules or micro-watts
+        return value * file.scale;
+    }
+
+    void PowercapIOGroup::write_file(m_file_s &file, double setting)
+    {
+        if (!(setting >= 0.0)) {
+            throw Exception("PowercapIOGroup: invalid setting for " + file.path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (file.write_fd == -1) {
+            file.write_fd = open(file.path.c_str(), O_WRONLY);
+            if (file.write_fd == -1) {
+                throw Exception("PowercapIOGroup: unable to open " + file.path + " for writing",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        }
+        std::string value = std::to_string((uint64_t)(setting / file.scale + 0.5)) + "\n";
+        if (pwrite(file.write_fd, value.c_str(), value.size(), 0) != (ssize_t)value.size()) {
+            throw Exception("PowercapIOGroup: unable to write " + file.path,
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    uint64_t PowercapIOGroup::read_uint(int fd, const std::string &path)
+    {
+        char buffer[64];
+        ssize_t num_byte = pread(fd, buffer, sizeof(buffer) - 1, 0);
+        if (num_byte <= 0) {
+            throw Exception("PowercapIOGroup: unable to read " + path,
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        buffer[num_byte] = '\0';
+        char *end = NULL;
+        errno = 0;
+        uint64_t result = strtoull(buffer, &end, 10);
+        if (errno || end == buffer || (*end != '\0' && *end != '\n')) {
+            throw Exception("PowercapIOGroup: unable to parse " + path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    std::string PowercapIOGroup::read_line(const std::string &path)
+    {
+        std::ifstream file(path);
+        std::string result;
+        if (!file.good()) {
+            throw Exception("PowercapIOGroup: unable to open " + path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        std::getline(file, result);
+        return result;
+    }
+}
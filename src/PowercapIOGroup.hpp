@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef POWERCAPIOGROUP_HPP_INCLUDE
+#define POWERCAPIOGROUP_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "IOGroup.hpp"
+
+namespace geopm
+{
+    class IPlatformTopo;
+
+    /// @brief IOGroup that provides RAPL energy signals and power
+    ///        limit controls through the Linux powercap sysfs
+    ///        interface, for systems where the MSR driver is not
+    ///        available.
+    ///
+    /// Files are opened on first use and kept open; every pushed
+    /// signal is sampled by read_batch() with one pread(2) at offset
+    /// zero.  Energy counters are extended beyond
+    /// max_energy_range_uj by tracking wraparound between reads.
+    ///
+    /// The high level aliases ENERGY_PACKAGE, ENERGY_DRAM and
+    /// POWER_PACKAGE are only provided when the MSR driver is not
+    /// usable, so that the MSRIOGroup remains the provider of those
+    /// names on systems that have both interfaces.
+    ///
+    /// A package power limit is only applied by the driver while the
+    /// zone's "enabled" attribute is set, so the first write of the
+    /// limit to a package also writes enabled=1, in the way the
+    /// MSRIOGroup sets PKG_POWER_LIMIT:SOFT_LIMIT_ENABLE.  The
+    /// attribute is saved and restored along with the limit.
+    class PowercapIOGroup : public IOGroup
+    {
+        public:
+            PowercapIOGroup();
+            /// @brief Constructor used for testing.
+            /// @param [in] topo Platform topology that provides the
+            ///        number of packages and memory domains.
+            /// @param [in] powercap_path Directory that holds the
+            ///        intel-rapl zones, normally
+            ///        /sys/class/powercap.
+            /// @param [in] is_alias If true provide the high level
+            ///        signal and control aliases.
+            PowercapIOGroup(IPlatformTopo &topo, const std::string &powercap_path, bool is_alias);
+            virtual ~PowercapIOGroup();
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            static std::string plugin_name(void);
+            static std::unique_ptr<IOGroup> make_plugin(void);
+        private:
+            enum m_file_type_e {
+                M_FILE_ENERGY_PACKAGE,
+                M_FILE_ENERGY_DRAM,
+                M_FILE_POWER_LIMIT,
+                M_FILE_POWER_MAX,
+                M_FILE_POWER_ENABLE,
+                M_NUM_FILE_TYPE,
+            };
+            /// @brief One sysfs attribute of one RAPL zone.
+            struct m_file_s {
+                std::string path;
+                int read_fd;
+                int write_fd;
+                /// Factor from the file contents to the signal units.
+                double scale;
+                /// Wraparound value for energy counters, zero otherwise.
+                uint64_t max_range;
+                bool is_read;
+                uint64_t last_value;
+                uint64_t overflow_offset;
+            };
+            void scan_zones(const std::string &powercap_path, bool is_alias);
+            void check_signal(const std::string &func_name, const std::string &signal_name,
+                              int domain_type, int domain_idx) const;
+            void check_control(const std::string &func_name, const std::string &control_name,
+                               int domain_type, int domain_idx) const;
+            /// @brief Set the enabled attribute of the package zone
+            ///        before its power limit is first written.
+            void enable_limit(int package_idx);
+            double read_file(m_file_s &file);
+            void write_file(m_file_s &file, double setting);
+            static uint64_t read_uint(int fd, const std::string &path);
+            static std::string read_line(const std::string &path);
+
+            const int m_num_package;
+            const int m_num_memory;
+            bool m_is_active;
+            bool m_is_read;
+            /// Files indexed by [file type][domain index]
+            std::vector<std::vector<m_file_s> > m_file;
+            std::vector<int> m_file_domain;
+            std::map<std::string, int> m_signal_file_type;
+            std::map<std::string, int> m_control_file_type;
+            /// Pushed signals and controls as (file type, domain index).
+            std::vector<std::pair<int, int> > m_active_signal;
+            std::vector<double> m_signal_value;
+            std::vector<std::pair<int, int> > m_active_control;
+            std::vector<double> m_control_value;
+            std::vector<bool> m_is_adjusted;
+            std::vector<double> m_saved_limit;
+            std::vector<double> m_saved_enable;
+            std::vector<bool> m_is_limit_enabled;
+    };
+}
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cmath>
+#include <sstream>
+#include <iostream>
+
+#include "RegionFreqCache.hpp"
+#include "Exception.hpp"
+#include "geopm_hash.h"
+#include "config.h"
+
+namespace geopm
+{
+    /// @brief Holds a flock(2) for the duration of a scope.
+    class RegionFreqCacheLock
+    {
+        public:
+            RegionFreqCacheLock(int fd, int operation)
+                : m_fd(fd)
+            {
+                if (flock(m_fd, operation)) {
+                    throw Exception("RegionFreqCache: flock() failed",
+                                    errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+            }
+            virtual ~RegionFreqCacheLock()
+            {
+                (void) flock(m_fd, LOCK_UN);
+            }
+        private:
+            int m_fd;
+    };
+
+    RegionFreqCache::RegionFreqCache(const std::string &path, uint64_t host_class)
+        : m_path(path)
+        , m_host_class(host_class)
+        , m_fd(-1)
+        , m_cache(nullptr)
+    {
+        m_fd = open(m_path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+        if (m_fd < 0) {
+            throw Exception("RegionFreqCache: could not open cache file \"" + m_path + "\"",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        try {
+            RegionFreqCacheLock lock(m_fd, LOCK_EX);
+            struct stat stat_struct;
+            if (fstat(m_fd, &stat_struct)) {
+                throw Exception("RegionFreqCache: fstat() failed on \"" + m_path + "\"",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            bool is_new = stat_struct.st_size == 0;
+            if (is_new && ftruncate(m_fd, sizeof(struct geopm_region_freq_cache_s))) {
+                throw Exception("RegionFreqCache: could not extend \"" + m_path + "\"",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            else if (!is_new && (size_t)stat_struct.st_size != sizeof(struct geopm_region_freq_cache_s)) {
+                throw Exception("RegionFreqCache: \"" + m_path + "\" is not a region frequency cache",
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            void *ptr = mmap(NULL, sizeof(struct geopm_region_freq_cache_s),
+                             PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+            if (ptr == MAP_FAILED) {
+                throw Exception("RegionFreqCache: could not mmap \"" + m_path + "\"",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            m_cache = (struct geopm_region_freq_cache_s *)ptr;
+            if (is_new) {
+                m_cache->magic = GEOPM_REGION_FREQ_CACHE_MAGIC;
+                m_cache->capacity = GEOPM_REGION_FREQ_CACHE_CAPACITY;
+            }
+            else if (m_cache->magic != GEOPM_REGION_FREQ_CACHE_MAGIC ||
+                     m_cache->capacity != GEOPM_REGION_FREQ_CACHE_CAPACITY) {
+                (void) munmap(m_cache, sizeof(struct geopm_region_freq_cache_s));
+                m_cache = nullptr;
+                throw Exception("RegionFreqCache: \"" + m_path + "\" is not a region frequency cache",
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+        }
+        catch (...) {
+            (void) close(m_fd);
+            throw;
+        }
+    }
+
+    RegionFreqCache::~RegionFreqCache()
+    {
+        if (munmap(m_cache, sizeof(struct geopm_region_freq_cache_s))) {
+#ifdef GEOPM_DEBUG
+            std::cerr << "Warning: " << Exception("RegionFreqCache: Could not unmap pointer",
+                                                  errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__).what() << std::endl;
+#endif
+        }
+        (void) close(m_fd);
+    }
+
+    struct geopm_region_freq_entry_s *RegionFreqCache::find(uint64_t region_hash) const
+    {
+        struct geopm_region_freq_entry_s *result = nullptr;
+        size_t slot = geopm_crc32_u64(region_hash, m_host_class) % GEOPM_REGION_FREQ_CACHE_CAPACITY;
+        for (size_t probe = 0; !result && probe != GEOPM_REGION_FREQ_CACHE_CAPACITY; ++probe) {
+            struct geopm_region_freq_entry_s *entry = m_cache->entry + slot;
+            if (entry->num_update == 0 ||
+                (entry->region_hash == region_hash && entry->host_class == m_host_class)) {
+                result = entry;
+            }
+            slot = (slot + 1) % GEOPM_REGION_FREQ_CACHE_CAPACITY;
+        }
+        return result;
+    }
+
+    double RegionFreqCache::freq(uint64_t region_hash) const
+    {
+        RegionFreqCacheLock lock(m_fd, LOCK_SH);
+        double result = NAN;
+        struct geopm_region_freq_entry_s *entry = find(region_hash);
+        if (entry && entry->num_update) {
+            result = entry->freq;
+        }
+        return result;
+    }
+
+    void RegionFreqCache::update(uint64_t region_hash, double freq)
+    {
+        RegionFreqCacheLock lock(m_fd, LOCK_EX);
+        struct geopm_region_freq_entry_s *entry = find(region_hash);
+        if (!entry) {
+            // Table is full; the region will be learned again by
+            // the next job.
+            return;
+        }
+        entry->region_hash = region_hash;
+        entry->host_class = m_host_class;
+        entry->freq = freq;
+        ++entry->num_update;
+    }
+
+    uint64_t RegionFreqCache::host_class(double freq_min, double freq_max,
+                                         double freq_step, int num_cpu)
+    {
+        std::ostringstream host_str;
+        host_str << freq_min << ":" << freq_max << ":" << freq_step << ":" << num_cpu;
+        return geopm_crc32_str(0, host_str.str().c_str());
+    }
+}
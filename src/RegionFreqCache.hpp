@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef REGIONFREQCACHE_HPP_INCLUDE
+#define REGIONFREQCACHE_HPP_INCLUDE
+
+#include <stdint.h>
+#include <string>
+
+namespace geopm
+{
+    enum geopm_region_freq_cache_e {
+        GEOPM_REGION_FREQ_CACHE_MAGIC = 0x63716667,
+        GEOPM_REGION_FREQ_CACHE_CAPACITY = 4096,
+    };
+
+    /// @brief One learned frequency in the cache file.  An entry
+    ///        with num_update of zero is empty.
+    struct geopm_region_freq_entry_s {
+        uint64_t region_hash;
+        uint64_t host_class;
+        double freq;
+        uint64_t num_update;
+    };
+
+    /// @brief Layout of the cache file: a header followed by an
+    ///        open addressed hash table of entries.
+    struct geopm_region_freq_cache_s {
+        uint64_t magic;
+        uint64_t capacity;
+        struct geopm_region_freq_entry_s entry[GEOPM_REGION_FREQ_CACHE_CAPACITY];
+    };
+
+    class IRegionFreqCache
+    {
+        public:
+            IRegionFreqCache() = default;
+            virtual ~IRegionFreqCache() = default;
+            /// @brief Frequency previously learned for a region on
+            ///        this class of host.
+            /// @param [in] region_hash Hash of the region name.
+            /// @return The frequency, or NAN if none is cached.
+            virtual double freq(uint64_t region_hash) const = 0;
+            /// @brief Store the frequency learned for a region,
+            ///        replacing any previous value.
+            /// @param [in] region_hash Hash of the region name.
+            /// @param [in] freq Learned frequency.
+            virtual void update(uint64_t region_hash, double freq) = 0;
+    };
+
+    /// @brief Region frequency cache persisted in a memory mapped
+    ///        file so that a new job can start from the frequencies
+    ///        learned by previous jobs of the same application.
+    ///        Entries are keyed by region hash and host class so
+    ///        that a file shared between different kinds of nodes
+    ///        does not mix their results.  Accesses are serialized
+    ///        between processes with flock(2).
+    class RegionFreqCache : public IRegionFreqCache
+    {
+        public:
+            /// @brief Open the cache file, creating it if it does
+            ///        not exist.
+            /// @param [in] path Path of the cache file.
+            /// @param [in] host_class Identifies the kind of node,
+            ///        see host_class().
+            RegionFreqCache(const std::string &path, uint64_t host_class);
+            virtual ~RegionFreqCache();
+            double freq(uint64_t region_hash) const override;
+            void update(uint64_t region_hash, double freq) override;
+            /// @brief Hash of the frequency range and CPU count of a
+            ///        node, used as the host class.
+            static uint64_t host_class(double freq_min, double freq_max,
+                                       double freq_step, int num_cpu);
+        private:
+            /// @brief Slot holding the region, or the empty slot
+            ///        where it would be inserted, or nullptr if the
+            ///        table is full.
+            struct geopm_region_freq_entry_s *find(uint64_t region_hash) const;
+
+            std::string m_path;
+            uint64_t m_host_class;
+            int m_fd;
+            struct geopm_region_freq_cache_s *m_cache;
+    };
+}
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+
+#include "RegionTransitionGraph.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    RegionTransitionGraph::RegionTransitionGraph()
+        : m_last_region_id(GEOPM_REGION_ID_UNDEFINED)
+    {
+
+    }
+
+    void RegionTransitionGraph::update(const std::list<geopm_region_info_s> &region_info)
+    {
+        for (const auto &info : region_info) {
+            if (info.progress == 0.0) {
+                entry(info.region_id);
+            }
+            else if (info.progress == 1.0) {
+                exit(info.region_id, info.runtime);
+            }
+        }
+    }
+
+    void RegionTransitionGraph::entry(uint64_t region_id)
+    {
+        // Ensure the region has a node even before it is exited
+        m_node.emplace(region_id, m_node_s {{}, 0, 0, 0.0});
+        if (m_last_region_id != GEOPM_REGION_ID_UNDEFINED) {
+            auto &last_node = m_node[m_last_region_id];
+            ++last_node.num_successor[region_id];
+            ++last_node.num_transition;
+        }
+        m_last_region_id = region_id;
+    }
+
+    void RegionTransitionGraph::exit(uint64_t region_id, double runtime)
+    {
+        if (std::isnan(runtime)) {
+            return;
+        }
+        auto node_it = m_node.find(region_id);
+        if (node_it != m_node.end()) {
+            ++node_it->second.num_exit;
+            node_it->second.total_runtime += runtime;
+        }
+    }
+
+    uint64_t RegionTransitionGraph::next_region(uint64_t region_id) const
+    {
+        uint64_t result = GEOPM_REGION_ID_UNDEFINED;
+        auto node_it = m_node.find(region_id);
+        if (node_it != m_node.end()) {
+            size_t max_count = 0;
+            for (const auto &succ : node_it->second.num_successor) {
+                if (succ.second > max_count) {
+                    max_count = succ.second;
+                    result = succ.first;
+                }
+            }
+        }
+        return result;
+    }
+
+    double RegionTransitionGraph::probability(uint64_t region_id, uint64_t next_region_id) const
+    {
+        double result = 0.0;
+        auto node_it = m_node.find(region_id);
+        if (node_it != m_node.end() && node_it->second.num_transition) {
+            auto succ_it = node_it->second.num_successor.find(next_region_id);
+            if (succ_it != node_it->second.num_successor.end()) {
+                result = (double)succ_it->second / node_it->second.num_transition;
+            }
+        }
+        return result;
+    }
+
+    double RegionTransitionGraph::mean_duration(uint64_t region_id) const
+    {
+        double result = NAN;
+        auto node_it = m_node.find(region_id);
+        if (node_it != m_node.end() && node_it->second.num_exit) {
+            result = node_it->second.total_runtime / node_it->second.num_exit;
+        }
+        return result;
+    }
+
+    uint64_t RegionTransitionGraph::predict(uint64_t region_id, double elapsed, double horizon) const
+    {
+        uint64_t result = region_id;
+        auto node_it = m_node.find(region_id);
+        if (node_it != m_node.end() &&
+            node_it->second.num_transition >= M_MIN_TRANSITION &&
+            elapsed + 0.5 * horizon >= mean_duration(region_id)) {
+            uint64_t next_region_id = next_region(region_id);
+            if (probability(region_id, next_region_id) > M_MIN_PROBABILITY) {
+                result = next_region_id;
+            }
+        }
+        return result;
+    }
+
+    std::vector<uint64_t> RegionTransitionGraph::region_ids(void) const
+    {
+        std::vector<uint64_t> result;
+        result.reserve(m_node.size());
+        for (const auto &node : m_node) {
+            result.push_back(node.first);
+        }
+        return result;
+    }
+}
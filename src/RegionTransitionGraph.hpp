@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef REGIONTRANSITIONGRAPH_HPP_INCLUDE
+#define REGIONTRANSITIONGRAPH_HPP_INCLUDE
+
+#include <stdint.h>
+#include <list>
+#include <map>
+#include <vector>
+
+#include "geopm_message.h"
+
+namespace geopm
+{
+    /// @brief Learns which region follows each region and how long
+    ///        each region typically runs from the stream of region
+    ///        entries and exits reported by the application.  Used
+    ///        to predict the next region before it is entered.
+    class RegionTransitionGraph
+    {
+        public:
+            RegionTransitionGraph();
+            virtual ~RegionTransitionGraph() = default;
+            /// @brief Learn from entries and exits in the order they
+            ///        occurred, as returned by
+            ///        IApplicationIO::region_info().
+            void update(const std::list<geopm_region_info_s> &region_info);
+            /// @brief Record entry into a region.  The transition
+            ///        from the previously entered region is counted.
+            void entry(uint64_t region_id);
+            /// @brief Record exit from a region.
+            /// @param [in] region_id Region exited.
+            /// @param [in] runtime Time spent in the region in
+            ///        seconds.
+            void exit(uint64_t region_id, double runtime);
+            /// @brief Most frequent successor of a region, or
+            ///        GEOPM_REGION_ID_UNDEFINED if none is known.
+            uint64_t next_region(uint64_t region_id) const;
+            /// @brief Fraction of the transitions out of a region
+            ///        that went to a given successor.
+            double probability(uint64_t region_id, uint64_t next_region_id) const;
+            /// @brief Mean runtime of a region in seconds, or NAN if
+            ///        it has not been exited.
+            double mean_duration(uint64_t region_id) const;
+            /// @brief Region expected to be running for most of a
+            ///        time horizon.
+            /// @param [in] region_id Region currently running.
+            /// @param [in] elapsed Time since the region was entered
+            ///        in seconds.
+            /// @param [in] horizon Time until the next opportunity
+            ///        to act in seconds.
+            /// @return The likely successor when the region is
+            ///         expected to end within the first half of the
+            ///         horizon and its successor is predictable,
+            ///         otherwise region_id.
+            uint64_t predict(uint64_t region_id, double elapsed, double horizon) const;
+            /// @brief All regions that have been entered.
+            std::vector<uint64_t> region_ids(void) const;
+        private:
+            struct m_node_s {
+                std::map<uint64_t, size_t> num_successor;
+                size_t num_transition;
+                size_t num_exit;
+                double total_runtime;
+            };
+            /// Share of transitions a successor must exceed to be
+            /// predicted.
+            const double M_MIN_PROBABILITY = 0.5;
+            /// Transitions out of a region observed before it is
+            /// predicted from.
+            const size_t M_MIN_TRANSITION = 2;
+            std::map<uint64_t, struct m_node_s> m_node;
+            uint64_t m_last_region_id;
+    };
+}
+
+#endif
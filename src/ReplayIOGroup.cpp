@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "ReplayIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    ReplayIOGroup::ReplayIOGroup(const std::string &log_path)
+        : m_log(log_path)
+        , m_num_read(0)
+        , m_setting(m_log.control().size(), NAN)
+        , m_write_idx(0)
+        , m_num_write(0)
+        , m_num_mismatch(0)
+    {
+        int column = 0;
+        for (const auto &req : m_log.signal()) {
+            m_signal_domain.emplace(req.name, req.domain_type);
+            m_signal_column[key(req)] = column;
+            ++column;
+        }
+        column = 0;
+        for (const auto &req : m_log.control()) {
+            m_control_domain.emplace(req.name, req.domain_type);
+            m_control_column[key(req)] = column;
+            ++column;
+        }
+        for (const auto &it : m_log.read_signal()) {
+            m_signal_domain.emplace(it.first.name, it.first.domain_type);
+            m_read_signal[key(it.first)].first.push_back(it.second);
+        }
+        for (const auto &it : m_log.write_control()) {
+            m_control_domain.emplace(it.first.name, it.first.domain_type);
+            m_write_control[key(it.first)].first.push_back(it.second);
+        }
+    }
+
+    ReplayIOGroup::m_key_t ReplayIOGroup::key(const IPlatformIO::m_request_s &request)
+    {
+        return m_key_t(request.name, request.domain_type, request.domain_idx);
+    }
+
+    bool ReplayIOGroup::is_equal(double lhs, double rhs)
+    {
+        bool result = std::isnan(lhs) && std::isnan(rhs);
+        if (!std::isnan(lhs) && !std::isnan(rhs)) {
+            result = std::fabs(lhs - rhs) <= 1e-9 * std::max(std::fabs(lhs), std::fabs(rhs));
+        }
+        return result;
+    }
+
+    std::set<std::string> ReplayIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_signal_domain) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> ReplayIOGroup::control_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_control_domain) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    bool ReplayIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_domain.find(signal_name) != m_signal_domain.end();
+    }
+
+    bool ReplayIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return m_control_domain.find(control_name) != m_control_domain.end();
+    }
+
+    int ReplayIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = PlatformTopo::M_DOMAIN_INVALID;
+        auto it = m_signal_domain.find(signal_name);
+        if (it != m_signal_domain.end()) {
+            result = it->second;
+        }
+        return result;
+    }
+
+    int ReplayIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        int result = PlatformTopo::M_DOMAIN_INVALID;
+        auto it = m_control_domain.find(control_name);
+        if (it != m_control_domain.end()) {
+            result = it->second;
+        }
+        return result;
+    }
+
+    int ReplayIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        if (m_num_read) {
+            throw Exception("ReplayIOGroup::push_signal(): cannot push a signal after read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        auto col_it = m_signal_column.find(m_key_t(signal_name, domain_type, domain_idx));
+        if (col_it == m_signal_column.end()) {
+            throw Exception("ReplayIOGroup::push_signal(): signal " + signal_name +
+                            " was not recorded for domain type " + std::to_string(domain_type) +
+                            " and index " + std::to_string(domain_idx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = m_active_signal.size();
+        auto active_it = std::find(m_active_signal.begin(), m_active_signal.end(), col_it->second);
+        if (active_it != m_active_signal.end()) {
+            result = active_it - m_active_signal.begin();
+        }
+        else {
+            m_active_signal.push_back(col_it->second);
+        }
+        return result;
+    }
+
+    int ReplayIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        if (m_num_read) {
+            throw Exception("ReplayIOGroup::push_control(): cannot push a control after read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        auto col_it = m_control_column.find(m_key_t(control_name, domain_type, domain_idx));
+        if (col_it == m_control_column.end()) {
+            throw Exception("ReplayIOGroup::push_control(): control " + control_name +
+                            " was not recorded for domain type " + std::to_string(domain_type) +
+                            " and index " + std::to_string(domain_idx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = m_active_control.size();
+        auto active_it = std::find(m_active_control.begin(), m_active_control.end(), col_it->second);
+        if (active_it != m_active_control.end()) {
+            result = active_it - m_active_control.begin();
+        }
+        else {
+            m_active_control.push_back(col_it->second);
+        }
+        return result;
+    }
+
+    void ReplayIOGroup::read_batch(void)
+    {
+        if (m_num_read == m_log.read().size()) {
+            throw Exception("ReplayIOGroup::read_batch(): reached the end of the replay log",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        ++m_num_read;
+    }
+
+    void ReplayIOGroup::write_batch(void)
+    {
+        const auto &write = m_log.write();
+        // Recorded writes made before the previous read were skipped
+        while (m_write_idx < write.size() && write[m_write_idx].num_read < m_num_read) {
+            ++m_write_idx;
+            ++m_num_mismatch;
+        }
+        bool is_match = m_write_idx < write.size() && write[m_write_idx].num_read == m_num_read;
+        if (is_match) {
+            const std::vector<double> &recorded = write[m_write_idx].setting;
+            for (size_t col = 0; is_match && col < recorded.size(); ++col) {
+                is_match = is_equal(m_setting[col], recorded[col]);
+            }
+            ++m_write_idx;
+        }
+        if (!is_match) {
+            ++m_num_mismatch;
+        }
+        ++m_num_write;
+        std::fill(m_setting.begin(), m_setting.end(), NAN);
+    }
+
+    double ReplayIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || (size_t)batch_idx >= m_active_signal.size()) {
+            throw Exception("ReplayIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!m_num_read) {
+            throw Exception("ReplayIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return m_log.read()[m_num_read - 1][m_active_signal[batch_idx]];
+    }
+
+    void ReplayIOGroup::adjust(int batch_idx, double setting)
+    {
+        if (batch_idx < 0 || (size_t)batch_idx >= m_active_control.size()) {
+            throw Exception("ReplayIOGroup::adjust(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_setting[m_active_control[batch_idx]] = setting;
+    }
+
+    double ReplayIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        double result = NAN;
+        m_key_t req_key(signal_name, domain_type, domain_idx);
+        auto read_it = m_read_signal.find(req_key);
+        auto col_it = m_signal_column.find(req_key);
+        if (read_it != m_read_signal.end()) {
+            // Return the recorded results in order, then repeat the last
+            auto &value = read_it->second.first;
+            size_t &value_idx = read_it->second.second;
+            result = value[std::min(value_idx, value.size() - 1)];
+            ++value_idx;
+        }
+        else if (col_it != m_signal_column.end() && m_num_read) {
+            result = m_log.read()[m_num_read - 1][col_it->second];
+        }
+        else {
+            throw Exception("ReplayIOGroup::read_signal(): signal " + signal_name +
+                            " was not recorded for domain type " + std::to_string(domain_type) +
+                            " and index " + std::to_string(domain_idx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    void ReplayIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        if (!is_valid_control(control_name)) {
+            throw Exception("ReplayIOGroup::write_control(): control " + control_name + " was not recorded",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        bool is_match = false;
+        auto write_it = m_write_control.find(m_key_t(control_name, domain_type, domain_idx));
+        if (write_it != m_write_control.end()) {
+            auto &recorded = write_it->second.first;
+            size_t &recorded_idx = write_it->second.second;
+            is_match = recorded_idx < recorded.size() &&
+                       is_equal(setting, recorded[recorded_idx]);
+            ++recorded_idx;
+        }
+        if (!is_match) {
+            ++m_num_mismatch;
+        }
+    }
+
+    void ReplayIOGroup::save_control(void)
+    {
+
+    }
+
+    void ReplayIOGroup::restore_control(void)
+    {
+
+    }
+
+    size_t ReplayIOGroup::num_read_record(void) const
+    {
+        return m_log.read().size();
+    }
+
+    size_t ReplayIOGroup::num_write(void) const
+    {
+        return m_num_write;
+    }
+
+    size_t ReplayIOGroup::num_mismatch(void) const
+    {
+        size_t result = m_num_mismatch;
+        const auto &write = m_log.write();
+        // Once the last record is read no more writes are expected
+        bool is_end = m_num_read == m_log.read().size();
+        for (size_t write_idx = m_write_idx;
+             write_idx < write.size() && (is_end || write[write_idx].num_read < m_num_read);
+             ++write_idx) {
+            ++result;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef REPLAYIOGROUP_HPP_INCLUDE
+#define REPLAYIOGROUP_HPP_INCLUDE
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "IOGroup.hpp"
+#include "ReplayLog.hpp"
+
+namespace geopm
+{
+    /// @brief IOGroup that plays back a log recorded by PlatformIO
+    ///        when GEOPM_RECORD is set, so that an agent can be run
+    ///        and benchmarked without the hardware or the job that
+    ///        produced the log.
+    ///
+    /// The signals and controls are the ones recorded, and each may
+    /// only be pushed with the domain that was recorded.  Every
+    /// read_batch() steps to the next read record of the log.
+    /// Settings are not applied to anything: each write_batch() is
+    /// compared with the write recorded after the same number of
+    /// reads, and the writes that differ are counted so that a
+    /// change to an agent can be checked against the decisions made
+    /// when the log was recorded.  In the same way every
+    /// write_control() is compared with the next setting recorded
+    /// for that request.
+    class ReplayIOGroup : public IOGroup
+    {
+        public:
+            /// @param [in] log_path Path of a log written by the
+            ///        ReplayLogWriter.
+            ReplayIOGroup(const std::string &log_path);
+            virtual ~ReplayIOGroup() = default;
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            /// @brief Number of read records in the log, which
+            ///        bounds the number of calls to read_batch().
+            size_t num_read_record(void) const;
+            /// @brief Number of calls to write_batch().
+            size_t num_write(void) const;
+            /// @brief Number of writes that differ from the log.
+            ///        This counts calls to write_batch() with
+            ///        settings that do not match the recorded write,
+            ///        or with no recorded write at that point, and
+            ///        recorded writes that were not made before the
+            ///        last read_batch() or, once the log has been
+            ///        read to the end, not made at all.  Calls to
+            ///        write_control() that differ from the next
+            ///        setting recorded for the request are also
+            ///        counted.
+            size_t num_mismatch(void) const;
+        private:
+            typedef std::tuple<std::string, int, int> m_key_t;
+            static m_key_t key(const IPlatformIO::m_request_s &request);
+            static bool is_equal(double lhs, double rhs);
+
+            ReplayLogReader m_log;
+            std::map<std::string, int> m_signal_domain;
+            std::map<std::string, int> m_control_domain;
+            /// Column of each recorded request in the log
+            std::map<m_key_t, int> m_signal_column;
+            std::map<m_key_t, int> m_control_column;
+            /// Recorded results of read_signal() and the number
+            /// already returned
+            std::map<m_key_t, std::pair<std::vector<double>, size_t> > m_read_signal;
+            /// Recorded settings of write_control() and the number
+            /// already compared
+            std::map<m_key_t, std::pair<std::vector<double>, size_t> > m_write_control;
+            /// Log column of each pushed signal and control
+            std::vector<int> m_active_signal;
+            std::vector<int> m_active_control;
+            size_t m_num_read;
+            std::vector<double> m_setting;
+            size_t m_write_idx;
+            size_t m_num_write;
+            size_t m_num_mismatch;
+    };
+}
+
+#endif
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <cmath>
+
+#include "ReplayLog.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    ReplayLogWriter::ReplayLogWriter(const std::string &path,
+                                     const std::vector<IPlatformIO::m_request_s> &signal,
+                                     const std::vector<IPlatformIO::m_request_s> &control)
+        : m_stream(path, std::ios::binary)
+        , m_num_signal(signal.size())
+        , m_num_control(control.size())
+    {
+        if (!m_stream.good()) {
+            throw Exception("ReplayLogWriter: unable to open replay log '" + path +
+                            "': " + strerror(errno), GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        m_stream << header() << "\n";
+        write_request(signal);
+        write_request(control);
+    }
+
+    const std::string &ReplayLogWriter::header(void)
+    {
+        static const std::string instance = "GEOPM_REPLAY 1";
+        return instance;
+    }
+
+    void ReplayLogWriter::write_request(const std::vector<IPlatformIO::m_request_s> &request)
+    {
+        uint32_t num_request = request.size();
+        m_stream.write((const char *)&num_request, sizeof(num_request));
+        for (const auto &req : request) {
+            write_request(req);
+        }
+    }
+
+    void ReplayLogWriter::write_request(const IPlatformIO::m_request_s &request)
+    {
+        uint32_t name_size = request.name.size();
+        int32_t domain[2] = {request.domain_type, request.domain_idx};
+        m_stream.write((const char *)&name_size, sizeof(name_size));
+        m_stream.write(request.name.data(), name_size);
+        m_stream.write((const char *)domain, sizeof(domain));
+    }
+
+    void ReplayLogWriter::read(const std::vector<double> &value)
+    {
+        if (value.size() != m_num_signal) {
+            throw Exception("ReplayLogWriter::read(): number of values does not match the number of signals",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        write_record(M_RECORD_READ, value);
+    }
+
+    void ReplayLogWriter::write(const std::vector<double> &setting)
+    {
+        if (setting.size() != m_num_control) {
+            throw Exception("ReplayLogWriter::write(): number of settings does not match the number of controls",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        write_record(M_RECORD_WRITE, setting);
+    }
+
+    void ReplayLogWriter::read_signal(const IPlatformIO::m_request_s &request, double value)
+    {
+        m_stream.put(M_RECORD_READ_SIGNAL);
+        write_request(request);
+        m_stream.write((const char *)&value, sizeof(value));
+    }
+
+    void ReplayLogWriter::write_control(const IPlatformIO::m_request_s &request, double setting)
+    {
+        m_stream.put(M_RECORD_WRITE_CONTROL);
+        write_request(request);
+        m_stream.write((const char *)&setting, sizeof(setting));
+    }
+
+    void ReplayLogWriter::write_record(char record_type, const std::vector<double> &value)
+    {
+        m_stream.put(record_type);
+        m_stream.write((const char *)value.data(), value.size() * sizeof(double));
+    }
+
+    ReplayLogReader::ReplayLogReader(const std::string &path)
+        : m_path(path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.good()) {
+            throw Exception("ReplayLogReader: unable to open replay log '" + path +
+                            "': " + strerror(errno), GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        std::string header;
+        std::getline(stream, header);
+        if (header != ReplayLogWriter::header()) {
+            throw Exception("ReplayLogReader: '" + path + "' is not a replay log",
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        read_request(stream, m_signal);
+        read_request(stream, m_control);
+        int record_type;
+        while ((record_type = stream.get()) != EOF) {
+            if (record_type == ReplayLogWriter::M_RECORD_READ_SIGNAL ||
+                record_type == ReplayLogWriter::M_RECORD_WRITE_CONTROL) {
+                IPlatformIO::m_request_s request = read_request(stream);
+                double value = NAN;
+                stream.read((char *)&value, sizeof(value));
+                if (!stream.good()) {
+                    throw Exception("ReplayLogReader: truncated record in '" + path + "'",
+                                    GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+                }
+                if (record_type == ReplayLogWriter::M_RECORD_READ_SIGNAL) {
+                    m_read_signal.emplace_back(request, value);
+                }
+                else {
+                    m_write_control.emplace_back(request, value);
+                }
+                continue;
+            }
+            std::vector<double> value;
+            if (record_type == ReplayLogWriter::M_RECORD_READ) {
+                value.resize(m_signal.size());
+            }
+            else if (record_type == ReplayLogWriter::M_RECORD_WRITE) {
+                value.resize(m_control.size());
+            }
+            else {
+                throw Exception("ReplayLogReader: invalid record in '" + path + "'",
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            stream.read((char *)value.data(), value.size() * sizeof(double));
+            if (!stream.good() && value.size()) {
+                throw Exception("ReplayLogReader: truncated record in '" + path + "'",
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            if (record_type == ReplayLogWriter::M_RECORD_READ) {
+                m_read.push_back(std::move(value));
+            }
+            else {
+                m_write.push_back({m_read.size(), std::move(value)});
+            }
+        }
+    }
+
+    void ReplayLogReader::read_request(std::ifstream &stream, std::vector<IPlatformIO::m_request_s> &request)
+    {
+        uint32_t num_request = 0;
+        stream.read((char *)&num_request, sizeof(num_request));
+        for (uint32_t req_idx = 0; stream.good() && req_idx < num_request; ++req_idx) {
+            request.push_back(read_request(stream));
+        }
+        if (!stream.good()) {
+            throw Exception("ReplayLogReader: truncated header in '" + m_path + "'",
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+    }
+
+    IPlatformIO::m_request_s ReplayLogReader::read_request(std::ifstream &stream)
+    {
+        uint32_t name_size = 0;
+        int32_t domain[2] = {0, 0};
+        stream.read((char *)&name_size, sizeof(name_size));
+        // Bound the name so a corrupt size cannot exhaust memory
+        if (!stream.good() || name_size > M_MAX_NAME) {
+            throw Exception("ReplayLogReader: invalid request in '" + m_path + "'",
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        std::string name(name_size, '\0');
+        stream.read(&name[0], name.size());
+        stream.read((char *)domain, sizeof(domain));
+        return {name, domain[0], domain[1]};
+    }
+
+    const std::vector<IPlatformIO::m_request_s> &ReplayLogReader::signal(void) const
+    {
+        return m_signal;
+    }
+
+    const std::vector<IPlatformIO::m_request_s> &ReplayLogReader::control(void) const
+    {
+        return m_control;
+    }
+
+    const std::vector<std::vector<double> > &ReplayLogReader::read(void) const
+    {
+        return m_read;
+    }
+
+    const std::vector<ReplayLogReader::m_write_s> &ReplayLogReader::write(void) const
+    {
+        return m_write;
+    }
+
+    const std::vector<std::pair<IPlatformIO::m_request_s, double> > &ReplayLogReader::read_signal(void) const
+    {
+        return m_read_signal;
+    }
+
+    const std::vector<std::pair<IPlatformIO::m_request_s, double> > &ReplayLogReader::write_control(void) const
+    {
+        return m_write_control;
+    }
+}
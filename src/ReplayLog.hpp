@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef REPLAYLOG_HPP_INCLUDE
+#define REPLAYLOG_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PlatformIO.hpp"
+
+namespace geopm
+{
+    /// @brief Binary log of the values read and the settings written
+    ///        through PlatformIO, for replay with the ReplayIOGroup.
+    ///
+    /// The file begins with the line "GEOPM_REPLAY 1".  Then come
+    /// the pushed signals and then the pushed controls, each as a
+    /// uint32_t count followed by one entry per request: a uint32_t
+    /// name length, the name, and int32_t domain type and domain
+    /// index.  The rest of the file is a sequence of records.  Each
+    /// record is one byte, M_RECORD_READ or M_RECORD_WRITE, followed
+    /// by one double per signal or per control.  A write record
+    /// holds NAN for controls that were not adjusted since the last
+    /// write.  A M_RECORD_READ_SIGNAL record holds one request in
+    /// the same layout as the header followed by the double returned
+    /// by read_signal(), and a M_RECORD_WRITE_CONTROL record holds
+    /// one request followed by the setting passed to
+    /// write_control().  The batch versions of those functions
+    /// produce one record per request.  All values are in host byte
+    /// order.
+    class ReplayLogWriter
+    {
+        public:
+            enum m_record_e {
+                M_RECORD_READ = 'R',
+                M_RECORD_WRITE = 'W',
+                M_RECORD_READ_SIGNAL = 'S',
+                M_RECORD_WRITE_CONTROL = 'C',
+            };
+            /// @param [in] path Path of the log file.
+            /// @param [in] signal Signals pushed to the IOGroups.
+            /// @param [in] control Controls pushed to the IOGroups.
+            ReplayLogWriter(const std::string &path,
+                            const std::vector<IPlatformIO::m_request_s> &signal,
+                            const std::vector<IPlatformIO::m_request_s> &control);
+            virtual ~ReplayLogWriter() = default;
+            /// @brief Record the value of every signal after a
+            ///        read_batch().
+            void read(const std::vector<double> &value);
+            /// @brief Record the setting of every control at a
+            ///        write_batch().
+            void write(const std::vector<double> &setting);
+            /// @brief Record the result of a read_signal().
+            void read_signal(const IPlatformIO::m_request_s &request, double value);
+            /// @brief Record the setting of a write_control().
+            void write_control(const IPlatformIO::m_request_s &request, double setting);
+            static const std::string &header(void);
+        private:
+            void write_request(const std::vector<IPlatformIO::m_request_s> &request);
+            void write_request(const IPlatformIO::m_request_s &request);
+            void write_record(char record_type, const std::vector<double> &value);
+            std::ofstream m_stream;
+            const size_t m_num_signal;
+            const size_t m_num_control;
+    };
+
+    /// @brief Reads a complete log written by the ReplayLogWriter.
+    class ReplayLogReader
+    {
+        public:
+            /// @brief Settings of one write_batch() in the log.
+            struct m_write_s {
+                /// Number of read records that precede the write.
+                size_t num_read;
+                std::vector<double> setting;
+            };
+            ReplayLogReader(const std::string &path);
+            virtual ~ReplayLogReader() = default;
+            const std::vector<IPlatformIO::m_request_s> &signal(void) const;
+            const std::vector<IPlatformIO::m_request_s> &control(void) const;
+            /// @brief Signal values of every read record, in order.
+            const std::vector<std::vector<double> > &read(void) const;
+            /// @brief Every write record, in order.
+            const std::vector<m_write_s> &write(void) const;
+            /// @brief Every read_signal() request and its result, in
+            ///        order.
+            const std::vector<std::pair<IPlatformIO::m_request_s, double> > &read_signal(void) const;
+            /// @brief Every write_control() request and its setting,
+            ///        in order.
+            const std::vector<std::pair<IPlatformIO::m_request_s, double> > &write_control(void) const;
+        private:
+            enum {
+                M_MAX_NAME = 4096,
+            };
+            void read_request(std::ifstream &stream, std::vector<IPlatformIO::m_request_s> &request);
+            IPlatformIO::m_request_s read_request(std::ifstream &stream);
+            std::string m_path;
+            std::vector<IPlatformIO::m_request_s> m_signal;
+            std::vector<IPlatformIO::m_request_s> m_control;
+            std::vector<std::vector<double> > m_read;
+            std::vector<m_write_s> m_write;
+            std::vector<std::pair<IPlatformIO::m_request_s, double> > m_read_signal;
+            std::vector<std::pair<IPlatformIO::m_request_s, double> > m_write_control;
+    };
+}
+
+#endif
@@ -40,6 +40,7 @@
 #include <numeric>
 #include <iostream>
 #include <iomanip>
+#include <cmath>
 
 #include "Reporter.hpp"
 #include "PlatformIO.hpp"
@@ -47,6 +48,8 @@
 #include "ApplicationIO.hpp"
 #include "Comm.hpp"
 #include "TreeComm.hpp"
+#include "KontrollerTimer.hpp"
+#include "KontrollerIOGroup.hpp"
 #include "Exception.hpp"
 #include "geopm_hash.h"
 #include "geopm_version.h"
@@ -78,6 +81,8 @@ namespace geopm
         m_platform_io.push_region_signal_total(m_energy_dram_idx, IPlatformTopo::M_DOMAIN_BOARD, 0);
         m_platform_io.push_region_signal_total(m_clk_core_idx, IPlatformTopo::M_DOMAIN_BOARD, 0);
         m_platform_io.push_region_signal_total(m_clk_ref_idx, IPlatformTopo::M_DOMAIN_BOARD, 0);
+        m_power_pkg_idx = m_platform_io.push_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_BOARD, 0);
+        m_platform_io.push_region_signal_histogram(m_power_pkg_idx, IPlatformTopo::M_DOMAIN_BOARD, 0);
 
         if (!m_rank) {
             // check if report file can be created
@@ -206,6 +211,13 @@ namespace geopm
             double freq = denom != 0 ? 100.0 * numer / denom : 0.0;
             report << "    frequency (%): " << freq << std::endl;
             report << "    frequency (Hz): " << freq / 100.0 * m_platform_io.read_signal("CPUINFO::FREQ_STICKER", IPlatformTopo::M_DOMAIN_BOARD, 0) << std::endl;
+            // tail of the package power, for regions that were sampled
+            for (double percentile : {50.0, 95.0, 99.0}) {
+                double power = m_platform_io.sample_region_percentile(m_power_pkg_idx, region.id, percentile);
+                if (!std::isnan(power)) {
+                    report << "    power-p" << percentile << " (watts): " << power << std::endl;
+                }
+            }
             report << "    mpi-runtime (sec): " << application_io.total_region_mpi_runtime(region.id) << std::endl;
             report << "    count: " << region.count << std::endl;
             if (agent_region_report.find(region.id) != agent_region_report.end()) {
@@ -226,6 +238,32 @@ namespace geopm
         report << "    geopmctl memory HWM: " << max_memory << std::endl;
         report << "    geopmctl network BW (B/sec): " << tree_comm.overhead_send() / total_runtime << std::endl;
 
+        // time spent in each phase of the control step when provided
+        // by the controller
+        const std::string timer_prefix = KontrollerIOGroup::plugin_name() + "::";
+        if (m_platform_io.signal_names().count(timer_prefix + "STEP_COUNT")) {
+            report << "Controller Timing:" << std::endl
+                   << "    step-count: "
+                   << (uint64_t)m_platform_io.read_signal(timer_prefix + "STEP_COUNT", IPlatformTopo::M_DOMAIN_BOARD, 0) << std::endl
+                   << "    busy (%): "
+                   << 100.0 * m_platform_io.read_signal(timer_prefix + "BUSY_FRACTION", IPlatformTopo::M_DOMAIN_BOARD, 0) << std::endl;
+            for (int phase = 0; phase < KontrollerTimer::M_NUM_PHASE; ++phase) {
+                std::string phase_name = KontrollerTimer::phase_name(phase);
+                std::string signal_base = phase_name;
+                std::transform(signal_base.begin(), signal_base.end(), signal_base.begin(), ::toupper);
+                signal_base = timer_prefix + signal_base + "_";
+                report << "    " << phase_name << " (sec):";
+                for (int stat = KontrollerTimer::M_STAT_MEAN; stat < KontrollerTimer::M_NUM_STAT; ++stat) {
+                    std::string stat_name = KontrollerTimer::stat_name(stat);
+                    std::string signal_name = stat_name;
+                    std::transform(signal_name.begin(), signal_name.end(), signal_name.begin(), ::toupper);
+                    report << " " << stat_name << "="
+                           << m_platform_io.read_signal(signal_base + signal_name, IPlatformTopo::M_DOMAIN_BOARD, 0);
+                }
+                report << std::endl;
+            }
+        }
+
         // aggregate reports from every node
         report.seekp(0, std::ios::end);
         size_t buffer_size = (size_t) report.tellp();
@@ -119,6 +119,7 @@ namespace geopm
             int m_energy_dram_idx;
             int m_clk_core_idx;
             int m_clk_ref_idx;
+            int m_power_pkg_idx;
     };
 }
 
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "SampleRing.hpp"
+#include "SharedMemory.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_time.h"
+#include "config.h"
+
+namespace geopm
+{
+    static size_t sample_ring_record_size(size_t num_field)
+    {
+        // sequence, timestamp and values
+        return sizeof(uint64_t) + sizeof(double) * (1 + num_field);
+    }
+
+    size_t SampleRing::region_size(size_t num_field, size_t capacity)
+    {
+        return sizeof(struct geopm_sample_ring_s) + capacity * sample_ring_record_size(num_field);
+    }
+
+    SampleRing::SampleRing(const std::string &shm_key,
+                           const std::vector<std::string> &signal_names,
+                           size_t capacity)
+        : SampleRing(geopm::make_unique<SharedMemory>(shm_key, region_size(signal_names.size(), capacity)),
+                     signal_names, capacity)
+    {
+
+    }
+
+    SampleRing::SampleRing(std::unique_ptr<ISharedMemory> shmem,
+                           const std::vector<std::string> &signal_names,
+                           size_t capacity)
+        : m_shmem(std::move(shmem))
+        , m_header(nullptr)
+        , m_record(nullptr)
+        , m_signal_names(signal_names)
+        , m_samples_up(signal_names.size(), 0.0)
+        , m_head(0)
+    {
+        if (signal_names.size() > GEOPM_SAMPLE_RING_MAX_FIELD || capacity == 0) {
+            throw Exception("SampleRing: at most " + std::to_string(GEOPM_SAMPLE_RING_MAX_FIELD) +
+                            " fields and a capacity of at least one record are supported",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_shmem->size() < region_size(signal_names.size(), capacity)) {
+            throw Exception("SampleRing: shared memory region is too small",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_header = (struct geopm_sample_ring_s *)m_shmem->pointer();
+        m_record = (char *)m_shmem->pointer() + sizeof(struct geopm_sample_ring_s);
+        memset(m_shmem->pointer(), 0, region_size(signal_names.size(), capacity));
+        m_header->num_field = signal_names.size();
+        m_header->capacity = capacity;
+        for (size_t field_idx = 0; field_idx != signal_names.size(); ++field_idx) {
+            if (signal_names[field_idx].size() >= GEOPM_SAMPLE_RING_NAME_MAX) {
+                throw Exception("SampleRing: field name too long: " + signal_names[field_idx],
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            strncpy(m_header->field_name[field_idx], signal_names[field_idx].c_str(),
+                    GEOPM_SAMPLE_RING_NAME_MAX - 1);
+        }
+        __atomic_store_n(&m_header->magic, (uint64_t)GEOPM_SAMPLE_RING_MAGIC, __ATOMIC_RELEASE);
+    }
+
+    SampleRing::~SampleRing() = default;
+
+    void SampleRing::adjust(const std::string &signal_name, double setting)
+    {
+        auto signal_it = std::find(m_signal_names.begin(), m_signal_names.end(), signal_name);
+        if (signal_it == m_signal_names.end()) {
+            throw Exception("SampleRing::" + std::string(__func__) + "(): requested signal \"" +
+                            signal_name + "\" is not published",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_samples_up[std::distance(m_signal_names.begin(), signal_it)] = setting;
+    }
+
+    void SampleRing::adjust(const std::vector<double> &settings)
+    {
+        if (settings.size() != m_signal_names.size()) {
+            throw Exception("SampleRing::" + std::string(__func__) + "(): size of settings does not match signal names.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::copy(settings.begin(), settings.end(), m_samples_up.begin());
+    }
+
+    void SampleRing::write_batch(void)
+    {
+        struct geopm_time_s zero {};
+        struct geopm_time_s time;
+        geopm_time(&time);
+        double timestamp = geopm_time_diff(&zero, &time);
+
+        size_t record_size = sample_ring_record_size(m_samples_up.size());
+        char *record = m_record + (m_head % m_header->capacity) * record_size;
+        uint64_t *sequence = (uint64_t *)record;
+        __atomic_store_n(sequence, 2 * m_head + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(record + sizeof(uint64_t), &timestamp, sizeof(double));
+        memcpy(record + sizeof(uint64_t) + sizeof(double), m_samples_up.data(),
+               m_samples_up.size() * sizeof(double));
+        __atomic_store_n(sequence, 2 * m_head + 2, __ATOMIC_RELEASE);
+        ++m_head;
+        __atomic_store_n(&m_header->head, m_head, __ATOMIC_RELEASE);
+    }
+
+    std::vector<std::string> SampleRing::signal_names(void) const
+    {
+        return m_signal_names;
+    }
+
+    SampleRingReader::SampleRingReader(const std::string &shm_key,
+                                       const std::vector<std::string> &field_names)
+        : SampleRingReader(geopm::make_unique<SharedMemoryUser>(shm_key), field_names)
+    {
+
+    }
+
+    SampleRingReader::SampleRingReader(std::unique_ptr<ISharedMemoryUser> shmem,
+                                       const std::vector<std::string> &field_names)
+        : m_shmem(std::move(shmem))
+        , m_header((const struct geopm_sample_ring_s *)m_shmem->pointer())
+        , m_record((const char *)m_shmem->pointer() + sizeof(struct geopm_sample_ring_s))
+        , m_num_field(0)
+        , m_capacity(0)
+        , m_next(0)
+    {
+        if (m_shmem->size() < sizeof(struct geopm_sample_ring_s) ||
+            __atomic_load_n(&m_header->magic, __ATOMIC_ACQUIRE) != GEOPM_SAMPLE_RING_MAGIC) {
+            throw Exception("SampleRingReader: shared memory region is not a sample ring",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_num_field = m_header->num_field;
+        m_capacity = m_header->capacity;
+        if (m_num_field > GEOPM_SAMPLE_RING_MAX_FIELD ||
+            m_shmem->size() < SampleRing::region_size(m_num_field, m_capacity)) {
+            throw Exception("SampleRingReader: sample ring header is corrupt",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::vector<std::string> ring_names(m_num_field);
+        for (size_t field_idx = 0; field_idx != m_num_field; ++field_idx) {
+            ring_names[field_idx] = std::string(m_header->field_name[field_idx],
+                                                strnlen(m_header->field_name[field_idx],
+                                                        GEOPM_SAMPLE_RING_NAME_MAX));
+        }
+        m_field_names = field_names.empty() ? ring_names : field_names;
+        for (const auto &name : m_field_names) {
+            auto name_it = std::find(ring_names.begin(), ring_names.end(), name);
+            if (name_it == ring_names.end()) {
+                throw Exception("SampleRingReader: field \"" + name + "\" is not published",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            m_field_idx.push_back(std::distance(ring_names.begin(), name_it));
+        }
+        m_buffer.resize(1 + m_num_field);
+        // Records published before attaching are neither read nor
+        // counted as lost
+        m_next = __atomic_load_n(&m_header->head, __ATOMIC_ACQUIRE);
+    }
+
+    SampleRingReader::~SampleRingReader() = default;
+
+    std::vector<std::string> SampleRingReader::field_names(void) const
+    {
+        return m_field_names;
+    }
+
+    size_t SampleRingReader::read(std::vector<double> &timestamp,
+                                  std::vector<std::vector<double> > &sample)
+    {
+        timestamp.clear();
+        sample.clear();
+        size_t num_lost = 0;
+        uint64_t head = __atomic_load_n(&m_header->head, __ATOMIC_ACQUIRE);
+        if (head - m_next > m_capacity) {
+            num_lost += head - m_capacity - m_next;
+            m_next = head - m_capacity;
+        }
+        size_t record_size = sample_ring_record_size(m_num_field);
+        for (; m_next != head; ++m_next) {
+            const char *record = m_record + (m_next % m_capacity) * record_size;
+            const uint64_t *sequence = (const uint64_t *)record;
+            uint64_t expect = 2 * m_next + 2;
+            if (__atomic_load_n(sequence, __ATOMIC_ACQUIRE) != expect) {
+                ++num_lost;
+                continue;
+            }
+            memcpy(m_buffer.data(), record + sizeof(uint64_t), m_buffer.size() * sizeof(double));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(sequence, __ATOMIC_RELAXED) != expect) {
+                ++num_lost;
+                continue;
+            }
+            timestamp.push_back(m_buffer[0]);
+            sample.emplace_back(m_field_idx.size());
+            for (size_t idx = 0; idx != m_field_idx.size(); ++idx) {
+                sample.back()[idx] = m_buffer[1 + m_field_idx[idx]];
+            }
+        }
+        return num_lost;
+    }
+}
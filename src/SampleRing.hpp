@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SAMPLERING_HPP_INCLUDE
+#define SAMPLERING_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ManagerIO.hpp"
+
+namespace geopm
+{
+    class ISharedMemory;
+    class ISharedMemoryUser;
+
+    enum geopm_sample_ring_e {
+        GEOPM_SAMPLE_RING_MAGIC = 0x72736d67,
+        GEOPM_SAMPLE_RING_MAX_FIELD = 63,
+        GEOPM_SAMPLE_RING_NAME_MAX = 64,
+    };
+
+    /// @brief Header of the shared memory region used to publish
+    ///        samples from the root of the tree to the resource
+    ///        manager.
+    ///
+    /// The header is followed by capacity records, each made of a
+    /// uint64_t sequence number, a double timestamp and num_field
+    /// double values.  There is a single writer which never waits
+    /// on readers: record n is stored in slot n % capacity with the
+    /// sequence set to 2 * n + 1 while it is written and to
+    /// 2 * n + 2 once it is complete, then head is set to n + 1.
+    /// Readers copy a record and keep it only if its sequence was
+    /// 2 * n + 2 both before and after the copy.
+    struct geopm_sample_ring_s {
+        /// @brief Set to GEOPM_SAMPLE_RING_MAGIC once the rest of
+        ///        the header is valid.
+        uint64_t magic;
+        /// @brief Number of values in each record.
+        uint64_t num_field;
+        /// @brief Number of records held by the ring.
+        uint64_t capacity;
+        /// @brief Number of records published since creation.
+        uint64_t head;
+        /// @brief Null terminated name of each value.
+        char field_name[GEOPM_SAMPLE_RING_MAX_FIELD][GEOPM_SAMPLE_RING_NAME_MAX];
+    };
+
+    /// @brief Publishes samples into a ring of timestamped records
+    ///        in shared memory.  Every write_batch() appends one
+    ///        record stamped with geopm_time(), overwriting the
+    ///        oldest record once the ring is full.  Publishing takes
+    ///        no lock and does not depend on readers.
+    class SampleRing : public IManagerIO
+    {
+        public:
+            enum m_const_e {
+                M_DEFAULT_CAPACITY = 1024,
+            };
+            SampleRing() = delete;
+            SampleRing(const SampleRing &other) = delete;
+            /// @brief Create the shared memory region.
+            /// @param [in] shm_key Shared memory key of the region.
+            /// @param [in] signal_names Name of each published value.
+            /// @param [in] capacity Number of records in the ring.
+            SampleRing(const std::string &shm_key,
+                       const std::vector<std::string> &signal_names,
+                       size_t capacity);
+            SampleRing(std::unique_ptr<ISharedMemory> shmem,
+                       const std::vector<std::string> &signal_names,
+                       size_t capacity);
+            virtual ~SampleRing();
+            void adjust(const std::string &signal_name, double setting) override;
+            void adjust(const std::vector<double> &settings) override;
+            void write_batch(void) override;
+            std::vector<std::string> signal_names(void) const override;
+            /// @brief Size in bytes of the shared memory region.
+            static size_t region_size(size_t num_field, size_t capacity);
+        private:
+            std::unique_ptr<ISharedMemory> m_shmem;
+            struct geopm_sample_ring_s *m_header;
+            char *m_record;
+            std::vector<std::string> m_signal_names;
+            std::vector<double> m_samples_up;
+            uint64_t m_head;
+    };
+
+    class ISampleRingReader
+    {
+        public:
+            ISampleRingReader() = default;
+            virtual ~ISampleRingReader() = default;
+            /// @brief Names of the values read, in the order they
+            ///        are returned by read().
+            virtual std::vector<std::string> field_names(void) const = 0;
+            /// @brief Read the records published since the previous
+            ///        call, or since attaching for the first call.
+            /// @param [out] timestamp Time in seconds of each
+            ///        record, on the clock used by geopm_time().
+            /// @param [out] sample Values of the subscribed fields
+            ///        for each record.
+            /// @return Number of records that were overwritten
+            ///         before they could be read.
+            virtual size_t read(std::vector<double> &timestamp,
+                                std::vector<std::vector<double> > &sample) = 0;
+    };
+
+    /// @brief Reads the records published by a SampleRing,
+    ///        restricted to a subset of its fields.
+    class SampleRingReader : public ISampleRingReader
+    {
+        public:
+            SampleRingReader() = delete;
+            SampleRingReader(const SampleRingReader &other) = delete;
+            /// @brief Attach to the shared memory region.
+            /// @param [in] shm_key Shared memory key of the region.
+            /// @param [in] field_names Names of the values to read,
+            ///        or empty to read all of them.
+            SampleRingReader(const std::string &shm_key,
+                             const std::vector<std::string> &field_names);
+            SampleRingReader(std::unique_ptr<ISharedMemoryUser> shmem,
+                             const std::vector<std::string> &field_names);
+            virtual ~SampleRingReader();
+            std::vector<std::string> field_names(void) const override;
+            size_t read(std::vector<double> &timestamp,
+                        std::vector<std::vector<double> > &sample) override;
+        private:
+            std::unique_ptr<ISharedMemoryUser> m_shmem;
+            const struct geopm_sample_ring_s *m_header;
+            const char *m_record;
+            size_t m_num_field;
+            size_t m_capacity;
+            std::vector<std::string> m_field_names;
+            std::vector<size_t> m_field_idx;
+            std::vector<double> m_buffer;
+            uint64_t m_next;
+    };
+}
+
+#endif
@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include "SimPlatformIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_env.h"
+#include "geopm_hash.h"
+#include "geopm_time.h"
+#include "contrib/json11/json11.hpp"
+#include "config.h"
+
+#define GEOPM_SIM_PLATFORM_IO_GROUP_PLUGIN_NAME "SIM"
+
+using json11::Json;
+
+namespace geopm
+{
+    static SimPlatformIOGroup::m_model_s env_model(void)
+    {
+        std::string path = geopm_env_sim();
+        if (path.empty()) {
+            throw Exception("SimPlatformIOGroup: GEOPM_SIM is not set",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::ifstream model_file(path);
+        if (!model_file.is_open()) {
+            throw Exception("SimPlatformIOGroup: model file \"" + path + "\" could not be opened",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::ostringstream json_str;
+        json_str << model_file.rdbuf();
+        return SimPlatformIOGroup::parse_model(json_str.str());
+    }
+
+    static uint64_t host_seed(void)
+    {
+        char hostname[NAME_MAX] = {};
+        (void)gethostname(hostname, NAME_MAX - 1);
+        // The rank on the host set by the launcher distinguishes
+        // nodes simulated on one host, and is the same in every run
+        // with the same layout.
+        static const char *local_rank_env[] = {"OMPI_COMM_WORLD_LOCAL_RANK",
+                                               "MPI_LOCALRANKID",
+                                               "MV2_COMM_WORLD_LOCAL_RANK",
+                                               "SLURM_LOCALID"};
+        std::string local_rank;
+        for (const char *name : local_rank_env) {
+            const char *value = getenv(name);
+            if (value && local_rank.empty()) {
+                local_rank = value;
+            }
+        }
+        return geopm_crc32_str(0, (std::string(hostname) + ":" + local_rank).c_str());
+    }
+
+    static double wall_clock(void)
+    {
+        static const struct geopm_time_s zero {{0, 0}};
+        struct geopm_time_s now;
+        geopm_time(&now);
+        return geopm_time_diff(&zero, &now);
+    }
+
+    SimPlatformIOGroup::SimPlatformIOGroup()
+        : SimPlatformIOGroup(platform_topo(), env_model(), host_seed(), wall_clock)
+    {
+
+    }
+
+    SimPlatformIOGroup::SimPlatformIOGroup(IPlatformTopo &topo, const m_model_s &model, uint64_t seed,
+                                           std::function<double(void)> clock)
+        : m_model(model)
+        , m_clock(clock)
+        , m_num_package(topo.num_domain(IPlatformTopo::M_DOMAIN_PACKAGE))
+        , m_num_memory(topo.num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY))
+        , m_num_cpu_per_package(m_num_package ? topo.num_domain(IPlatformTopo::M_DOMAIN_CPU) / m_num_package : 0)
+        , m_generator(seed ^ (uint64_t)model.seed)
+        , m_package(m_num_package)
+        , m_time_zero(m_clock())
+        , m_time(m_time_zero)
+        , m_energy_dram(0.0)
+        , m_epoch_progress(0.0)
+        , m_epoch_begin(m_time_zero)
+        , m_epoch_runtime(0.0)
+        , m_epoch_count(0.0)
+        , m_signal_domain(M_NUM_SIGNAL, IPlatformTopo::M_DOMAIN_PACKAGE)
+        , m_control_domain(M_NUM_CONTROL, IPlatformTopo::M_DOMAIN_PACKAGE)
+        , m_is_active(false)
+        , m_is_read(false)
+    {
+        if (m_model.freq_min <= 0.0 || m_model.freq_min > m_model.freq_max ||
+            m_model.power_idle < 0.0 || m_model.power_freq_max < m_model.power_idle) {
+            throw Exception("SimPlatformIOGroup: invalid model, requires 0 < freq_min <= freq_max "
+                            "and 0 <= power_idle <= power_freq_max",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        for (auto &package : m_package) {
+            // Keep the efficiency positive for large variation
+            package.efficiency = std::max(0.5, 1.0 + m_model.variation * m_normal(m_generator));
+            package.freq_request = m_model.freq_max;
+            package.power_limit = m_model.power_tdp;
+            package.freq = std::min(package.freq_request, limit_freq(package));
+            package.power = package_power(package, package.freq);
+            package.energy = 0.0;
+            package.cycles_thread = 0.0;
+            package.cycles_reference = 0.0;
+        }
+        m_signal_domain[M_SIGNAL_ENERGY_DRAM] = IPlatformTopo::M_DOMAIN_BOARD_MEMORY;
+        m_signal_domain[M_SIGNAL_TIME] = IPlatformTopo::M_DOMAIN_BOARD;
+        m_signal_domain[M_SIGNAL_EPOCH_RUNTIME] = IPlatformTopo::M_DOMAIN_BOARD;
+        m_signal_domain[M_SIGNAL_EPOCH_COUNT] = IPlatformTopo::M_DOMAIN_BOARD;
+        const std::vector<std::pair<std::string, int> > signal_alias {
+            {"POWER_PACKAGE", M_SIGNAL_POWER_PACKAGE},
+            {"ENERGY_PACKAGE", M_SIGNAL_ENERGY_PACKAGE},
+            {"ENERGY_DRAM", M_SIGNAL_ENERGY_DRAM},
+            {"FREQUENCY", M_SIGNAL_FREQUENCY},
+            {"CYCLES_THREAD", M_SIGNAL_CYCLES_THREAD},
+            {"CYCLES_REFERENCE", M_SIGNAL_CYCLES_REFERENCE},
+            {"POWER_PACKAGE_MIN", M_SIGNAL_POWER_PACKAGE_MIN},
+            {"POWER_PACKAGE_MAX", M_SIGNAL_POWER_PACKAGE_MAX},
+            {"EPOCH_RUNTIME", M_SIGNAL_EPOCH_RUNTIME},
+            {"EPOCH_COUNT", M_SIGNAL_EPOCH_COUNT},
+        };
+        for (const auto &it : signal_alias) {
+            m_signal_type[it.first] = it.second;
+            m_signal_type[plugin_name() + "::" + it.first] = it.second;
+        }
+        m_signal_type[plugin_name() + "::POWER_PACKAGE_LIMIT"] = M_SIGNAL_POWER_PACKAGE_LIMIT;
+        m_signal_type[plugin_name() + "::POWER_PACKAGE_TDP"] = M_SIGNAL_POWER_PACKAGE_TDP;
+        m_signal_type[plugin_name() + "::TIME"] = M_SIGNAL_TIME;
+        const std::vector<std::pair<std::string, int> > control_alias {
+            {"POWER_PACKAGE", M_CONTROL_POWER_PACKAGE},
+            {"FREQUENCY", M_CONTROL_FREQUENCY},
+        };
+        for (const auto &it : control_alias) {
+            m_control_type[it.first] = it.second;
+            m_control_type[plugin_name() + "::" + it.first] = it.second;
+        }
+    }
+
+    SimPlatformIOGroup::m_model_s SimPlatformIOGroup::parse_model(const std::string &json_str)
+    {
+        m_model_s result;
+        const std::map<std::string, double m_model_s::*> field {
+            {"freq_min", &m_model_s::freq_min},
+            {"freq_max", &m_model_s::freq_max},
+            {"freq_sticker", &m_model_s::freq_sticker},
+            {"power_idle", &m_model_s::power_idle},
+            {"power_freq_max", &m_model_s::power_freq_max},
+            {"power_min", &m_model_s::power_min},
+            {"power_max", &m_model_s::power_max},
+            {"power_tdp", &m_model_s::power_tdp},
+            {"power_dram", &m_model_s::power_dram},
+            {"rapl_time_constant", &m_model_s::rapl_time_constant},
+            {"noise", &m_model_s::noise},
+            {"variation", &m_model_s::variation},
+            {"epoch_runtime", &m_model_s::epoch_runtime},
+            {"freq_sensitivity", &m_model_s::freq_sensitivity},
+            {"seed", &m_model_s::seed},
+        };
+        std::string err;
+        Json root = Json::parse(json_str, err);
+        if (!err.empty() || !root.is_object()) {
+            throw Exception("SimPlatformIOGroup::parse_model(): detected a malformed json model: " + err,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        for (const auto &obj : root.object_items()) {
+            auto field_it = field.find(obj.first);
+            if (field_it == field.end()) {
+                throw Exception("SimPlatformIOGroup::parse_model(): unknown model parameter: " + obj.first,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            if (!obj.second.is_number()) {
+                throw Exception("SimPlatformIOGroup::parse_model(): model parameter is not a number: " + obj.first,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            result.*(field_it->second) = obj.second.number_value();
+        }
+        return result;
+    }
+
+    std::set<std::string> SimPlatformIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_signal_type) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> SimPlatformIOGroup::control_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_control_type) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    bool SimPlatformIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_type.find(signal_name) != m_signal_type.end();
+    }
+
+    bool SimPlatformIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return m_control_type.find(control_name) != m_control_type.end();
+    }
+
+    int SimPlatformIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = IPlatformTopo::M_DOMAIN_INVALID;
+        auto it = m_signal_type.find(signal_name);
+        if (it != m_signal_type.end()) {
+            result = m_signal_domain[it->second];
+        }
+        return result;
+    }
+
+    int SimPlatformIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        int result = IPlatformTopo::M_DOMAIN_INVALID;
+        auto it = m_control_type.find(control_name);
+        if (it != m_control_type.end()) {
+            result = m_control_domain[it->second];
+        }
+        return result;
+    }
+
+    void SimPlatformIOGroup::check_domain(const std::string &func_name, const std::string &name,
+                                          int domain_type, int domain_idx) const
+    {
+        int num_domain = 1;
+        if (domain_type == IPlatformTopo::M_DOMAIN_PACKAGE) {
+            num_domain = m_num_package;
+        }
+        else if (domain_type == IPlatformTopo::M_DOMAIN_BOARD_MEMORY) {
+            num_domain = m_num_memory;
+        }
+        if (domain_idx < 0 || domain_idx >= num_domain) {
+            throw Exception("SimPlatformIOGroup::" + func_name + "(): domain_idx out of range for " + name,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    int SimPlatformIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("SimPlatformIOGroup::push_signal(): signal_name " + signal_name +
+                            " not valid for SimPlatformIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != signal_domain_type(signal_name)) {
+            throw Exception("SimPlatformIOGroup::push_signal(): domain_type does not match the domain of the signal.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("push_signal", signal_name, domain_type, domain_idx);
+        if (m_is_active) {
+            throw Exception("SimPlatformIOGroup::push_signal(): cannot push a signal after read_batch() or adjust() has been called.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::pair<int, int> request(m_signal_type.at(signal_name), domain_idx);
+        int result = m_active_signal.size();
+        auto it = std::find(m_active_signal.begin(), m_active_signal.end(), request);
+        if (it != m_active_signal.end()) {
+            result = it - m_active_signal.begin();
+        }
+        else {
+            m_active_signal.push_back(request);
+            m_signal_value.push_back(NAN);
+        }
+        return result;
+    }
+
+    int SimPlatformIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        if (!is_valid_control(control_name)) {
+            throw Exception("SimPlatformIOGroup::push_control(): control_name " + control_name +
+                            " not valid for SimPlatformIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != control_domain_type(control_name)) {
+            throw Exception("SimPlatformIOGroup::push_control(): domain_type does not match the domain of the control.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("push_control", control_name, domain_type, domain_idx);
+        if (m_is_active) {
+            throw Exception("SimPlatformIOGroup::push_control(): cannot push a control after read_batch() or adjust() has been called.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::pair<int, int> request(m_control_type.at(control_name), domain_idx);
+        int result = m_active_control.size();
+        auto it = std::find(m_active_control.begin(), m_active_control.end(), request);
+        if (it != m_active_control.end()) {
+            result = it - m_active_control.begin();
+        }
+        else {
+            m_active_control.push_back(request);
+            m_control_value.push_back(NAN);
+            m_is_adjusted.push_back(false);
+        }
+        return result;
+    }
+
+    double SimPlatformIOGroup::package_power(const m_package_s &package, double freq) const
+    {
+        double ratio = freq / m_model.freq_max;
+        return package.efficiency * (m_model.power_idle + (m_model.power_freq_max - m_model.power_idle) *
+                                     ratio * ratio * ratio);
+    }
+
+    double SimPlatformIOGroup::limit_freq(const m_package_s &package) const
+    {
+        double result = m_model.freq_max;
+        double power_dynamic = m_model.power_freq_max - m_model.power_idle;
+        if (power_dynamic > 0.0) {
+            double ratio = (package.power_limit / package.efficiency - m_model.power_idle) / power_dynamic;
+            result = m_model.freq_max * std::cbrt(std::max(ratio, 0.0));
+        }
+        return std::min(std::max(result, m_model.freq_min), m_model.freq_max);
+    }
+
+    void SimPlatformIOGroup::update(void)
+    {
+        double time = m_clock();
+        double delta = time - m_time;
+        if (delta <= 0.0) {
+            return;
+        }
+        double alpha = m_model.rapl_time_constant > 0.0 ?
+                       1.0 - std::exp(-delta / m_model.rapl_time_constant) : 1.0;
+        double slowest_freq = m_model.freq_max;
+        for (auto &package : m_package) {
+            double target = std::min(package.freq_request, limit_freq(package));
+            package.freq += (target - package.freq) * alpha;
+            package.power = std::max(0.0, package_power(package, package.freq) *
+                                          (1.0 + m_model.noise * m_normal(m_generator)));
+            package.energy += package.power * delta;
+            package.cycles_thread += m_num_cpu_per_package * package.freq * delta;
+            package.cycles_reference += m_num_cpu_per_package * m_model.freq_sticker * delta;
+            slowest_freq = std::min(slowest_freq, package.freq);
+        }
+        m_energy_dram += m_model.power_dram * delta;
+        if (m_model.epoch_runtime > 0.0) {
+            // Epochs per second at the frequency of the slowest package
+            double rate = 1.0 / (m_model.epoch_runtime *
+                                 (1.0 - m_model.freq_sensitivity +
+                                  m_model.freq_sensitivity * m_model.freq_max / slowest_freq));
+            m_epoch_progress += rate * delta;
+            while (m_epoch_progress >= 1.0) {
+                m_epoch_progress -= 1.0;
+                double epoch_end = time - m_epoch_progress / rate;
+                m_epoch_runtime = epoch_end - m_epoch_begin;
+                m_epoch_begin = epoch_end;
+                m_epoch_count += 1.0;
+            }
+        }
+        m_time = time;
+    }
+
+    double SimPlatformIOGroup::value(int signal, int domain_idx) const
+    {
+        double result = NAN;
+        switch (signal) {
+            case M_SIGNAL_POWER_PACKAGE:
+                result = m_package[domain_idx].power;
+                break;
+            case M_SIGNAL_ENERGY_PACKAGE:
+                result = m_package[domain_idx].energy;
+                break;
+            case M_SIGNAL_ENERGY_DRAM:
+                result = m_energy_dram;
+                break;
+            case M_SIGNAL_FREQUENCY:
+                result = m_package[domain_idx].freq;
+                break;
+            case M_SIGNAL_CYCLES_THREAD:
+                result = m_package[domain_idx].cycles_thread;
+                break;
+            case M_SIGNAL_CYCLES_REFERENCE:
+                result = m_package[domain_idx].cycles_reference;
+                break;
+            case M_SIGNAL_POWER_PACKAGE_LIMIT:
+                result = m_package[domain_idx].power_limit;
+                break;
+            case M_SIGNAL_POWER_PACKAGE_MIN:
+                result = m_model.power_min;
+                break;
+            case M_SIGNAL_POWER_PACKAGE_MAX:
+                result = m_model.power_max;
+                break;
+            case M_SIGNAL_POWER_PACKAGE_TDP:
+                result = m_model.power_tdp;
+                break;
+            case M_SIGNAL_TIME:
+                result = m_time - m_time_zero;
+                break;
+            case M_SIGNAL_EPOCH_RUNTIME:
+                result = m_epoch_runtime;
+                break;
+            case M_SIGNAL_EPOCH_COUNT:
+                result = m_epoch_count;
+                break;
+            default:
+                break;
+        }
+        return result;
+    }
+
+    void SimPlatformIOGroup::apply(int control, int domain_idx, double setting)
+    {
+        if (control == M_CONTROL_POWER_PACKAGE) {
+            m_package[domain_idx].power_limit = setting;
+        }
+        else if (control == M_CONTROL_FREQUENCY) {
+            m_package[domain_idx].freq_request = std::min(std::max(setting, m_model.freq_min),
+                                                          m_model.freq_max);
+        }
+    }
+
+    void SimPlatformIOGroup::read_batch(void)
+    {
+        m_is_active = true;
+        m_is_read = true;
+        update();
+        for (size_t idx = 0; idx < m_active_signal.size(); ++idx) {
+            m_signal_value[idx] = value(m_active_signal[idx].first, m_active_signal[idx].second);
+        }
+    }
+
+    void SimPlatformIOGroup::write_batch(void)
+    {
+        // Settings take effect from now on
+        update();
+        for (size_t idx = 0; idx < m_active_control.size(); ++idx) {
+            if (m_is_adjusted[idx]) {
+                apply(m_active_control[idx].first, m_active_control[idx].second, m_control_value[idx]);
+                m_is_adjusted[idx] = false;
+            }
+        }
+    }
+
+    double SimPlatformIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_active_signal.size()) {
+            throw Exception("SimPlatformIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!m_is_read) {
+            throw Exception("SimPlatformIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_signal_value[batch_idx];
+    }
+
+    void SimPlatformIOGroup::adjust(int batch_idx, double setting)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_active_control.size()) {
+            throw Exception("SimPlatformIOGroup::adjust(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_is_active = true;
+        m_control_value[batch_idx] = setting;
+        m_is_adjusted[batch_idx] = true;
+    }
+
+    double SimPlatformIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("SimPlatformIOGroup::read_signal(): signal_name " + signal_name +
+                            " not valid for SimPlatformIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != signal_domain_type(signal_name)) {
+            throw Exception("SimPlatformIOGroup::read_signal(): domain_type does not match the domain of the signal.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("read_signal", signal_name, domain_type, domain_idx);
+        update();
+        return value(m_signal_type.at(signal_name), domain_idx);
+    }
+
+    void SimPlatformIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        if (!is_valid_control(control_name)) {
+            throw Exception("SimPlatformIOGroup::write_control(): control_name " + control_name +
+                            " not valid for SimPlatformIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != control_domain_type(control_name)) {
+            throw Exception("SimPlatformIOGroup::write_control(): domain_type does not match the domain of the control.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("write_control", control_name, domain_type, domain_idx);
+        update();
+        apply(m_control_type.at(control_name), domain_idx, setting);
+    }
+
+    void SimPlatformIOGroup::save_control(void)
+    {
+        m_saved_package = m_package;
+    }
+
+    void SimPlatformIOGroup::restore_control(void)
+    {
+        update();
+        for (size_t idx = 0; idx < m_saved_package.size(); ++idx) {
+            m_package[idx].power_limit = m_saved_package[idx].power_limit;
+            m_package[idx].freq_request = m_saved_package[idx].freq_request;
+        }
+    }
+
+    std::string SimPlatformIOGroup::plugin_name(void)
+    {
+        return GEOPM_SIM_PLATFORM_IO_GROUP_PLUGIN_NAME;
+    }
+
+    std::unique_ptr<IOGroup> SimPlatformIOGroup::make_plugin(void)
+    {
+        return geopm::make_unique<SimPlatformIOGroup>();
+    }
+}
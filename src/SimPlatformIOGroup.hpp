@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SIMPLATFORMIOGROUP_HPP_INCLUDE
+#define SIMPLATFORMIOGROUP_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "IOGroup.hpp"
+
+namespace geopm
+{
+    class IPlatformTopo;
+
+    /// @brief IOGroup that simulates the power, frequency and
+    ///        runtime of a compute node, so that agents and the
+    ///        controller tree can be run at scale without msr-safe,
+    ///        e.g. with many oversubscribed ranks on one machine.
+    ///
+    /// The plugin is loaded only when GEOPM_SIM gives the path of a
+    /// JSON object that sets the fields of m_model_s by name; fields
+    /// that are not given keep their defaults.  Each package draws
+    ///
+    ///     power = efficiency * (power_idle + (power_freq_max - power_idle) * (f / freq_max)^3)
+    ///
+    /// where efficiency is drawn once per package from a normal
+    /// distribution with mean one and standard deviation variation,
+    /// which stands in for manufacturing variation.  The package frequency approaches the lower of the
+    /// FREQUENCY request and the frequency at which the power equals
+    /// the POWER_PACKAGE limit with the rapl_time_constant, as RAPL
+    /// enforces a limit over a time window.  The power reported is
+    /// perturbed by relative noise.  A bulk synchronous workload
+    /// completes epochs of epoch_runtime seconds at freq_max on the
+    /// slowest package, with freq_sensitivity of that time scaling
+    /// with frequency.
+    ///
+    /// The model advances in real time at each read_batch(),
+    /// write_batch(), read_signal() and write_control().  All names
+    /// are provided with the "SIM::" prefix and the common ones also
+    /// without it, e.g. ENERGY_PACKAGE, so they take the place of
+    /// the MSRIOGroup signals and controls.  TIME is left to the
+    /// TimeIOGroup, which reads the same clock.
+    class SimPlatformIOGroup : public IOGroup
+    {
+        public:
+            /// @brief Parameters of the node model.
+            struct m_model_s {
+                double freq_min = 1.0e9;
+                double freq_max = 2.2e9;
+                double freq_sticker = 2.1e9;
+                /// Package power at any frequency, in watts
+                double power_idle = 40.0;
+                /// Package power at freq_max, in watts
+                double power_freq_max = 180.0;
+                double power_min = 50.0;
+                double power_max = 200.0;
+                double power_tdp = 150.0;
+                /// Power of each memory domain, in watts
+                double power_dram = 10.0;
+                /// Time constant of power limit enforcement, in
+                /// seconds
+                double rapl_time_constant = 0.01;
+                /// Standard deviation of the relative power noise
+                double noise = 0.01;
+                /// Standard deviation of the per package efficiency
+                double variation = 0.05;
+                /// Epoch time at freq_max, in seconds
+                double epoch_runtime = 0.1;
+                /// Fraction of the epoch time that scales with
+                /// frequency
+                double freq_sensitivity = 0.8;
+                /// Combined with the hostname and the rank on the host
+                /// given by the launcher to seed the random numbers,
+                /// so each simulated node has its own stable noise
+                double seed = 0.0;
+            };
+            SimPlatformIOGroup();
+            /// @brief Constructor used for testing.
+            /// @param [in] topo Platform topology that provides the
+            ///        number of packages, memory domains and CPUs.
+            /// @param [in] model Parameters of the node model.
+            /// @param [in] seed Seed of the random numbers.
+            /// @param [in] clock Returns the current time in
+            ///        seconds.
+            SimPlatformIOGroup(IPlatformTopo &topo, const m_model_s &model, uint64_t seed,
+                               std::function<double(void)> clock);
+            virtual ~SimPlatformIOGroup() = default;
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            /// @brief Parse a JSON object that sets model parameters.
+            static m_model_s parse_model(const std::string &json_str);
+            static std::string plugin_name(void);
+            static std::unique_ptr<IOGroup> make_plugin(void);
+        private:
+            enum m_signal_e {
+                M_SIGNAL_POWER_PACKAGE,
+                M_SIGNAL_ENERGY_PACKAGE,
+                M_SIGNAL_ENERGY_DRAM,
+                M_SIGNAL_FREQUENCY,
+                M_SIGNAL_CYCLES_THREAD,
+                M_SIGNAL_CYCLES_REFERENCE,
+                M_SIGNAL_POWER_PACKAGE_LIMIT,
+                M_SIGNAL_POWER_PACKAGE_MIN,
+                M_SIGNAL_POWER_PACKAGE_MAX,
+                M_SIGNAL_POWER_PACKAGE_TDP,
+                M_SIGNAL_TIME,
+                M_SIGNAL_EPOCH_RUNTIME,
+                M_SIGNAL_EPOCH_COUNT,
+                M_NUM_SIGNAL,
+            };
+            enum m_control_e {
+                M_CONTROL_POWER_PACKAGE,
+                M_CONTROL_FREQUENCY,
+                M_NUM_CONTROL,
+            };
+            /// @brief State of one simulated package.
+            struct m_package_s {
+                double efficiency;
+                double freq;
+                double freq_request;
+                double power_limit;
+                double power;
+                double energy;
+                double cycles_thread;
+                double cycles_reference;
+            };
+            void check_domain(const std::string &func_name, const std::string &name,
+                              int domain_type, int domain_idx) const;
+            /// @brief Advance the model to the current time.
+            void update(void);
+            double package_power(const m_package_s &package, double freq) const;
+            /// @brief Frequency at which the package power is the
+            ///        limit, within freq_min and freq_max.
+            double limit_freq(const m_package_s &package) const;
+            double value(int signal, int domain_idx) const;
+            void apply(int control, int domain_idx, double setting);
+
+            const m_model_s m_model;
+            std::function<double(void)> m_clock;
+            const int m_num_package;
+            const int m_num_memory;
+            const int m_num_cpu_per_package;
+            std::mt19937_64 m_generator;
+            std::normal_distribution<double> m_normal;
+            std::vector<m_package_s> m_package;
+            double m_time_zero;
+            double m_time;
+            double m_energy_dram;
+            double m_epoch_progress;
+            double m_epoch_begin;
+            double m_epoch_runtime;
+            double m_epoch_count;
+            std::map<std::string, int> m_signal_type;
+            std::map<std::string, int> m_control_type;
+            std::vector<int> m_signal_domain;
+            std::vector<int> m_control_domain;
+            bool m_is_active;
+            bool m_is_read;
+            /// Pushed signals and controls as (type, domain index)
+            std::vector<std::pair<int, int> > m_active_signal;
+            std::vector<double> m_signal_value;
+            std::vector<std::pair<int, int> > m_active_control;
+            std::vector<double> m_control_value;
+            std::vector<bool> m_is_adjusted;
+            std::vector<m_package_s> m_saved_package;
+    };
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    ThreadPool::ThreadPool(int num_thread)
+        : m_num_thread(std::max(num_thread, 1))
+        , m_func(nullptr)
+        , m_epoch(0)
+        , m_is_shutdown(false)
+        , m_num_pending(0)
+        , m_is_active(false)
+    {
+        for (int thread_idx = 0; thread_idx != m_num_thread; ++thread_idx) {
+            m_queue.push_back(geopm::make_unique<m_queue_s>());
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_is_shutdown = true;
+            m_start_cond.notify_all();
+        }
+        for (auto &thread : m_thread) {
+            thread.join();
+        }
+    }
+
+    int ThreadPool::num_thread(void) const
+    {
+        return m_num_thread;
+    }
+
+    void ThreadPool::start(void)
+    {
+        // Threads inherit the affinity mask of the creating thread.
+        for (int thread_idx = 1; thread_idx < m_num_thread; ++thread_idx) {
+            m_thread.emplace_back(&ThreadPool::run, this, thread_idx);
+        }
+    }
+
+    void ThreadPool::parallel_for(size_t begin, size_t end,
+                                  const std::function<void(size_t)> &func)
+    {
+        size_t num_item = end > begin ? end - begin : 0;
+        if (m_num_thread == 1 || num_item < 2 || m_is_active) {
+            for (size_t idx = begin; idx < end; ++idx) {
+                func(idx);
+            }
+            return;
+        }
+        if (m_thread.empty()) {
+            start();
+        }
+        m_is_active = true;
+        m_func = &func;
+        m_error = nullptr;
+        size_t num_chunk = std::min(num_item, (size_t)(m_num_thread * M_CHUNK_PER_THREAD));
+        m_num_pending = num_chunk;
+        for (size_t chunk_idx = 0; chunk_idx != num_chunk; ++chunk_idx) {
+            m_chunk_s chunk {begin + num_item * chunk_idx / num_chunk,
+                             begin + num_item * (chunk_idx + 1) / num_chunk};
+            m_queue_s &queue = *m_queue[chunk_idx % m_num_thread];
+            std::lock_guard<std::mutex> lock(queue.lock);
+            queue.chunk.push_back(chunk);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            ++m_epoch;
+            m_start_cond.notify_all();
+        }
+        execute(0);
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_done_cond.wait(lock, [this] {return m_num_pending == 0;});
+        }
+        m_is_active = false;
+        m_func = nullptr;
+        if (m_error) {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void ThreadPool::run(int thread_idx)
+    {
+        uint64_t epoch = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+                m_start_cond.wait(lock, [this, epoch] {return m_is_shutdown || m_epoch != epoch;});
+                if (m_is_shutdown) {
+                    break;
+                }
+                epoch = m_epoch;
+            }
+            execute(thread_idx);
+        }
+    }
+
+    bool ThreadPool::take(int thread_idx, m_chunk_s &chunk)
+    {
+        bool result = false;
+        {
+            m_queue_s &queue = *m_queue[thread_idx];
+            std::lock_guard<std::mutex> lock(queue.lock);
+            if (!queue.chunk.empty()) {
+                chunk = queue.chunk.back();
+                queue.chunk.pop_back();
+                result = true;
+            }
+        }
+        for (int offset = 1; !result && offset != m_num_thread; ++offset) {
+            m_queue_s &queue = *m_queue[(thread_idx + offset) % m_num_thread];
+            std::lock_guard<std::mutex> lock(queue.lock);
+            if (!queue.chunk.empty()) {
+                chunk = queue.chunk.front();
+                queue.chunk.pop_front();
+                result = true;
+            }
+        }
+        return result;
+    }
+
+    void ThreadPool::execute(int thread_idx)
+    {
+        m_chunk_s chunk;
+        while (take(thread_idx, chunk)) {
+            try {
+                for (size_t idx = chunk.begin; idx != chunk.end; ++idx) {
+                    (*m_func)(idx);
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+            }
+            if (--m_num_pending == 0) {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_done_cond.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef THREADPOOL_HPP_INCLUDE
+#define THREADPOOL_HPP_INCLUDE
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace geopm
+{
+    /// @brief Small work stealing executor for data parallel loops
+    ///        run by the controller.
+    ///
+    /// A parallel_for() splits its range into chunks that are dealt
+    /// to a queue per thread.  Each thread takes chunks from the
+    /// back of its own queue and, once that is empty, steals from
+    /// the front of the other queues.  The calling thread takes part
+    /// in the loop, so a pool of one thread runs the loop inline
+    /// without creating any threads.  Worker threads are created by
+    /// the first parallel_for() and inherit the CPU affinity of the
+    /// thread that calls it, which keeps them within the cpuset of
+    /// the controller.
+    class ThreadPool
+    {
+        public:
+            ThreadPool() = delete;
+            ThreadPool(const ThreadPool &other) = delete;
+            /// @brief Constructor.
+            /// @param [in] num_thread Number of threads used by
+            ///        parallel_for() including the calling thread.
+            ///        Values less than one are treated as one.
+            ThreadPool(int num_thread);
+            virtual ~ThreadPool();
+            /// @brief Number of threads used by parallel_for().
+            int num_thread(void) const;
+            /// @brief Call func(idx) for every idx in [begin, end)
+            ///        and return when all calls are complete.  The
+            ///        order of the calls is unspecified.  The first
+            ///        exception thrown by func is rethrown after all
+            ///        chunks have finished.  Calls made from within
+            ///        func run serially; other concurrent calls are
+            ///        not supported.
+            void parallel_for(size_t begin, size_t end,
+                              const std::function<void(size_t)> &func);
+        private:
+            enum m_const_e {
+                /// Number of chunks dealt to each thread.
+                M_CHUNK_PER_THREAD = 4,
+            };
+            struct m_chunk_s {
+                size_t begin;
+                size_t end;
+            };
+            struct m_queue_s {
+                std::mutex lock;
+                std::deque<m_chunk_s> chunk;
+            };
+            void start(void);
+            void run(int thread_idx);
+            bool take(int thread_idx, m_chunk_s &chunk);
+            void execute(int thread_idx);
+
+            const int m_num_thread;
+            std::vector<std::thread> m_thread;
+            std::vector<std::unique_ptr<m_queue_s> > m_queue;
+            const std::function<void(size_t)> *m_func;
+            std::mutex m_lock;
+            std::condition_variable m_start_cond;
+            std::condition_variable m_done_cond;
+            uint64_t m_epoch;
+            bool m_is_shutdown;
+            std::atomic<size_t> m_num_pending;
+            std::exception_ptr m_error;
+            std::atomic<bool> m_is_active;
+    };
+}
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <endian.h>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+
+#include "TraceBlockWriter.hpp"
+#include "TraceCodec.hpp"
+#include "Exception.hpp"
+#include "geopm_time.h"
+#include "config.h"
+
+namespace geopm
+{
+    TraceBlockWriter::TraceBlockWriter(const std::string &file_path,
+                                       std::unique_ptr<ITraceCodec> codec)
+        : m_stream(file_path, std::ios::binary)
+        , m_codec(std::move(codec))
+        , m_is_closed(false)
+        , m_raw_bytes(0)
+        , m_compressed_bytes(0)
+        , m_compress_seconds(0.0)
+        , m_num_dropped(0)
+        , m_dropped_bytes(0)
+    {
+        if (!m_stream.good()) {
+            throw Exception("TraceBlockWriter: unable to open trace file '" + file_path +
+                            "': " + strerror(errno), GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        m_stream << "GEOPM_TRACE_BLOCKS " << m_codec->name() << "\n";
+        m_thread = std::thread(&TraceBlockWriter::run, this);
+    }
+
+    TraceBlockWriter::~TraceBlockWriter()
+    {
+        try {
+            close();
+        }
+        catch (...) {
+            // The error was already reported if close() was called
+            // before, and a destructor can not throw.
+        }
+    }
+
+    void TraceBlockWriter::write(std::string &&block)
+    {
+        if (block.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_error) {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+        if (m_is_closed) {
+            throw Exception("TraceBlockWriter::write(): called after close()",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (m_queue.size() >= M_MAX_QUEUE) {
+            // Never stall the control loop on the compressor or disk
+            ++m_num_dropped;
+            m_dropped_bytes += block.size();
+            return;
+        }
+        m_queue.push_back(std::move(block));
+        m_queue_cond.notify_all();
+    }
+
+    void TraceBlockWriter::run(void)
+    {
+        std::vector<char> compressed;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_queue_cond.wait(lock, [this] {return m_is_closed || !m_queue.empty();});
+            if (m_queue.empty()) {
+                break;
+            }
+            std::string block(std::move(m_queue.front()));
+            m_queue.pop_front();
+            lock.unlock();
+
+            struct geopm_time_s begin, end;
+            try {
+                geopm_time(&begin);
+                m_codec->compress(block.data(), block.size(), compressed);
+                geopm_time(&end);
+                uint32_t header[3] = {htole32(M_BLOCK_MAGIC),
+                                      htole32((uint32_t)block.size()),
+                                      htole32((uint32_t)compressed.size())};
+                m_stream.write((const char *)header, sizeof(header));
+                m_stream.write(compressed.data(), compressed.size());
+                if (!m_stream.good()) {
+                    throw Exception("TraceBlockWriter: failed to write to trace file",
+                                    GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+            }
+            catch (...) {
+                lock.lock();
+                m_error = std::current_exception();
+                m_queue.clear();
+                break;
+            }
+
+            lock.lock();
+            m_compress_seconds += geopm_time_diff(&begin, &end);
+            m_raw_bytes += block.size();
+            m_compressed_bytes += M_BLOCK_HEADER_SIZE + compressed.size();
+        }
+    }
+
+    void TraceBlockWriter::close(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_is_closed) {
+                return;
+            }
+            m_is_closed = true;
+            m_queue_cond.notify_all();
+        }
+        m_thread.join();
+        if (!m_error) {
+            m_stream << "# " << stats() << "\n";
+        }
+        m_stream.close();
+        if (!m_error && m_stream.fail()) {
+            m_error = std::make_exception_ptr(
+                Exception("TraceBlockWriter::close(): failed to write to trace file",
+                          GEOPM_ERROR_RUNTIME, __FILE__, __LINE__));
+        }
+        if (m_num_dropped) {
+            std::cerr << "Warning: <geopm> TraceBlockWriter: dropped " << m_num_dropped
+                      << " trace blocks because compression fell behind" << std::endl;
+        }
+        if (m_error) {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    size_t TraceBlockWriter::raw_bytes(void) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_raw_bytes;
+    }
+
+    size_t TraceBlockWriter::compressed_bytes(void) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_compressed_bytes;
+    }
+
+    double TraceBlockWriter::compress_seconds(void) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_compress_seconds;
+    }
+
+    size_t TraceBlockWriter::num_dropped(void) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_num_dropped;
+    }
+
+    std::string TraceBlockWriter::stats(void) const
+    {
+        size_t dropped_bytes = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            dropped_bytes = m_dropped_bytes;
+        }
+        size_t raw = raw_bytes();
+        size_t compressed = compressed_bytes();
+        double seconds = compress_seconds();
+        std::ostringstream result;
+        result << "\"compression\" : {\"codec\" : \"" << m_codec->name() << "\", "
+               << "\"raw_bytes\" : " << raw << ", "
+               << "\"compressed_bytes\" : " << compressed << ", "
+               << "\"dropped_blocks\" : " << num_dropped() << ", "
+               << "\"dropped_bytes\" : " << dropped_bytes << ", "
+               << std::setprecision(4)
+               << "\"ratio\" : " << (compressed ? (double)raw / compressed : 0.0) << ", "
+               << "\"throughput_mb_per_sec\" : " << (seconds > 0.0 ? raw / seconds / 1e6 : 0.0) << "}";
+        return result.str();
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TRACEBLOCKWRITER_HPP_INCLUDE
+#define TRACEBLOCKWRITER_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace geopm
+{
+    class ITraceCodec;
+
+    /// @brief Writes trace text to a file as a sequence of
+    ///        independently compressed blocks.  Compression and file
+    ///        output are done by a background thread so that the
+    ///        caller only pays for handing over the block.
+    ///
+    /// The file begins with the line "GEOPM_TRACE_BLOCKS <codec>".
+    /// Each block follows as a header of three little endian
+    /// uint32_t values: M_BLOCK_MAGIC, the uncompressed size and the
+    /// compressed size, and then the compressed data.  A block always
+    /// ends at the end of a trace line.  After the last block a text
+    /// line beginning with '#' records the compression statistics.
+    ///
+    /// The caller is never blocked by the background thread: when
+    /// the compressor falls behind by M_MAX_QUEUE blocks, further
+    /// blocks are dropped and counted in the statistics.  An error
+    /// in the background thread stops the output and is thrown by
+    /// the next call to write() or close().
+    class TraceBlockWriter
+    {
+        public:
+            enum m_block_const_e {
+                M_BLOCK_MAGIC = 0x42545447, // "GTTB"
+                M_BLOCK_HEADER_SIZE = 3 * sizeof(uint32_t),
+                /// Number of blocks that may wait for compression
+                /// before write() drops blocks.
+                M_MAX_QUEUE = 64,
+            };
+            /// @param [in] file_path Path of the compressed trace.
+            /// @param [in] codec Codec used to compress each block.
+            TraceBlockWriter(const std::string &file_path,
+                             std::unique_ptr<ITraceCodec> codec);
+            virtual ~TraceBlockWriter();
+            /// @brief Queue a block of complete trace lines to be
+            ///        compressed and written, or drop it if the
+            ///        queue is full.  Throws the error of the
+            ///        background thread if it failed.
+            void write(std::string &&block);
+            /// @brief Write all queued blocks and the statistics
+            ///        line, then close the file.  Throws the error of
+            ///        the background thread if it failed, or if the
+            ///        file could not be written.
+            void close(void);
+            /// @brief Total size of the blocks before compression.
+            size_t raw_bytes(void) const;
+            /// @brief Total size of the blocks after compression
+            ///        including the block headers.
+            size_t compressed_bytes(void) const;
+            /// @brief Time spent by the background thread in the
+            ///        codec in seconds.
+            double compress_seconds(void) const;
+            /// @brief Number of blocks dropped because the queue
+            ///        was full.
+            size_t num_dropped(void) const;
+            /// @brief Human readable statistics: codec, sizes, ratio
+            ///        and compression throughput.
+            std::string stats(void) const;
+        private:
+            void run(void);
+            std::ofstream m_stream;
+            std::unique_ptr<ITraceCodec> m_codec;
+            std::deque<std::string> m_queue;
+            bool m_is_closed;
+            size_t m_raw_bytes;
+            size_t m_compressed_bytes;
+            double m_compress_seconds;
+            size_t m_num_dropped;
+            size_t m_dropped_bytes;
+            /// Error raised by the background thread, not yet thrown
+            std::exception_ptr m_error;
+            mutable std::mutex m_mutex;
+            std::condition_variable m_queue_cond;
+            std::thread m_thread;
+    };
+}
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+#include "TraceCodec.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "config.h"
+
+#ifdef GEOPM_HAS_LZ4
+#include <lz4.h>
+#endif
+#ifdef GEOPM_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace geopm
+{
+#ifdef GEOPM_HAS_ZSTD
+    class ZstdTraceCodec : public ITraceCodec
+    {
+        public:
+            ZstdTraceCodec() = default;
+            virtual ~ZstdTraceCodec() = default;
+            std::string name(void) const override
+            {
+                return plugin_name();
+            }
+            void compress(const char *in, size_t in_size,
+                          std::vector<char> &out) override
+            {
+                out.resize(ZSTD_compressBound(in_size));
+                size_t out_size = ZSTD_compress(out.data(), out.size(), in, in_size, 1);
+                if (ZSTD_isError(out_size)) {
+                    throw Exception("ZstdTraceCodec::compress(): " + std::string(ZSTD_getErrorName(out_size)),
+                                    GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+                out.resize(out_size);
+            }
+            void decompress(const char *in, size_t in_size,
+                            size_t out_size, std::vector<char> &out) override
+            {
+                out.resize(out_size);
+                size_t result = ZSTD_decompress(out.data(), out.size(), in, in_size);
+                if (ZSTD_isError(result) || result != out_size) {
+                    throw Exception("ZstdTraceCodec::decompress(): block is corrupt",
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+            }
+            static std::string plugin_name(void)
+            {
+                return "zstd";
+            }
+            static std::unique_ptr<ITraceCodec> make_plugin(void)
+            {
+                return geopm::make_unique<ZstdTraceCodec>();
+            }
+    };
+#endif
+
+    static PluginFactory<ITraceCodec> *g_plugin_factory;
+    static pthread_once_t g_register_built_in_once = PTHREAD_ONCE_INIT;
+    static void register_built_in_once(void)
+    {
+        g_plugin_factory->register_plugin(LZ4TraceCodec::plugin_name(),
+                                          LZ4TraceCodec::make_plugin);
+#ifdef GEOPM_HAS_ZSTD
+        g_plugin_factory->register_plugin(ZstdTraceCodec::plugin_name(),
+                                          ZstdTraceCodec::make_plugin);
+#endif
+    }
+
+    PluginFactory<ITraceCodec> &trace_codec_factory(void)
+    {
+        static PluginFactory<ITraceCodec> instance;
+        g_plugin_factory = &instance;
+        pthread_once(&g_register_built_in_once, register_built_in_once);
+        return instance;
+    }
+
+    std::string LZ4TraceCodec::name(void) const
+    {
+        return plugin_name();
+    }
+
+    std::string LZ4TraceCodec::plugin_name(void)
+    {
+        return "lz4";
+    }
+
+    std::unique_ptr<ITraceCodec> LZ4TraceCodec::make_plugin(void)
+    {
+        return geopm::make_unique<LZ4TraceCodec>();
+    }
+
+#ifdef GEOPM_HAS_LZ4
+    void LZ4TraceCodec::compress(const char *in, size_t in_size, std::vector<char> &out)
+    {
+        out.resize(LZ4_compressBound(in_size));
+        int out_size = LZ4_compress_default(in, out.data(), in_size, out.size());
+        if (out_size <= 0 && in_size) {
+            throw Exception("LZ4TraceCodec::compress(): LZ4_compress_default() failed",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        out.resize(out_size);
+    }
+
+    void LZ4TraceCodec::decompress(const char *in, size_t in_size, size_t out_size, std::vector<char> &out)
+    {
+        out.resize(out_size);
+        int result = LZ4_decompress_safe(in, out.data(), in_size, out_size);
+        if (result < 0 || (size_t)result != out_size) {
+            throw Exception("LZ4TraceCodec::decompress(): block is corrupt",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+#else
+    // Built-in encoder and decoder for the LZ4 block format: a
+    // sequence of tokens each giving a run of literals followed by a
+    // back reference of at least four bytes within the last 64 KiB.
+    // The encoder is a greedy single probe hash match, which favors
+    // speed over ratio as liblz4 does with its default settings.
+    enum m_lz4_const_e {
+        M_LZ4_MIN_MATCH = 4,
+        M_LZ4_LAST_LITERALS = 5,  // block always ends with literals
+        M_LZ4_MFLIMIT = 12,  // last match starts this far from the end
+        M_LZ4_MAX_OFFSET = 65535,
+        M_LZ4_HASH_LOG = 16,
+    };
+
+    static inline uint32_t lz4_read32(const uint8_t *ptr)
+    {
+        uint32_t result;
+        memcpy(&result, ptr, sizeof(result));
+        return result;
+    }
+
+    static inline void lz4_write_length(size_t length, std::vector<char> &out)
+    {
+        length -= 15;
+        while (length >= 255) {
+            out.push_back((char)255);
+            length -= 255;
+        }
+        out.push_back((char)length);
+    }
+
+    static inline void lz4_write_sequence(const uint8_t *literal, size_t num_literal,
+                                          size_t offset, size_t match_length,
+                                          std::vector<char> &out)
+    {
+        size_t match_code = match_length ? match_length - M_LZ4_MIN_MATCH : 0;
+        uint8_t token = (std::min(num_literal, (size_t)15) << 4) |
+                        std::min(match_code, (size_t)15);
+        out.push_back((char)token);
+        if (num_literal >= 15) {
+            lz4_write_length(num_literal, out);
+        }
+        out.insert(out.end(), literal, literal + num_literal);
+        if (match_length) {
+            out.push_back((char)(offset & 0xFF));
+            out.push_back((char)(offset >> 8));
+            if (match_code >= 15) {
+                lz4_write_length(match_code, out);
+            }
+        }
+    }
+
+    void LZ4TraceCodec::compress(const char *in, size_t in_size, std::vector<char> &out)
+    {
+        const uint8_t *src = (const uint8_t *)in;
+        out.clear();
+        out.reserve(in_size + in_size / 255 + 16);
+        m_hash_table.assign(1 << M_LZ4_HASH_LOG, -1);
+        size_t anchor = 0;
+        size_t pos = 0;
+        while (pos + M_LZ4_MFLIMIT <= in_size) {
+            uint32_t sequence = lz4_read32(src + pos);
+            uint32_t hash = (sequence * 2654435761U) >> (32 - M_LZ4_HASH_LOG);
+            int ref = m_hash_table[hash];
+            m_hash_table[hash] = pos;
+            if (ref >= 0 && pos - ref <= M_LZ4_MAX_OFFSET &&
+                lz4_read32(src + ref) == sequence) {
+                size_t max_length = in_size - M_LZ4_LAST_LITERALS - pos;
+                size_t length = M_LZ4_MIN_MATCH;
+                while (length < max_length && src[ref + length] == src[pos + length]) {
+                    ++length;
+                }
+                lz4_write_sequence(src + anchor, pos - anchor, pos - ref, length, out);
+                pos += length;
+                anchor = pos;
+            }
+            else {
+                ++pos;
+            }
+        }
+        lz4_write_sequence(src + anchor, in_size - anchor, 0, 0, out);
+    }
+
+    void LZ4TraceCodec::decompress(const char *in, size_t in_size, size_t out_size, std::vector<char> &out)
+    {
+        const uint8_t *src = (const uint8_t *)in;
+        out.resize(out_size);
+        size_t ip = 0;
+        size_t op = 0;
+        bool is_corrupt = false;
+        while (!is_corrupt && ip < in_size) {
+            uint8_t token = src[ip++];
+            size_t length = token >> 4;
+            if (length == 15) {
+                uint8_t extra;
+                do {
+                    extra = ip < in_size ? src[ip++] : 0;
+                    length += extra;
+                } while (extra == 255);
+            }
+            if (ip + length > in_size || op + length > out_size) {
+                is_corrupt = true;
+                break;
+            }
+            memcpy(out.data() + op, src + ip, length);
+            ip += length;
+            op += length;
+            if (ip == in_size) {
+                // Last sequence has no match
+                break;
+            }
+            if (ip + 2 > in_size) {
+                is_corrupt = true;
+                break;
+            }
+            size_t offset = src[ip] | (src[ip + 1] << 8);
+            ip += 2;
+            length = token & 0xF;
+            if (length == 15) {
+                uint8_t extra;
+                do {
+                    extra = ip < in_size ? src[ip++] : 0;
+                    length += extra;
+                } while (extra == 255);
+            }
+            length += M_LZ4_MIN_MATCH;
+            if (offset == 0 || offset > op || op + length > out_size) {
+                is_corrupt = true;
+                break;
+            }
+            // Byte wise copy: the match may overlap the output
+            for (size_t idx = 0; idx < length; ++idx, ++op) {
+                out[op] = out[op - offset];
+            }
+        }
+        if (is_corrupt || op != out_size) {
+            throw Exception("LZ4TraceCodec::decompress(): block is corrupt",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+#endif
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TRACECODEC_HPP_INCLUDE
+#define TRACECODEC_HPP_INCLUDE
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "PluginFactory.hpp"
+
+namespace geopm
+{
+    /// @brief Compresses blocks of trace text.  Every block is
+    ///        compressed independently so that it can be
+    ///        decompressed without the blocks that precede it.
+    class ITraceCodec
+    {
+        public:
+            ITraceCodec() = default;
+            virtual ~ITraceCodec() = default;
+            /// @brief Name of the codec recorded in the file header.
+            virtual std::string name(void) const = 0;
+            /// @brief Compress a block.
+            /// @param [in] in Start of the uncompressed block.
+            /// @param [in] in_size Size of the uncompressed block in
+            ///        bytes.
+            /// @param [out] out Compressed block, resized to the
+            ///        compressed size.
+            virtual void compress(const char *in, size_t in_size,
+                                  std::vector<char> &out) = 0;
+            /// @brief Decompress a block.
+            /// @param [in] in Start of the compressed block.
+            /// @param [in] in_size Size of the compressed block in
+            ///        bytes.
+            /// @param [in] out_size Size of the uncompressed block.
+            /// @param [out] out Uncompressed block.
+            virtual void decompress(const char *in, size_t in_size,
+                                    size_t out_size, std::vector<char> &out) = 0;
+    };
+
+    /// @brief Codec producing the LZ4 block format.  Uses liblz4
+    ///        when GEOPM is built with it and a built-in encoder
+    ///        otherwise; the output of both is interchangeable.
+    class LZ4TraceCodec : public ITraceCodec
+    {
+        public:
+            LZ4TraceCodec() = default;
+            virtual ~LZ4TraceCodec() = default;
+            std::string name(void) const override;
+            void compress(const char *in, size_t in_size,
+                          std::vector<char> &out) override;
+            void decompress(const char *in, size_t in_size,
+                            size_t out_size, std::vector<char> &out) override;
+            static std::string plugin_name(void);
+            static std::unique_ptr<ITraceCodec> make_plugin(void);
+        private:
+            /// Most recent position of each hashed four byte
+            /// sequence, used by the built-in encoder.
+            std::vector<int> m_hash_table;
+    };
+
+    PluginFactory<ITraceCodec> &trace_codec_factory(void);
+}
+
+#endif
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <cmath>
+#include <limits>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include "TraceRollup.hpp"
+#include "Tracer.hpp"
+#include "TreeComm.hpp"
+#include "PlatformIO.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_env.h"
+#include "geopm_version.h"
+#include "config.h"
+
+namespace geopm
+{
+    TraceRollup::TraceRollup(std::shared_ptr<Comm> comm)
+        : TraceRollup(comm, geopm_env_trace_rollup(), geopm_env_do_trace_rollup(),
+                      geopm_env_trace_rollup_period() / 1000.0, platform_io(),
+                      {}, 16, nullptr)
+    {
+
+    }
+
+    TraceRollup::TraceRollup(std::shared_ptr<Comm> comm,
+                             const std::string &file_path,
+                             bool do_rollup,
+                             double period,
+                             IPlatformIO &platform_io,
+                             const std::vector<std::string> &env_column,
+                             int precision,
+                             std::unique_ptr<ITreeComm> tree_comm)
+        : m_comm(comm)
+        , m_file_path(file_path)
+        , m_is_enabled(do_rollup)
+        , m_period(period)
+        , m_platform_io(platform_io)
+        , m_env_column(env_column)
+        , m_precision(precision)
+        , m_tree_comm(std::move(tree_comm))
+        , m_num_level_ctl(0)
+        , m_is_root(false)
+        , m_num_column(0)
+        , m_time_zero({{0, 0}})
+        , m_window_begin({{0, 0}})
+        , m_buffer_limit(1048576) // 1 MiB
+    {
+        if (m_env_column.empty()) {
+            int num_extra_cols = geopm_env_num_trace_signal();
+            for (int i = 0; i < num_extra_cols; ++i) {
+                m_env_column.push_back(geopm_env_trace_signal(i));
+            }
+        }
+    }
+
+    TraceRollup::~TraceRollup()
+    {
+        if (m_stream.good() && m_is_enabled && m_is_root) {
+            m_stream << m_buffer.str();
+            m_stream.close();
+        }
+    }
+
+    void TraceRollup::columns(const std::vector<std::string> &agent_cols)
+    {
+        if (!m_is_enabled) {
+            return;
+        }
+        // Numeric columns of the default trace that are meaningful
+        // to summarize; time is recorded per window and the region
+        // ID cannot be averaged.
+        std::vector<IPlatformIO::m_request_s> base_columns({
+                {"REGION_PROGRESS", IPlatformTopo::M_DOMAIN_BOARD, 0},
+                {"REGION_RUNTIME", IPlatformTopo::M_DOMAIN_BOARD, 0},
+                {"ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_BOARD, 0},
+                {"ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD, 0},
+                {"POWER_PACKAGE", IPlatformTopo::M_DOMAIN_BOARD, 0},
+                {"FREQUENCY", IPlatformTopo::M_DOMAIN_BOARD, 0}});
+        for (const auto &extra : m_env_column) {
+            base_columns.push_back({extra, IPlatformTopo::M_DOMAIN_BOARD, 0});
+        }
+        std::vector<std::string> names;
+        for (const auto &col : base_columns) {
+            m_column_idx.push_back(m_platform_io.push_signal(col.name,
+                                                             col.domain_type,
+                                                             col.domain_idx));
+            names.push_back(ITracer::pretty_name(col));
+        }
+        names.insert(names.end(), agent_cols.begin(), agent_cols.end());
+        m_num_column = names.size();
+        size_t num_send_up = m_num_column * M_NUM_FIELD;
+
+        // The summaries travel on their own tree so that the agent
+        // message sizes are not affected.
+        if (!m_tree_comm) {
+            m_tree_comm = geopm::make_unique<TreeComm>(m_comm, 0, num_send_up);
+        }
+        m_num_level_ctl = m_tree_comm->num_level_controlled();
+        m_is_root = (m_num_level_ctl == m_tree_comm->root_level());
+        m_num_child.resize(m_num_level_ctl);
+        m_in_summary.resize(m_num_level_ctl);
+        for (int level = 0; level != m_num_level_ctl; ++level) {
+            m_num_child[level] = m_tree_comm->level_size(level);
+            m_in_summary[level].resize(m_num_child[level] * num_send_up);
+        }
+        m_window.resize(num_send_up);
+        m_out_summary.resize(num_send_up);
+        reset(m_window);
+        geopm_time(&m_time_zero);
+        m_window_begin = m_time_zero;
+
+        if (m_is_root) {
+            m_stream.open(m_file_path);
+            if (!m_stream.good()) {
+                std::cerr << "Warning: unable to open rollup trace file '" << m_file_path
+                          << "': " << strerror(errno) << std::endl;
+                m_is_enabled = false;
+                return;
+            }
+            m_buffer << "# \"geopm_version\" : \"" << geopm_version() << "\",\n"
+                     << "# \"rollup_period\" : " << m_period << "\n"
+                     << "seconds";
+            for (const auto &name : names) {
+                m_buffer << "|" << name << "-min"
+                         << "|" << name << "-mean"
+                         << "|" << name << "-max";
+            }
+            m_buffer << "\n";
+        }
+    }
+
+    void TraceRollup::reset(std::vector<double> &summary) const
+    {
+        for (size_t col_idx = 0; col_idx < m_num_column; ++col_idx) {
+            double *field = summary.data() + col_idx * M_NUM_FIELD;
+            // NAN is never sent: TreeComm treats it as missing data.
+            field[M_FIELD_COUNT] = 0.0;
+            field[M_FIELD_MIN] = std::numeric_limits<double>::infinity();
+            field[M_FIELD_SUM] = 0.0;
+            field[M_FIELD_MAX] = -std::numeric_limits<double>::infinity();
+        }
+    }
+
+    void TraceRollup::accumulate(size_t col_idx, double value, std::vector<double> &summary) const
+    {
+        if (!std::isnan(value)) {
+            double *field = summary.data() + col_idx * M_NUM_FIELD;
+            field[M_FIELD_COUNT] += 1.0;
+            field[M_FIELD_MIN] = std::min(field[M_FIELD_MIN], value);
+            field[M_FIELD_SUM] += value;
+            field[M_FIELD_MAX] = std::max(field[M_FIELD_MAX], value);
+        }
+    }
+
+    void TraceRollup::combine(MatrixView<const double> in_summary, std::vector<double> &out_summary) const
+    {
+        reset(out_summary);
+        for (size_t child_idx = 0; child_idx < in_summary.num_row(); ++child_idx) {
+            const double *child = in_summary.row(child_idx);
+            for (size_t col_idx = 0; col_idx < m_num_column; ++col_idx) {
+                const double *in_field = child + col_idx * M_NUM_FIELD;
+                double *out_field = out_summary.data() + col_idx * M_NUM_FIELD;
+                out_field[M_FIELD_COUNT] += in_field[M_FIELD_COUNT];
+                out_field[M_FIELD_MIN] = std::min(out_field[M_FIELD_MIN], in_field[M_FIELD_MIN]);
+                out_field[M_FIELD_SUM] += in_field[M_FIELD_SUM];
+                out_field[M_FIELD_MAX] = std::max(out_field[M_FIELD_MAX], in_field[M_FIELD_MAX]);
+            }
+        }
+    }
+
+    void TraceRollup::update(const std::vector<double> &agent_signals)
+    {
+        if (!m_is_enabled) {
+            return;
+        }
+#ifdef GEOPM_DEBUG
+        if (m_column_idx.size() + agent_signals.size() != m_num_column) {
+            throw Exception("TraceRollup::update(): agent signal vector not sized correctly.",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+#endif
+        size_t col_idx = 0;
+        for (; col_idx < m_column_idx.size(); ++col_idx) {
+            accumulate(col_idx, m_platform_io.sample(m_column_idx[col_idx]), m_window);
+        }
+        for (const auto &val : agent_signals) {
+            accumulate(col_idx, val, m_window);
+            ++col_idx;
+        }
+
+        struct geopm_time_s curr_time;
+        geopm_time(&curr_time);
+        bool do_send = false;
+        if (geopm_time_diff(&m_window_begin, &curr_time) >= m_period) {
+            m_out_summary = m_window;
+            reset(m_window);
+            m_window_begin = curr_time;
+            do_send = true;
+        }
+        for (int level = 0; level != m_num_level_ctl; ++level) {
+            if (do_send) {
+                m_tree_comm->send_up(level, m_out_summary);
+            }
+            MatrixView<double> in_summary(m_in_summary[level].data(),
+                                          m_num_child[level], m_num_column * M_NUM_FIELD);
+            do_send = m_tree_comm->receive_up_view(level, in_summary);
+            if (do_send) {
+                combine(in_summary, m_out_summary);
+            }
+        }
+        if (do_send) {
+            if (!m_is_root) {
+                m_tree_comm->send_up(m_num_level_ctl, m_out_summary);
+            }
+            else {
+                write_line(m_out_summary);
+            }
+        }
+    }
+
+    void TraceRollup::write_line(const std::vector<double> &summary)
+    {
+        struct geopm_time_s curr_time;
+        geopm_time(&curr_time);
+        m_buffer << std::setprecision(m_precision) << std::scientific
+                 << geopm_time_diff(&m_time_zero, &curr_time);
+        for (size_t col_idx = 0; col_idx < m_num_column; ++col_idx) {
+            const double *field = summary.data() + col_idx * M_NUM_FIELD;
+            double min = NAN;
+            double mean = NAN;
+            double max = NAN;
+            if (field[M_FIELD_COUNT] != 0.0) {
+                min = field[M_FIELD_MIN];
+                mean = field[M_FIELD_SUM] / field[M_FIELD_COUNT];
+                max = field[M_FIELD_MAX];
+            }
+            m_buffer << "|" << min << "|" << mean << "|" << max;
+        }
+        m_buffer << "\n";
+        // if buffer is full, flush to file
+        if (m_buffer.tellp() > m_buffer_limit) {
+            m_stream << m_buffer.str();
+            m_buffer.str("");
+        }
+    }
+
+    void TraceRollup::flush(void)
+    {
+        if (m_is_enabled && m_is_root) {
+            m_stream << m_buffer.str();
+            m_buffer.str("");
+            m_stream.close();
+        }
+        m_is_enabled = false;
+    }
+}
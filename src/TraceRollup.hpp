@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TRACEROLLUP_HPP_INCLUDE
+#define TRACEROLLUP_HPP_INCLUDE
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "geopm_time.h"
+#include "MatrixView.hpp"
+
+namespace geopm
+{
+    class Comm;
+    class IPlatformIO;
+    class ITreeComm;
+
+    /// @brief Summarizes trace columns over a time window on every
+    ///        node and combines the summaries up the controller
+    ///        tree so that the root can write a single cluster wide
+    ///        trace.
+    class ITraceRollup
+    {
+        public:
+            ITraceRollup() = default;
+            virtual ~ITraceRollup() = default;
+            /// @brief Set up the columns to be summarized: the
+            ///        default numeric trace signals, the signals
+            ///        requested through the environment and the
+            ///        columns provided by the Agent.
+            /// @param [in] agent_cols Names of the columns provided
+            ///        by the Agent.
+            virtual void columns(const std::vector<std::string> &agent_cols) = 0;
+            /// @brief Add one sample of every column to the current
+            ///        window.  When the window period has elapsed the
+            ///        summary is sent up the tree.  Summaries received
+            ///        from children are combined and forwarded, and
+            ///        at the root written to the rollup trace.
+            /// @param [in] agent_signals Values for the columns
+            ///        provided by the Agent.
+            virtual void update(const std::vector<double> &agent_signals) = 0;
+            /// @brief Write the remaining rollup data to the file
+            ///        and stop the rollup.  Any partial window is
+            ///        discarded.
+            virtual void flush(void) = 0;
+    };
+
+    class TraceRollup : public ITraceRollup
+    {
+        public:
+            /// @brief Fields of the summary sent up the tree for
+            ///        each column.
+            enum m_field_e {
+                M_FIELD_COUNT,
+                M_FIELD_MIN,
+                M_FIELD_SUM,
+                M_FIELD_MAX,
+                M_NUM_FIELD,
+            };
+            /// @brief Constructor configured by the GEOPM_TRACE_ROLLUP
+            ///        and GEOPM_TRACE_ROLLUP_PERIOD environment
+            ///        variables.
+            /// @param [in] comm Communicator with one rank per node
+            ///        used to create the tree.
+            TraceRollup(std::shared_ptr<Comm> comm);
+            /// @brief Constructor for testing that allows injecting
+            ///        the tree communication.
+            /// @param [in] tree_comm Tree used to send summaries; if
+            ///        null one is created from comm when the columns
+            ///        are set.
+            TraceRollup(std::shared_ptr<Comm> comm,
+                        const std::string &file_path,
+                        bool do_rollup,
+                        double period,
+                        IPlatformIO &platform_io,
+                        const std::vector<std::string> &env_column,
+                        int precision,
+                        std::unique_ptr<ITreeComm> tree_comm);
+            virtual ~TraceRollup();
+            void columns(const std::vector<std::string> &agent_cols) override;
+            void update(const std::vector<double> &agent_signals) override;
+            void flush(void) override;
+        private:
+            /// @brief Set every column of a summary to the identity
+            ///        of its reduction.
+            void reset(std::vector<double> &summary) const;
+            /// @brief Add a sample to a column of a summary.
+            void accumulate(size_t col_idx, double value, std::vector<double> &summary) const;
+            /// @brief Combine the summaries from all children into
+            ///        one summary.
+            void combine(MatrixView<const double> in_summary, std::vector<double> &out_summary) const;
+            void write_line(const std::vector<double> &summary);
+
+            std::shared_ptr<Comm> m_comm;
+            std::string m_file_path;
+            bool m_is_enabled;
+            double m_period;
+            IPlatformIO &m_platform_io;
+            std::vector<std::string> m_env_column;
+            int m_precision;
+            std::unique_ptr<ITreeComm> m_tree_comm;
+            int m_num_level_ctl;
+            bool m_is_root;
+            std::vector<int> m_column_idx; // columns sampled by TraceRollup
+            size_t m_num_column;
+            std::vector<int> m_num_child;
+            /// Summary of the samples in the current window.
+            std::vector<double> m_window;
+            std::vector<double> m_out_summary;
+            /// Summaries from children at each controlled level
+            /// packed into a child by summary matrix.
+            std::vector<std::vector<double> > m_in_summary;
+            struct geopm_time_s m_time_zero;
+            struct geopm_time_s m_window_begin;
+            std::ofstream m_stream;
+            std::ostringstream m_buffer;
+            off_t m_buffer_limit;
+    };
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <limits.h>
 #include <string.h>
 #include <cctype>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
@@ -43,6 +44,9 @@
 #include "PlatformIO.hpp"
 #include "PlatformTopo.hpp"
 #include "Exception.hpp"
+#include "Helper.hpp"
+#include "TraceCodec.hpp"
+#include "TraceBlockWriter.hpp"
 #include "geopm_env.h"
 #include "geopm_hash.h"
 #include "geopm_version.h"
@@ -96,7 +100,8 @@ namespace geopm
 
     Tracer::Tracer()
         : Tracer(geopm_env_trace(), hostname(), geopm_env_do_trace(), platform_io(),
-                 {}, 16)
+                 {}, 16, geopm_env_do_trace_adaptive(), geopm_env_trace_adaptive(),
+                 geopm_env_trace_adaptive_burst(), geopm_env_trace_codec())
     {
 
     }
@@ -106,7 +111,11 @@ namespace geopm
                    bool do_trace,
                    IPlatformIO &platform_io,
                    const std::vector<std::string> &env_column,
-                   int precision)
+                   int precision,
+                   bool do_adaptive,
+                   double adaptive_tolerance,
+                   int adaptive_burst,
+                   const std::string &codec_name)
         : m_file_path(file_path)
         , m_hostname(hostname)
         , m_is_trace_enabled(do_trace)
@@ -117,6 +126,9 @@ namespace geopm
         , m_platform_io(platform_io)
         , m_env_column(env_column)
         , m_precision(precision)
+        , m_is_adaptive(do_adaptive)
+        , m_adaptive_tolerance(adaptive_tolerance)
+        , m_adaptive_burst(adaptive_burst)
     {
         if (m_env_column.empty()) {
             auto num_extra_cols = geopm_env_num_trace_signal();
@@ -125,7 +137,27 @@ namespace geopm
             }
         }
 
-        if (m_is_trace_enabled) {
+        if (m_is_trace_enabled && !codec_name.empty()) {
+            std::unique_ptr<ITraceCodec> codec;
+            try {
+                codec = trace_codec_factory().make_plugin(codec_name);
+            }
+            catch (const Exception &ex) {
+                std::cerr << "Warning: trace codec \"" << codec_name << "\" is not available, using \""
+                          << LZ4TraceCodec::plugin_name() << "\"" << std::endl;
+                codec = trace_codec_factory().make_plugin(LZ4TraceCodec::plugin_name());
+            }
+            std::string output_path = m_file_path + "-" + m_hostname + ".gtb";
+            try {
+                m_block_writer = geopm::make_unique<TraceBlockWriter>(output_path, std::move(codec));
+                m_buffer_limit = 1048576; // 1 MiB blocks
+            }
+            catch (const Exception &ex) {
+                std::cerr << "Warning: " << ex.what() << std::endl;
+                m_is_trace_enabled = false;
+            }
+        }
+        else if (m_is_trace_enabled) {
             std::ostringstream output_path;
             output_path << m_file_path << "-" << m_hostname;
             m_stream.open(output_path.str());
@@ -134,7 +166,8 @@ namespace geopm
                           << "': " << strerror(errno) << std::endl;
                 m_is_trace_enabled = false;
             }
-
+        }
+        if (m_is_trace_enabled) {
             // Header
             m_buffer << "# \"geopm_version\" : \"" << geopm_version() << "\",\n"
                      << "# \"profile_name\" : \"TODO\",\n"
@@ -147,10 +180,31 @@ namespace geopm
 
     Tracer::~Tracer()
     {
-        if (m_stream.good() && m_is_trace_enabled) {
+        if (m_is_trace_enabled) {
+            try {
+                write_buffer();
+                if (m_block_writer) {
+                    m_block_writer->close();
+                }
+            }
+            catch (...) {
+                geopm::exception_handler(std::current_exception(), true);
+            }
+            if (!m_block_writer) {
+                m_stream.close();
+            }
+        }
+    }
+
+    void Tracer::write_buffer(void)
+    {
+        if (m_block_writer) {
+            m_block_writer->write(m_buffer.str());
+        }
+        else {
             m_stream << m_buffer.str();
-            m_stream.close();
         }
+        m_buffer.str("");
     }
 
     void Tracer::update(const std::vector <struct geopm_telemetry_message_s> &telemetry)
@@ -189,8 +243,7 @@ namespace geopm
 
         }
         if (m_buffer.tellp() > m_buffer_limit) {
-            m_stream << m_buffer.str();
-            m_buffer.str("");
+            write_buffer();
         }
     }
 
@@ -217,6 +270,7 @@ namespace geopm
                     {"POWER_PACKAGE", PlatformTopo::M_DOMAIN_BOARD, 0},
                     {"FREQUENCY", PlatformTopo::M_DOMAIN_BOARD, 0}});
             // for region entry/exit, make sure region index is known
+            m_time_idx = 0;
             m_region_id_idx = 1;
             m_region_progress_idx = 2;
             m_region_runtime_idx = 3;
@@ -253,16 +307,17 @@ namespace geopm
         }
     }
 
-    void Tracer::write_line(void)
+    void Tracer::write_line(const std::vector<double> &row)
     {
         m_buffer << std::setprecision(m_precision) << std::scientific;
-        for (size_t idx = 0; idx < m_last_telemetry.size(); ++idx) {
+        for (size_t idx = 0; idx < row.size(); ++idx) {
             if (idx != 0) {
                 m_buffer << "|";
             }
-            if (m_hex_column.find(m_column_idx[idx]) != m_hex_column.end()) {
+            if (idx < m_column_idx.size() &&
+                m_hex_column.find(m_column_idx[idx]) != m_hex_column.end()) {
                 m_buffer << "0x" << std::hex << std::setfill('0') << std::setw(16);
-                uint64_t value = geopm_signal_to_field(m_last_telemetry[idx]);
+                uint64_t value = geopm_signal_to_field(row[idx]);
                 if ((int)idx == m_region_id_idx) {
                     // Remove hints from trace
                     value = geopm_region_id_unset_hint(GEOPM_MASK_REGION_HINT, value);
@@ -272,16 +327,86 @@ namespace geopm
             }
             else if ((int)idx == m_region_progress_idx) {
                 m_buffer << std::setprecision(1) << std::fixed
-                         << m_last_telemetry[idx]
+                         << row[idx]
                          << std::setprecision(m_precision) << std::scientific;
             }
             else {
-                m_buffer << m_last_telemetry[idx];
+                m_buffer << row[idx];
             }
         }
         m_buffer << "\n";
     }
 
+    bool Tracer::is_changed(void) const
+    {
+        bool result = m_last_written.empty();
+        for (size_t idx = 0; !result && idx < m_last_telemetry.size(); ++idx) {
+            double curr = m_last_telemetry[idx];
+            double last = m_last_written[idx];
+            if ((int)idx == m_time_idx ||
+                (std::isnan(curr) && std::isnan(last))) {
+                continue;
+            }
+            if ((int)idx == m_region_id_idx) {
+                result = (geopm_signal_to_field(curr) != geopm_signal_to_field(last));
+            }
+            else {
+                // Comparisons with NAN are false, so a change to or
+                // from NAN is detected by the negation.
+                result = !(std::fabs(curr - last) <= m_adaptive_tolerance * std::fabs(last));
+            }
+        }
+        return result;
+    }
+
+    void Tracer::write_held(void)
+    {
+        if (m_num_dropped) {
+            m_buffer << std::setprecision(m_precision) << std::scientific
+                     << "# gap " << m_num_dropped << " "
+                     << m_dropped_begin << " " << m_dropped_end << "\n";
+            m_num_dropped = 0;
+        }
+        if (m_is_held) {
+            write_line(m_held);
+            m_is_held = false;
+        }
+    }
+
+    void Tracer::adaptive_line(bool is_transition)
+    {
+        if (!m_is_adaptive) {
+            write_line(m_last_telemetry);
+            return;
+        }
+        bool is_trigger = is_transition || is_changed();
+        if (is_trigger || m_burst_remain > 0) {
+            // The held row is the last one before the change, write
+            // it so the transition is bracketed at full rate.
+            write_held();
+            write_line(m_last_telemetry);
+            m_last_written = m_last_telemetry;
+            if (is_trigger) {
+                m_burst_remain = m_adaptive_burst;
+            }
+            else {
+                --m_burst_remain;
+            }
+        }
+        else {
+            if (m_is_held) {
+                double held_time = m_held[m_time_idx];
+                if (!m_num_dropped) {
+                    m_dropped_begin = held_time;
+                }
+                m_dropped_end = held_time;
+                ++m_num_dropped;
+            }
+            m_held = m_last_telemetry;
+            m_is_held = true;
+        }
+    }
+
     void Tracer::update(const std::vector<double> &agent_values,
                         std::list<geopm_region_info_s> region_entry_exit)
     {
@@ -322,7 +447,7 @@ namespace geopm
                     m_last_telemetry[m_region_id_idx] = geopm_field_to_signal(reg.region_id);
                     m_last_telemetry[m_region_progress_idx] = reg.progress;
                     m_last_telemetry[m_region_runtime_idx] = reg.runtime;
-                    write_line();
+                    adaptive_line(true);
                 }
                 ++idx;
             }
@@ -330,21 +455,30 @@ namespace geopm
             m_last_telemetry[m_region_id_idx] = region_id;
             m_last_telemetry[m_region_progress_idx] = region_progress;
             m_last_telemetry[m_region_runtime_idx] = region_runtime;
-            write_line();
+            adaptive_line(false);
         }
 
         // if buffer is full, flush to file
         if (m_buffer.tellp() > m_buffer_limit) {
-            m_stream << m_buffer.str();
-            m_buffer.str("");
+            write_buffer();
         }
     }
 
     void Tracer::flush(void)
     {
-        m_stream << m_buffer.str();
-        m_buffer.str("");
-        m_stream.close();
+        if (m_is_trace_enabled) {
+            // Keep the final state of the trace
+            write_held();
+        }
+        write_buffer();
+        if (m_block_writer) {
+            // Writes the compression ratio and throughput after the
+            // last block.
+            m_block_writer->close();
+        }
+        else {
+            m_stream.close();
+        }
         m_is_trace_enabled = false;
     }
 
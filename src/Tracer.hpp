@@ -39,6 +39,7 @@
 #include <sstream>
 #include <set>
 #include <list>
+#include <memory>
 
 #include "PlatformIO.hpp"
 #include "geopm_message.h"
@@ -88,6 +89,7 @@ namespace geopm
     };
 
     class IPlatformIO;
+    class TraceBlockWriter;
 
     /// @brief Class used to write a trace of the telemetry and policy.
     class Tracer : public ITracer
@@ -96,12 +98,27 @@ namespace geopm
             /// @brief Tracer constructor.
             Tracer(std::string header);
             Tracer();
+            /// @param [in] do_adaptive If true, rows are suppressed
+            ///        while all columns stay within
+            ///        adaptive_tolerance of the last written row.
+            /// @param [in] adaptive_tolerance Relative change in any
+            ///        column that causes a row to be written.
+            /// @param [in] adaptive_burst Number of rows written at
+            ///        full rate after a region transition or a change
+            ///        larger than the tolerance.
+            /// @param [in] codec_name Name of the ITraceCodec used to
+            ///        write a block compressed trace, or empty to
+            ///        write plain text.
             Tracer(const std::string &file_path,
                    const std::string &hostname,
                    bool do_trace,
                    IPlatformIO &platform_io,
                    const std::vector<std::string> &env_column,
-                   int precision);
+                   int precision,
+                   bool do_adaptive,
+                   double adaptive_tolerance,
+                   int adaptive_burst,
+                   const std::string &codec_name);
             /// @brief Tracer destructor, virtual.
             virtual ~Tracer();
             void update(const std::vector <struct geopm_telemetry_message_s> &telemetry) override;
@@ -113,14 +130,32 @@ namespace geopm
             void flush(void) override;
         private:
             static std::string hostname(void);
-            /// @brief Format and write the values in m_last_telemetry to the trace.
-            void write_line(void);
+            /// @brief Move the formatted trace in m_buffer to the
+            ///        file or to the block writer.
+            void write_buffer(void);
+            /// @brief Format and write a row of values to the trace.
+            void write_line(const std::vector<double> &row);
+            /// @brief Write the values in m_last_telemetry to the
+            ///        trace, or hold them back if adaptive tracing is
+            ///        enabled and they are within tolerance of the
+            ///        last written row.
+            /// @param [in] is_transition True if the row records a
+            ///        region entry or exit and must be written.
+            void adaptive_line(bool is_transition);
+            /// @brief Returns true if any column of m_last_telemetry
+            ///        differs from the last written row by more than
+            ///        the adaptive tolerance.
+            bool is_changed(void) const;
+            /// @brief Write the gap marker for dropped rows and the
+            ///        last held back row.
+            void write_held(void);
             std::string m_file_path;
             std::string m_header;
             std::string m_hostname;
             bool m_is_trace_enabled;
             bool m_do_header;
             std::ofstream m_stream;
+            std::unique_ptr<TraceBlockWriter> m_block_writer;
             std::ostringstream m_buffer;
             off_t m_buffer_limit;
             struct geopm_time_s m_time_zero;
@@ -135,6 +170,21 @@ namespace geopm
             int m_region_id_idx = -1;
             int m_region_progress_idx = -1;
             int m_region_runtime_idx = -1;
+            int m_time_idx = -1;
+            bool m_is_adaptive = false;
+            double m_adaptive_tolerance = 0.0;
+            int m_adaptive_burst = 0;
+            /// Number of rows left to write at full rate.
+            int m_burst_remain = 0;
+            std::vector<double> m_last_written;
+            /// Most recent row that was held back.
+            std::vector<double> m_held;
+            bool m_is_held = false;
+            /// Number of rows dropped before the held row and the
+            /// time of the first and last of them.
+            int m_num_dropped = 0;
+            double m_dropped_begin = 0.0;
+            double m_dropped_end = 0.0;
     };
 }
 
@@ -184,6 +184,24 @@ namespace geopm
         return m_level_ctl[level]->receive_down(policy);
     }
 
+    void TreeComm::send_down_view(int level, MatrixView<const double> policy)
+    {
+        if (level < 0 || level >= m_num_level_ctl) {
+            throw Exception("TreeComm::send_down_view()",
+                            GEOPM_ERROR_LEVEL_RANGE, __FILE__, __LINE__);
+        }
+        m_level_ctl[level]->send_down_view(policy);
+    }
+
+    bool TreeComm::receive_up_view(int level, MatrixView<double> sample)
+    {
+        if (level < 0 || level >= m_num_level_ctl) {
+            throw Exception("TreeComm::receive_up_view()",
+                            GEOPM_ERROR_LEVEL_RANGE, __FILE__, __LINE__);
+        }
+        return m_level_ctl[level]->receive_up_view(sample);
+    }
+
     size_t TreeComm::overhead_send(void) const
     {
         size_t result = 0;
@@ -35,6 +35,8 @@
 
 #include <vector>
 
+#include "MatrixView.hpp"
+
 namespace geopm
 {
     class Comm;
@@ -65,6 +67,12 @@ namespace geopm
             virtual bool receive_up(int level, std::vector<std::vector<double> > &sample) = 0;
             /// @brief Receive policies from the parent within a level.
             virtual bool receive_down(int level, std::vector<double> &policy) = 0;
+            /// @brief Send policies down to children within a level
+            ///        from a matrix with one row per child.
+            virtual void send_down_view(int level, MatrixView<const double> policy) = 0;
+            /// @brief Receive samples from children within a level
+            ///        into a matrix with one row per child.
+            virtual bool receive_up_view(int level, MatrixView<double> sample) = 0;
             /// @brief Returns the total number of bytes sent from the
             ///        entire tree.
             virtual size_t overhead_send(void) const = 0;
@@ -97,6 +105,8 @@ namespace geopm
             void send_up(int level, const std::vector<double> &sample) override;
             bool receive_down(int level, std::vector<double> &policy) override;
             bool receive_up(int level, std::vector<std::vector<double> > &sample) override;
+            void send_down_view(int level, MatrixView<const double> policy) override;
+            bool receive_up_view(int level, MatrixView<double> sample) override;
             size_t overhead_send(void) const override;
         private:
             int num_level_controlled(std::vector<int> coords);
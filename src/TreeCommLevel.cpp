@@ -54,7 +54,7 @@ namespace geopm
         , m_num_send_down(num_send_down)
     {
         if (!m_rank) {
-            m_policy_last.resize(m_size, std::vector<double>(num_send_down, 0.0));
+            m_policy_last.resize(m_size * num_send_down, 0.0);
         }
         create_window();
     }
@@ -102,6 +102,24 @@ namespace geopm
     }
 
     void TreeCommLevel::send_down(const std::vector<std::vector<double> > &policy)
+    {
+        size_t num_down = m_num_send_down;
+        if (m_size != (int)policy.size() ||
+            std::any_of(policy.begin(), policy.end(),
+                        [num_down](const std::vector<double> &it)
+                        {return it.size() != num_down;})) {
+            throw Exception("TreeCommLevel::send_down(): policy vector is not sized correctly.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_pack.resize(m_size * m_num_send_down);
+        for (int child_rank = 0; child_rank != m_size; ++child_rank) {
+            std::copy(policy[child_rank].begin(), policy[child_rank].end(),
+                      m_pack.begin() + child_rank * m_num_send_down);
+        }
+        send_down_view(MatrixView<const double>(m_pack.data(), m_size, m_num_send_down));
+    }
+
+    void TreeCommLevel::send_down_view(MatrixView<const double> policy)
     {
 #ifdef GEOPM_DEBUG
         if (m_rank != 0) {
@@ -109,33 +127,53 @@ namespace geopm
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
         }
 #endif
-        size_t num_down = m_num_send_down;
-        if (m_size != (int)policy.size() ||
-            std::any_of(policy.begin(), policy.end(),
-                        [num_down](std::vector<double> it)
-                        {return it.size() != num_down;})) {
-            throw Exception("TreeCommLevel::send_down(): policy vector is not sized correctly.",
+        if (m_size != (int)policy.num_row() ||
+            m_num_send_down != policy.num_col()) {
+            throw Exception("TreeCommLevel::send_down_view(): policy matrix is not sized correctly.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         size_t msg_size = sizeof(double) * m_num_send_down;
         double is_ready = 1.0;
         m_policy_mailbox[0] = is_ready;
         // Copy message to self for rank zero
-        memcpy(m_policy_mailbox + 1, policy[0].data(), msg_size);
+        memcpy(m_policy_mailbox + 1, policy.row(0), msg_size);
 
         for (int child_rank = 1; child_rank != m_size; ++child_rank) {
-            if (policy[child_rank] != m_policy_last[child_rank]) {
+            const double *child_policy = policy.row(child_rank);
+            double *child_last = m_policy_last.data() + child_rank * m_num_send_down;
+            if (!std::equal(child_policy, child_policy + m_num_send_down, child_last)) {
                 m_comm->window_lock(m_policy_window, true, child_rank, 0);
                 m_comm->window_put(&is_ready, sizeof(double), child_rank, 0, m_policy_window);
-                m_comm->window_put(policy[child_rank].data(), msg_size, child_rank, sizeof(double), m_policy_window);
+                m_comm->window_put(child_policy, msg_size, child_rank, sizeof(double), m_policy_window);
                 m_comm->window_unlock(m_policy_window, child_rank);
                 m_overhead_send += sizeof(double) + msg_size;
-                m_policy_last[child_rank] = policy[child_rank];
+                std::copy(child_policy, child_policy + m_num_send_down, child_last);
             }
         }
     }
 
     bool TreeCommLevel::receive_up(std::vector<std::vector<double> > &sample)
+    {
+        size_t num_up = m_num_send_up;
+        if (m_size != (int)sample.size() ||
+            std::any_of(sample.begin(), sample.end(),
+                        [num_up](const std::vector<double> &it)
+                        {return it.size() != num_up;})) {
+            throw Exception("TreeCommLevel::receive_up(): sample vector is not sized correctly.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_pack.resize(m_size * m_num_send_up);
+        bool is_complete = receive_up_view(MatrixView<double>(m_pack.data(), m_size, m_num_send_up));
+        if (is_complete) {
+            for (int child_rank = 0; child_rank != m_size; ++child_rank) {
+                auto child_begin = m_pack.begin() + child_rank * m_num_send_up;
+                std::copy(child_begin, child_begin + m_num_send_up, sample[child_rank].begin());
+            }
+        }
+        return is_complete;
+    }
+
+    bool TreeCommLevel::receive_up_view(MatrixView<double> sample)
     {
 #ifdef GEOPM_DEBUG
         if (m_rank != 0) {
@@ -143,12 +181,9 @@ namespace geopm
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
         }
 #endif
-        size_t num_up = m_num_send_up;
-        if (m_size != (int)sample.size() ||
-            std::any_of(sample.begin(), sample.end(),
-                        [num_up](std::vector<double> it)
-                        {return it.size() != num_up;})) {
-            throw Exception("TreeCommLevel::send_down(): policy vector is not sized correctly.",
+        if (m_size != (int)sample.num_row() ||
+            m_num_send_up != sample.num_col()) {
+            throw Exception("TreeCommLevel::receive_up_view(): sample matrix is not sized correctly.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
 
@@ -163,21 +198,18 @@ namespace geopm
         if (is_complete) {
             m_comm->window_lock(m_sample_window, true, 0, 0);
             for (int child_rank = 0; child_rank != m_size; ++child_rank) {
-                memcpy(sample[child_rank].data(),
+                memcpy(sample.row(child_rank),
                        m_sample_mailbox + child_rank * (m_num_send_up + 1) + 1,
                        sizeof(double) * m_num_send_up);
                 m_sample_mailbox[child_rank * (m_num_send_up + 1)] = 0.0;
             }
             m_comm->window_unlock(m_sample_window, 0);
+            for (int child_rank = 0; is_complete && child_rank != m_size; ++child_rank) {
+                const double *child_sample = sample.row(child_rank);
+                is_complete = std::none_of(child_sample, child_sample + m_num_send_up,
+                                           [](double val){return std::isnan(val);});
+            }
         }
-
-        is_complete = is_complete &&
-                      std::none_of(sample.begin(), sample.end(),
-                                   [](const std::vector<double> &vec)
-                                   {
-                                       return std::any_of(vec.begin(), vec.end(),
-                                                          [](double val){return std::isnan(val);});
-                                   });
         return is_complete;
     }
 
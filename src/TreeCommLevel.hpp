@@ -36,6 +36,8 @@
 #include <vector>
 #include <memory>
 
+#include "MatrixView.hpp"
+
 namespace geopm
 {
     class Comm;
@@ -55,6 +57,12 @@ namespace geopm
             virtual bool receive_up(std::vector<std::vector<double> > &sample) = 0;
             /// @brief Receive policies down from the parent.
             virtual bool receive_down(std::vector<double> &policy) = 0;
+            /// @brief Send policies down to children from a
+            ///        contiguous matrix with one row per child.
+            virtual void send_down_view(MatrixView<const double> policy) = 0;
+            /// @brief Receive samples up from children into a
+            ///        contiguous matrix with one row per child.
+            virtual bool receive_up_view(MatrixView<double> sample) = 0;
             /// @brief Returns the total number of bytes sent at this
             ///        level.
             virtual size_t overhead_send(void) const = 0;
@@ -70,6 +78,8 @@ namespace geopm
             void send_down(const std::vector<std::vector<double> > &policy) override;
             bool receive_up(std::vector<std::vector<double> > &sample) override;
             bool receive_down(std::vector<double> &policy) override;
+            void send_down_view(MatrixView<const double> policy) override;
+            bool receive_up_view(MatrixView<double> sample) override;
             size_t overhead_send(void) const override;
         private:
             void create_window();
@@ -81,9 +91,14 @@ namespace geopm
             size_t m_sample_window;
             size_t m_policy_window;
             size_t m_overhead_send;
-            std::vector<std::vector<double> > m_policy_last;
+            /// Last policy sent to each child packed with one row per
+            /// child.
+            std::vector<double> m_policy_last;
             size_t m_num_send_up;
             size_t m_num_send_down;
+            /// Scratch space used to pack vector of vector messages
+            /// into a contiguous matrix.
+            std::vector<double> m_pack;
     };
 }
 
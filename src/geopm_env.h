@@ -47,6 +47,13 @@ const char *geopm_env_policy(void);
 const char *geopm_env_agent(void);
 const char *geopm_env_shmkey(void);
 const char *geopm_env_trace(void);
+const char *geopm_env_trace_rollup(void);
+const char *geopm_env_trace_codec(void);
+const char *geopm_env_sample_ring(void);
+const char *geopm_env_topo_cache(void);
+const char *geopm_env_record(void);
+const char *geopm_env_sim(void);
+const char *geopm_env_perf_event_pid(void);
 const char *geopm_env_plugin_path(void);
 const char *geopm_env_report(void);
 const char *geopm_env_comm(void);
@@ -57,9 +64,15 @@ int geopm_env_report_verbosity(void);
 int geopm_env_pmpi_ctl(void);
 int geopm_env_do_region_barrier(void);
 int geopm_env_do_trace(void);
+int geopm_env_do_trace_rollup(void);
+int geopm_env_trace_rollup_period(void);
+int geopm_env_do_trace_adaptive(void);
+double geopm_env_trace_adaptive(void);
+int geopm_env_trace_adaptive_burst(void);
 int geopm_env_do_profile(void);
 int geopm_env_profile_timeout(void);
 int geopm_env_debug_attach(void);
+int geopm_env_agent_threads(void);
 int geopm_env_do_kontroller(void);
 
 #ifdef __cplusplus
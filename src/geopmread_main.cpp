@@ -36,8 +36,10 @@
 #include <unistd.h>
 #include <getopt.h>
 #include <errno.h>
+#include <signal.h>
 
 #include <string>
+#include <vector>
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
@@ -45,6 +47,7 @@
 #include "geopm_version.h"
 #include "geopm_error.h"
 #include "geopm_env.h"
+#include "geopm_time.h"
 #include "PlatformIO.hpp"
 #include "PlatformTopo.hpp"
 #include "Exception.hpp"
@@ -56,10 +59,90 @@ using geopm::IPlatformTopo;
 
 int parse_domain_type(const std::string &dom);
 
+static volatile sig_atomic_t g_is_stopped = 0;
+
+static void stop_handler(int signum)
+{
+    g_is_stopped = 1;
+}
+
+/// @brief Read the pushed signals every period seconds and write a
+///        row for each read to standard output until the count is
+///        reached (if non-zero), a SIGINT or SIGTERM is received, or
+///        standard output is closed.  Each row is the time since the
+///        first read followed by the signals in the order pushed,
+///        either as CSV or as native double precision values.
+static int stream_signals(IPlatformIO &platform_io,
+                          const std::vector<int> &signal_idx,
+                          const std::vector<std::string> &column_name,
+                          double period,
+                          long count,
+                          bool is_binary)
+{
+    struct sigaction action = {};
+    action.sa_handler = stop_handler;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    // Detect a closed pipe from the failed write instead
+    signal(SIGPIPE, SIG_IGN);
+
+    if (!is_binary) {
+        printf("TIME");
+        for (const auto &name : column_name) {
+            printf(",%s", name.c_str());
+        }
+        printf("\n");
+    }
+    std::vector<double> row(signal_idx.size() + 1);
+    struct geopm_time_s start;
+    struct geopm_time_s next;
+    geopm_time(&start);
+    next = start;
+    int err = 0;
+    for (long row_idx = 0; !err && !g_is_stopped && (!count || row_idx < count); ++row_idx) {
+        platform_io.read_batch();
+        struct geopm_time_s now;
+        geopm_time(&now);
+        row[0] = geopm_time_diff(&start, &now);
+        for (size_t sig_idx = 0; sig_idx < signal_idx.size(); ++sig_idx) {
+            row[sig_idx + 1] = platform_io.sample(signal_idx[sig_idx]);
+        }
+        if (is_binary) {
+            if (fwrite(row.data(), sizeof(double), row.size(), stdout) != row.size()) {
+                err = errno ? errno : EIO;
+            }
+        }
+        else {
+            printf("%.6f", row[0]);
+            for (size_t col_idx = 1; col_idx < row.size(); ++col_idx) {
+                printf(",%.16g", row[col_idx]);
+            }
+            printf("\n");
+        }
+        if (!err && fflush(stdout)) {
+            err = errno ? errno : EIO;
+        }
+        if (!err && (!count || row_idx + 1 < count)) {
+            // Skip any periods missed rather than reading in a burst
+            do {
+                geopm_time_add(&next, period, &next);
+            } while (geopm_time_comp(&next, &now));
+            double wait = geopm_time_diff(&now, &next);
+            struct timespec wait_ts = {(time_t)wait, (long)((wait - (time_t)wait) * 1E9)};
+            while (!g_is_stopped && nanosleep(&wait_ts, &wait_ts) == -1 && errno == EINTR) {
+
+            }
+        }
+    }
+    // A closed standard output ends the stream as a stop signal does
+    return err == EPIPE ? 0 : err;
+}
+
 int main(int argc, char **argv)
 {
     const char *usage = "\nUsage:\n"
-                        "       geopmread SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX\n"
+                        "       geopmread SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX [SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX ...]\n"
+                        "       geopmread -p PERIOD [-n COUNT] [-b] SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX ...\n"
                         "       geopmread [-d [SIGNAL_NAME]]\n"
                         "       geopmread [--help] [--version]\n"
                         "\n"
@@ -68,6 +151,11 @@ int main(int argc, char **argv)
                         "  DOMAIN_INDEX: index of the domain, starting from 0\n"
                         "\n"
                         "  -d, --domain                     print domain of a signal\n"
+                        "  -p, --period=PERIOD              read the signals every PERIOD seconds and\n"
+                        "                                   print a CSV row for each read until stopped\n"
+                        "  -n, --count=COUNT                stop after COUNT rows when streaming\n"
+                        "  -b, --binary                     write rows as native double precision values\n"
+                        "                                   when streaming\n"
                         "  -h, --help                       print brief summary of the command line\n"
                         "                                   usage information, then exit\n"
                         "  -v, --version                    print version of GEOPM to standard output,\n"
@@ -78,6 +166,9 @@ int main(int argc, char **argv)
 
     static struct option long_options[] = {
         {"domain", no_argument, NULL, 'd'},
+        {"period", required_argument, NULL, 'p'},
+        {"count", required_argument, NULL, 'n'},
+        {"binary", no_argument, NULL, 'b'},
         {"help", no_argument, NULL, 'h'},
         {"version", no_argument, NULL, 'v'},
         {NULL, 0, NULL, 0}
@@ -86,11 +177,32 @@ int main(int argc, char **argv)
     int opt;
     int err = 0;
     bool is_domain = false;
-    while (!err && (opt = getopt_long(argc, argv, "dhv", long_options, NULL)) != -1) {
+    bool is_binary = false;
+    double period = 0.0;
+    long count = 0;
+    char *end_ptr = NULL;
+    while (!err && (opt = getopt_long(argc, argv, "dp:n:bhv", long_options, NULL)) != -1) {
         switch (opt) {
             case 'd':
                 is_domain = true;
                 break;
+            case 'p':
+                period = strtod(optarg, &end_ptr);
+                if (*end_ptr != '\0' || !(period > 0.0)) {
+                    std::cerr << "Error: period must be a positive number of seconds." << std::endl;
+                    err = EINVAL;
+                }
+                break;
+            case 'n':
+                count = strtol(optarg, &end_ptr, 10);
+                if (*end_ptr != '\0' || count < 0) {
+                    std::cerr << "Error: count must be a non-negative integer." << std::endl;
+                    err = EINVAL;
+                }
+                break;
+            case 'b':
+                is_binary = true;
+                break;
             case 'h':
                 printf("%s", usage);
                 return 0;
@@ -109,6 +221,10 @@ int main(int argc, char **argv)
         }
     }
 
+    if (err) {
+        return err;
+    }
+
     std::vector<std::string> pos_args;
     while (optind < argc) {
         pos_args.emplace_back(argv[optind++]);
@@ -138,7 +254,7 @@ int main(int argc, char **argv)
         }
     }
     else {
-        if (pos_args.size() == 0) {
+        if (pos_args.size() == 0 && period == 0.0) {
             // print all signals
             auto signals = platform_io.signal_names();
             for (const auto &sig : signals) {
@@ -146,23 +262,45 @@ int main(int argc, char **argv)
             }
         }
         else if (pos_args.size() >= 3) {
-            // read signal
-            std::string signal_name = pos_args[0];
-            int domain_idx = -1;
-            try {
-                domain_idx = std::stoi(pos_args[2]);
-            }
-            catch (std::invalid_argument) {
-                std::cerr << "Error: invalid domain index.\n" << std::endl;
-                err = EINVAL;
+            // read signals; arguments after the last complete triple
+            // are ignored, as they were when only one signal was read
+            std::vector<int> signal_idx;
+            std::vector<std::string> column_name;
+            for (size_t arg_idx = 0; !err && arg_idx + 2 < pos_args.size(); arg_idx += 3) {
+                const std::string &signal_name = pos_args[arg_idx];
+                int domain_idx = -1;
+                try {
+                    domain_idx = std::stoi(pos_args[arg_idx + 2]);
+                }
+                catch (std::invalid_argument) {
+                    std::cerr << "Error: invalid domain index.\n" << std::endl;
+                    err = EINVAL;
+                }
+                if (!err) {
+                    try {
+                        int domain_type = IPlatformTopo::domain_name_to_type(pos_args[arg_idx + 1]);
+                        signal_idx.push_back(platform_io.push_signal(signal_name, domain_type, domain_idx));
+                        column_name.push_back(signal_name + "-" + pos_args[arg_idx + 1] + "-" +
+                                              std::to_string(domain_idx));
+                    }
+                    catch (const geopm::Exception &ex) {
+                        std::cerr << "Error: cannot read signal: " << ex.what() << std::endl;
+                        err = EINVAL;
+                    }
+                }
             }
             if (!err) {
                 try {
-                    int domain_type = IPlatformTopo::domain_name_to_type(pos_args[1]);
-                    int idx = platform_io.push_signal(signal_name, domain_type, domain_idx);
-                    platform_io.read_batch();
-                    double result = platform_io.sample(idx);
-                    std::cout << result << std::endl;
+                    if (period > 0.0) {
+                        err = stream_signals(platform_io, signal_idx, column_name,
+                                             period, count, is_binary);
+                    }
+                    else {
+                        platform_io.read_batch();
+                        for (auto idx : signal_idx) {
+                            std::cout << platform_io.sample(idx) << std::endl;
+                        }
+                    }
                 }
                 catch (const geopm::Exception &ex) {
                     std::cerr << "Error: cannot read signal: " << ex.what() << std::endl;
@@ -48,7 +48,21 @@
 
 using geopm::ApplicationIO;
 using geopm::IPlatformTopo;
+using geopm::IPlatformIO;
 using testing::Return;
+using testing::SetArgReferee;
+using testing::_;
+
+MATCHER_P(RequestEq, expected, "")
+{
+    bool result = arg.size() == expected.size();
+    for (size_t idx = 0; result && idx < arg.size(); ++idx) {
+        result = arg[idx].name == expected[idx].name &&
+                 arg[idx].domain_type == expected[idx].domain_type &&
+                 arg[idx].domain_idx == expected[idx].domain_idx;
+    }
+    return result;
+}
 
 class ApplicationIOTest : public ::testing::Test
 {
@@ -83,10 +97,11 @@ void ApplicationIOTest::SetUp()
     m_num_memory_domain = 1;
     EXPECT_CALL(m_platform_topo, num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY))
         .WillOnce(Return(m_num_memory_domain));
-    EXPECT_CALL(m_platform_io, read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, m_num_package_domain - 1))
-        .WillOnce(Return(122.0));
-    EXPECT_CALL(m_platform_io, read_signal("ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, m_num_memory_domain - 1))
-        .WillOnce(Return(221.0));
+    std::vector<IPlatformIO::m_request_s> energy_request {
+        {"ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, (int)m_num_package_domain - 1},
+        {"ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, (int)m_num_memory_domain - 1}};
+    EXPECT_CALL(m_platform_io, read_signal_batch(RequestEq(energy_request), _))
+        .WillOnce(SetArgReferee<1>(std::vector<double> {122.0, 221.0}));
     std::vector<int> ranks {1, 2, 3, 4};
     EXPECT_CALL(*m_sampler, cpu_rank()).WillOnce(Return(ranks));
     m_app_io = geopm::make_unique<ApplicationIO>(m_shm_key, std::move(tmp_s), tmp_pio,
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "CpufreqIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "MockPlatformTopo.hpp"
+#include "geopm_test.hpp"
+
+using geopm::CpufreqIOGroup;
+using geopm::IPlatformTopo;
+using testing::Return;
+using testing::SetArgReferee;
+using testing::_;
+
+class CpufreqIOGroupTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        void write_file(const std::string &path, const std::string &value);
+        std::string read_file(const std::string &path);
+        std::string policy_path(int policy_idx);
+        void set_governor(const std::string &governor);
+        const std::string m_cpu_path = "CpufreqIOGroupTest-cpu";
+        std::vector<std::string> m_file;
+        std::vector<std::string> m_dir;
+        MockPlatformTopo m_topo;
+};
+
+void CpufreqIOGroupTest::SetUp()
+{
+    // Four CPUs on two cores; CPUs 0 and 2 share a cpufreq policy
+    ON_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_CPU))
+        .WillByDefault(Return(4));
+    ON_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_CORE))
+        .WillByDefault(Return(2));
+    ON_CALL(m_topo, domain_cpus(IPlatformTopo::M_DOMAIN_CORE, 0, _))
+        .WillByDefault(SetArgReferee<2>(std::set<int>{0, 2}));
+    ON_CALL(m_topo, domain_cpus(IPlatformTopo::M_DOMAIN_CORE, 1, _))
+        .WillByDefault(SetArgReferee<2>(std::set<int>{1, 3}));
+    for (int cpu_idx = 0; cpu_idx < 4; ++cpu_idx) {
+        ON_CALL(m_topo, domain_cpus(IPlatformTopo::M_DOMAIN_CPU, cpu_idx, _))
+            .WillByDefault(SetArgReferee<2>(std::set<int>{cpu_idx}));
+    }
+    EXPECT_CALL(m_topo, num_domain(_)).Times(testing::AnyNumber());
+    EXPECT_CALL(m_topo, domain_cpus(_, _, _)).Times(testing::AnyNumber());
+
+    const int cpu_policy[4] = {0, 1, 0, 3};
+    for (int policy_idx : {0, 1, 3}) {
+        std::string path = policy_path(policy_idx);
+        std::string cur_freq = std::to_string(1200000 + policy_idx * 100000);
+        write_file(path + "scaling_cur_freq", cur_freq);
+        write_file(path + "cpuinfo_cur_freq", cur_freq);
+        write_file(path + "scaling_min_freq", "1000000");
+        write_file(path + "scaling_max_freq", "2000000");
+        write_file(path + "scaling_setspeed", "<unsupported>");
+        write_file(path + "scaling_governor", "powersave");
+    }
+    for (int cpu_idx = 0; cpu_idx < 4; ++cpu_idx) {
+        std::string dir = m_cpu_path + "/cpu" + std::to_string(cpu_idx);
+        if (!mkdir(dir.c_str(), 0755)) {
+            m_dir.push_back(dir);
+        }
+        std::string link = dir + "/cpufreq";
+        if (!symlink(("../cpufreq/policy" + std::to_string(cpu_policy[cpu_idx])).c_str(), link.c_str())) {
+            m_file.push_back(link);
+        }
+    }
+}
+
+void CpufreqIOGroupTest::TearDown()
+{
+    for (const auto &path : m_file) {
+        unlink(path.c_str());
+    }
+    for (auto it = m_dir.rbegin(); it != m_dir.rend(); ++it) {
+        rmdir(it->c_str());
+    }
+}
+
+void CpufreqIOGroupTest::write_file(const std::string &path, const std::string &value)
+{
+    std::string dir;
+    size_t pos = 0;
+    while ((pos = path.find('/', pos + 1)) != std::string::npos) {
+        dir = path.substr(0, pos);
+        if (!mkdir(dir.c_str(), 0755)) {
+            m_dir.push_back(dir);
+        }
+    }
+    std::ofstream file(path);
+    file << value << "\n";
+    file.close();
+    m_file.push_back(path);
+}
+
+std::string CpufreqIOGroupTest::read_file(const std::string &path)
+{
+    std::ifstream file(path);
+    std::string result;
+    std::getline(file, result);
+    return result;
+}
+
+std::string CpufreqIOGroupTest::policy_path(int policy_idx)
+{
+    return m_cpu_path + "/cpufreq/policy" + std::to_string(policy_idx) + "/";
+}
+
+void CpufreqIOGroupTest::set_governor(const std::string &governor)
+{
+    for (int policy_idx : {0, 1, 3}) {
+        write_file(policy_path(policy_idx) + "scaling_governor", governor);
+    }
+}
+
+TEST_F(CpufreqIOGroupTest, valid_signals)
+{
+    CpufreqIOGroup group(m_topo, m_cpu_path, true);
+    std::set<std::string> expected_signal {"CPUFREQ::SCALING_CUR_FREQ",
+                                           "CPUFREQ::CPUINFO_CUR_FREQ",
+                                           "CPUFREQ::SCALING_MIN_FREQ",
+                                           "CPUFREQ::SCALING_MAX_FREQ",
+                                           "FREQUENCY"};
+    std::set<std::string> expected_control {"CPUFREQ::SCALING_MIN_FREQ",
+                                            "CPUFREQ::SCALING_MAX_FREQ",
+                                            "FREQUENCY"};
+    EXPECT_EQ(expected_signal, group.signal_names());
+    EXPECT_EQ(expected_control, group.control_names());
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_CPU, group.signal_domain_type("FREQUENCY"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_CORE, group.control_domain_type("FREQUENCY"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_INVALID, group.signal_domain_type("INVALID"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_INVALID, group.control_domain_type("CPUFREQ::SCALING_CUR_FREQ"));
+
+    // without aliases
+    CpufreqIOGroup group_no_alias(m_topo, m_cpu_path, false);
+    EXPECT_TRUE(group_no_alias.is_valid_signal("CPUFREQ::SCALING_CUR_FREQ"));
+    EXPECT_FALSE(group_no_alias.is_valid_signal("FREQUENCY"));
+    EXPECT_FALSE(group_no_alias.is_valid_control("FREQUENCY"));
+}
+
+TEST_F(CpufreqIOGroupTest, no_policy)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(CpufreqIOGroup(m_topo, "CpufreqIOGroupTest-missing", true),
+                               GEOPM_ERROR_RUNTIME, "no cpufreq policy found");
+}
+
+TEST_F(CpufreqIOGroupTest, read_signal)
+{
+    CpufreqIOGroup group(m_topo, m_cpu_path, true);
+    EXPECT_DOUBLE_EQ(1.2e9, group.read_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_CPU, 0));
+    EXPECT_DOUBLE_EQ(1.3e9, group.read_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_CPU, 1));
+    EXPECT_DOUBLE_EQ(1.2e9, group.read_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_CPU, 2));
+    EXPECT_DOUBLE_EQ(1.5e9, group.read_signal("CPUFREQ::CPUINFO_CUR_FREQ", IPlatformTopo::M_DOMAIN_CPU, 3));
+    EXPECT_DOUBLE_EQ(2.0e9, group.read_signal("CPUFREQ::SCALING_MAX_FREQ", IPlatformTopo::M_DOMAIN_CPU, 3));
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("INVALID", IPlatformTopo::M_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "not valid for CpufreqIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_CORE, 0),
+                               GEOPM_ERROR_INVALID, "domain_type must be M_DOMAIN_CPU");
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_CPU, 4),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+}
+
+TEST_F(CpufreqIOGroupTest, sample)
+{
+    CpufreqIOGroup group(m_topo, m_cpu_path, true);
+    std::vector<int> batch_idx;
+    for (int cpu_idx = 0; cpu_idx < 4; ++cpu_idx) {
+        batch_idx.push_back(group.push_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_CPU, cpu_idx));
+    }
+    // CPUs that share a policy share a batch index
+    EXPECT_EQ(batch_idx[0], batch_idx[2]);
+    EXPECT_NE(batch_idx[0], batch_idx[1]);
+    GEOPM_EXPECT_THROW_MESSAGE(group.sample(batch_idx[0]),
+                               GEOPM_ERROR_INVALID, "signal has not been read");
+    group.read_batch();
+    EXPECT_DOUBLE_EQ(1.2e9, group.sample(batch_idx[0]));
+    EXPECT_DOUBLE_EQ(1.3e9, group.sample(batch_idx[1]));
+    EXPECT_DOUBLE_EQ(1.5e9, group.sample(batch_idx[3]));
+    write_file(policy_path(1) + "scaling_cur_freq", "1800000");
+    group.read_batch();
+    EXPECT_DOUBLE_EQ(1.8e9, group.sample(batch_idx[1]));
+    GEOPM_EXPECT_THROW_MESSAGE(group.sample(3),
+                               GEOPM_ERROR_INVALID, "batch_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "cannot push signal after call to read_batch()");
+}
+
+TEST_F(CpufreqIOGroupTest, adjust)
+{
+    CpufreqIOGroup group(m_topo, m_cpu_path, true);
+    int core0_idx = group.push_control("FREQUENCY", IPlatformTopo::M_DOMAIN_CORE, 0);
+    int core1_idx = group.push_control("FREQUENCY", IPlatformTopo::M_DOMAIN_CORE, 1);
+    // CPU 2 has the same policy as core 0
+    EXPECT_EQ(core0_idx, group.push_control("CPUFREQ::SCALING_MAX_FREQ", IPlatformTopo::M_DOMAIN_CPU, 2));
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_control("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_INVALID, "domain_type must be M_DOMAIN_CORE or M_DOMAIN_CPU");
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_control("CPUFREQ::SCALING_CUR_FREQ", IPlatformTopo::M_DOMAIN_CORE, 0),
+                               GEOPM_ERROR_INVALID, "not valid for CpufreqIOGroup");
+
+    // Nothing is written before the first adjust()
+    group.write_batch();
+    EXPECT_EQ("2000000", read_file(policy_path(0) + "scaling_max_freq"));
+
+    group.adjust(core0_idx, 1.4e9);
+    group.adjust(core1_idx, 1.6e9);
+    group.write_batch();
+    EXPECT_EQ("1400000", read_file(policy_path(0) + "scaling_max_freq"));
+    EXPECT_EQ("1600000", read_file(policy_path(1) + "scaling_max_freq"));
+    EXPECT_EQ("1600000", read_file(policy_path(3) + "scaling_max_freq"));
+
+    // Unchanged values are not written again
+    write_file(policy_path(0) + "scaling_max_freq", "2000000");
+    group.adjust(core0_idx, 1.4e9);
+    group.adjust(core1_idx, 1.7e9);
+    group.write_batch();
+    EXPECT_EQ("2000000", read_file(policy_path(0) + "scaling_max_freq"));
+    EXPECT_EQ("1700000", read_file(policy_path(1) + "scaling_max_freq"));
+
+    GEOPM_EXPECT_THROW_MESSAGE(group.adjust(2, 1.0e9),
+                               GEOPM_ERROR_INVALID, "batch_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(group.write_control("FREQUENCY", IPlatformTopo::M_DOMAIN_CORE, 0, -1.0),
+                               GEOPM_ERROR_INVALID, "invalid setting");
+}
+
+TEST_F(CpufreqIOGroupTest, userspace_governor)
+{
+    set_governor("userspace");
+    CpufreqIOGroup group(m_topo, m_cpu_path, true);
+    EXPECT_TRUE(group.is_valid_control("CPUFREQ::SCALING_SETSPEED"));
+    EXPECT_FALSE(group.is_valid_signal("CPUFREQ::SCALING_SETSPEED"));
+    group.write_control("FREQUENCY", IPlatformTopo::M_DOMAIN_CORE, 1, 1.9e9);
+    EXPECT_EQ("1900000", read_file(policy_path(1) + "scaling_setspeed"));
+    EXPECT_EQ("1900000", read_file(policy_path(3) + "scaling_setspeed"));
+    EXPECT_EQ("2000000", read_file(policy_path(1) + "scaling_max_freq"));
+}
+
+TEST_F(CpufreqIOGroupTest, save_restore)
+{
+    CpufreqIOGroup group(m_topo, m_cpu_path, true);
+    group.save_control();
+    group.write_control("FREQUENCY", IPlatformTopo::M_DOMAIN_CPU, 1, 1.1e9);
+    group.write_control("CPUFREQ::SCALING_MIN_FREQ", IPlatformTopo::M_DOMAIN_CPU, 1, 1.1e9);
+    EXPECT_EQ("1100000", read_file(policy_path(1) + "scaling_max_freq"));
+    group.restore_control();
+    EXPECT_EQ("2000000", read_file(policy_path(1) + "scaling_max_freq"));
+    EXPECT_EQ("1000000", read_file(policy_path(1) + "scaling_min_freq"));
+}
+
+TEST_F(CpufreqIOGroupTest, plugin)
+{
+    EXPECT_EQ("CPUFREQ", CpufreqIOGroup::plugin_name());
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <string>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "EndpointAggregator.hpp"
+#include "SampleRing.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_test.hpp"
+#include "MockManagerIO.hpp"
+#include "MockSharedMemory.hpp"
+#include "MockSharedMemoryUser.hpp"
+
+using geopm::EndpointAggregator;
+using geopm::EndpointTableReader;
+using geopm::SampleRing;
+using geopm::SampleRingReader;
+using testing::Return;
+
+class EndpointAggregatorTest : public ::testing::Test
+{
+    protected:
+        void SetUp();
+        /// Start a stand-in job publishing into a SampleRing and
+        /// track it with the aggregator.
+        void add_job(const std::string &job_name);
+        std::unique_ptr<MockSharedMemoryUser> attach(MockSharedMemory *shmem);
+
+        std::vector<std::string> m_names = {"POWER", "RUNTIME"};
+        size_t m_max_job = 3;
+        MockSharedMemory *m_table_shmem;
+        std::unique_ptr<EndpointAggregator> m_aggregator;
+        std::map<std::string, std::unique_ptr<SampleRing> > m_job_ring;
+        std::map<std::string, MockManagerIO *> m_job_policy;
+};
+
+void EndpointAggregatorTest::SetUp()
+{
+    m_table_shmem = new MockSharedMemory(EndpointAggregator::table_size(m_names.size(), m_max_job));
+    m_aggregator = geopm::make_unique<EndpointAggregator>(std::unique_ptr<MockSharedMemory>(m_table_shmem),
+                                                          m_names, m_max_job);
+}
+
+std::unique_ptr<MockSharedMemoryUser> EndpointAggregatorTest::attach(MockSharedMemory *shmem)
+{
+    std::unique_ptr<MockSharedMemoryUser> user(new MockSharedMemoryUser(0));
+    EXPECT_CALL(*user, pointer()).WillRepeatedly(Return(shmem->pointer()));
+    EXPECT_CALL(*user, size()).WillRepeatedly(Return(shmem->size()));
+    return user;
+}
+
+void EndpointAggregatorTest::add_job(const std::string &job_name)
+{
+    // job publishes an extra field that the table does not keep
+    std::vector<std::string> job_names = {"ENERGY", "RUNTIME", "POWER"};
+    MockSharedMemory *ring_shmem = new MockSharedMemory(SampleRing::region_size(job_names.size(), 4));
+    m_job_ring[job_name] = geopm::make_unique<SampleRing>(std::unique_ptr<MockSharedMemory>(ring_shmem),
+                                                          job_names, 4);
+    m_job_policy[job_name] = new MockManagerIO();
+    m_aggregator->add_job(job_name, std::unique_ptr<MockManagerIO>(m_job_policy[job_name]),
+                          geopm::make_unique<SampleRingReader>(attach(ring_shmem), m_names));
+}
+
+TEST_F(EndpointAggregatorTest, aggregate)
+{
+    add_job("job-a");
+    add_job("job-b");
+    EndpointTableReader reader(attach(m_table_shmem));
+    EXPECT_EQ(m_names, reader.field_names());
+
+    std::vector<std::string> job_name;
+    std::vector<double> timestamp;
+    std::vector<std::vector<double> > sample;
+    ASSERT_TRUE(reader.read(job_name, timestamp, sample));
+    EXPECT_EQ(std::vector<std::string>({"job-a", "job-b"}), job_name);
+    EXPECT_EQ(std::vector<double>({0.0, 0.0}), timestamp);
+    ASSERT_EQ(2u, sample.size());
+    EXPECT_TRUE(std::isnan(sample[0][0]));
+
+    m_job_ring["job-a"]->adjust({1.0, 2.0, 3.0});
+    m_job_ring["job-a"]->write_batch();
+    m_job_ring["job-a"]->adjust({4.0, 5.0, 6.0});
+    m_job_ring["job-a"]->write_batch();
+    m_job_ring["job-b"]->adjust({7.0, 8.0, 9.0});
+    m_job_ring["job-b"]->write_batch();
+    m_aggregator->update();
+
+    ASSERT_TRUE(reader.read(job_name, timestamp, sample));
+    std::vector<std::vector<double> > expected = {{6.0, 5.0}, {9.0, 8.0}};
+    EXPECT_EQ(expected, sample);
+    EXPECT_LT(0.0, timestamp[0]);
+    EXPECT_LE(timestamp[0], timestamp[1]);
+
+    // rows are compacted when a job is removed
+    m_aggregator->remove_job("job-a");
+    add_job("job-c");
+    ASSERT_TRUE(reader.read(job_name, timestamp, sample));
+    EXPECT_EQ(std::vector<std::string>({"job-b", "job-c"}), job_name);
+    EXPECT_EQ(std::vector<double>({9.0, 8.0}), sample[0]);
+}
+
+TEST_F(EndpointAggregatorTest, policy_batch)
+{
+    add_job("job-a");
+    add_job("job-b");
+    add_job("job-c");
+    EXPECT_EQ(std::vector<std::string>({"job-a", "job-b", "job-c"}), m_aggregator->job_names());
+    EXPECT_EQ(0, m_aggregator->write_batch());
+
+    std::vector<double> policy_a = {100.0};
+    std::vector<double> policy_c = {200.0};
+    m_aggregator->adjust("job-a", {50.0});
+    m_aggregator->adjust("job-a", policy_a);
+    m_aggregator->adjust("job-c", policy_c);
+    EXPECT_CALL(*m_job_policy["job-a"], adjust(policy_a));
+    EXPECT_CALL(*m_job_policy["job-a"], write_batch());
+    EXPECT_CALL(*m_job_policy["job-b"], write_batch()).Times(0);
+    EXPECT_CALL(*m_job_policy["job-c"], adjust(policy_c));
+    EXPECT_CALL(*m_job_policy["job-c"], write_batch());
+    EXPECT_EQ(2, m_aggregator->write_batch());
+    EXPECT_EQ(0, m_aggregator->write_batch());
+}
+
+TEST_F(EndpointAggregatorTest, negative)
+{
+    add_job("job-a");
+    GEOPM_EXPECT_THROW_MESSAGE(add_job("job-a"), GEOPM_ERROR_INVALID, "already tracked");
+    GEOPM_EXPECT_THROW_MESSAGE(m_aggregator->adjust("job-x", {1.0}), GEOPM_ERROR_INVALID, "not tracked");
+    GEOPM_EXPECT_THROW_MESSAGE(m_aggregator->remove_job("job-x"), GEOPM_ERROR_INVALID, "not tracked");
+    add_job("job-b");
+    add_job("job-c");
+    GEOPM_EXPECT_THROW_MESSAGE(add_job("job-d"), GEOPM_ERROR_INVALID, "table is full");
+
+    MockSharedMemory *ring_shmem = new MockSharedMemory(SampleRing::region_size(1, 1));
+    SampleRing ring(std::unique_ptr<MockSharedMemory>(ring_shmem), {"POWER"}, 1);
+    m_aggregator->remove_job("job-c");
+    GEOPM_EXPECT_THROW_MESSAGE(m_aggregator->add_job("job-e", nullptr,
+                                   geopm::make_unique<SampleRingReader>(attach(ring_shmem),
+                                                                        std::vector<std::string>{})),
+                               GEOPM_ERROR_INVALID, "does not provide the fields");
+
+    std::unique_ptr<MockSharedMemoryUser> user(new MockSharedMemoryUser(EndpointAggregator::table_size(1, 1)));
+    GEOPM_EXPECT_THROW_MESSAGE(EndpointTableReader(std::move(user)),
+                               GEOPM_ERROR_INVALID, "not an endpoint table");
+}
@@ -35,6 +35,9 @@
 #include <fstream>
 #include <map>
 #include <memory>
+#include <sstream>
+#include <iomanip>
+#include <list>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -47,6 +50,7 @@
 #include "Helper.hpp"
 #include "MockPlatformIO.hpp"
 #include "MockPlatformTopo.hpp"
+#include "MockRegionFreqCache.hpp"
 #include "PlatformTopo.hpp"
 #include "geopm.h"
 
@@ -55,6 +59,7 @@ using ::testing::Invoke;
 using ::testing::Sequence;
 using ::testing::Return;
 using ::testing::AtLeast;
+using ::testing::AnyNumber;
 using geopm::EnergyEfficientAgent;
 using geopm::PlatformTopo;
 using geopm::IPlatformIO;
@@ -165,6 +170,9 @@ void EnergyEfficientAgentTest::TearDown()
     unsetenv("GEOPM_EFFICIENT_FREQ_RID_MAP");
     unsetenv("GEOPM_EFFICIENT_FREQ_MIN");
     unsetenv("GEOPM_EFFICIENT_FREQ_MAX");
+    unsetenv("GEOPM_EFFICIENT_FREQ_ONLINE");
+    unsetenv("GEOPM_EFFICIENT_FREQ_PER_CORE");
+    unsetenv("GEOPM_EFFICIENT_FREQ_PREDICT");
 }
 
 TEST_F(EnergyEfficientAgentTest, map)
@@ -272,3 +280,114 @@ TEST_F(EnergyEfficientAgentTest, online_mode)
 
     unsetenv("GEOPM_EFFICIENT_FREQ_RID_MAP");
 }
+
+TEST_F(EnergyEfficientAgentTest, per_core)
+{
+    setenv("GEOPM_EFFICIENT_FREQ_PER_CORE", "yes", 1);
+    const int cpu_region_id_idx = ENERGY_DRAM_IDX + 1;
+    EXPECT_CALL(*m_platform_io, push_control("FREQUENCY", _, _)).Times(M_NUM_CPU);
+    EXPECT_CALL(*m_platform_io, push_signal("REGION_ID#", PlatformTopo::M_DOMAIN_BOARD, 0))
+        .WillOnce(Return(REGION_ID_IDX));
+    for (int cpu_idx = 0; cpu_idx < M_NUM_CPU; ++cpu_idx) {
+        EXPECT_CALL(*m_platform_io, push_signal("REGION_ID#", PlatformTopo::M_DOMAIN_CPU, cpu_idx))
+            .WillOnce(Return(cpu_region_id_idx + cpu_idx));
+    }
+    m_agent = geopm::make_unique<EnergyEfficientAgent>(*m_platform_io, *m_platform_topo);
+
+    std::vector<uint64_t> cpu_region = {m_region_hash[0], m_region_hash[1],
+                                        geopm_region_id_set_hint(GEOPM_REGION_HINT_COMPUTE, 0x1234),
+                                        m_region_hash[4]};
+    EXPECT_CALL(*m_platform_io, sample(ENERGY_PKG_IDX)).WillRepeatedly(Return(8888));
+    EXPECT_CALL(*m_platform_io, sample(ENERGY_DRAM_IDX)).WillRepeatedly(Return(10000));
+    EXPECT_CALL(*m_platform_io, sample(REGION_ID_IDX))
+        .WillRepeatedly(Return(geopm_field_to_signal(m_region_hash[0])));
+    for (int cpu_idx = 0; cpu_idx < M_NUM_CPU; ++cpu_idx) {
+        EXPECT_CALL(*m_platform_io, sample(cpu_region_id_idx + cpu_idx))
+            .WillRepeatedly(Return(geopm_field_to_signal(cpu_region[cpu_idx])));
+    }
+    // Each core is set from the region running on it
+    EXPECT_CALL(*m_platform_io, adjust(FREQ_IDX, m_freq_max)).Times(2);
+    EXPECT_CALL(*m_platform_io, adjust(FREQ_IDX, m_mapped_freqs[1])).Times(1);
+    EXPECT_CALL(*m_platform_io, adjust(FREQ_IDX, m_freq_min)).Times(1);
+    m_agent->sample_platform(m_sample);
+    EXPECT_TRUE(m_agent->adjust_platform(m_default_policy));
+
+    // No writes when no core changes region
+    m_agent->sample_platform(m_sample);
+    EXPECT_FALSE(m_agent->adjust_platform(m_default_policy));
+
+    // Only the core that changed region is adjusted
+    EXPECT_CALL(*m_platform_io, sample(cpu_region_id_idx + 1))
+        .WillRepeatedly(Return(geopm_field_to_signal(m_region_hash[2])));
+    EXPECT_CALL(*m_platform_io, adjust(FREQ_IDX, m_mapped_freqs[2])).Times(1);
+    m_agent->sample_platform(m_sample);
+    EXPECT_TRUE(m_agent->adjust_platform(m_default_policy));
+}
+
+TEST_F(EnergyEfficientAgentTest, online_warm_start)
+{
+    unsetenv("GEOPM_EFFICIENT_FREQ_RID_MAP");
+    setenv("GEOPM_EFFICIENT_FREQ_ONLINE", "yes", 1);
+    EXPECT_CALL(*m_platform_io, push_control("FREQUENCY", _, _)).Times(M_NUM_CPU);
+    auto cache = geopm::make_unique<MockRegionFreqCache>();
+    MockRegionFreqCache *cache_ptr = cache.get();
+    m_agent = geopm::make_unique<EnergyEfficientAgent>(*m_platform_io, *m_platform_topo,
+                                                       std::move(cache));
+
+    EXPECT_CALL(*m_platform_io, sample(_)).WillRepeatedly(Return(1.0));
+    EXPECT_CALL(*m_platform_io, adjust(FREQ_IDX, _)).Times(AnyNumber());
+    EXPECT_CALL(*cache_ptr, freq(m_region_hash[0])).WillOnce(Return(1.9e9));
+    EXPECT_CALL(*cache_ptr, freq(m_region_hash[1])).WillOnce(Return(NAN));
+    // Each region is stored once: the cached frequency after it is
+    // validated, and the other once its search converges
+    EXPECT_CALL(*cache_ptr, update(m_region_hash[0], 1.9e9)).Times(1);
+    EXPECT_CALL(*cache_ptr, update(m_region_hash[1], m_freq_min)).Times(1);
+
+    // Warm started region runs at the cached frequency right away
+    EXPECT_CALL(*m_platform_io, sample(REGION_ID_IDX))
+        .WillRepeatedly(Return(geopm_field_to_signal(m_region_hash[0])));
+    m_agent->sample_platform(m_sample);
+    EXPECT_CALL(*m_platform_io, adjust(FREQ_IDX, 1.9e9)).Times(M_NUM_CPU);
+    m_agent->adjust_platform(m_default_policy);
+
+    // Alternate between the regions until the second one converges
+    for (int step = 0; step < 32; ++step) {
+        EXPECT_CALL(*m_platform_io, sample(REGION_ID_IDX))
+            .WillRepeatedly(Return(geopm_field_to_signal(m_region_hash[(step + 1) % 2])));
+        m_agent->sample_platform(m_sample);
+    }
+}
+
+TEST_F(EnergyEfficientAgentTest, predict)
+{
+    setenv("GEOPM_EFFICIENT_FREQ_PREDICT", "yes", 1);
+    EXPECT_CALL(*m_platform_io, push_control("FREQUENCY", _, _)).Times(M_NUM_CPU);
+    m_agent = geopm::make_unique<EnergyEfficientAgent>(*m_platform_io, *m_platform_topo);
+
+    // Region 0 runs briefly and is always followed by region 1
+    std::list<geopm_region_info_s> region_info;
+    for (int cycle = 0; cycle < 4; ++cycle) {
+        region_info.push_back({m_region_hash[0], 0.0, 0.0});
+        region_info.push_back({m_region_hash[0], 1.0, 1e-4});
+        region_info.push_back({m_region_hash[1], 0.0, 0.0});
+        region_info.push_back({m_region_hash[1], 1.0, 1.0});
+    }
+    m_agent->update_region_info(region_info);
+
+    EXPECT_CALL(*m_platform_io, sample(_)).WillRepeatedly(Return(1.0));
+    EXPECT_CALL(*m_platform_io, sample(REGION_ID_IDX))
+        .WillRepeatedly(Return(geopm_field_to_signal(m_region_hash[0])));
+    m_agent->sample_platform(m_sample);
+    // Region 1 frequency is applied while region 0 is still running
+    EXPECT_CALL(*m_platform_io, adjust(FREQ_IDX, m_mapped_freqs[1])).Times(M_NUM_CPU);
+    m_agent->adjust_platform(m_default_policy);
+
+    auto report = m_agent->report_region();
+    ASSERT_EQ(1u, report.count(m_region_hash[0]));
+    std::map<std::string, std::string> region_report(report[m_region_hash[0]].begin(),
+                                                     report[m_region_hash[0]].end());
+    std::ostringstream next_region;
+    next_region << "0x" << std::hex << std::setfill('0') << std::setw(16) << m_region_hash[1];
+    EXPECT_EQ(next_region.str(), region_report["NEXT_REGION"]);
+    EXPECT_EQ(std::to_string(1.0), region_report["NEXT_REGION_PROBABILITY"]);
+}
@@ -102,6 +102,7 @@ class EnergyEfficientRegionTest : public ::testing::Test
         EnergyEfficientRegion m_freq_region;
 
         void sample_to_set_baseline();
+        void run_region();
 };
 
 EnergyEfficientRegionTest::EnergyEfficientRegionTest()
@@ -135,6 +136,13 @@ void EnergyEfficientRegionTest::sample_to_set_baseline()
     }
 }
 
+void EnergyEfficientRegionTest::run_region()
+{
+    m_freq_region.update_entry();
+    m_platform_io.run_region();
+    m_freq_region.update_exit();
+}
+
 TEST_F(EnergyEfficientRegionTest, freq_starts_at_maximum)
 {
     ASSERT_EQ(m_freq_max, m_freq_region.freq());
@@ -162,39 +170,45 @@ TEST_F(EnergyEfficientRegionTest, only_changes_freq_after_enough_samples)
 {
     m_platform_io.set_runtime(2);
     sample_to_set_baseline();
+    EXPECT_TRUE(m_freq_region.is_learning());
+
+    // first probe after the baseline bisects the range
+    run_region();
+    EXPECT_LT(m_freq_region.freq(), m_freq_max);
+    EXPECT_GT(m_freq_region.freq(), m_freq_min);
 
     // freq decreases as runtime continues to hit target
+    double last_freq = m_freq_region.freq();
     for (int i = 1; i <= 3; ++i) {
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
-        EXPECT_EQ(m_freq_region.freq(), m_freq_max - (i * m_freq_step));
+        run_region();
+        EXPECT_LT(m_freq_region.freq(), last_freq);
+        last_freq = m_freq_region.freq();
     }
-
-    double end = m_freq_region.freq();
-    ASSERT_EQ(end, m_freq_max - (3 * m_freq_step));
 }
 
-
 TEST_F(EnergyEfficientRegionTest, freq_does_not_go_below_min)
 {
-    // run more times than the number of frequencies
-    size_t num_steps = 5 + (size_t)(ceil((m_freq_max - m_freq_min) / m_freq_step));
-
     m_platform_io.set_runtime(2); // not senstive to freq
 
     sample_to_set_baseline();
 
+    // bisection converges in log2 of the number of frequencies
+    size_t num_freq = 1 + (size_t)(ceil((m_freq_max - m_freq_min) / m_freq_step));
+    size_t max_probe = 1 + (size_t)ceil(log2(num_freq));
+    size_t num_probe = 0;
     double start = m_freq_region.freq();
-    for (size_t i = 1; i <= num_steps; ++i) {
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
+    while (m_freq_region.is_learning() && num_probe <= max_probe) {
+        run_region();
         EXPECT_LT(m_freq_region.freq(), start);
+        ++num_probe;
     }
-
+    EXPECT_FALSE(m_freq_region.is_learning());
+    EXPECT_LE(num_probe, max_probe);
     ASSERT_EQ(m_freq_min, m_freq_region.freq());
 
+    run_region();
+    EXPECT_EQ(m_freq_min, m_freq_region.freq());
+
     double updated_min = m_freq_min + m_freq_step;
     m_freq_region.update_freq_range(updated_min, m_freq_max, m_freq_step);
     ASSERT_EQ(updated_min, m_freq_region.freq());
@@ -202,111 +216,187 @@ TEST_F(EnergyEfficientRegionTest, freq_does_not_go_below_min)
 
 TEST_F(EnergyEfficientRegionTest, freq_does_not_go_above_max)
 {
-    // 90% target will be 3.3
     m_platform_io.set_runtime(3);
 
     sample_to_set_baseline();
-
-    std::vector<time_t> samples {3, 3, 5};
-    double updated_max = m_freq_max - m_freq_step * 2;
-    std::vector<double> expected {m_freq_max - m_freq_step,
-                                  m_freq_max - m_freq_step * 2,
-                                  updated_max};
-    for (size_t i = 0; i < samples.size(); ++i) {
-        if (i == 2) {
-            m_freq_region.update_freq_range(m_freq_min, updated_max, m_freq_step);
-        }
-        m_platform_io.set_runtime(samples[i]);
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
-        EXPECT_EQ(expected[i], m_freq_region.freq());
+    run_region();
+
+    double updated_max = m_freq_min + m_freq_step * 2;
+    m_freq_region.update_freq_range(m_freq_min, updated_max, m_freq_step);
+    EXPECT_LE(m_freq_region.freq(), updated_max);
+    for (int i = 0; i < 4; ++i) {
+        run_region();
+        EXPECT_LE(m_freq_region.freq(), updated_max);
+        EXPECT_GE(m_freq_region.freq(), m_freq_min);
     }
+    EXPECT_FALSE(m_freq_region.is_learning());
+    EXPECT_EQ(m_freq_min, m_freq_region.freq());
 }
 
 TEST_F(EnergyEfficientRegionTest, performance_decreases_freq_steps_back_up)
 {
-    // 90% target will be 3.3
+    // 90% target will be 3.3; below 2 GHz the region slows to 5
+    double freq_knee = 2.0e9;
     m_platform_io.set_runtime(3);
 
     sample_to_set_baseline();
 
-    std::vector<time_t> samples {3, 3, 5};
-    std::vector<double> expected {m_freq_max - m_freq_step,
-                                  m_freq_max - m_freq_step * 2,
-                                  m_freq_max - m_freq_step};
-    for (size_t i = 0; i < samples.size(); ++i) {
-        m_platform_io.set_runtime(samples[i]);
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
-        EXPECT_EQ(expected[i], m_freq_region.freq());
+    int num_step_up = 0;
+    for (int i = 0; i < 20 && m_freq_region.is_learning(); ++i) {
+        double probe = m_freq_region.freq();
+        m_platform_io.set_runtime(probe >= freq_knee ? 3 : 5);
+        run_region();
+        if (m_freq_region.freq() > probe) {
+            ++num_step_up;
+        }
     }
+    EXPECT_FALSE(m_freq_region.is_learning());
+    EXPECT_LT(0, num_step_up);
+    EXPECT_EQ(freq_knee, m_freq_region.freq());
 }
 
 TEST_F(EnergyEfficientRegionTest, energy_increases_freq_steps_back_up)
 {
+    // below 2.1 GHz the region uses five times the energy
+    double freq_knee = 2.1e9;
     m_platform_io.set_runtime(3);
     m_platform_io.set_energy(1);
 
     sample_to_set_baseline();
 
-    std::vector<time_t> samples {1, 1, 5};
-    std::vector<double> expected {m_freq_max - m_freq_step,
-                                  m_freq_max - m_freq_step * 2,
-                                  m_freq_max - m_freq_step};
-    for (size_t i = 0; i < samples.size(); ++i) {
-        m_platform_io.set_energy(samples[i]);
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
-        EXPECT_EQ(expected[i], m_freq_region.freq());
+    int num_step_up = 0;
+    for (int i = 0; i < 20 && m_freq_region.is_learning(); ++i) {
+        double probe = m_freq_region.freq();
+        m_platform_io.set_energy(probe >= freq_knee ? 1 : 5);
+        run_region();
+        if (m_freq_region.freq() > probe) {
+            ++num_step_up;
+        }
     }
+    EXPECT_FALSE(m_freq_region.is_learning());
+    EXPECT_LT(0, num_step_up);
+    EXPECT_EQ(freq_knee, m_freq_region.freq());
 }
 
 TEST_F(EnergyEfficientRegionTest, after_too_many_increase_freq_stays_at_higher)
 {
-    m_platform_io.set_runtime(3); // 90% target should be 2.7
+    double freq_knee = 2.0e9;
+    m_platform_io.set_runtime(3);
 
     sample_to_set_baseline();
 
-    size_t max_increase = 4;
-    double higher_freq = m_freq_max - m_freq_step;
-    double lower_freq = m_freq_max - m_freq_step * 2;
-    // run once to step down from max
-    m_freq_region.update_entry();
-    m_platform_io.run_region();
-    m_freq_region.update_exit();
-    EXPECT_EQ(higher_freq, m_freq_region.freq());
-
-    // raise and lower bandwidth and alternate freq
-    for (size_t i = 0; i < max_increase; ++i) {
-        // lower freq
-        m_platform_io.set_runtime(3);
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
-        EXPECT_EQ(lower_freq, m_freq_region.freq());
-        // raise freq
-        m_platform_io.set_runtime(5);
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
-        EXPECT_EQ(higher_freq, m_freq_region.freq());
+    for (int i = 0; i < 20 && m_freq_region.is_learning(); ++i) {
+        m_platform_io.set_runtime(m_freq_region.freq() >= freq_knee ? 3 : 5);
+        run_region();
     }
+    ASSERT_FALSE(m_freq_region.is_learning());
 
-    // freq should stay at higher
+    // once converged freq should stay put
     for (size_t i = 0; i < 3; ++i) {
         m_platform_io.set_runtime(3);
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
-        EXPECT_EQ(higher_freq, m_freq_region.freq());
+        run_region();
+        EXPECT_EQ(freq_knee, m_freq_region.freq());
 
         m_platform_io.set_runtime(5);
-        m_freq_region.update_entry();
-        m_platform_io.run_region();
-        m_freq_region.update_exit();
-        EXPECT_EQ(higher_freq, m_freq_region.freq());
+        run_region();
+        EXPECT_EQ(freq_knee, m_freq_region.freq());
+    }
+}
+
+TEST_F(EnergyEfficientRegionTest, freq_range_change_during_search)
+{
+    m_platform_io.set_runtime(3);
+    m_platform_io.set_energy(1);
+
+    sample_to_set_baseline();
+    // First probe
+    run_region();
+    ASSERT_TRUE(m_freq_region.is_learning());
+
+    // The new maximum has not been measured; the search compares the
+    // probes against the baseline energy instead
+    double updated_max = m_freq_max - m_freq_step;
+    m_freq_region.update_freq_range(m_freq_min, updated_max, m_freq_step);
+    for (int i = 0; i < 20 && m_freq_region.is_learning(); ++i) {
+        run_region();
+        EXPECT_LE(m_freq_region.freq(), updated_max);
+    }
+    EXPECT_FALSE(m_freq_region.is_learning());
+    EXPECT_EQ(m_freq_min, m_freq_region.freq());
+}
+
+TEST_F(EnergyEfficientRegionTest, freq_range_change_before_baseline)
+{
+    m_platform_io.set_runtime(3);
+    run_region();
+    double updated_max = m_freq_max - m_freq_step;
+    m_freq_region.update_freq_range(m_freq_min, updated_max, m_freq_step);
+    EXPECT_EQ(updated_max, m_freq_region.freq());
+    m_freq_region.update_freq_range(m_freq_min, m_freq_max, m_freq_step);
+    // The baseline is measured at the maximum, including the sample
+    // taken before the range changed
+    EXPECT_EQ(m_freq_max, m_freq_region.freq());
+    for (int i = 0; i < m_base_samples; ++i) {
+        run_region();
+    }
+    EXPECT_LT(m_freq_region.freq(), m_freq_max);
+}
+
+TEST_F(EnergyEfficientRegionTest, warm_start)
+{
+    m_freq_region.warm_start(NAN);
+    EXPECT_TRUE(m_freq_region.is_learning());
+    EXPECT_EQ(m_freq_max, m_freq_region.freq());
+
+    // rounds up to an allowed frequency
+    double expected = m_freq_min + 101 * m_freq_step;
+    m_freq_region.warm_start(m_freq_min + 100.5 * m_freq_step);
+    EXPECT_EQ(expected, m_freq_region.freq());
+
+    // Runs at the cached frequency, then measures the baseline
+    m_platform_io.set_runtime(3);
+    m_platform_io.set_energy(1);
+    for (int i = 0; i < m_base_samples + 1; ++i) {
+        EXPECT_EQ(expected, m_freq_region.freq());
+        EXPECT_TRUE(m_freq_region.is_learning());
+        run_region();
+    }
+    sample_to_set_baseline();
+    // The cached frequency is validated without further probes
+    run_region();
+    EXPECT_FALSE(m_freq_region.is_learning());
+    EXPECT_EQ(expected, m_freq_region.freq());
+    for (int i = 0; i < 8; ++i) {
+        run_region();
+        EXPECT_EQ(expected, m_freq_region.freq());
+    }
+
+    m_freq_region.warm_start(2 * m_freq_max);
+    EXPECT_EQ(m_freq_max, m_freq_region.freq());
+}
+
+TEST_F(EnergyEfficientRegionTest, warm_start_stale)
+{
+    // The region became frequency sensitive since the frequency was
+    // cached: below 2 GHz it slows from 3 to 5
+    double freq_knee = 2.0e9;
+    double cached = 1.9e9;
+    m_freq_region.warm_start(cached);
+    m_platform_io.set_energy(1);
+    m_platform_io.set_runtime(5);
+    for (int i = 0; i < m_base_samples + 1; ++i) {
+        EXPECT_EQ(cached, m_freq_region.freq());
+        run_region();
+    }
+    m_platform_io.set_runtime(3);
+    sample_to_set_baseline();
+    // The search continues above the cached frequency
+    for (int i = 0; i < 20 && m_freq_region.is_learning(); ++i) {
+        double probe = m_freq_region.freq();
+        EXPECT_GT(probe, cached);
+        m_platform_io.set_runtime(probe >= freq_knee ? 3 : 5);
+        run_region();
     }
+    EXPECT_FALSE(m_freq_region.is_learning());
+    EXPECT_EQ(freq_knee, m_freq_region.freq());
 }
@@ -100,6 +100,15 @@ void EnvironmentTest::SetUp()
     unsetenv("GEOPM_COMM");
     unsetenv("GEOPM_AGENT");
     unsetenv("GEOPM_TRACE_SIGNALS");
+    unsetenv("GEOPM_TRACE_ADAPTIVE");
+    unsetenv("GEOPM_TRACE_ADAPTIVE_BURST");
+    unsetenv("GEOPM_TRACE_CODEC");
+    unsetenv("GEOPM_SAMPLE_RING");
+    unsetenv("GEOPM_TOPO_CACHE");
+    unsetenv("GEOPM_AGENT_THREADS");
+    unsetenv("GEOPM_RECORD");
+    unsetenv("GEOPM_SIM");
+    unsetenv("GEOPM_PERF_EVENT_PID");
 }
 
 void EnvironmentTest::TearDown()
@@ -119,6 +128,15 @@ void EnvironmentTest::TearDown()
     unsetenv("GEOPM_COMM");
     unsetenv("GEOPM_AGENT");
     unsetenv("GEOPM_TRACE_SIGNALS");
+    unsetenv("GEOPM_TRACE_ADAPTIVE");
+    unsetenv("GEOPM_TRACE_ADAPTIVE_BURST");
+    unsetenv("GEOPM_TRACE_CODEC");
+    unsetenv("GEOPM_SAMPLE_RING");
+    unsetenv("GEOPM_TOPO_CACHE");
+    unsetenv("GEOPM_AGENT_THREADS");
+    unsetenv("GEOPM_RECORD");
+    unsetenv("GEOPM_SIM");
+    unsetenv("GEOPM_PERF_EVENT_PID");
 }
 
 TEST_F(EnvironmentTest, construction0)
@@ -136,6 +154,15 @@ TEST_F(EnvironmentTest, construction0)
     setenv("GEOPM_PMPI_CTL", m_pmpi_ctl_str.c_str(), 1);
     setenv("GEOPM_DEBUG_ATTACH", std::to_string(m_debug_attach).c_str(), 1);
     setenv("GEOPM_PROFILE", m_profile.c_str(), 1);
+    setenv("GEOPM_TRACE_ADAPTIVE", "0.05", 1);
+    setenv("GEOPM_TRACE_ADAPTIVE_BURST", "4", 1);
+    setenv("GEOPM_TRACE_CODEC", "lz4", 1);
+    setenv("GEOPM_SAMPLE_RING", "geopm-sample-test", 1);
+    setenv("GEOPM_TOPO_CACHE", "/tmp/geopm-topo-test", 1);
+    setenv("GEOPM_AGENT_THREADS", "4", 1);
+    setenv("GEOPM_RECORD", "/tmp/geopm-record-test", 1);
+    setenv("GEOPM_SIM", "/tmp/geopm-sim-test.json", 1);
+    setenv("GEOPM_PERF_EVENT_PID", "1234,5678", 1);
 
     geopm_env_load();
 
@@ -152,6 +179,16 @@ TEST_F(EnvironmentTest, construction0)
     EXPECT_EQ(1, geopm_env_do_profile());
     EXPECT_EQ(m_profile_timeout, geopm_env_profile_timeout());
     EXPECT_EQ(m_debug_attach, geopm_env_debug_attach());
+    EXPECT_EQ(1, geopm_env_do_trace_adaptive());
+    EXPECT_EQ(0.05, geopm_env_trace_adaptive());
+    EXPECT_EQ(4, geopm_env_trace_adaptive_burst());
+    EXPECT_EQ("lz4", std::string(geopm_env_trace_codec()));
+    EXPECT_EQ("/geopm-sample-test", std::string(geopm_env_sample_ring()));
+    EXPECT_EQ("/tmp/geopm-topo-test", std::string(geopm_env_topo_cache()));
+    EXPECT_EQ(4, geopm_env_agent_threads());
+    EXPECT_EQ("/tmp/geopm-record-test", std::string(geopm_env_record()));
+    EXPECT_EQ("/tmp/geopm-sim-test.json", std::string(geopm_env_sim()));
+    EXPECT_EQ("1234,5678", std::string(geopm_env_perf_event_pid()));
 }
 
 TEST_F(EnvironmentTest, construction1)
@@ -192,4 +229,10 @@ TEST_F(EnvironmentTest, construction1)
     EXPECT_STREQ("test1", geopm_env_trace_signal(0));
     EXPECT_STREQ("test2", geopm_env_trace_signal(1));
     EXPECT_STREQ("test3", geopm_env_trace_signal(2));
+    EXPECT_STREQ("", geopm_env_sample_ring());
+    EXPECT_STREQ("", geopm_env_topo_cache());
+    EXPECT_EQ(1, geopm_env_agent_threads());
+    EXPECT_STREQ("", geopm_env_record());
+    EXPECT_STREQ("", geopm_env_sim());
+    EXPECT_STREQ("", geopm_env_perf_event_pid());
 }
@@ -44,6 +44,7 @@ using geopm::EpochRuntimeRegulator;
 using geopm::IPlatformTopo;
 using testing::Return;
 using testing::_;
+using testing::SizeIs;
 
 class EpochRuntimeRegulatorTest : public ::testing::Test
 {
@@ -153,10 +154,8 @@ TEST_F(EpochRuntimeRegulatorTest, epoch_runtime)
         .WillRepeatedly(Return(num_package));
     EXPECT_CALL(m_platform_topo, num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY)).Times(6)
         .WillRepeatedly(Return(num_memory));
-    EXPECT_CALL(m_platform_io, read_signal("ENERGY_PACKAGE", _, _))
-        .Times(num_package * 6);
-    EXPECT_CALL(m_platform_io, read_signal("ENERGY_DRAM", _, _))
-        .Times(num_memory * 6);
+    EXPECT_CALL(m_platform_io, read_signal_batch(SizeIs(num_package + num_memory), _))
+        .Times(6);
 
     uint64_t region_id = 0x98765432;
     m_regulator.record_entry(region_id, 0, {{1, 0}});
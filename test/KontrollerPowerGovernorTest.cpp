@@ -50,6 +50,7 @@
 #include "MockTreeComm.hpp"
 #include "MockReporter.hpp"
 #include "MockTracer.hpp"
+#include "MockTraceRollup.hpp"
 #include "Helper.hpp"
 
 using geopm::Kontroller;
@@ -172,6 +173,7 @@ class KontrollerPowerGovernorTest : public ::testing::Test
         MockTreeComm *m_tree_comm;
         MockReporter *m_reporter;
         MockTracer *m_tracer;
+        MockTraceRollup *m_trace_rollup;
         std::vector<PowerGovernorAgent*> m_level_agent;
         std::vector<std::unique_ptr<Agent> > m_agents;
         MockManagerIOSampler *m_manager_io;
@@ -210,6 +212,7 @@ void KontrollerPowerGovernorTest::SetUp()
     m_manager_io = new NiceMock<MockManagerIOSampler>();
     m_reporter = new NiceMock<MockReporter>();
     m_tracer = new NiceMock<MockTracer>();
+    m_trace_rollup = new NiceMock<MockTraceRollup>();
 
     ON_CALL(*m_application_io, region_info()).WillByDefault(Return(m_region_info));
     std::vector<double> manager_sample = {m_power_budget};
@@ -254,8 +257,10 @@ TEST_F(KontrollerPowerGovernorTest, single_node)
                           m_application_io,
                           std::unique_ptr<MockReporter>(m_reporter),
                           std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockTraceRollup>(m_trace_rollup),
                           std::move(m_agents),
-                          std::unique_ptr<MockManagerIOSampler>(m_manager_io));
+                          std::unique_ptr<MockManagerIOSampler>(m_manager_io),
+                          nullptr);
     kontroller.setup_trace();
 
     for (int step = 0; step < m_num_step; ++step) {
@@ -307,8 +312,10 @@ TEST_F(KontrollerPowerGovernorTest, two_level_controller_1)
                           m_application_io,
                           std::unique_ptr<MockReporter>(m_reporter),
                           std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockTraceRollup>(m_trace_rollup),
                           std::move(m_agents),
-                          std::unique_ptr<MockManagerIOSampler>(m_manager_io));
+                          std::unique_ptr<MockManagerIOSampler>(m_manager_io),
+                          nullptr);
     kontroller.setup_trace();
 
     // mock parent sending to this child
@@ -384,8 +391,10 @@ TEST_F(KontrollerPowerGovernorTest, two_level_controller_2)
                           m_application_io,
                           std::unique_ptr<MockReporter>(m_reporter),
                           std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockTraceRollup>(m_trace_rollup),
                           std::move(m_agents),
-                          std::unique_ptr<MockManagerIOSampler>(m_manager_io));
+                          std::unique_ptr<MockManagerIOSampler>(m_manager_io),
+                          nullptr);
     kontroller.setup_trace();
 
     // mock parent sending to this child
@@ -456,8 +465,10 @@ TEST_F(KontrollerPowerGovernorTest, two_level_controller_0)
                           m_application_io,
                           std::unique_ptr<MockReporter>(m_reporter),
                           std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockTraceRollup>(m_trace_rollup),
                           std::move(m_agents),
-                          std::unique_ptr<MockManagerIOSampler>(m_manager_io));
+                          std::unique_ptr<MockManagerIOSampler>(m_manager_io),
+                          nullptr);
     kontroller.setup_trace();
 
     for (int step = 0; step < m_num_step; ++step) {
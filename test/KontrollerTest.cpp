@@ -39,16 +39,19 @@
 #include "gmock/gmock.h"
 
 #include "Kontroller.hpp"
+#include "IOGroup.hpp"
 
 #include "MockPlatformTopo.hpp"
 #include "MockPlatformIO.hpp"
 #include "MockComm.hpp"
 #include "MockApplicationIO.hpp"
+#include "MockManagerIO.hpp"
 #include "MockManagerIOSampler.hpp"
 #include "MockAgent.hpp"
 #include "MockTreeComm.hpp"
 #include "MockReporter.hpp"
 #include "MockTracer.hpp"
+#include "MockTraceRollup.hpp"
 #include "Helper.hpp"
 
 using geopm::Kontroller;
@@ -60,6 +63,7 @@ using testing::NiceMock;
 using testing::_;
 using testing::Return;
 using testing::AtLeast;
+using testing::SaveArg;
 
 
 class KontrollerTestMockPlatformIO : public MockPlatformIO
@@ -107,6 +111,7 @@ class KontrollerTest : public ::testing::Test
         MockTreeComm *m_tree_comm;
         MockReporter *m_reporter;
         MockTracer *m_tracer;
+        MockTraceRollup *m_trace_rollup;
         std::vector<MockAgent*> m_level_agent;
         std::vector<std::unique_ptr<Agent> > m_agents;
         MockManagerIOSampler *m_manager_io;
@@ -130,6 +135,7 @@ void KontrollerTest::SetUp()
     m_manager_io = new MockManagerIOSampler();
     m_reporter = new MockReporter();
     m_tracer = new MockTracer();
+    m_trace_rollup = new MockTraceRollup();
 
 }
 
@@ -145,19 +151,25 @@ TEST_F(KontrollerTest, single_node)
         .WillOnce(Return(num_level_ctl));
     EXPECT_CALL(*m_tree_comm, root_level())
         .WillOnce(Return(root_level));
+    std::shared_ptr<geopm::IOGroup> timer_iogroup;
+    EXPECT_CALL(m_platform_io, register_iogroup(_))
+        .WillOnce(SaveArg<0>(&timer_iogroup));
     Kontroller kontroller(m_comm, m_platform_io,
                           m_agent_name, m_num_send_down, m_num_send_up,
                           std::unique_ptr<MockTreeComm>(m_tree_comm),
                           m_application_io,
                           std::unique_ptr<MockReporter>(m_reporter),
                           std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockTraceRollup>(m_trace_rollup),
                           std::move(m_agents),
-                          std::unique_ptr<MockManagerIOSampler>(m_manager_io));
+                          std::unique_ptr<MockManagerIOSampler>(m_manager_io),
+                          nullptr);
 
     // setup trace
     std::vector<std::string> trace_names = {"COL1", "COL2"};
     EXPECT_CALL(*agent, trace_names()).WillOnce(Return(trace_names));
     EXPECT_CALL(*m_tracer, columns(_));
+    EXPECT_CALL(*m_trace_rollup, columns(_));
     kontroller.setup_trace();
 
     // step
@@ -169,10 +181,15 @@ TEST_F(KontrollerTest, single_node)
     EXPECT_CALL(*m_application_io, clear_region_info()).Times(m_num_step);
     std::vector<double> manager_sample = {8.8, 9.9};
     ASSERT_EQ(m_num_send_down, (int)manager_sample.size());
-    EXPECT_CALL(*m_manager_io, sample()).Times(m_num_step)
-        .WillRepeatedly(Return(manager_sample));
+    EXPECT_CALL(*m_manager_io, sample()).Times(1)
+        .WillOnce(Return(manager_sample));
+    EXPECT_CALL(*m_manager_io, is_update_available()).Times(m_num_step - 1)
+        .WillRepeatedly(Return(false));
+    EXPECT_CALL(*m_manager_io, read_batch()).Times(0);
     EXPECT_CALL(*m_tracer, update(_, _)).Times(m_num_step);
+    EXPECT_CALL(*m_trace_rollup, update(_)).Times(m_num_step);
     EXPECT_CALL(*agent, trace_values(_)).Times(m_num_step);
+    EXPECT_CALL(*agent, update_region_info(_)).Times(m_num_step);
     EXPECT_CALL(*agent, adjust_platform(_)).Times(m_num_step).WillRepeatedly(Return(true));
     EXPECT_CALL(*agent, sample_platform(_)).Times(m_num_step)
         .WillRepeatedly(Return(true));
@@ -181,6 +198,11 @@ TEST_F(KontrollerTest, single_node)
     for (int step = 0; step < m_num_step; ++step) {
         kontroller.step();
     }
+    ASSERT_NE(nullptr, timer_iogroup);
+    EXPECT_EQ(m_num_step, timer_iogroup->read_signal("CONTROLLER::STEP_COUNT",
+                                                      IPlatformTopo::M_DOMAIN_BOARD, 0));
+    EXPECT_LE(0.0, timer_iogroup->read_signal("CONTROLLER::READ_BATCH_MAX",
+                                              IPlatformTopo::M_DOMAIN_BOARD, 0));
 
     // generate report and trace
     EXPECT_CALL(*agent, report_header()).WillOnce(Return(m_agent_report));
@@ -188,6 +210,7 @@ TEST_F(KontrollerTest, single_node)
     EXPECT_CALL(*agent, report_region()).WillOnce(Return(m_region_names));
     EXPECT_CALL(*m_reporter, generate(_, _, _, _, _, _, _));
     EXPECT_CALL(*m_tracer, flush());
+    EXPECT_CALL(*m_trace_rollup, flush());
     kontroller.generate();
 
     // single node Kontroller should not send anything via TreeComm
@@ -214,12 +237,15 @@ TEST_F(KontrollerTest, two_level_controller_1)
                           m_application_io,
                           std::unique_ptr<MockReporter>(m_reporter),
                           std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockTraceRollup>(m_trace_rollup),
                           std::move(m_agents),
-                          std::unique_ptr<MockManagerIOSampler>(m_manager_io));
+                          std::unique_ptr<MockManagerIOSampler>(m_manager_io),
+                          nullptr);
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
     EXPECT_CALL(*agent, trace_names()).WillOnce(Return(trace_names));
     EXPECT_CALL(*m_tracer, columns(_));
+    EXPECT_CALL(*m_trace_rollup, columns(_));
     kontroller.setup_trace();
 
     // mock parent sending to this child
@@ -236,6 +262,7 @@ TEST_F(KontrollerTest, two_level_controller_1)
         .WillRepeatedly(Return(m_region_info));
     EXPECT_CALL(*m_application_io, clear_region_info()).Times(m_num_step);
     EXPECT_CALL(*m_tracer, update(_, _)).Times(m_num_step);
+    EXPECT_CALL(*m_trace_rollup, update(_)).Times(m_num_step);
     EXPECT_CALL(*agent, trace_values(_)).Times(m_num_step);
     EXPECT_CALL(*agent, adjust_platform(_)).Times(m_num_step).WillRepeatedly(Return(true));
     EXPECT_CALL(*agent, sample_platform(_)).Times(m_num_step)
@@ -254,6 +281,7 @@ TEST_F(KontrollerTest, two_level_controller_1)
     EXPECT_CALL(*agent, report_region()).WillOnce(Return(m_region_names));
     EXPECT_CALL(*m_reporter, generate(_, _, _, _, _, _, _));
     EXPECT_CALL(*m_tracer, flush());
+    EXPECT_CALL(*m_trace_rollup, flush());
     kontroller.generate();
 
     EXPECT_NE(0, m_tree_comm->num_send());
@@ -291,12 +319,15 @@ TEST_F(KontrollerTest, two_level_controller_2)
                           m_application_io,
                           std::unique_ptr<MockReporter>(m_reporter),
                           std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockTraceRollup>(m_trace_rollup),
                           std::move(m_agents),
-                          std::unique_ptr<MockManagerIOSampler>(m_manager_io));
+                          std::unique_ptr<MockManagerIOSampler>(m_manager_io),
+                          nullptr);
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
     EXPECT_CALL(*m_level_agent[0], trace_names()).WillOnce(Return(trace_names));
     EXPECT_CALL(*m_tracer, columns(_));
+    EXPECT_CALL(*m_trace_rollup, columns(_));
     kontroller.setup_trace();
 
     // mock parent sending to this child
@@ -313,6 +344,7 @@ TEST_F(KontrollerTest, two_level_controller_2)
         .WillRepeatedly(Return(m_region_info));
     EXPECT_CALL(*m_application_io, clear_region_info()).Times(m_num_step);
     EXPECT_CALL(*m_tracer, update(_, _)).Times(m_num_step);
+    EXPECT_CALL(*m_trace_rollup, update(_)).Times(m_num_step);
     EXPECT_CALL(*m_level_agent[0], trace_values(_)).Times(m_num_step);
     EXPECT_CALL(*m_level_agent[0], adjust_platform(_)).Times(m_num_step).WillRepeatedly(Return(true));
     EXPECT_CALL(*m_level_agent[0], sample_platform(_)).Times(m_num_step)
@@ -335,6 +367,7 @@ TEST_F(KontrollerTest, two_level_controller_2)
     EXPECT_CALL(*m_level_agent[0], report_region()).WillOnce(Return(m_region_names));
     EXPECT_CALL(*m_reporter, generate(_, _, _, _, _, _, _));
     EXPECT_CALL(*m_tracer, flush());
+    EXPECT_CALL(*m_trace_rollup, flush());
     kontroller.generate();
 
     EXPECT_NE(0, m_tree_comm->num_send());
@@ -365,6 +398,7 @@ TEST_F(KontrollerTest, two_level_controller_0)
         m_agents.emplace_back(m_level_agent[level]);
     }
     ASSERT_EQ(3u, m_level_agent.size());
+    MockManagerIO *manager_io = new MockManagerIO();
 
     Kontroller kontroller(m_comm, m_platform_io,
                           m_agent_name, m_num_send_down, m_num_send_up,
@@ -372,12 +406,15 @@ TEST_F(KontrollerTest, two_level_controller_0)
                           m_application_io,
                           std::unique_ptr<MockReporter>(m_reporter),
                           std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockTraceRollup>(m_trace_rollup),
                           std::move(m_agents),
-                          std::unique_ptr<MockManagerIOSampler>(m_manager_io));
+                          std::unique_ptr<MockManagerIOSampler>(m_manager_io),
+                          std::unique_ptr<MockManagerIO>(manager_io));
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
     EXPECT_CALL(*m_level_agent[0], trace_names()).WillOnce(Return(trace_names));
     EXPECT_CALL(*m_tracer, columns(_));
+    EXPECT_CALL(*m_trace_rollup, columns(_));
     kontroller.setup_trace();
 
     EXPECT_CALL(m_platform_io, read_batch()).Times(m_num_step);
@@ -388,9 +425,18 @@ TEST_F(KontrollerTest, two_level_controller_0)
     EXPECT_CALL(*m_application_io, clear_region_info()).Times(m_num_step);
     std::vector<double> manager_sample = {8.8, 9.9};
     ASSERT_EQ(m_num_send_down, (int)manager_sample.size());
-    EXPECT_CALL(*m_manager_io, sample()).Times(m_num_step)
-        .WillRepeatedly(Return(manager_sample));
+    // policy is re-read only after the resource manager updates it
+    std::vector<double> manager_update = {7.7, 6.6};
+    ASSERT_EQ(3, m_num_step);
+    EXPECT_CALL(*m_manager_io, sample()).Times(2)
+        .WillOnce(Return(manager_sample))
+        .WillOnce(Return(manager_update));
+    EXPECT_CALL(*m_manager_io, is_update_available()).Times(m_num_step - 1)
+        .WillOnce(Return(true))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*m_manager_io, read_batch()).Times(1);
     EXPECT_CALL(*m_tracer, update(_, _)).Times(m_num_step);
+    EXPECT_CALL(*m_trace_rollup, update(_)).Times(m_num_step);
     EXPECT_CALL(*m_level_agent[0], trace_values(_)).Times(m_num_step);
     EXPECT_CALL(*m_level_agent[0], adjust_platform(_)).Times(m_num_step).WillRepeatedly(Return(true));
     EXPECT_CALL(*m_level_agent[0], sample_platform(_)).Times(m_num_step)
@@ -405,6 +451,10 @@ TEST_F(KontrollerTest, two_level_controller_0)
         .WillRepeatedly(Return(true));
     EXPECT_CALL(*m_level_agent[1], ascend(_, _)).Times(m_num_step)
         .WillRepeatedly(Return(true));
+    // root publishes the aggregated sample every step
+    EXPECT_CALL(*manager_io, adjust(testing::Matcher<const std::vector<double> &>(
+        testing::SizeIs(m_num_send_up)))).Times(m_num_step);
+    EXPECT_CALL(*manager_io, write_batch()).Times(m_num_step);
 
     for (int step = 0; step < m_num_step; ++step) {
         kontroller.step();
@@ -415,6 +465,7 @@ TEST_F(KontrollerTest, two_level_controller_0)
     EXPECT_CALL(*m_level_agent[0], report_region()).WillOnce(Return(m_region_names));
     EXPECT_CALL(*m_reporter, generate(_, _, _, _, _, _, _));
     EXPECT_CALL(*m_tracer, flush());
+    EXPECT_CALL(*m_trace_rollup, flush());
     kontroller.generate();
 
     EXPECT_NE(0, m_tree_comm->num_send());
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+
+#include <cmath>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "KontrollerTimer.hpp"
+#include "KontrollerIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_time.h"
+
+using geopm::KontrollerTimer;
+using geopm::KontrollerIOGroup;
+using geopm::PlatformTopo;
+
+class KontrollerTimerTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        /// Record steps where read_batch takes 1 ms, 2 ms, ... and
+        /// the agent waits 5 ms.
+        void run_steps(int num_step);
+        std::shared_ptr<KontrollerTimer> m_timer;
+        std::unique_ptr<KontrollerIOGroup> m_group;
+};
+
+void KontrollerTimerTest::SetUp()
+{
+    m_timer = std::make_shared<KontrollerTimer>();
+    m_group = geopm::make_unique<KontrollerIOGroup>(m_timer);
+}
+
+void KontrollerTimerTest::run_steps(int num_step)
+{
+    for (int step = 0; step < num_step; ++step) {
+        struct geopm_time_s time;
+        m_timer->begin_step(time);
+        // pretend that each phase started in the past
+        geopm_time_add(&time, -0.001 * (step + 1), &time);
+        m_timer->lap(KontrollerTimer::M_PHASE_READ_BATCH, time);
+        geopm_time_add(&time, -0.005, &time);
+        m_timer->lap(KontrollerTimer::M_PHASE_AGENT_WAIT, time);
+        m_timer->end_step();
+    }
+}
+
+TEST_F(KontrollerTimerTest, empty)
+{
+    EXPECT_EQ(0u, m_timer->num_step());
+    EXPECT_TRUE(std::isnan(m_timer->stat(KontrollerTimer::M_PHASE_STEP, KontrollerTimer::M_STAT_MEAN)));
+    EXPECT_TRUE(std::isnan(m_timer->busy_fraction()));
+    EXPECT_THROW(m_timer->stat(KontrollerTimer::M_NUM_PHASE, KontrollerTimer::M_STAT_MEAN), geopm::Exception);
+    EXPECT_THROW(m_timer->stat(KontrollerTimer::M_PHASE_STEP, KontrollerTimer::M_NUM_STAT), geopm::Exception);
+    EXPECT_THROW(KontrollerTimer::phase_name(-1), geopm::Exception);
+}
+
+TEST_F(KontrollerTimerTest, stats)
+{
+    run_steps(10);
+    EXPECT_EQ(10u, m_timer->num_step());
+    int phase = KontrollerTimer::M_PHASE_READ_BATCH;
+    EXPECT_NEAR(0.010, m_timer->stat(phase, KontrollerTimer::M_STAT_LAST), 0.0005);
+    EXPECT_NEAR(0.0055, m_timer->stat(phase, KontrollerTimer::M_STAT_MEAN), 0.0005);
+    EXPECT_NEAR(0.001, m_timer->stat(phase, KontrollerTimer::M_STAT_MIN), 0.0005);
+    EXPECT_NEAR(0.010, m_timer->stat(phase, KontrollerTimer::M_STAT_MAX), 0.0005);
+    // percentiles are estimated by a LogHistogram
+    double p50 = m_timer->stat(phase, KontrollerTimer::M_STAT_P50);
+    EXPECT_NEAR(0.005, p50, 0.005 / 16);
+    EXPECT_NEAR(0.009, m_timer->stat(phase, KontrollerTimer::M_STAT_P90), 0.009 / 16);
+    double p99 = m_timer->stat(phase, KontrollerTimer::M_STAT_P99);
+    EXPECT_LE(p50, p99);
+    EXPECT_GE(m_timer->stat(phase, KontrollerTimer::M_STAT_MAX), p99);
+    // phases that were not entered take no time
+    EXPECT_EQ(0.0, m_timer->stat(KontrollerTimer::M_PHASE_TRACER, KontrollerTimer::M_STAT_MAX));
+    // no period before the first step
+    EXPECT_LT(0.0, m_timer->stat(KontrollerTimer::M_PHASE_PERIOD, KontrollerTimer::M_STAT_MEAN));
+}
+
+TEST_F(KontrollerTimerTest, busy_fraction)
+{
+    for (int step = 0; step < 3; ++step) {
+        struct geopm_time_s time;
+        m_timer->begin_step(time);
+        usleep(1000);
+        m_timer->lap(KontrollerTimer::M_PHASE_READ_BATCH, time);
+        usleep(3000);
+        m_timer->lap(KontrollerTimer::M_PHASE_AGENT_WAIT, time);
+        m_timer->end_step();
+    }
+    double step_mean = m_timer->stat(KontrollerTimer::M_PHASE_STEP, KontrollerTimer::M_STAT_MEAN);
+    EXPECT_LE(0.004, step_mean);
+    EXPECT_LE(0.004, m_timer->stat(KontrollerTimer::M_PHASE_PERIOD, KontrollerTimer::M_STAT_MEAN));
+    EXPECT_LT(0.0, m_timer->busy_fraction());
+    EXPECT_GT(0.5, m_timer->busy_fraction());
+}
+
+TEST_F(KontrollerTimerTest, iogroup_valid)
+{
+    EXPECT_TRUE(m_group->is_valid_signal("CONTROLLER::STEP_COUNT"));
+    EXPECT_TRUE(m_group->is_valid_signal("CONTROLLER::BUSY_FRACTION"));
+    EXPECT_TRUE(m_group->is_valid_signal("CONTROLLER::READ_BATCH_P99"));
+    EXPECT_TRUE(m_group->is_valid_signal("CONTROLLER::AGENT_WAIT_MEAN"));
+    EXPECT_FALSE(m_group->is_valid_signal("CONTROLLER::READ_BATCH"));
+    EXPECT_FALSE(m_group->is_valid_control("CONTROLLER::STEP_COUNT"));
+    EXPECT_EQ(PlatformTopo::M_DOMAIN_BOARD, m_group->signal_domain_type("CONTROLLER::STEP_MAX"));
+    EXPECT_EQ(PlatformTopo::M_DOMAIN_INVALID, m_group->signal_domain_type("INVALID"));
+    EXPECT_EQ(2u + KontrollerTimer::M_NUM_PHASE * KontrollerTimer::M_NUM_STAT,
+              m_group->signal_names().size());
+    for (const auto &sig : m_group->signal_names()) {
+        EXPECT_TRUE(m_group->is_valid_signal(sig));
+    }
+    EXPECT_EQ(0u, m_group->control_names().size());
+    EXPECT_THROW(m_group->push_signal("INVALID", PlatformTopo::M_DOMAIN_BOARD, 0), geopm::Exception);
+    EXPECT_THROW(m_group->push_signal("CONTROLLER::STEP_COUNT", PlatformTopo::M_DOMAIN_CPU, 0), geopm::Exception);
+    EXPECT_THROW(m_group->push_control("CONTROLLER::STEP_COUNT", PlatformTopo::M_DOMAIN_BOARD, 0), geopm::Exception);
+    EXPECT_THROW(m_group->read_signal("INVALID", PlatformTopo::M_DOMAIN_BOARD, 0), geopm::Exception);
+}
+
+TEST_F(KontrollerTimerTest, iogroup_sample)
+{
+    int count_idx = m_group->push_signal("CONTROLLER::STEP_COUNT", PlatformTopo::M_DOMAIN_BOARD, 0);
+    int max_idx = m_group->push_signal("CONTROLLER::READ_BATCH_MAX", PlatformTopo::M_DOMAIN_BOARD, 0);
+    EXPECT_EQ(count_idx, m_group->push_signal("CONTROLLER::STEP_COUNT", PlatformTopo::M_DOMAIN_BOARD, 0));
+    EXPECT_NE(count_idx, max_idx);
+    EXPECT_THROW(m_group->sample(count_idx), geopm::Exception);
+
+    m_group->read_batch();
+    EXPECT_EQ(0.0, m_group->sample(count_idx));
+    EXPECT_TRUE(std::isnan(m_group->sample(max_idx)));
+    EXPECT_THROW(m_group->push_signal("CONTROLLER::STEP_MAX", PlatformTopo::M_DOMAIN_BOARD, 0), geopm::Exception);
+
+    run_steps(4);
+    // sample() returns the value from the last read_batch()
+    EXPECT_EQ(0.0, m_group->sample(count_idx));
+    m_group->read_batch();
+    EXPECT_EQ(4.0, m_group->sample(count_idx));
+    EXPECT_EQ(m_timer->stat(KontrollerTimer::M_PHASE_READ_BATCH, KontrollerTimer::M_STAT_MAX),
+              m_group->sample(max_idx));
+    EXPECT_EQ(4.0, m_group->read_signal("CONTROLLER::STEP_COUNT", PlatformTopo::M_DOMAIN_BOARD, 0));
+    EXPECT_EQ(m_timer->busy_fraction(),
+              m_group->read_signal("CONTROLLER::BUSY_FRACTION", PlatformTopo::M_DOMAIN_BOARD, 0));
+}
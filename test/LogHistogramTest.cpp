@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "LogHistogram.hpp"
+#include "Exception.hpp"
+#include "geopm_test.hpp"
+
+using geopm::LogHistogram;
+
+TEST(LogHistogramTest, empty)
+{
+    LogHistogram hist;
+    EXPECT_EQ(0u, hist.count());
+    EXPECT_TRUE(std::isnan(hist.min()));
+    EXPECT_TRUE(std::isnan(hist.max()));
+    EXPECT_TRUE(std::isnan(hist.percentile(50.0)));
+    hist.insert(NAN);
+    hist.insert(INFINITY);
+    EXPECT_EQ(0u, hist.count());
+    GEOPM_EXPECT_THROW_MESSAGE(hist.percentile(-1.0), GEOPM_ERROR_INVALID, "between 0 and 100");
+    GEOPM_EXPECT_THROW_MESSAGE(hist.percentile(NAN), GEOPM_ERROR_INVALID, "between 0 and 100");
+}
+
+TEST(LogHistogramTest, percentile)
+{
+    // Samples spanning several orders of magnitude, e.g. frequency
+    std::mt19937 generator(7);
+    std::lognormal_distribution<double> distribution(std::log(2.0e9), 0.5);
+    std::vector<double> sample(10000);
+    LogHistogram hist;
+    for (auto &value : sample) {
+        value = distribution(generator);
+        hist.insert(value);
+    }
+    std::sort(sample.begin(), sample.end());
+    EXPECT_EQ(sample.size(), hist.count());
+    EXPECT_EQ(sample.front(), hist.min());
+    EXPECT_EQ(sample.back(), hist.max());
+    EXPECT_EQ(sample.front(), hist.percentile(0.0));
+    EXPECT_EQ(sample.back(), hist.percentile(100.0));
+    for (double percentile : {1.0, 10.0, 50.0, 95.0, 99.0, 99.9}) {
+        double expect = sample[std::ceil(percentile / 100.0 * sample.size()) - 1];
+        // Within half a bucket of 1/16 of the value
+        EXPECT_NEAR(expect, hist.percentile(percentile), expect / 32) << percentile;
+    }
+    hist.reset();
+    EXPECT_EQ(0u, hist.count());
+    EXPECT_TRUE(std::isnan(hist.percentile(99.0)));
+}
+
+TEST(LogHistogramTest, range)
+{
+    LogHistogram hist;
+    // Zero and negative values are reported as the minimum
+    hist.insert(-3.0);
+    hist.insert(0.0);
+    // Values outside of the bucket range are clamped to the
+    // minimum and maximum
+    hist.insert(1e-12);
+    hist.insert(1.0);
+    hist.insert(1e30);
+    EXPECT_EQ(5u, hist.count());
+    EXPECT_EQ(-3.0, hist.percentile(20.0));
+    EXPECT_EQ(-3.0, hist.percentile(40.0));
+    EXPECT_NEAR(0.0, hist.percentile(60.0), 1e-6);
+    EXPECT_NEAR(1.0, hist.percentile(80.0), 1.0 / 32);
+    EXPECT_EQ(1e30, hist.percentile(100.0));
+}
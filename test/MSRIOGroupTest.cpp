@@ -54,6 +54,7 @@
 
 using geopm::MSRIOGroup;
 using geopm::IPlatformTopo;
+using geopm::IPlatformIO;
 using geopm::Exception;
 using testing::Return;
 using testing::SetArgReferee;
@@ -507,6 +508,51 @@ TEST_F(MSRIOGroupTest, adjust)
     close(fd_0);
 }
 
+TEST_F(MSRIOGroupTest, write_batch_dirty)
+{
+    EXPECT_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_PACKAGE)).Times(3);
+    EXPECT_CALL(m_topo, domain_cpus(IPlatformTopo::M_DOMAIN_PACKAGE, _, _)).Times(3);
+
+    int freq_idx = m_msrio_group->push_control("MSR::PERF_CTL:FREQ", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    int power_idx = m_msrio_group->push_control("MSR::PKG_POWER_LIMIT:SOFT_POWER_LIMIT", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    int fd_0 = open(m_test_dev_path[0].c_str(), O_RDWR);
+    ASSERT_NE(-1, fd_0);
+    uint64_t value;
+    m_msrio_group->adjust(freq_idx, 1e9);
+    m_msrio_group->adjust(power_idx, 160);
+    m_msrio_group->write_batch();
+    ASSERT_EQ(8, pread(fd_0, &value, sizeof(value), 0x199));
+    EXPECT_EQ(0xA00ULL, (value & 0xFF00));
+
+    // Controls adjusted to the same setting are not written
+    value = 0;
+    ASSERT_EQ(8, pwrite(fd_0, &value, sizeof(value), 0x199));
+    m_msrio_group->adjust(freq_idx, 1e9);
+    m_msrio_group->adjust(power_idx, 160);
+    m_msrio_group->write_batch();
+    ASSERT_EQ(8, pread(fd_0, &value, sizeof(value), 0x199));
+    EXPECT_EQ(0ULL, (value & 0xFF00));
+
+    // Only the MSR that changed is written
+    m_msrio_group->adjust(power_idx, 200);
+    m_msrio_group->write_batch();
+    ASSERT_EQ(8, pread(fd_0, &value, sizeof(value), 0x199));
+    EXPECT_EQ(0ULL, (value & 0xFF00));
+    ASSERT_EQ(8, pread(fd_0, &value, sizeof(value), 0x610));
+    EXPECT_EQ(0x640ULL, (value & 0x7FFF));
+
+    // A direct write is undone by the next write_batch()
+    m_msrio_group->write_control("MSR::PKG_POWER_LIMIT:SOFT_POWER_LIMIT", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 300);
+    ASSERT_EQ(8, pread(fd_0, &value, sizeof(value), 0x610));
+    EXPECT_EQ(0x960ULL, (value & 0x7FFF));
+    m_msrio_group->adjust(power_idx, 200);
+    m_msrio_group->write_batch();
+    ASSERT_EQ(8, pread(fd_0, &value, sizeof(value), 0x610));
+    EXPECT_EQ(0x640ULL, (value & 0x7FFF));
+
+    close(fd_0);
+}
+
 TEST_F(MSRIOGroupTest, write_control)
 {
     EXPECT_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_PACKAGE)).Times(2);
@@ -531,6 +577,39 @@ TEST_F(MSRIOGroupTest, write_control)
     close(fd_0);
 }
 
+TEST_F(MSRIOGroupTest, write_control_batch)
+{
+    EXPECT_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_PACKAGE)).Times(2);
+    EXPECT_CALL(m_topo, domain_cpus(IPlatformTopo::M_DOMAIN_PACKAGE, _, _)).Times(2);
+
+    int fd_0 = open(m_test_dev_path[0].c_str(), O_RDWR);
+    ASSERT_NE(-1, fd_0);
+    uint64_t value;
+    size_t num_read;
+
+    std::vector<IPlatformIO::m_request_s> request {
+        {"MSR::PERF_CTL:FREQ", IPlatformTopo::M_DOMAIN_PACKAGE, 0},
+        {"MSR::PKG_POWER_LIMIT:SOFT_POWER_LIMIT", IPlatformTopo::M_DOMAIN_PACKAGE, 0}};
+    m_msrio_group->write_control_batch(request, {3e9, 300});
+    num_read = pread(fd_0, &value, sizeof(value), 0x199);
+    EXPECT_EQ(8ULL, num_read);
+    EXPECT_EQ(0x1E00ULL, (value & 0xFF00));
+    num_read = pread(fd_0, &value, sizeof(value), 0x610);
+    EXPECT_EQ(8ULL, num_read);
+    EXPECT_EQ(0x960ULL, (value & 0x7FFF));
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio_group->write_control_batch(request, {3e9}),
+                               GEOPM_ERROR_INVALID, "number of settings does not match");
+    request = {{"INVALID", IPlatformTopo::M_DOMAIN_PACKAGE, 0}};
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio_group->write_control_batch(request, {0.0}),
+                               GEOPM_ERROR_INVALID, "control name \"INVALID\" not found");
+    std::vector<double> result;
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio_group->read_signal_batch(request, result),
+                               GEOPM_ERROR_INVALID, "signal name \"INVALID\" not found");
+
+    close(fd_0);
+}
+
 TEST_F(MSRIOGroupTest, control_alias)
 {
     EXPECT_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_PACKAGE)).Times(2);
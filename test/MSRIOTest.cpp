@@ -820,3 +820,78 @@ TEST_F(MSRIOTest, write_batch)
     EXPECT_THROW(m_msrio->config_batch(write_cpu_idx, {}, {}, {}, {}), geopm::Exception);
     EXPECT_THROW(m_msrio->config_batch({}, {}, write_cpu_idx, write_offset, {}), geopm::Exception);
 }
+
+TEST_F(MSRIOTest, write_batch_shadow)
+{
+    // Two fields of one MSR and a field of a second MSR on CPU 0
+    std::vector<int> write_cpu_idx {0, 0, 0};
+    std::vector<uint64_t> write_offset {0xd28, 0xd28, 0x520};
+    std::vector<uint64_t> write_mask {0x00000000000000FF,
+                                      0x000000000000FF00,
+                                      0x00000000000000FF};
+    std::vector<uint64_t> write_value(3);
+    memcpy(&write_value[0], "H\0\0\0\0\0\0\0", 8);
+    memcpy(&write_value[1], "\0A\0\0\0\0\0\0", 8);
+    memcpy(&write_value[2], "B\0\0\0\0\0\0\0", 8);
+    m_msrio->config_batch({}, {}, write_cpu_idx, write_offset, write_mask);
+    m_msrio->write_batch(write_value);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "HAftware", 8));
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0x520), "Bngineer", 8));
+
+    // Unchanged values are not written again
+    memcpy(m_msrio->msr_space_ptr(0, 0xd28), "hardware", 8);
+    memcpy(m_msrio->msr_space_ptr(0, 0x520), "engineer", 8);
+    m_msrio->write_batch(write_value);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "hardware", 8));
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0x520), "engineer", 8));
+
+    // A changed field is merged into the last value written rather
+    // than the value read back from the MSR.
+    memcpy(&write_value[1], "\0O\0\0\0\0\0\0", 8);
+    m_msrio->write_batch(write_value);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "HOftware", 8));
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0x520), "engineer", 8));
+
+    // Single writes update the last value written
+    m_msrio->write_msr(0, 0xd28, write_value[0], 0xFF);
+    m_msrio->write_msr(0, 0xd28, 0, 0xFF0000);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "HO\0tware", 8));
+    m_msrio->write_batch(write_value);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "HO\0tware", 8));
+
+    write_value[2] = 0xFFFF;
+    EXPECT_THROW(m_msrio->write_batch(write_value), geopm::Exception);
+    EXPECT_THROW(m_msrio->write_batch({0, 0}), geopm::Exception);
+}
+
+TEST_F(MSRIOTest, read_write_list)
+{
+    std::vector<int> cpu_idx {0, 1, 3};
+    std::vector<uint64_t> offset {0xd28, 0x520, 0x468};
+    std::vector<uint64_t> raw_value;
+    m_msrio->read_msr(cpu_idx, offset, raw_value);
+    ASSERT_EQ(3u, raw_value.size());
+    EXPECT_EQ(0, memcmp(&raw_value[0], "software", 8));
+    EXPECT_EQ(0, memcmp(&raw_value[1], "engineer", 8));
+    EXPECT_EQ(0, memcmp(&raw_value[2], "document", 8));
+
+    // Two fields of the same MSR are merged into one write
+    std::vector<uint64_t> write_value(3);
+    memcpy(&write_value[0], "H\0\0\0\0\0\0\0", 8);
+    memcpy(&write_value[1], "\0A\0\0\0\0\0\0", 8);
+    memcpy(&write_value[2], "\0\0\0\0\0\0\0R", 8);
+    m_msrio->write_msr({2, 2, 3}, {0xd28, 0xd28, 0x468}, write_value,
+                       {0xFF, 0xFF00, 0xFF00000000000000});
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(2, 0xd28), "HAftware", 8));
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(3, 0x468), "documenR", 8));
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "software", 8));
+
+    EXPECT_THROW(m_msrio->read_msr(cpu_idx, {0xd28}, raw_value), geopm::Exception);
+    std::vector<int> bad_cpu {0};
+    std::vector<uint64_t> bad_offset {0xd28};
+    std::vector<uint64_t> bad_value {0xFFFF};
+    std::vector<uint64_t> bad_mask {0xFF};
+    EXPECT_THROW(m_msrio->write_msr(bad_cpu, bad_offset, bad_value, bad_mask), geopm::Exception);
+    bad_mask.clear();
+    EXPECT_THROW(m_msrio->write_msr(bad_cpu, bad_offset, bad_value, bad_mask), geopm::Exception);
+}
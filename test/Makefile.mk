@@ -140,10 +140,54 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/CpuinfoIOGroupTest.parse_cpu_info6 \
               test/gtest_links/CpuinfoIOGroupTest.parse_cpu_freq \
               test/gtest_links/CpuinfoIOGroupTest.plugin \
+              test/gtest_links/CpufreqIOGroupTest.valid_signals \
+              test/gtest_links/CpufreqIOGroupTest.no_policy \
+              test/gtest_links/CpufreqIOGroupTest.read_signal \
+              test/gtest_links/CpufreqIOGroupTest.sample \
+              test/gtest_links/CpufreqIOGroupTest.adjust \
+              test/gtest_links/CpufreqIOGroupTest.userspace_governor \
+              test/gtest_links/CpufreqIOGroupTest.save_restore \
+              test/gtest_links/CpufreqIOGroupTest.plugin \
+              test/gtest_links/PerfEventIOGroupTest.valid_signals \
+              test/gtest_links/PerfEventIOGroupTest.push \
+              test/gtest_links/PerfEventIOGroupTest.sample \
+              test/gtest_links/PerfEventIOGroupTest.read_signal \
+              test/gtest_links/PerfEventIOGroupTest.task \
+              test/gtest_links/PerfEventIOGroupTest.task_env \
+              test/gtest_links/PerfEventIOGroupTest.plugin \
+              test/gtest_links/PowercapIOGroupTest.valid_signals \
+              test/gtest_links/PowercapIOGroupTest.no_zones \
+              test/gtest_links/PowercapIOGroupTest.read_signal \
+              test/gtest_links/PowercapIOGroupTest.sample \
+              test/gtest_links/PowercapIOGroupTest.adjust \
+              test/gtest_links/PowercapIOGroupTest.save_restore \
+              test/gtest_links/PowercapIOGroupTest.enable_limit \
+              test/gtest_links/PowercapIOGroupTest.plugin \
+              test/gtest_links/ReplayIOGroupTest.record_replay \
+              test/gtest_links/ReplayIOGroupTest.read_signal \
+              test/gtest_links/ReplayIOGroupTest.mismatch \
+              test/gtest_links/ReplayIOGroupTest.batch \
+              test/gtest_links/ReplayIOGroupTest.end_of_log \
+              test/gtest_links/ReplayIOGroupTest.invalid_push \
+              test/gtest_links/ReplayIOGroupTest.bad_file \
+              test/gtest_links/SimPlatformIOGroupTest.valid_signals \
+              test/gtest_links/SimPlatformIOGroupTest.power_limit \
+              test/gtest_links/SimPlatformIOGroupTest.frequency_control \
+              test/gtest_links/SimPlatformIOGroupTest.energy_cycles \
+              test/gtest_links/SimPlatformIOGroupTest.epoch \
+              test/gtest_links/SimPlatformIOGroupTest.variation \
+              test/gtest_links/SimPlatformIOGroupTest.save_restore \
+              test/gtest_links/SimPlatformIOGroupTest.parse_model \
+              test/gtest_links/LogHistogramTest.empty \
+              test/gtest_links/LogHistogramTest.percentile \
+              test/gtest_links/LogHistogramTest.range \
               test/gtest_links/EnergyEfficientAgentTest.map \
               test/gtest_links/EnergyEfficientAgentTest.name \
               test/gtest_links/EnergyEfficientAgentTest.hint \
               test/gtest_links/EnergyEfficientAgentTest.online_mode \
+              test/gtest_links/EnergyEfficientAgentTest.per_core \
+              test/gtest_links/EnergyEfficientAgentTest.online_warm_start \
+              test/gtest_links/EnergyEfficientAgentTest.predict \
               test/gtest_links/EfficientFreqDeciderTest.map \
               test/gtest_links/EfficientFreqDeciderTest.decider_is_supported \
               test/gtest_links/EfficientFreqDeciderTest.name \
@@ -201,6 +245,10 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/EnergyEfficientRegionTest.performance_decreases_freq_steps_back_up \
               test/gtest_links/EnergyEfficientRegionTest.energy_increases_freq_steps_back_up \
               test/gtest_links/EnergyEfficientRegionTest.after_too_many_increase_freq_stays_at_higher \
+              test/gtest_links/EnergyEfficientRegionTest.freq_range_change_during_search \
+              test/gtest_links/EnergyEfficientRegionTest.freq_range_change_before_baseline \
+              test/gtest_links/EnergyEfficientRegionTest.warm_start \
+              test/gtest_links/EnergyEfficientRegionTest.warm_start_stale \
               test/gtest_links/EfficientFreqRegionTest.freq_starts_at_maximum \
               test/gtest_links/EfficientFreqRegionTest.update_ignores_nan_sample \
               test/gtest_links/EfficientFreqRegionTest.only_changes_freq_after_enough_samples \
@@ -225,6 +273,12 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/PlatformTopoTest.parse_error \
               test/gtest_links/PlatformTopoTest.domain_name_to_type \
               test/gtest_links/PlatformTopoTest.domain_type_to_name \
+              test/gtest_links/PlatformTopoTest.sysfs_domain \
+              test/gtest_links/PlatformTopoTest.domain_list \
+              test/gtest_links/PlatformTopoTest.sysfs_snapshot \
+              test/gtest_links/PlatformTopoTest.sysfs_snapshot_host \
+              test/gtest_links/PlatformTopoTest.sysfs_snapshot_range \
+              test/gtest_links/PlatformTopoTest.sysfs_error \
               test/gtest_links/SingleTreeCommunicatorTest.hello \
               test/gtest_links/TreeCommunicatorTest.hello \
               test/gtest_links/TreeCommunicatorTest.send_policy_down \
@@ -258,6 +312,7 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/PlatformIOTest.push_control \
               test/gtest_links/PlatformIOTest.sample \
               test/gtest_links/PlatformIOTest.sample_region_total \
+              test/gtest_links/PlatformIOTest.sample_region_percentile \
               test/gtest_links/PlatformIOTest.adjust \
               test/gtest_links/PlatformIOTest.read_signal \
               test/gtest_links/PlatformIOTest.write_control \
@@ -287,36 +342,84 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/TreeCommLevelTest.level_rank \
               test/gtest_links/TreeCommLevelTest.send_up \
               test/gtest_links/TreeCommLevelTest.send_down \
+              test/gtest_links/TreeCommLevelTest.send_down_view \
+              test/gtest_links/TreeCommLevelTest.receive_up_view \
               test/gtest_links/TreeCommLevelTest.receive_up_complete \
               test/gtest_links/TreeCommLevelTest.receive_up_incomplete \
               test/gtest_links/TreeCommLevelTest.receive_down_complete \
               test/gtest_links/TreeCommLevelTest.receive_down_incomplete \
               test/gtest_links/TreeCommTest.geometry \
               test/gtest_links/TreeCommTest.send_receive \
+              test/gtest_links/TreeCommTest.send_receive_view \
               test/gtest_links/TreeCommTest.overhead_send \
               test/gtest_links/MonitorAgentTest.fixed_signal_list \
               test/gtest_links/MonitorAgentTest.sample_platform \
               test/gtest_links/MonitorAgentTest.descend_nothing \
               test/gtest_links/MonitorAgentTest.ascend_aggregates_signals \
+              test/gtest_links/MonitorAgentTest.ascend_view_adapter \
+              test/gtest_links/MatrixReduceTest.agg_equivalence \
+              test/gtest_links/MatrixReduceTest.strided \
+              test/gtest_links/MatrixReduceTest.empty \
               test/gtest_links/ReporterTest.generate \
               test/gtest_links/KontrollerTest.single_node \
               test/gtest_links/KontrollerTest.two_level_controller_2 \
               test/gtest_links/KontrollerTest.two_level_controller_1 \
               test/gtest_links/KontrollerTest.two_level_controller_0 \
+              test/gtest_links/KontrollerTimerTest.empty \
+              test/gtest_links/KontrollerTimerTest.stats \
+              test/gtest_links/KontrollerTimerTest.busy_fraction \
+              test/gtest_links/KontrollerTimerTest.iogroup_valid \
+              test/gtest_links/KontrollerTimerTest.iogroup_sample \
+              test/gtest_links/ThreadPoolTest.serial \
+              test/gtest_links/ThreadPoolTest.parallel \
+              test/gtest_links/ThreadPoolTest.nested \
+              test/gtest_links/ThreadPoolTest.negative_exception \
               test/gtest_links/ManagerIOTest.write_json_file \
               test/gtest_links/ManagerIOTest.write_shm \
               test/gtest_links/ManagerIOTest.negative_write_json_file \
               test/gtest_links/ManagerIOTestIntegration.write_shm \
               test/gtest_links/ManagerIOSamplerTest.parse_json_file \
               test/gtest_links/ManagerIOSamplerTest.negative_parse_json_file \
+              test/gtest_links/ManagerIOSamplerTest.parse_json_file_update \
               test/gtest_links/ManagerIOSamplerTest.parse_shm \
+              test/gtest_links/ManagerIOSamplerTest.parse_shm_seqlock \
+              test/gtest_links/ManagerIOSamplerTest.parse_shm_old_layout \
+              test/gtest_links/ManagerIOSamplerTest.negative_parse_shm_seqlock \
               test/gtest_links/ManagerIOSamplerTest.negative_parse_shm \
               test/gtest_links/ManagerIOSamplerTest.negative_shm_setup_mutex \
               test/gtest_links/ManagerIOSamplerTest.negative_bad_files \
               test/gtest_links/ManagerIOSamplerTestIntegration.parse_shm \
+              test/gtest_links/RegionFreqCacheTest.persist \
+              test/gtest_links/RegionFreqCacheTest.host_class \
+              test/gtest_links/RegionFreqCacheTest.negative \
+              test/gtest_links/RegionTransitionGraphTest.empty \
+              test/gtest_links/RegionTransitionGraphTest.learn \
+              test/gtest_links/RegionTransitionGraphTest.predict \
+              test/gtest_links/SampleRingTest.publish_read \
+              test/gtest_links/SampleRingTest.overrun \
+              test/gtest_links/SampleRingTest.late_attach \
+              test/gtest_links/SampleRingTest.negative \
+              test/gtest_links/EndpointAggregatorTest.aggregate \
+              test/gtest_links/EndpointAggregatorTest.policy_batch \
+              test/gtest_links/EndpointAggregatorTest.negative \
+              test/gtest_links/TraceBlockWriterTest.codec_error \
+              test/gtest_links/TraceBlockWriterTest.drop_when_full \
+              test/gtest_links/TraceBlockWriterTest.round_trip \
+              test/gtest_links/TraceBlockWriterTest.stream_error \
+              test/gtest_links/TraceBlockWriterTest.tracer \
+              test/gtest_links/TraceCodecTest.factory \
+              test/gtest_links/TraceCodecTest.lz4_round_trip \
+              test/gtest_links/TraceCodecTest.lz4_long_run \
+              test/gtest_links/TraceCodecTest.lz4_corrupt \
               test/gtest_links/TracerTest.columns \
               test/gtest_links/TracerTest.update_samples \
               test/gtest_links/TracerTest.region_entry_exit \
+              test/gtest_links/TracerTest.adaptive \
+              test/gtest_links/TraceRollupTest.single_node \
+              test/gtest_links/TraceRollupTest.combine_children \
+              test/gtest_links/TraceRollupTest.leaf_window \
+              test/gtest_links/TraceRollupTest.disabled \
+              test/gtest_links/TraceRollupTest.buffer_limit \
               test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/ApplicationIOTest.passthrough \
               test/gtest_links/KruntimeRegulatorTest.exceptions \
@@ -388,8 +491,15 @@ test_geopm_test_SOURCES = test/geopm_test.cpp \
                           test/EnergyEfficientAgentTest.cpp \
                           test/MockIOGroup.hpp \
                           test/MockRegion.hpp \
+                          test/MockRegionFreqCache.hpp \
                           test/MockPolicy.hpp \
                           test/CpuinfoIOGroupTest.cpp \
+                          test/CpufreqIOGroupTest.cpp \
+                          test/PerfEventIOGroupTest.cpp \
+                          test/PowercapIOGroupTest.cpp \
+                          test/ReplayIOGroupTest.cpp \
+                          test/SimPlatformIOGroupTest.cpp \
+                          test/LogHistogramTest.cpp \
                           test/EfficientFreqDeciderTest.cpp \
                           test/MockComm.hpp \
                           test/MockControlMessage.hpp \
@@ -440,16 +550,28 @@ test_geopm_test_SOURCES = test/geopm_test.cpp \
                           test/TreeCommTest.cpp \
                           test/MockTreeCommLevel.hpp \
                           test/MonitorAgentTest.cpp \
+                          test/MatrixReduceTest.cpp \
                           test/AgentFactoryTest.cpp \
                           test/ReporterTest.cpp \
                           test/KontrollerTest.cpp \
+                          test/KontrollerTimerTest.cpp \
                           test/MockApplicationIO.hpp \
                           test/MockAgent.hpp \
                           test/MockReporter.hpp \
                           test/MockTracer.hpp \
+                          test/MockTraceRollup.hpp \
                           test/MockTreeComm.hpp \
                           test/MockManagerIOSampler.hpp \
+                          test/MockManagerIO.hpp \
+                          test/RegionFreqCacheTest.cpp \
+                          test/RegionTransitionGraphTest.cpp \
+                          test/SampleRingTest.cpp \
+                          test/EndpointAggregatorTest.cpp \
+                          test/ThreadPoolTest.cpp \
+                          test/TraceBlockWriterTest.cpp \
+                          test/TraceCodecTest.cpp \
                           test/TracerTest.cpp \
+                          test/TraceRollupTest.cpp \
                           test/ApplicationIOTest.cpp \
                           test/MockKprofileIOSample.hpp \
                           test/MockProfileIORuntime.hpp \
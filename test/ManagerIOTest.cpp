@@ -134,6 +134,9 @@ TEST_F(ManagerIOTest, write_shm)
     EXPECT_EQ(777, test[0]);
     EXPECT_EQ(12.3456, test[1]);
     EXPECT_EQ(2.3e9, test[2]);
+    // Both the generation and the flag read by older samplers
+    EXPECT_EQ(2u, data->generation);
+    EXPECT_EQ(1, data->is_updated);
 }
 
 TEST_F(ManagerIOTest, negative_write_json_file)
@@ -181,6 +184,15 @@ TEST_F(ManagerIOTestIntegration, write_shm)
     EXPECT_EQ(2.8e9, mios.sample("GHZ8"));
     EXPECT_EQ(2.7e9, mios.sample("GHZ7"));
     EXPECT_EQ(2.6e9, mios.sample("GHZ6"));
+    EXPECT_FALSE(mios.is_update_available());
+
+    mio.adjust("POWER_CONSUMED", 888);
+    mio.write_batch();
+    EXPECT_TRUE(mios.is_update_available());
+    mios.read_batch();
+    EXPECT_FALSE(mios.is_update_available());
+    EXPECT_EQ(888, mios.sample("POWER_CONSUMED"));
+    EXPECT_EQ(12.3456, mios.sample("RUNTIME"));
 }
 
 
@@ -300,6 +312,136 @@ TEST_F(ManagerIOSamplerTest, parse_shm)
     EXPECT_EQ(5.5, gp.sample("FIVE"));
 }
 
+TEST_F(ManagerIOSamplerTest, parse_json_file_update)
+{
+    std::vector<std::string> signal_names = {"POWER_MAX", "PI"};
+    ManagerIOSampler gp(m_json_file_path, nullptr, signal_names);
+    EXPECT_FALSE(gp.is_update_available());
+    EXPECT_EQ(400, gp.sample("POWER_MAX"));
+
+    std::ofstream json_stream(m_json_file_path);
+    json_stream << "{\"POWER_MAX\" : 250, \"PI\" : 3}" << std::endl;
+    json_stream.close();
+    EXPECT_TRUE(gp.is_update_available());
+    gp.read_batch();
+    EXPECT_FALSE(gp.is_update_available());
+    EXPECT_EQ(250, gp.sample("POWER_MAX"));
+    EXPECT_EQ(3, gp.sample("PI"));
+
+    // a partially written file keeps the previous values until the
+    // next update
+    json_stream.open(m_json_file_path);
+    json_stream << "{\"POWER_MAX\" : 1";
+    json_stream.close();
+    EXPECT_TRUE(gp.is_update_available());
+    gp.read_batch();
+    EXPECT_TRUE(gp.is_update_available());
+    EXPECT_EQ(250, gp.sample("POWER_MAX"));
+}
+
+TEST_F(ManagerIOSamplerTest, parse_shm_seqlock)
+{
+    size_t shmem_size = sizeof(struct geopm_manager_shmem_s);
+    std::unique_ptr<MockSharedMemoryUser> shmem(new MockSharedMemoryUser(shmem_size));
+    struct geopm_manager_shmem_s *data = (struct geopm_manager_shmem_s *) shmem->pointer();
+
+    // Build the data as a writer using the generation
+    ManagerIO::setup_mutex(data->lock);
+    double tmp[] = { 1.1, 2.2, 3.3 };
+    data->count = sizeof(tmp) / sizeof(tmp[0]);
+    memcpy(data->values, tmp, sizeof(tmp));
+    data->generation = 2;
+
+    std::vector<std::string> signal_names = {"ONE", "TWO", "THREE"};
+    ManagerIOSampler gp("/FAKE_PATH", std::move(shmem), signal_names);
+    EXPECT_FALSE(gp.is_update_available());
+    EXPECT_EQ(1.1, gp.sample("ONE"));
+    EXPECT_EQ(3.3, gp.sample("THREE"));
+
+    // update in progress
+    data->generation = 3;
+    data->values[0] = 1.5;
+    EXPECT_FALSE(gp.is_update_available());
+    gp.read_batch();
+    EXPECT_EQ(1.1, gp.sample("ONE"));
+
+    // update complete
+    data->generation = 4;
+    EXPECT_TRUE(gp.is_update_available());
+    gp.read_batch();
+    EXPECT_FALSE(gp.is_update_available());
+    EXPECT_EQ(1.5, gp.sample("ONE"));
+    EXPECT_EQ(2.2, gp.sample("TWO"));
+
+    // the reader never takes the lock
+    (void) pthread_mutex_lock(&data->lock);
+    data->generation = 6;
+    data->values[1] = 2.5;
+    gp.read_batch();
+    EXPECT_EQ(2.5, gp.sample("TWO"));
+    (void) pthread_mutex_unlock(&data->lock);
+}
+
+TEST_F(ManagerIOSamplerTest, parse_shm_old_layout)
+{
+    // Layout used by resource managers built before the generation
+    // was added
+    struct old_shmem_s {
+        pthread_mutex_t lock;
+        uint8_t is_updated;
+        size_t count;
+        double values[(4096 - offsetof(struct geopm::geopm_manager_shmem_header, values)) / sizeof(double)];
+    };
+    static_assert(sizeof(struct old_shmem_s) == sizeof(struct geopm_manager_shmem_s),
+                  "Size of the shared memory region changed");
+    EXPECT_EQ(offsetof(struct old_shmem_s, count), offsetof(struct geopm_manager_shmem_s, count));
+    EXPECT_EQ(offsetof(struct old_shmem_s, values), offsetof(struct geopm_manager_shmem_s, values));
+
+    size_t shmem_size = sizeof(struct geopm_manager_shmem_s);
+    std::unique_ptr<MockSharedMemoryUser> shmem(new MockSharedMemoryUser(shmem_size));
+    struct old_shmem_s *old_data = (struct old_shmem_s *) shmem->pointer();
+    struct geopm_manager_shmem_s *data = (struct geopm_manager_shmem_s *) shmem->pointer();
+
+    ManagerIO::setup_mutex(old_data->lock);
+    old_data->is_updated = true;
+    double tmp[] = { 1.1, 2.2, 3.3 };
+    old_data->count = sizeof(tmp) / sizeof(tmp[0]);
+    memcpy(old_data->values, tmp, sizeof(tmp));
+
+    std::vector<std::string> signal_names = {"ONE", "TWO", "THREE"};
+    ManagerIOSampler gp("/FAKE_PATH", std::move(shmem), signal_names);
+    EXPECT_EQ(0u, data->generation);
+    EXPECT_EQ(1.1, gp.sample("ONE"));
+    EXPECT_EQ(3.3, gp.sample("THREE"));
+    // the locked read consumed the update
+    EXPECT_EQ(0, old_data->is_updated);
+    EXPECT_FALSE(gp.is_update_available());
+
+    // next update by the old writer is seen through is_updated
+    (void) pthread_mutex_lock(&old_data->lock);
+    old_data->values[1] = 2.5;
+    old_data->is_updated = true;
+    (void) pthread_mutex_unlock(&old_data->lock);
+    EXPECT_TRUE(gp.is_update_available());
+    gp.read_batch();
+    EXPECT_FALSE(gp.is_update_available());
+    EXPECT_EQ(2.5, gp.sample("TWO"));
+}
+
+TEST_F(ManagerIOSamplerTest, negative_parse_shm_seqlock)
+{
+    size_t shmem_size = sizeof(struct geopm_manager_shmem_s);
+    std::unique_ptr<MockSharedMemoryUser> shmem(new MockSharedMemoryUser(shmem_size));
+    struct geopm_manager_shmem_s *data = (struct geopm_manager_shmem_s *) shmem->pointer();
+
+    // writer never completed its update
+    ManagerIO::setup_mutex(data->lock);
+    data->count = 1;
+    data->generation = 1;
+    GEOPM_EXPECT_THROW_MESSAGE(new ManagerIOSampler("/FAKE_PATH", std::move(shmem), {"ONE"}),
+                               GEOPM_ERROR_RUNTIME, "unable to read a consistent copy");
+}
+
 TEST_F(ManagerIOSamplerTest, negative_parse_shm)
 {
     size_t shmem_size = sizeof(struct geopm_manager_shmem_s);
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "MatrixReduce.hpp"
+#include "PlatformIO.hpp"
+#include "Exception.hpp"
+#include "geopm_test.hpp"
+
+using geopm::MatrixReduce;
+using geopm::MatrixView;
+using geopm::IPlatformIO;
+
+class MatrixReduceTest : public ::testing::Test
+{
+    protected:
+        void check(MatrixView<const double> matrix);
+        MatrixReduce m_reduce;
+};
+
+void MatrixReduceTest::check(MatrixView<const double> matrix)
+{
+    m_reduce.reduce(matrix);
+    EXPECT_EQ(matrix.num_row(), m_reduce.num_row());
+    EXPECT_EQ(matrix.num_col(), m_reduce.num_col());
+    for (size_t col_idx = 0; col_idx < matrix.num_col(); ++col_idx) {
+        std::vector<double> column(matrix.num_row());
+        for (size_t row_idx = 0; row_idx < matrix.num_row(); ++row_idx) {
+            column[row_idx] = matrix(row_idx, col_idx);
+        }
+        EXPECT_NEAR(IPlatformIO::agg_sum(column), m_reduce.sum(col_idx), 1e-9);
+        EXPECT_NEAR(IPlatformIO::agg_average(column), m_reduce.average(col_idx), 1e-9);
+        EXPECT_DOUBLE_EQ(IPlatformIO::agg_median(column), m_reduce.median(col_idx));
+        EXPECT_DOUBLE_EQ(IPlatformIO::agg_min(column), m_reduce.min(col_idx));
+        EXPECT_DOUBLE_EQ(IPlatformIO::agg_max(column), m_reduce.max(col_idx));
+        EXPECT_NEAR(IPlatformIO::agg_stddev(column), m_reduce.stddev(col_idx), 1e-6);
+        EXPECT_EQ(IPlatformIO::agg_and(column), m_reduce.logical_and(col_idx));
+        EXPECT_EQ(IPlatformIO::agg_or(column), m_reduce.logical_or(col_idx));
+    }
+}
+
+TEST_F(MatrixReduceTest, agg_equivalence)
+{
+    const size_t num_col = 3;
+    for (size_t num_row : {1, 2, 7, 8, 9, 16, 31, 64}) {
+        std::vector<double> data(num_row * num_col);
+        for (size_t row_idx = 0; row_idx < num_row; ++row_idx) {
+            data[row_idx * num_col] = 100.0 + std::sin(row_idx) * 50.0;
+            data[row_idx * num_col + 1] = (double)((row_idx * 7) % 5);
+            data[row_idx * num_col + 2] = row_idx % 3 ? 1.0 : 0.0;
+        }
+        check(MatrixView<const double>(data.data(), num_row, num_col));
+    }
+}
+
+TEST_F(MatrixReduceTest, strided)
+{
+    // Only the first two of every three columns are part of the view
+    std::vector<double> data {1.0, 0.0, -99.0,
+                              5.0, 1.0, -99.0,
+                              3.0, 1.0, -99.0,
+                              2.0, 1.0, -99.0};
+    MatrixView<const double> matrix(data.data(), 4, 2, 3);
+    check(matrix);
+    EXPECT_EQ(11.0, m_reduce.sum(0));
+    EXPECT_EQ(2.5, m_reduce.median(0));
+    EXPECT_EQ(0.0, m_reduce.logical_and(1));
+    EXPECT_EQ(1.0, m_reduce.logical_or(1));
+
+    std::vector<double> result;
+    m_reduce.reduce(matrix, {MatrixReduce::M_REDUCE_MAX, MatrixReduce::M_REDUCE_SUM}, result);
+    EXPECT_EQ(std::vector<double>({5.0, 3.0}), result);
+}
+
+TEST_F(MatrixReduceTest, empty)
+{
+    m_reduce.reduce(MatrixView<const double>(nullptr, 0, 2));
+    for (int reduce_type = 0; reduce_type < MatrixReduce::M_NUM_REDUCE; ++reduce_type) {
+        EXPECT_TRUE(std::isnan(m_reduce.value(reduce_type, 0)));
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(m_reduce.value(MatrixReduce::M_NUM_REDUCE, 0),
+                               GEOPM_ERROR_INVALID, "invalid aggregation type");
+    std::vector<double> result;
+    GEOPM_EXPECT_THROW_MESSAGE(m_reduce.reduce(MatrixView<const double>(nullptr, 0, 2),
+                                               {MatrixReduce::M_REDUCE_SUM}, result),
+                               GEOPM_ERROR_INVALID, "number of aggregation types");
+}
@@ -63,6 +63,8 @@ class MockAgent : public geopm::Agent
                            std::vector<std::string>(void));
         MOCK_METHOD1(trace_values,
                      void(std::vector<double> &values));
+        MOCK_METHOD1(update_region_info,
+                     void(const std::list<geopm_region_info_s> &region_info));
 };
 
 #endif
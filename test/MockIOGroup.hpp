@@ -66,6 +66,10 @@ class MockIOGroup : public geopm::IOGroup
                      double (const std::string &signal_name, int domain_type, int domain_idx));
         MOCK_METHOD4(write_control,
                      void (const std::string &control_name, int domain_type, int domain_idx, double setting));
+        MOCK_METHOD2(read_signal_batch,
+                     void (const std::vector<geopm::IPlatformIO::m_request_s> &request, std::vector<double> &result));
+        MOCK_METHOD2(write_control_batch,
+                     void (const std::vector<geopm::IPlatformIO::m_request_s> &request, const std::vector<double> &setting));
         MOCK_METHOD0(save_control,
                      void(void));
         MOCK_METHOD0(restore_control,
@@ -56,6 +56,8 @@ class MockPlatformIO : public geopm::IPlatformIO
                          const std::vector<int> &sub_signal_idx));
         MOCK_METHOD3(push_region_signal_total,
                      void(int signal_idx, int domain_type, int domain_idx));
+        MOCK_METHOD3(push_region_signal_histogram,
+                     void(int signal_idx, int domain_type, int domain_idx));
         MOCK_METHOD3(push_control,
                      int(const std::string &control_name, int domain_type, int domain_idx));
         MOCK_CONST_METHOD0(num_signal,
@@ -66,6 +68,8 @@ class MockPlatformIO : public geopm::IPlatformIO
                      double(int signal_idx));
         MOCK_METHOD2(sample_region_total,
                      double(int signal_idx, uint64_t region_id));
+        MOCK_METHOD3(sample_region_percentile,
+                     double(int signal_idx, uint64_t region_id, double percentile));
         MOCK_METHOD2(adjust,
                      void(int control_idx, double setting));
         MOCK_METHOD0(read_batch,
@@ -76,6 +80,10 @@ class MockPlatformIO : public geopm::IPlatformIO
                      double(const std::string &signal_name, int domain_type, int domain_idx));
         MOCK_METHOD4(write_control,
                      void(const std::string &control_name, int domain_type, int domain_idx, double setting));
+        MOCK_METHOD2(read_signal_batch,
+                     void(const std::vector<m_request_s> &request, std::vector<double> &result));
+        MOCK_METHOD2(write_control_batch,
+                     void(const std::vector<m_request_s> &request, const std::vector<double> &setting));
         MOCK_METHOD0(save_control,
                      void(void));
         MOCK_METHOD0(restore_control,
@@ -33,6 +33,8 @@
 #ifndef MOCKPLATFORMTOPO_HPP_INCLUDE
 #define MOCKPLATFORMTOPO_HPP_INCLUDE
 
+#include <map>
+
 #include "PlatformTopo.hpp"
 
 class MockPlatformTopo : public geopm::IPlatformTopo
@@ -48,6 +50,29 @@ class MockPlatformTopo : public geopm::IPlatformTopo
                      int(const std::vector<int> &cpu_domain_idx));
         MOCK_CONST_METHOD2(is_domain_within,
                            bool(int inner_domain, int outer_domain));
+        /// The list accessors are answered through the mocked
+        /// domain_cpus() and domain_idx() so that tests only need
+        /// to set expectations on those.
+        const std::vector<int> &domain_cpu_list(int domain_type, int domain_idx) const override
+        {
+            std::set<int> cpu_idx;
+            domain_cpus(domain_type, domain_idx, cpu_idx);
+            std::vector<int> &result = m_domain_cpu_list[std::make_pair(domain_type, domain_idx)];
+            result.assign(cpu_idx.begin(), cpu_idx.end());
+            return result;
+        }
+        const std::vector<int> &cpu_domain_idx(int domain_type) const override
+        {
+            std::vector<int> &result = m_cpu_domain_idx[domain_type];
+            result.resize(num_domain(geopm::IPlatformTopo::M_DOMAIN_CPU));
+            for (int cpu_idx = 0; cpu_idx < (int)result.size(); ++cpu_idx) {
+                result[cpu_idx] = domain_idx(domain_type, cpu_idx);
+            }
+            return result;
+        }
+    private:
+        mutable std::map<std::pair<int, int>, std::vector<int> > m_domain_cpu_list;
+        mutable std::map<int, std::vector<int> > m_cpu_domain_idx;
 };
 
 #endif
@@ -82,6 +82,35 @@ class MockTreeComm : public geopm::ITreeComm
             }
             return true;
         }
+        void send_down_view(int level, geopm::MatrixView<const double> policy) override
+        {
+            ++m_num_send;
+            if (policy.num_row() == 0) {
+                throw std::runtime_error("MockTreeComm::send_down_view(): policy matrix was wrong size");
+            }
+            m_data_sent_down[level].assign(policy.row(0), policy.row(0) + policy.num_col());
+        }
+        bool receive_up_view(int level, geopm::MatrixView<double> sample) override
+        {
+            if (m_data_sent_up.find(level) == m_data_sent_up.end()) {
+                return false;
+            }
+            ++m_num_recv;
+            for (int child_idx = 0; child_idx != (int)sample.num_row(); ++child_idx) {
+                std::vector<double> vec;
+                if (m_data_sent_up_child.find({level, child_idx}) != m_data_sent_up_child.end()) {
+                    vec = m_data_sent_up_child.at({level, child_idx});
+                }
+                else {
+                    vec = m_data_sent_up.at(level);
+                }
+                if (vec.size() < sample.num_col()) {
+                    throw std::runtime_error("MockTreeComm::receive_up_view(): sample matrix was wrong size");
+                }
+                std::copy(vec.begin(), vec.begin() + sample.num_col(), sample.row(child_idx));
+            }
+            return true;
+        }
         bool receive_down(int level, std::vector<double> &policy) override
         {
             if (m_data_sent_down.find(level) == m_data_sent_down.end()) {
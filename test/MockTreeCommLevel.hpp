@@ -52,6 +52,10 @@ class MockTreeCommLevel : public geopm::ITreeCommLevel {
                      bool(std::vector<std::vector<double> > &sample));
         MOCK_METHOD1(receive_down,
                      bool(std::vector<double> &policy));
+        MOCK_METHOD1(send_down_view,
+                     void(geopm::MatrixView<const double> policy));
+        MOCK_METHOD1(receive_up_view,
+                     bool(geopm::MatrixView<double> sample));
         MOCK_CONST_METHOD0(overhead_send,
                      size_t(void));
 };
@@ -132,3 +132,22 @@ TEST_F(MonitorAgentTest, ascend_aggregates_signals)
 
     EXPECT_EQ(expected, result);
 }
+
+TEST_F(MonitorAgentTest, ascend_view_adapter)
+{
+    // Row stride of three skips a header value in front of each row
+    std::vector<double> input = {
+        1, 3, 8,
+        1, 4, 9,
+        1, 5, 10
+    };
+    geopm::MatrixView<const double> input_view(input.data() + 1, 3, 2, 3);
+    std::vector<double> expected = {
+        12,  // sum
+        9,   // average
+    };
+    std::vector<double> result(expected.size());
+    m_agent->ascend_view(input_view, result);
+
+    EXPECT_EQ(expected, result);
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "PerfEventIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "MockPlatformTopo.hpp"
+#include "geopm_env.h"
+#include "geopm_sched.h"
+#include "geopm_test.hpp"
+
+extern "C"
+{
+    void geopm_env_load(void);
+}
+
+using geopm::PerfEventIOGroup;
+using geopm::IPlatformTopo;
+using testing::Return;
+using testing::_;
+
+class PerfEventIOGroupTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void spin(void);
+        const std::string m_task_clock = "PERF_EVENT::TASK_CLOCK";
+        int m_num_cpu;
+        MockPlatformTopo m_topo;
+        std::unique_ptr<PerfEventIOGroup> m_group;
+};
+
+void PerfEventIOGroupTest::SetUp()
+{
+    m_num_cpu = geopm_sched_num_cpu();
+    ON_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_CPU))
+        .WillByDefault(Return(m_num_cpu));
+    EXPECT_CALL(m_topo, num_domain(_)).Times(testing::AnyNumber());
+    try {
+        // Count only this process so that unprivileged users can
+        // open the software events.
+        m_group = geopm::make_unique<PerfEventIOGroup>(m_topo, 0);
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Warning: perf_event_open() is not available, skipping test: "
+                  << ex.what() << std::endl;
+    }
+}
+
+void PerfEventIOGroupTest::spin(void)
+{
+    volatile double sum = 0.0;
+    for (int idx = 0; idx < 10000000; ++idx) {
+        sum += idx;
+    }
+}
+
+TEST_F(PerfEventIOGroupTest, valid_signals)
+{
+    if (!m_group) {
+        return;
+    }
+    EXPECT_TRUE(m_group->is_valid_signal(m_task_clock));
+    EXPECT_FALSE(m_group->is_valid_signal("INVALID"));
+    EXPECT_FALSE(m_group->is_valid_control(m_task_clock));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_CPU, m_group->signal_domain_type(m_task_clock));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_INVALID, m_group->signal_domain_type("INVALID"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_INVALID, m_group->control_domain_type(m_task_clock));
+
+    // all provided signals are valid
+    EXPECT_NE(0u, m_group->signal_names().size());
+    for (const auto &sig : m_group->signal_names()) {
+        EXPECT_TRUE(m_group->is_valid_signal(sig));
+        EXPECT_EQ(0u, sig.find("PERF_EVENT::"));
+    }
+    EXPECT_EQ(0u, m_group->control_names().size());
+}
+
+TEST_F(PerfEventIOGroupTest, push)
+{
+    if (!m_group) {
+        return;
+    }
+    int idx1 = m_group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, 0);
+    int idx2 = m_group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, 0);
+    EXPECT_EQ(idx1, idx2);
+    GEOPM_EXPECT_THROW_MESSAGE(m_group->push_signal("INVALID", IPlatformTopo::M_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "not valid for PerfEventIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "domain_type must be M_DOMAIN_CPU");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, m_num_cpu),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+    EXPECT_THROW(m_group->push_control(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, 0), geopm::Exception);
+}
+
+TEST_F(PerfEventIOGroupTest, sample)
+{
+    if (!m_group) {
+        return;
+    }
+    std::vector<int> task_clock_idx;
+    std::vector<int> switch_idx;
+    bool is_switch_valid = m_group->is_valid_signal("PERF_EVENT::CONTEXT_SWITCHES");
+    for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+        task_clock_idx.push_back(m_group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, cpu_idx));
+        if (is_switch_valid) {
+            switch_idx.push_back(m_group->push_signal("PERF_EVENT::CONTEXT_SWITCHES",
+                                                      IPlatformTopo::M_DOMAIN_CPU, cpu_idx));
+        }
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(m_group->sample(task_clock_idx[0]),
+                               GEOPM_ERROR_INVALID, "signal has not been read");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group->sample(-1),
+                               GEOPM_ERROR_INVALID, "batch_idx out of range");
+    m_group->read_batch();
+    double begin = 0.0;
+    for (int idx : task_clock_idx) {
+        begin += m_group->sample(idx);
+    }
+    spin();
+    m_group->read_batch();
+    double end = 0.0;
+    for (int idx : task_clock_idx) {
+        end += m_group->sample(idx);
+    }
+    // Task clock is reported in seconds
+    EXPECT_LT(begin, end);
+    EXPECT_LT(end - begin, 60.0);
+    for (int idx : switch_idx) {
+        EXPECT_LE(0.0, m_group->sample(idx));
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(m_group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "cannot push signal after call to read_batch()");
+}
+
+TEST_F(PerfEventIOGroupTest, read_signal)
+{
+    if (!m_group) {
+        return;
+    }
+    double begin = 0.0;
+    for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+        begin += m_group->read_signal(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, cpu_idx);
+    }
+    spin();
+    double end = 0.0;
+    for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+        end += m_group->read_signal(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, cpu_idx);
+    }
+    EXPECT_LT(begin, end);
+    GEOPM_EXPECT_THROW_MESSAGE(m_group->read_signal("INVALID", IPlatformTopo::M_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "not valid for PerfEventIOGroup");
+    EXPECT_THROW(m_group->write_control(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, 0, 0.0),
+                 geopm::Exception);
+}
+
+TEST_F(PerfEventIOGroupTest, task)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(PerfEventIOGroup(m_topo, std::vector<int>{}),
+                               GEOPM_ERROR_INVALID, "no process to count");
+    std::unique_ptr<PerfEventIOGroup> group;
+    try {
+        group = geopm::make_unique<PerfEventIOGroup>(m_topo, std::vector<int>{getpid()});
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Warning: perf_event_open() is not available, skipping test: "
+                  << ex.what() << std::endl;
+        return;
+    }
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_BOARD, group->signal_domain_type(m_task_clock));
+    GEOPM_EXPECT_THROW_MESSAGE(group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "domain_type must be M_DOMAIN_BOARD");
+    GEOPM_EXPECT_THROW_MESSAGE(group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_BOARD, 1),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+    int idx = group->push_signal(m_task_clock, IPlatformTopo::M_DOMAIN_BOARD, 0);
+    group->read_batch();
+    double begin = group->sample(idx);
+    double read_begin = group->read_signal(m_task_clock, IPlatformTopo::M_DOMAIN_BOARD, 0);
+    spin();
+    group->read_batch();
+    double end = group->sample(idx);
+    double read_end = group->read_signal(m_task_clock, IPlatformTopo::M_DOMAIN_BOARD, 0);
+    // Every thread of this process is counted on any CPU
+    EXPECT_LT(begin, end);
+    EXPECT_LT(end - begin, 60.0);
+    EXPECT_LT(read_begin, read_end);
+}
+
+TEST_F(PerfEventIOGroupTest, task_env)
+{
+    setenv("GEOPM_PERF_EVENT_PID", "not-a-pid", 1);
+    geopm_env_load();
+    GEOPM_EXPECT_THROW_MESSAGE(PerfEventIOGroup(), GEOPM_ERROR_INVALID,
+                               "invalid process id in GEOPM_PERF_EVENT_PID");
+    setenv("GEOPM_PERF_EVENT_PID", std::to_string(getpid()).c_str(), 1);
+    geopm_env_load();
+    std::unique_ptr<PerfEventIOGroup> group;
+    try {
+        group = geopm::make_unique<PerfEventIOGroup>();
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Warning: perf_event_open() is not available, skipping test: "
+                  << ex.what() << std::endl;
+    }
+    unsetenv("GEOPM_PERF_EVENT_PID");
+    geopm_env_load();
+    if (group) {
+        EXPECT_EQ(IPlatformTopo::M_DOMAIN_BOARD, group->signal_domain_type(m_task_clock));
+    }
+}
+
+TEST_F(PerfEventIOGroupTest, plugin)
+{
+    EXPECT_EQ("PERF_EVENT", PerfEventIOGroup::plugin_name());
+}
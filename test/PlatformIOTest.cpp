@@ -57,6 +57,7 @@ using geopm::IPlatformTopo;
 using ::testing::_;
 using ::testing::Return;
 using ::testing::SetArgReferee;
+using ::testing::SizeIs;
 
 class PlatformIOTestMockIOGroup : public MockIOGroup
 {
@@ -471,6 +472,79 @@ TEST_F(PlatformIOTest, sample_region_total)
     }
 }
 
+TEST_F(PlatformIOTest, sample_region_percentile)
+{
+    for (auto &it : m_iogroup_ptr) {
+        EXPECT_CALL(*it, push_signal(_, _, _)).Times(testing::AnyNumber());
+        EXPECT_CALL(*it, signal_domain_type(_)).Times(testing::AnyNumber());
+        EXPECT_CALL(*it, read_batch()).Times(testing::AnyNumber());
+    }
+    EXPECT_CALL(m_topo, is_domain_within(_, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(m_topo, domain_cpus(_, _, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(m_topo, domain_idx(_, _)).Times(testing::AnyNumber());
+
+    int time_idx = m_platio->push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    m_platio->push_region_signal_histogram(time_idx, IPlatformTopo::M_DOMAIN_BOARD, 0);
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->push_region_signal_histogram(time_idx + 10, IPlatformTopo::M_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "signal_idx out of range");
+
+    // Before the application connects the region is NAN and the
+    // sample is not recorded
+    for (auto &it : m_iogroup_ptr) {
+        if (it->is_valid_signal("TIME")) {
+            EXPECT_CALL(*it, sample(0))
+                .WillRepeatedly(Return(0.5));
+        }
+        if (it->is_valid_signal("REGION_ID#")) {
+            EXPECT_CALL(*it, sample(0))
+                .WillRepeatedly(Return(NAN));
+        }
+    }
+    m_platio->read_batch();
+
+    uint64_t rid1 = 0x444;
+    uint64_t rid2 = 0x555;
+    // rid 1 samples 1 to 10, then rid 2 samples 100 to 105, then
+    // rid 1 again samples 11 to 20
+    std::vector<std::pair<uint64_t, double> > batch;
+    for (int val = 1; val <= 10; ++val) {
+        batch.emplace_back(rid1, val);
+    }
+    for (int val = 100; val <= 105; ++val) {
+        batch.emplace_back(rid2, val);
+    }
+    for (int val = 11; val <= 20; ++val) {
+        batch.emplace_back(rid1, val);
+    }
+    for (const auto &sample : batch) {
+        for (auto &it : m_iogroup_ptr) {
+            if (it->is_valid_signal("TIME")) {
+                EXPECT_CALL(*it, sample(0))
+                    .WillRepeatedly(Return(sample.second));
+            }
+            if (it->is_valid_signal("REGION_ID#")) {
+                EXPECT_CALL(*it, sample(0))
+                    .WillRepeatedly(Return(geopm_field_to_signal(sample.first)));
+            }
+        }
+        m_platio->read_batch();
+    }
+    // Estimates are within the bucket width relative to the value
+    EXPECT_NEAR(10.0, m_platio->sample_region_percentile(time_idx, rid1, 50.0), 10.0 / 16);
+    EXPECT_NEAR(19.0, m_platio->sample_region_percentile(time_idx, rid1, 95.0), 19.0 / 16);
+    EXPECT_EQ(1.0, m_platio->sample_region_percentile(time_idx, rid1, 0.0));
+    EXPECT_EQ(20.0, m_platio->sample_region_percentile(time_idx, rid1, 100.0));
+    EXPECT_NEAR(102.0, m_platio->sample_region_percentile(time_idx, rid2, 50.0), 102.0 / 16);
+    EXPECT_EQ(105.0, m_platio->sample_region_percentile(time_idx, rid2, 100.0));
+    EXPECT_TRUE(std::isnan(m_platio->sample_region_percentile(time_idx, 0x666, 50.0)));
+    uint64_t nan_rid = geopm_region_id_unset_hint(GEOPM_MASK_REGION_HINT, geopm_signal_to_field(NAN));
+    EXPECT_TRUE(std::isnan(m_platio->sample_region_percentile(time_idx, nan_rid, 50.0)));
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample_region_percentile(time_idx, rid1, 101.0),
+                               GEOPM_ERROR_INVALID, "percentile must be between 0 and 100");
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample_region_percentile(time_idx + 1, rid1, 50.0),
+                               GEOPM_ERROR_INVALID, "not passed to push_region_signal_histogram");
+}
+
 TEST_F(PlatformIOTest, adjust)
 {
     for (auto &it : m_iogroup_ptr) {
@@ -520,6 +594,68 @@ TEST_F(PlatformIOTest, write_control)
                                GEOPM_ERROR_INVALID, "control name \"INVALID\" not found");
 }
 
+TEST_F(PlatformIOTest, read_signal_batch)
+{
+    std::vector<IPlatformIO::m_request_s> request {
+        {"FREQ", IPlatformTopo::M_DOMAIN_CPU, 0},
+        {"TIME", IPlatformTopo::M_DOMAIN_BOARD, 0},
+        {"FREQ", IPlatformTopo::M_DOMAIN_CPU, 1},
+        {"MODE", IPlatformTopo::M_DOMAIN_BOARD, 0}};
+    // Each IOGroup is called once with all of its requests
+    auto time_group = m_iogroup_ptr.front();
+    auto mode_group = m_iogroup_ptr.back();
+    auto freq_group = *std::next(m_iogroup_ptr.rbegin());
+    for (auto &it : m_iogroup_ptr) {
+        EXPECT_CALL(*it, read_signal(_, _, _)).Times(0);
+        EXPECT_CALL(*it, read_batch()).Times(0);
+        if (it != time_group && it != mode_group && it != freq_group) {
+            EXPECT_CALL(*it, read_signal_batch(_, _)).Times(0);
+        }
+    }
+    EXPECT_CALL(*freq_group, read_signal_batch(SizeIs(2), _))
+        .WillOnce(SetArgReferee<1>(std::vector<double> {4e9, 3e9}));
+    EXPECT_CALL(*time_group, read_signal_batch(SizeIs(1), _))
+        .WillOnce(SetArgReferee<1>(std::vector<double> {2.0}));
+    EXPECT_CALL(*mode_group, read_signal_batch(SizeIs(1), _))
+        .WillOnce(SetArgReferee<1>(std::vector<double> {5.0}));
+    std::vector<double> result;
+    m_platio->read_signal_batch(request, result);
+    std::vector<double> expected {4e9, 2.0, 3e9, 5.0};
+    EXPECT_EQ(expected, result);
+
+    request.push_back({"INVALID", IPlatformTopo::M_DOMAIN_CPU, 0});
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->read_signal_batch(request, result),
+                               GEOPM_ERROR_INVALID, "signal name \"INVALID\" not found");
+}
+
+TEST_F(PlatformIOTest, write_control_batch)
+{
+    std::vector<IPlatformIO::m_request_s> request {
+        {"FREQ", IPlatformTopo::M_DOMAIN_CPU, 0},
+        {"MODE", IPlatformTopo::M_DOMAIN_BOARD, 0},
+        {"FREQ", IPlatformTopo::M_DOMAIN_CPU, 1}};
+    auto mode_group = m_iogroup_ptr.back();
+    auto freq_group = *std::next(m_iogroup_ptr.rbegin());
+    for (auto &it : m_iogroup_ptr) {
+        EXPECT_CALL(*it, write_control(_, _, _, _)).Times(0);
+        EXPECT_CALL(*it, write_batch()).Times(0);
+        if (it != mode_group && it != freq_group) {
+            EXPECT_CALL(*it, write_control_batch(_, _)).Times(0);
+        }
+    }
+    std::vector<double> freq_setting {3e9, 2e9};
+    std::vector<double> mode_setting {1.0};
+    EXPECT_CALL(*freq_group, write_control_batch(SizeIs(2), freq_setting));
+    EXPECT_CALL(*mode_group, write_control_batch(SizeIs(1), mode_setting));
+    m_platio->write_control_batch(request, {3e9, 1.0, 2e9});
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->write_control_batch(request, {3e9}),
+                               GEOPM_ERROR_INVALID, "number of settings does not match");
+    request.push_back({"INVALID", IPlatformTopo::M_DOMAIN_CPU, 0});
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->write_control_batch(request, {3e9, 1.0, 2e9, 0.0}),
+                               GEOPM_ERROR_INVALID, "control name \"INVALID\" not found");
+}
+
 TEST_F(PlatformIOTest, read_signal_override)
 {
     for (auto &it : m_iogroup_ptr) {
@@ -31,11 +31,14 @@
  */
 
 #include <unistd.h>
+#include <sys/stat.h>
 #include <fstream>
+#include <vector>
 #include "gtest/gtest.h"
 
 #include "PlatformTopo.hpp"
 #include "Exception.hpp"
+#include "geopm_test.hpp"
 
 using geopm::IPlatformTopo;
 using geopm::PlatformTopo;
@@ -47,12 +50,20 @@ class PlatformTopoTest : public :: testing :: Test
         void SetUp();
         void TearDown();
         void write_lscpu(const std::string &lscpu_str);
+        /// Create a sysfs tree with two packages of two cores with
+        /// two hyper-threads each and two NUMA nodes.
+        void write_sysfs(void);
+        void write_sysfs_file(const std::string &path, const std::string &value);
         std::string m_lscpu_file_name;
         std::string m_hsw_lscpu_str;
         std::string m_knl_lscpu_str;
         std::string m_bdx_lscpu_str;
         std::string m_ppc_lscpu_str;
         bool m_do_unlink;
+        std::string m_sysfs_path;
+        std::string m_snapshot_path;
+        std::vector<std::string> m_sysfs_dir;
+        std::vector<std::string> m_sysfs_file;
 };
 
 void PlatformTopoTest::SetUp()
@@ -154,6 +165,8 @@ void PlatformTopoTest::SetUp()
         "NUMA node0 CPU(s):     0x1010101010101010101\n"
         "NUMA node1 CPU(s):     0x101010101010101010100000000000000000000\n";
     m_do_unlink = false;
+    m_sysfs_path = "PlatformTopoTest-sysfs";
+    m_snapshot_path = "PlatformTopoTest-snapshot";
 }
 
 void PlatformTopoTest::TearDown()
@@ -161,6 +174,13 @@ void PlatformTopoTest::TearDown()
     if (m_do_unlink) {
         unlink(m_lscpu_file_name.c_str());
     }
+    for (const auto &path : m_sysfs_file) {
+        unlink(path.c_str());
+    }
+    for (auto it = m_sysfs_dir.rbegin(); it != m_sysfs_dir.rend(); ++it) {
+        rmdir(it->c_str());
+    }
+    unlink(m_snapshot_path.c_str());
 }
 
 void PlatformTopoTest::write_lscpu(const std::string &lscpu_str)
@@ -171,6 +191,37 @@ void PlatformTopoTest::write_lscpu(const std::string &lscpu_str)
     m_do_unlink = true;
 }
 
+void PlatformTopoTest::write_sysfs_file(const std::string &path, const std::string &value)
+{
+    std::string dir;
+    size_t pos = 0;
+    while ((pos = path.find('/', pos + 1)) != std::string::npos) {
+        dir = path.substr(0, pos);
+        if (!mkdir(dir.c_str(), 0755)) {
+            m_sysfs_dir.push_back(dir);
+        }
+    }
+    std::ofstream sysfs_fid(path);
+    sysfs_fid << value << "\n";
+    sysfs_fid.close();
+    m_sysfs_file.push_back(path);
+}
+
+void PlatformTopoTest::write_sysfs(void)
+{
+    // Core IDs are sparse as on many servers
+    const int core_id[4] = {0, 4, 0, 4};
+    write_sysfs_file(m_sysfs_path + "/cpu/online", "0-7");
+    for (int cpu_idx = 0; cpu_idx < 8; ++cpu_idx) {
+        std::string topo_path = m_sysfs_path + "/cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+        write_sysfs_file(topo_path + "physical_package_id", std::to_string((cpu_idx % 4) / 2));
+        write_sysfs_file(topo_path + "core_id", std::to_string(core_id[cpu_idx % 4]));
+    }
+    write_sysfs_file(m_sysfs_path + "/node/online", "0-1");
+    write_sysfs_file(m_sysfs_path + "/node/node0/cpulist", "0-1,4-5");
+    write_sysfs_file(m_sysfs_path + "/node/node1/cpulist", "2-3,6-7");
+}
+
 TEST_F(PlatformTopoTest, hsw_num_domain)
 {
     write_lscpu(m_hsw_lscpu_str);
@@ -448,6 +499,166 @@ TEST_F(PlatformTopoTest, parse_error)
     EXPECT_THROW(PlatformTopo topo(m_lscpu_file_name), Exception);
 }
 
+TEST_F(PlatformTopoTest, sysfs_domain)
+{
+    write_sysfs();
+    PlatformTopo topo(m_sysfs_path, "");
+    EXPECT_EQ(1, topo.num_domain(IPlatformTopo::M_DOMAIN_BOARD));
+    EXPECT_EQ(2, topo.num_domain(IPlatformTopo::M_DOMAIN_PACKAGE));
+    EXPECT_EQ(4, topo.num_domain(IPlatformTopo::M_DOMAIN_CORE));
+    EXPECT_EQ(8, topo.num_domain(IPlatformTopo::M_DOMAIN_CPU));
+    EXPECT_EQ(2, topo.num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY));
+    EXPECT_EQ(0, topo.num_domain(IPlatformTopo::M_DOMAIN_PACKAGE_MEMORY));
+
+    const std::vector<int> expect_package = {0, 0, 1, 1, 0, 0, 1, 1};
+    const std::vector<int> expect_core = {0, 1, 2, 3, 0, 1, 2, 3};
+    for (int cpu_idx = 0; cpu_idx < 8; ++cpu_idx) {
+        EXPECT_EQ(0, topo.domain_idx(IPlatformTopo::M_DOMAIN_BOARD, cpu_idx));
+        EXPECT_EQ(expect_package[cpu_idx], topo.domain_idx(IPlatformTopo::M_DOMAIN_PACKAGE, cpu_idx));
+        EXPECT_EQ(expect_core[cpu_idx], topo.domain_idx(IPlatformTopo::M_DOMAIN_CORE, cpu_idx));
+        EXPECT_EQ(cpu_idx, topo.domain_idx(IPlatformTopo::M_DOMAIN_CPU, cpu_idx));
+        EXPECT_EQ(expect_package[cpu_idx], topo.domain_idx(IPlatformTopo::M_DOMAIN_BOARD_MEMORY, cpu_idx));
+    }
+    EXPECT_THROW(topo.domain_idx(IPlatformTopo::M_DOMAIN_CPU, 8), Exception);
+
+    std::set<int> cpu_set;
+    topo.domain_cpus(IPlatformTopo::M_DOMAIN_BOARD, 0, cpu_set);
+    EXPECT_EQ(std::set<int>({0, 1, 2, 3, 4, 5, 6, 7}), cpu_set);
+    topo.domain_cpus(IPlatformTopo::M_DOMAIN_PACKAGE, 1, cpu_set);
+    EXPECT_EQ(std::set<int>({2, 3, 6, 7}), cpu_set);
+    topo.domain_cpus(IPlatformTopo::M_DOMAIN_CORE, 1, cpu_set);
+    EXPECT_EQ(std::set<int>({1, 5}), cpu_set);
+    topo.domain_cpus(IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 0, cpu_set);
+    EXPECT_EQ(std::set<int>({0, 1, 4, 5}), cpu_set);
+    EXPECT_THROW(topo.domain_cpus(IPlatformTopo::M_DOMAIN_PACKAGE, 2, cpu_set), Exception);
+    EXPECT_THROW(topo.domain_cpus(IPlatformTopo::M_DOMAIN_CORE, -1, cpu_set), Exception);
+}
+
+TEST_F(PlatformTopoTest, domain_list)
+{
+    write_sysfs();
+    PlatformTopo topo(m_sysfs_path, "");
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}),
+              topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_BOARD, 0));
+    EXPECT_EQ(std::vector<int>({2, 3, 6, 7}),
+              topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_PACKAGE, 1));
+    EXPECT_EQ(std::vector<int>({1, 5}),
+              topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_CORE, 1));
+    EXPECT_EQ(std::vector<int>({6}),
+              topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_CPU, 6));
+    EXPECT_EQ(std::vector<int>({2, 3, 6, 7}),
+              topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 1));
+    // Lists are stored, not rebuilt on each call
+    EXPECT_EQ(&topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_CORE, 2),
+              &topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_CORE, 2));
+
+    EXPECT_EQ(std::vector<int>({0, 0, 0, 0, 0, 0, 0, 0}),
+              topo.cpu_domain_idx(IPlatformTopo::M_DOMAIN_BOARD));
+    EXPECT_EQ(std::vector<int>({0, 0, 1, 1, 0, 0, 1, 1}),
+              topo.cpu_domain_idx(IPlatformTopo::M_DOMAIN_PACKAGE));
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 0, 1, 2, 3}),
+              topo.cpu_domain_idx(IPlatformTopo::M_DOMAIN_CORE));
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}),
+              topo.cpu_domain_idx(IPlatformTopo::M_DOMAIN_CPU));
+
+    GEOPM_EXPECT_THROW_MESSAGE(topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_CPU, 8),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(topo.domain_cpu_list(IPlatformTopo::M_DOMAIN_PACKAGE_NIC, 0),
+                               GEOPM_ERROR_NOT_IMPLEMENTED, "support not yet implemented");
+    GEOPM_EXPECT_THROW_MESSAGE(topo.cpu_domain_idx(IPlatformTopo::M_DOMAIN_INVALID),
+                               GEOPM_ERROR_INVALID, "invalid domain specified");
+    GEOPM_EXPECT_THROW_MESSAGE(topo.cpu_domain_idx(IPlatformTopo::M_DOMAIN_PACKAGE_MEMORY),
+                               GEOPM_ERROR_NOT_IMPLEMENTED, "no support yet");
+}
+
+TEST_F(PlatformTopoTest, sysfs_snapshot)
+{
+    write_sysfs();
+    {
+        PlatformTopo topo(m_sysfs_path, m_snapshot_path);
+        EXPECT_EQ(4, topo.num_domain(IPlatformTopo::M_DOMAIN_CORE));
+    }
+    ASSERT_EQ(0, access(m_snapshot_path.c_str(), R_OK));
+    // Later processes only read the online CPUs from sysfs
+    for (int cpu_idx = 0; cpu_idx < 8; ++cpu_idx) {
+        std::string topo_path = m_sysfs_path + "/cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+        unlink((topo_path + "core_id").c_str());
+    }
+    PlatformTopo topo(m_sysfs_path, m_snapshot_path);
+    EXPECT_EQ(2, topo.num_domain(IPlatformTopo::M_DOMAIN_PACKAGE));
+    EXPECT_EQ(8, topo.num_domain(IPlatformTopo::M_DOMAIN_CPU));
+    EXPECT_EQ(3, topo.domain_idx(IPlatformTopo::M_DOMAIN_CORE, 7));
+    EXPECT_EQ(1, topo.domain_idx(IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 6));
+    std::set<int> cpu_set;
+    topo.domain_cpus(IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 1, cpu_set);
+    EXPECT_EQ(std::set<int>({2, 3, 6, 7}), cpu_set);
+    EXPECT_THROW(PlatformTopo(m_sysfs_path, ""), Exception);
+
+    // A change in the online CPUs invalidates the snapshot
+    write_sysfs_file(m_sysfs_path + "/cpu/online", "0-3");
+    EXPECT_THROW(PlatformTopo(m_sysfs_path, m_snapshot_path), Exception);
+}
+
+TEST_F(PlatformTopoTest, sysfs_snapshot_host)
+{
+    write_sysfs();
+    {
+        PlatformTopo topo(m_sysfs_path, m_snapshot_path);
+    }
+    for (int cpu_idx = 0; cpu_idx < 8; ++cpu_idx) {
+        std::string topo_path = m_sysfs_path + "/cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+        unlink((topo_path + "core_id").c_str());
+    }
+    EXPECT_NO_THROW(PlatformTopo(m_sysfs_path, m_snapshot_path));
+    // A snapshot written by another host on a shared file system is
+    // not used: change the host hash that follows the magic, CPU
+    // count and online hash in the header.
+    std::fstream snapshot(m_snapshot_path, std::ios::in | std::ios::out | std::ios::binary);
+    snapshot.seekp(2 * sizeof(uint32_t) + sizeof(uint64_t));
+    uint64_t other_host = 0xdeadbeef;
+    snapshot.write((const char *)&other_host, sizeof(other_host));
+    snapshot.close();
+    EXPECT_THROW(PlatformTopo(m_sysfs_path, m_snapshot_path), Exception);
+}
+
+TEST_F(PlatformTopoTest, sysfs_snapshot_range)
+{
+    write_sysfs();
+    {
+        PlatformTopo topo(m_sysfs_path, m_snapshot_path);
+    }
+    // Set the core of the last CPU out of range; it is followed by
+    // the three NUMA offsets and the eight NUMA CPUs.
+    std::fstream snapshot(m_snapshot_path, std::ios::in | std::ios::out | std::ios::binary);
+    snapshot.seekp(-12 * (int)sizeof(int32_t), std::ios::end);
+    int32_t bad_core = 1000;
+    snapshot.write((const char *)&bad_core, sizeof(bad_core));
+    snapshot.close();
+    // The snapshot is ignored and rewritten from sysfs
+    {
+        PlatformTopo topo(m_sysfs_path, m_snapshot_path);
+        EXPECT_EQ(3, topo.domain_idx(IPlatformTopo::M_DOMAIN_CORE, 7));
+    }
+    for (int cpu_idx = 0; cpu_idx < 8; ++cpu_idx) {
+        std::string topo_path = m_sysfs_path + "/cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+        unlink((topo_path + "core_id").c_str());
+    }
+    PlatformTopo topo(m_sysfs_path, m_snapshot_path);
+    EXPECT_EQ(3, topo.domain_idx(IPlatformTopo::M_DOMAIN_CORE, 7));
+}
+
+TEST_F(PlatformTopoTest, sysfs_error)
+{
+    write_sysfs();
+    write_sysfs_file(m_sysfs_path + "/cpu/online", "0-5");
+    EXPECT_THROW(PlatformTopo(m_sysfs_path, ""), Exception);
+    write_sysfs_file(m_sysfs_path + "/cpu/online", "0-3,5-7");
+    EXPECT_THROW(PlatformTopo(m_sysfs_path, ""), Exception);
+    write_sysfs_file(m_sysfs_path + "/cpu/online", "0-x");
+    EXPECT_THROW(PlatformTopo(m_sysfs_path, ""), Exception);
+    EXPECT_THROW(PlatformTopo(m_sysfs_path + "-missing", ""), Exception);
+}
+
 TEST_F(PlatformTopoTest, domain_type_to_name)
 {
     EXPECT_THROW(IPlatformTopo::domain_type_to_name(IPlatformTopo::M_DOMAIN_INVALID),
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "PowercapIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "MockPlatformTopo.hpp"
+#include "geopm_test.hpp"
+
+using geopm::PowercapIOGroup;
+using geopm::IPlatformTopo;
+using testing::Return;
+using testing::_;
+
+class PowercapIOGroupTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        void write_file(const std::string &path, const std::string &value);
+        std::string read_file(const std::string &path);
+        void write_zone(const std::string &zone, const std::string &name);
+        const std::string m_powercap_path = "PowercapIOGroupTest-powercap";
+        const std::string m_max_range = "262143328850";
+        std::vector<std::string> m_file;
+        std::vector<std::string> m_dir;
+        MockPlatformTopo m_topo;
+};
+
+void PowercapIOGroupTest::SetUp()
+{
+    ON_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_PACKAGE))
+        .WillByDefault(Return(2));
+    ON_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY))
+        .WillByDefault(Return(2));
+    EXPECT_CALL(m_topo, num_domain(_)).Times(testing::AnyNumber());
+
+    // Zone numbers are not in package order
+    write_zone("intel-rapl:0", "package-1");
+    write_zone("intel-rapl:0:0", "core");
+    write_zone("intel-rapl:0:1", "dram");
+    write_zone("intel-rapl:1", "package-0");
+    write_zone("intel-rapl:1:0", "dram");
+    write_file(m_powercap_path + "/intel-rapl:0/energy_uj", "2000000");
+    write_file(m_powercap_path + "/intel-rapl:1/energy_uj", "1000000");
+    write_file(m_powercap_path + "/intel-rapl:0:1/energy_uj", "4000000");
+    write_file(m_powercap_path + "/intel-rapl:1:0/energy_uj", "3000000");
+    write_file(m_powercap_path + "/intel-rapl:0/constraint_0_power_limit_uw", "150000000");
+    write_file(m_powercap_path + "/intel-rapl:1/constraint_0_power_limit_uw", "140000000");
+    write_file(m_powercap_path + "/intel-rapl:0/constraint_0_max_power_uw", "250000000");
+    write_file(m_powercap_path + "/intel-rapl:1/constraint_0_max_power_uw", "250000000");
+}
+
+void PowercapIOGroupTest::TearDown()
+{
+    for (const auto &path : m_file) {
+        unlink(path.c_str());
+    }
+    for (auto it = m_dir.rbegin(); it != m_dir.rend(); ++it) {
+        rmdir(it->c_str());
+    }
+}
+
+void PowercapIOGroupTest::write_file(const std::string &path, const std::string &value)
+{
+    std::string dir;
+    size_t pos = 0;
+    while ((pos = path.find('/', pos + 1)) != std::string::npos) {
+        dir = path.substr(0, pos);
+        if (!mkdir(dir.c_str(), 0755)) {
+            m_dir.push_back(dir);
+        }
+    }
+    std::ofstream file(path);
+    file << value << "\n";
+    file.close();
+    m_file.push_back(path);
+}
+
+std::string PowercapIOGroupTest::read_file(const std::string &path)
+{
+    // Like a sysfs attribute, a file written by the IOGroup is not
+    // truncated, so only the first line holds the value.
+    std::ifstream file(path);
+    std::string result;
+    std::getline(file, result);
+    return result;
+}
+
+void PowercapIOGroupTest::write_zone(const std::string &zone, const std::string &name)
+{
+    write_file(m_powercap_path + "/" + zone + "/name", name);
+    write_file(m_powercap_path + "/" + zone + "/max_energy_range_uj", m_max_range);
+}
+
+TEST_F(PowercapIOGroupTest, valid_signals)
+{
+    PowercapIOGroup group(m_topo, m_powercap_path, true);
+    std::set<std::string> expected_signal {"POWERCAP::ENERGY_PACKAGE",
+                                           "POWERCAP::ENERGY_DRAM",
+                                           "POWERCAP::POWER_PACKAGE_LIMIT",
+                                           "POWERCAP::POWER_PACKAGE_MAX",
+                                           "ENERGY_PACKAGE",
+                                           "ENERGY_DRAM"};
+    std::set<std::string> expected_control {"POWERCAP::POWER_PACKAGE_LIMIT",
+                                            "POWER_PACKAGE"};
+    EXPECT_EQ(expected_signal, group.signal_names());
+    EXPECT_EQ(expected_control, group.control_names());
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_PACKAGE, group.signal_domain_type("ENERGY_PACKAGE"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_BOARD_MEMORY, group.signal_domain_type("ENERGY_DRAM"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_PACKAGE, group.control_domain_type("POWER_PACKAGE"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_INVALID, group.signal_domain_type("INVALID"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_INVALID, group.control_domain_type("ENERGY_PACKAGE"));
+
+    // without aliases
+    PowercapIOGroup group_no_alias(m_topo, m_powercap_path, false);
+    EXPECT_TRUE(group_no_alias.is_valid_signal("POWERCAP::ENERGY_PACKAGE"));
+    EXPECT_FALSE(group_no_alias.is_valid_signal("ENERGY_PACKAGE"));
+    EXPECT_FALSE(group_no_alias.is_valid_signal("ENERGY_DRAM"));
+    EXPECT_FALSE(group_no_alias.is_valid_control("POWER_PACKAGE"));
+}
+
+TEST_F(PowercapIOGroupTest, no_zones)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(PowercapIOGroup(m_topo, m_powercap_path + "/intel-rapl:0:0", true),
+                               GEOPM_ERROR_RUNTIME, "no readable intel-rapl package zones");
+    GEOPM_EXPECT_THROW_MESSAGE(PowercapIOGroup(m_topo, "PowercapIOGroupTest-missing", true),
+                               GEOPM_ERROR_RUNTIME, "unable to open");
+}
+
+TEST_F(PowercapIOGroupTest, read_signal)
+{
+    PowercapIOGroup group(m_topo, m_powercap_path, true);
+    EXPECT_DOUBLE_EQ(1.0, group.read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(2.0, group.read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1));
+    EXPECT_DOUBLE_EQ(3.0, group.read_signal("ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 0));
+    EXPECT_DOUBLE_EQ(4.0, group.read_signal("POWERCAP::ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 1));
+    EXPECT_DOUBLE_EQ(140.0, group.read_signal("POWERCAP::POWER_PACKAGE_LIMIT", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(250.0, group.read_signal("POWERCAP::POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE, 1));
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("INVALID", IPlatformTopo::M_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_INVALID, "not valid for PowercapIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "domain_type does not match");
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 2),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+
+    write_file(m_powercap_path + "/intel-rapl:1/energy_uj", "garbage");
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_FILE_PARSE, "unable to parse");
+}
+
+TEST_F(PowercapIOGroupTest, sample)
+{
+    PowercapIOGroup group(m_topo, m_powercap_path, true);
+    int pkg0_idx = group.push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    int pkg1_idx = group.push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1);
+    int dram0_idx = group.push_signal("ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 0);
+    EXPECT_EQ(pkg0_idx, group.push_signal("POWERCAP::ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    GEOPM_EXPECT_THROW_MESSAGE(group.sample(pkg0_idx),
+                               GEOPM_ERROR_INVALID, "signal has not been read");
+    group.read_batch();
+    EXPECT_DOUBLE_EQ(1.0, group.sample(pkg0_idx));
+    EXPECT_DOUBLE_EQ(2.0, group.sample(pkg1_idx));
+    EXPECT_DOUBLE_EQ(3.0, group.sample(dram0_idx));
+
+    // Counter for package 0 wraps around
+    write_file(m_powercap_path + "/intel-rapl:1/energy_uj", "500000");
+    write_file(m_powercap_path + "/intel-rapl:0/energy_uj", "2500000");
+    group.read_batch();
+    EXPECT_DOUBLE_EQ(262143.328851 + 0.5, group.sample(pkg0_idx));
+    EXPECT_DOUBLE_EQ(2.5, group.sample(pkg1_idx));
+    // Wraparound state is shared with read_signal()
+    EXPECT_DOUBLE_EQ(262143.328851 + 0.5,
+                     group.read_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+
+    GEOPM_EXPECT_THROW_MESSAGE(group.sample(3),
+                               GEOPM_ERROR_INVALID, "batch_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_signal("ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 1),
+                               GEOPM_ERROR_INVALID, "cannot push signal after call to read_batch()");
+}
+
+TEST_F(PowercapIOGroupTest, adjust)
+{
+    std::string limit0_path = m_powercap_path + "/intel-rapl:1/constraint_0_power_limit_uw";
+    std::string limit1_path = m_powercap_path + "/intel-rapl:0/constraint_0_power_limit_uw";
+    PowercapIOGroup group(m_topo, m_powercap_path, true);
+    int pkg0_idx = group.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    int pkg1_idx = group.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1);
+    EXPECT_EQ(pkg0_idx, group.push_control("POWERCAP::POWER_PACKAGE_LIMIT", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_control("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_INVALID, "not valid for PowercapIOGroup");
+    group.adjust(pkg0_idx, 90.0);
+    group.write_batch();
+    EXPECT_EQ("90000000", read_file(limit0_path));
+    EXPECT_EQ("150000000", read_file(limit1_path));
+
+    // Unchanged settings are not written again
+    write_file(limit0_path, "100000000");
+    group.adjust(pkg0_idx, 90.0);
+    group.adjust(pkg1_idx, 110.5);
+    group.write_batch();
+    EXPECT_EQ("100000000", read_file(limit0_path));
+    EXPECT_EQ("110500000", read_file(limit1_path));
+
+    // A direct write replaces the batch value, so adjusting back to
+    // the previous batch setting is written
+    group.write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 80.0);
+    EXPECT_EQ("80000000", read_file(limit0_path));
+    group.adjust(pkg0_idx, 90.0);
+    group.write_batch();
+    EXPECT_EQ("90000000", read_file(limit0_path));
+
+    GEOPM_EXPECT_THROW_MESSAGE(group.adjust(2, 100.0),
+                               GEOPM_ERROR_INVALID, "batch_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(group.write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0, -1.0),
+                               GEOPM_ERROR_INVALID, "invalid setting");
+}
+
+TEST_F(PowercapIOGroupTest, save_restore)
+{
+    std::string limit0_path = m_powercap_path + "/intel-rapl:1/constraint_0_power_limit_uw";
+    PowercapIOGroup group(m_topo, m_powercap_path, true);
+    int pkg0_idx = group.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    group.save_control();
+    group.write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 80.0);
+    EXPECT_EQ("80000000", read_file(limit0_path));
+    group.restore_control();
+    EXPECT_EQ("140000000", read_file(limit0_path));
+
+    group.adjust(pkg0_idx, 90.0);
+    group.write_batch();
+    EXPECT_EQ("90000000", read_file(limit0_path));
+    group.restore_control();
+    EXPECT_EQ("140000000", read_file(limit0_path));
+    // The batch value is written again after a restore
+    group.adjust(pkg0_idx, 90.0);
+    group.write_batch();
+    EXPECT_EQ("90000000", read_file(limit0_path));
+}
+
+TEST_F(PowercapIOGroupTest, enable_limit)
+{
+    std::string enable0_path = m_powercap_path + "/intel-rapl:1/enabled";
+    std::string enable1_path = m_powercap_path + "/intel-rapl:0/enabled";
+    std::string limit0_path = m_powercap_path + "/intel-rapl:1/constraint_0_power_limit_uw";
+    write_file(enable0_path, "0");
+    write_file(enable1_path, "0");
+    PowercapIOGroup group(m_topo, m_powercap_path, true);
+    // The attribute is not exposed as a signal or control
+    EXPECT_EQ(2u, group.control_names().size());
+    group.save_control();
+    int pkg0_idx = group.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    group.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1);
+    group.write_batch();
+    // Nothing is written until a limit is adjusted
+    EXPECT_EQ("0", read_file(enable0_path));
+    group.adjust(pkg0_idx, 90.0);
+    group.write_batch();
+    EXPECT_EQ("90000000", read_file(limit0_path));
+    EXPECT_EQ("1", read_file(enable0_path));
+    EXPECT_EQ("0", read_file(enable1_path));
+    // Enabled once per package
+    write_file(enable0_path, "0");
+    group.adjust(pkg0_idx, 95.0);
+    group.write_batch();
+    EXPECT_EQ("0", read_file(enable0_path));
+    group.write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1, 100.0);
+    EXPECT_EQ("1", read_file(enable1_path));
+
+    group.restore_control();
+    EXPECT_EQ("140000000", read_file(limit0_path));
+    EXPECT_EQ("0", read_file(enable0_path));
+    EXPECT_EQ("0", read_file(enable1_path));
+    // Enabled again on the next write after a restore
+    group.write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 80.0);
+    EXPECT_EQ("1", read_file(enable0_path));
+}
+
+TEST_F(PowercapIOGroupTest, plugin)
+{
+    EXPECT_EQ("POWERCAP", PowercapIOGroup::plugin_name());
+}
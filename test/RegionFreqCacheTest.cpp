@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <fstream>
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "RegionFreqCache.hpp"
+#include "Exception.hpp"
+#include "geopm_error.h"
+
+using geopm::RegionFreqCache;
+
+class RegionFreqCacheTest : public ::testing::Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        std::string m_path;
+        uint64_t m_host_class;
+};
+
+void RegionFreqCacheTest::SetUp()
+{
+    m_path = "RegionFreqCacheTest.cache";
+    (void) unlink(m_path.c_str());
+    m_host_class = RegionFreqCache::host_class(1.0e9, 2.2e9, 1.0e8, 4);
+}
+
+void RegionFreqCacheTest::TearDown()
+{
+    (void) unlink(m_path.c_str());
+}
+
+TEST_F(RegionFreqCacheTest, persist)
+{
+    {
+        RegionFreqCache cache(m_path, m_host_class);
+        EXPECT_TRUE(std::isnan(cache.freq(0x1234)));
+        cache.update(0x1234, 1.5e9);
+        cache.update(0x5678, 1.9e9);
+        cache.update(0x1234, 1.6e9);
+        EXPECT_EQ(1.6e9, cache.freq(0x1234));
+    }
+    // A later job reads the frequencies back
+    RegionFreqCache cache(m_path, m_host_class);
+    EXPECT_EQ(1.6e9, cache.freq(0x1234));
+    EXPECT_EQ(1.9e9, cache.freq(0x5678));
+    EXPECT_TRUE(std::isnan(cache.freq(0x9abc)));
+}
+
+TEST_F(RegionFreqCacheTest, host_class)
+{
+    uint64_t other_class = RegionFreqCache::host_class(1.0e9, 2.4e9, 1.0e8, 4);
+    EXPECT_NE(m_host_class, other_class);
+    EXPECT_NE(m_host_class, RegionFreqCache::host_class(1.0e9, 2.2e9, 1.0e8, 8));
+    EXPECT_EQ(m_host_class, RegionFreqCache::host_class(1.0e9, 2.2e9, 1.0e8, 4));
+
+    RegionFreqCache cache(m_path, m_host_class);
+    RegionFreqCache other_cache(m_path, other_class);
+    cache.update(0x1234, 1.5e9);
+    other_cache.update(0x1234, 2.0e9);
+    EXPECT_EQ(1.5e9, cache.freq(0x1234));
+    EXPECT_EQ(2.0e9, other_cache.freq(0x1234));
+}
+
+TEST_F(RegionFreqCacheTest, negative)
+{
+    {
+        std::ofstream bad_file(m_path);
+        bad_file << "not a cache\n";
+    }
+    EXPECT_THROW(RegionFreqCache(m_path, m_host_class), geopm::Exception);
+    EXPECT_THROW(RegionFreqCache("/proc/geopm/no/such/path", m_host_class), geopm::Exception);
+}
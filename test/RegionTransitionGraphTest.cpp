@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "RegionTransitionGraph.hpp"
+
+using geopm::RegionTransitionGraph;
+
+class RegionTransitionGraphTest : public ::testing::Test
+{
+    protected:
+        void run_cycle(int num_cycle);
+        RegionTransitionGraph m_graph;
+        const uint64_t M_REGION_A = 0x1111;
+        const uint64_t M_REGION_B = 0x2222;
+        const uint64_t M_REGION_C = 0x3333;
+};
+
+void RegionTransitionGraphTest::run_cycle(int num_cycle)
+{
+    // A is followed by B three times out of four, then by C
+    for (int cycle = 0; cycle < num_cycle; ++cycle) {
+        uint64_t next = (cycle % 4 == 3) ? M_REGION_C : M_REGION_B;
+        m_graph.update({{M_REGION_A, 0.0, 0.0},
+                        {M_REGION_A, 1.0, 0.002},
+                        {next, 0.0, 0.0},
+                        {next, 1.0, 0.010}});
+    }
+}
+
+TEST_F(RegionTransitionGraphTest, empty)
+{
+    EXPECT_EQ(GEOPM_REGION_ID_UNDEFINED, m_graph.next_region(M_REGION_A));
+    EXPECT_EQ(0.0, m_graph.probability(M_REGION_A, M_REGION_B));
+    EXPECT_TRUE(std::isnan(m_graph.mean_duration(M_REGION_A)));
+    EXPECT_EQ(M_REGION_A, m_graph.predict(M_REGION_A, 1.0, 1.0));
+    EXPECT_TRUE(m_graph.region_ids().empty());
+}
+
+TEST_F(RegionTransitionGraphTest, learn)
+{
+    run_cycle(8);
+    std::vector<uint64_t> expected_ids {M_REGION_A, M_REGION_B, M_REGION_C};
+    EXPECT_EQ(expected_ids, m_graph.region_ids());
+    EXPECT_EQ(M_REGION_B, m_graph.next_region(M_REGION_A));
+    EXPECT_DOUBLE_EQ(0.75, m_graph.probability(M_REGION_A, M_REGION_B));
+    EXPECT_DOUBLE_EQ(0.25, m_graph.probability(M_REGION_A, M_REGION_C));
+    EXPECT_EQ(M_REGION_A, m_graph.next_region(M_REGION_B));
+    EXPECT_DOUBLE_EQ(1.0, m_graph.probability(M_REGION_B, M_REGION_A));
+    EXPECT_DOUBLE_EQ(0.002, m_graph.mean_duration(M_REGION_A));
+    EXPECT_DOUBLE_EQ(0.010, m_graph.mean_duration(M_REGION_B));
+}
+
+TEST_F(RegionTransitionGraphTest, predict)
+{
+    run_cycle(1);
+    // Too few transitions to predict from
+    EXPECT_EQ(M_REGION_A, m_graph.predict(M_REGION_A, 0.0, 0.005));
+    run_cycle(7);
+    // A runs for 2 ms, so B is expected within a 5 ms horizon
+    EXPECT_EQ(M_REGION_B, m_graph.predict(M_REGION_A, 0.0, 0.005));
+    // B runs for 10 ms, so it is not about to end
+    EXPECT_EQ(M_REGION_B, m_graph.predict(M_REGION_B, 0.001, 0.005));
+    EXPECT_EQ(M_REGION_B, m_graph.predict(M_REGION_B, 0.006, 0.005));
+    EXPECT_EQ(M_REGION_A, m_graph.predict(M_REGION_B, 0.008, 0.005));
+
+    // No successor is likely enough
+    RegionTransitionGraph graph;
+    for (int cycle = 0; cycle < 4; ++cycle) {
+        graph.entry(M_REGION_A);
+        graph.exit(M_REGION_A, 0.001);
+        graph.entry(cycle % 2 ? M_REGION_B : M_REGION_C);
+        graph.entry(M_REGION_C);
+    }
+    EXPECT_EQ(M_REGION_A, graph.predict(M_REGION_A, 0.0, 0.005));
+}
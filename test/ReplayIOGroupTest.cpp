@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+
+#include <cmath>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "ReplayIOGroup.hpp"
+#include "ReplayLog.hpp"
+#include "PlatformIOInternal.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "MockIOGroup.hpp"
+#include "MockPlatformTopo.hpp"
+#include "geopm_test.hpp"
+
+using geopm::ReplayIOGroup;
+using geopm::PlatformIO;
+using geopm::IPlatformTopo;
+using testing::NiceMock;
+using testing::Return;
+using testing::Invoke;
+using testing::_;
+
+class ReplayIOGroupTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        /// Record m_value for each step through a PlatformIO and
+        /// adjust POWER_PACKAGE to m_setting at the steps where it
+        /// is not NAN.
+        void record(void);
+        const std::string m_log_path = "ReplayIOGroupTest-log";
+        std::vector<std::vector<double> > m_value;
+        std::vector<double> m_setting;
+        MockPlatformTopo m_topo;
+};
+
+void ReplayIOGroupTest::SetUp()
+{
+    // TIME, package 0 energy and package 1 energy at each step
+    m_value = {{1.0, 100.0, 200.0},
+               {2.0, 150.0, 260.0},
+               {3.0, 190.0, 330.0}};
+    m_setting = {120.0, NAN, 110.0};
+}
+
+void ReplayIOGroupTest::TearDown()
+{
+    unlink(m_log_path.c_str());
+}
+
+void ReplayIOGroupTest::record(void)
+{
+    auto group = std::make_shared<NiceMock<MockIOGroup> >();
+    ON_CALL(*group, is_valid_signal(_)).WillByDefault(Return(false));
+    ON_CALL(*group, is_valid_signal("TIME")).WillByDefault(Return(true));
+    ON_CALL(*group, is_valid_signal("ENERGY_PACKAGE")).WillByDefault(Return(true));
+    ON_CALL(*group, is_valid_signal("POWER_PACKAGE_MAX")).WillByDefault(Return(true));
+    ON_CALL(*group, is_valid_control(_)).WillByDefault(Return(false));
+    ON_CALL(*group, is_valid_control("POWER_PACKAGE")).WillByDefault(Return(true));
+    ON_CALL(*group, signal_domain_type("TIME")).WillByDefault(Return(IPlatformTopo::M_DOMAIN_BOARD));
+    ON_CALL(*group, signal_domain_type("ENERGY_PACKAGE")).WillByDefault(Return(IPlatformTopo::M_DOMAIN_PACKAGE));
+    ON_CALL(*group, control_domain_type("POWER_PACKAGE")).WillByDefault(Return(IPlatformTopo::M_DOMAIN_PACKAGE));
+    ON_CALL(*group, push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0)).WillByDefault(Return(0));
+    ON_CALL(*group, push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0)).WillByDefault(Return(1));
+    ON_CALL(*group, push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1)).WillByDefault(Return(2));
+    ON_CALL(*group, push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0)).WillByDefault(Return(0));
+    ON_CALL(*group, read_signal("POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE, 0)).WillByDefault(Return(250.0));
+    size_t step = 0;
+    ON_CALL(*group, sample(_)).WillByDefault(Invoke([this, &step] (int batch_idx) {
+        return m_value[step][batch_idx];
+    }));
+
+    PlatformIO platio({group}, m_topo, m_log_path);
+    EXPECT_EQ(250.0, platio.read_signal("POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    platio.push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    platio.push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    platio.push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1);
+    int control_idx = platio.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    for (step = 0; step < m_value.size(); ++step) {
+        platio.read_batch();
+        if (!std::isnan(m_setting[step])) {
+            platio.adjust(control_idx, m_setting[step]);
+            platio.write_batch();
+        }
+    }
+}
+
+TEST_F(ReplayIOGroupTest, record_replay)
+{
+    record();
+    geopm::ReplayLogReader log(m_log_path);
+    ASSERT_EQ(3u, log.signal().size());
+    EXPECT_EQ("ENERGY_PACKAGE", log.signal()[2].name);
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_PACKAGE, log.signal()[2].domain_type);
+    EXPECT_EQ(1, log.signal()[2].domain_idx);
+    ASSERT_EQ(1u, log.control().size());
+    EXPECT_EQ(m_value, log.read());
+    ASSERT_EQ(2u, log.write().size());
+    EXPECT_EQ(1u, log.write()[0].num_read);
+    EXPECT_EQ(std::vector<double>{110.0}, log.write()[1].setting);
+    ASSERT_EQ(1u, log.read_signal().size());
+    EXPECT_EQ(250.0, log.read_signal()[0].second);
+
+    auto group = std::make_shared<ReplayIOGroup>(m_log_path);
+    EXPECT_EQ(3u, group->num_read_record());
+    EXPECT_EQ(std::set<std::string>({"ENERGY_PACKAGE", "POWER_PACKAGE_MAX", "TIME"}), group->signal_names());
+    EXPECT_EQ(std::set<std::string>({"POWER_PACKAGE"}), group->control_names());
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_PACKAGE, group->control_domain_type("POWER_PACKAGE"));
+
+    PlatformIO platio({group}, m_topo);
+    EXPECT_EQ(250.0, platio.read_signal("POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    // Pushed in a different order than recorded
+    int energy_1 = platio.push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1);
+    int time = platio.push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    int control_idx = platio.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    for (size_t step = 0; step < m_value.size(); ++step) {
+        platio.read_batch();
+        EXPECT_EQ(m_value[step][0], platio.sample(time));
+        EXPECT_EQ(m_value[step][2], platio.sample(energy_1));
+        if (!std::isnan(m_setting[step])) {
+            platio.adjust(control_idx, m_setting[step]);
+            platio.write_batch();
+        }
+    }
+    EXPECT_EQ(2u, group->num_write());
+    EXPECT_EQ(0u, group->num_mismatch());
+}
+
+TEST_F(ReplayIOGroupTest, read_signal)
+{
+    record();
+    ReplayIOGroup group(m_log_path);
+    int time = group.push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "was not recorded");
+    GEOPM_EXPECT_THROW_MESSAGE(group.sample(time), GEOPM_ERROR_RUNTIME, "has not been read");
+    group.read_batch();
+    group.read_batch();
+    EXPECT_EQ(2.0, group.read_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0));
+    // Recorded results are repeated once used up
+    EXPECT_EQ(250.0, group.read_signal("POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    EXPECT_EQ(250.0, group.read_signal("POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+}
+
+TEST_F(ReplayIOGroupTest, mismatch)
+{
+    record();
+    ReplayIOGroup group(m_log_path);
+    int control_idx = group.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    // Different setting at the first step
+    group.read_batch();
+    group.adjust(control_idx, 130.0);
+    group.write_batch();
+    EXPECT_EQ(1u, group.num_mismatch());
+    // Write that was not recorded
+    group.read_batch();
+    group.adjust(control_idx, 120.0);
+    group.write_batch();
+    EXPECT_EQ(2u, group.num_mismatch());
+    // Recorded write that is not made
+    group.read_batch();
+    EXPECT_EQ(3u, group.num_mismatch());
+    EXPECT_EQ(2u, group.num_write());
+}
+
+TEST_F(ReplayIOGroupTest, batch)
+{
+    auto group = std::make_shared<NiceMock<MockIOGroup> >();
+    ON_CALL(*group, is_valid_signal(_)).WillByDefault(Return(false));
+    ON_CALL(*group, is_valid_signal("TIME")).WillByDefault(Return(true));
+    ON_CALL(*group, is_valid_signal("ENERGY_PACKAGE")).WillByDefault(Return(true));
+    ON_CALL(*group, is_valid_control(_)).WillByDefault(Return(false));
+    ON_CALL(*group, is_valid_control("POWER_PACKAGE")).WillByDefault(Return(true));
+    ON_CALL(*group, signal_domain_type("TIME")).WillByDefault(Return(IPlatformTopo::M_DOMAIN_BOARD));
+    ON_CALL(*group, push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0)).WillByDefault(Return(0));
+    double energy_offset = 0.0;
+    ON_CALL(*group, read_signal_batch(_, _)).WillByDefault(Invoke(
+        [&energy_offset] (const std::vector<PlatformIO::m_request_s> &request,
+                          std::vector<double> &result) {
+            result.clear();
+            for (const auto &req : request) {
+                result.push_back(100.0 * (req.domain_idx + 1) + energy_offset);
+            }
+        }));
+    std::vector<PlatformIO::m_request_s> energy_req {
+        {"ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0},
+        {"ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1}};
+    std::vector<PlatformIO::m_request_s> power_req {
+        {"POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0},
+        {"POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1}};
+    std::vector<double> result;
+    {
+        PlatformIO platio({group}, m_topo, m_log_path);
+        // Before the log is opened by the first batch operation
+        platio.read_signal_batch(energy_req, result);
+        platio.push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+        platio.read_batch();
+        energy_offset = 10.0;
+        platio.read_signal_batch(energy_req, result);
+        EXPECT_EQ(std::vector<double>({110.0, 210.0}), result);
+        platio.write_control_batch(power_req, {90.0, 95.0});
+        platio.write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1, 100.0);
+    }
+    geopm::ReplayLogReader log(m_log_path);
+    ASSERT_EQ(4u, log.read_signal().size());
+    EXPECT_EQ(1, log.read_signal()[1].first.domain_idx);
+    EXPECT_EQ(200.0, log.read_signal()[1].second);
+    ASSERT_EQ(3u, log.write_control().size());
+    EXPECT_EQ(95.0, log.write_control()[1].second);
+
+    auto replay = std::make_shared<ReplayIOGroup>(m_log_path);
+    EXPECT_EQ(std::set<std::string>({"POWER_PACKAGE"}), replay->control_names());
+    PlatformIO platio({replay}, m_topo);
+    platio.read_signal_batch(energy_req, result);
+    EXPECT_EQ(std::vector<double>({100.0, 200.0}), result);
+    platio.push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    platio.read_batch();
+    platio.read_signal_batch(energy_req, result);
+    EXPECT_EQ(std::vector<double>({110.0, 210.0}), result);
+    platio.write_control_batch(power_req, {90.0, 95.0});
+    EXPECT_EQ(0u, replay->num_mismatch());
+    // Differs from the recorded write_control()
+    platio.write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1, 101.0);
+    EXPECT_EQ(1u, replay->num_mismatch());
+    // No more writes were recorded
+    platio.write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 90.0);
+    EXPECT_EQ(2u, replay->num_mismatch());
+}
+
+TEST_F(ReplayIOGroupTest, end_of_log)
+{
+    record();
+    ReplayIOGroup group(m_log_path);
+    for (size_t step = 0; step < m_value.size(); ++step) {
+        group.read_batch();
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_batch(), GEOPM_ERROR_RUNTIME, "end of the replay log");
+}
+
+TEST_F(ReplayIOGroupTest, invalid_push)
+{
+    record();
+    ReplayIOGroup group(m_log_path);
+    EXPECT_FALSE(group.is_valid_signal("FREQUENCY"));
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 2),
+                               GEOPM_ERROR_INVALID, "was not recorded");
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "was not recorded");
+    int idx = group.push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    EXPECT_EQ(idx, group.push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0));
+    group.read_batch();
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_signal("TIME", IPlatformTopo::M_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "after read_batch()");
+}
+
+TEST_F(ReplayIOGroupTest, bad_file)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup replay("ReplayIOGroupTest-missing"),
+                               GEOPM_ERROR_FILE_PARSE, "unable to open");
+    std::ofstream log(m_log_path);
+    log << "GEOPM_TRACE_BLOCKS lz4\n";
+    log.close();
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup replay(m_log_path),
+                               GEOPM_ERROR_FILE_PARSE, "not a replay log");
+    std::string header = geopm::ReplayLogWriter::header() + "\n";
+    log.open(m_log_path);
+    log << header;
+    log.write("\x01\x00", 2);
+    log.close();
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup replay(m_log_path),
+                               GEOPM_ERROR_FILE_PARSE, "truncated header");
+}
@@ -30,6 +30,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <cmath>
 #include <sstream>
 #include <fstream>
 
@@ -79,6 +80,7 @@ class ReporterTest : public testing::Test
             M_ENERGY_DRAM_IDX,
             M_CLK_CORE_IDX,
             M_CLK_REF_IDX,
+            M_POWER_PKG_IDX,
         };
         ReporterTest();
         void TearDown(void);
@@ -130,6 +132,13 @@ class ReporterTest : public testing::Test
             {GEOPM_REGION_ID_UNMARKED, 4444},
             {GEOPM_REGION_ID_EPOCH, 0}
         };
+        // Epoch is not sampled so has no power percentiles
+        std::map<uint64_t, std::vector<double> > m_region_power = {
+            {geopm_crc32_str(0, "all2all"), {150, 180, 190}},
+            {geopm_crc32_str(0, "model-init"), {100, 110, 111}},
+            {GEOPM_REGION_ID_UNMARKED, {120, 130, 140}},
+            {GEOPM_REGION_ID_EPOCH, {NAN, NAN, NAN}}
+        };
         std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > m_region_agent_detail = {
             {geopm_crc32_str(0, "all2all"), {{"agent stat", "1"}, {"agent other stat", "2"}}},
             {geopm_crc32_str(0, "model-init"), {{"agent stat", "2"}}},
@@ -161,6 +170,9 @@ ReporterTest::ReporterTest()
     EXPECT_CALL(m_platform_io, push_signal("CYCLES_THREAD", _, _))
         .WillOnce(Return(M_CLK_CORE_IDX));
     EXPECT_CALL(m_platform_io, push_region_signal_total(M_CLK_CORE_IDX, _, _));
+    EXPECT_CALL(m_platform_io, push_signal("POWER_PACKAGE", _, _))
+        .WillOnce(Return(M_POWER_PKG_IDX));
+    EXPECT_CALL(m_platform_io, push_region_signal_histogram(M_POWER_PKG_IDX, _, _));
 
     m_comm = std::make_shared<ReporterTestMockComm>();
     m_reporter = geopm::make_unique<Reporter>(m_report_name, m_platform_io, 0);
@@ -238,6 +250,14 @@ TEST_F(ReporterTest, generate)
                     sample_region_total(M_CLK_REF_IDX, geopm_region_id_set_mpi(rid.first)))
             .WillOnce(Return(rid.second));
     }
+    for (auto rid : m_region_power) {
+        EXPECT_CALL(m_platform_io, sample_region_percentile(M_POWER_PKG_IDX, rid.first, 50.0))
+            .WillOnce(Return(rid.second[0]));
+        EXPECT_CALL(m_platform_io, sample_region_percentile(M_POWER_PKG_IDX, rid.first, 95.0))
+            .WillOnce(Return(rid.second[1]));
+        EXPECT_CALL(m_platform_io, sample_region_percentile(M_POWER_PKG_IDX, rid.first, 99.0))
+            .WillOnce(Return(rid.second[2]));
+    }
     EXPECT_CALL(*m_comm, rank()).WillOnce(Return(0));
     EXPECT_CALL(*m_comm, num_rank()).WillOnce(Return(1));
 
@@ -269,6 +289,9 @@ TEST_F(ReporterTest, generate)
         "    energy (joules): 778\n"
         "    frequency (%): 81.81\n"
         "    frequency (Hz): 0.818182\n"
+        "    power-p50 (watts): 150\n"
+        "    power-p95 (watts): 180\n"
+        "    power-p99 (watts): 190\n"
         "    mpi-runtime (sec): 3.4\n"
         "    count: 20\n"
         "    agent stat: 1\n"
@@ -279,6 +302,9 @@ TEST_F(ReporterTest, generate)
         "    energy (joules): 889\n"
         "    frequency (%): 84.84\n"
         "    frequency (Hz): 0.848485\n"
+        "    power-p50 (watts): 100\n"
+        "    power-p95 (watts): 110\n"
+        "    power-p99 (watts): 111\n"
         "    mpi-runtime (sec): 5.6\n"
         "    count: 1\n"
         "    agent stat: 2\n"
@@ -288,6 +314,9 @@ TEST_F(ReporterTest, generate)
         "    energy (joules): 223\n"
         "    frequency (%): 77.2727\n"
         "    frequency (Hz): 0.772727\n"
+        "    power-p50 (watts): 120\n"
+        "    power-p95 (watts): 130\n"
+        "    power-p99 (watts): 140\n"
         "    mpi-runtime (sec): 1.2\n"
         "    count: 0\n"
         "    agent stat: 3\n"
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <string>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "SampleRing.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_test.hpp"
+#include "MockSharedMemory.hpp"
+#include "MockSharedMemoryUser.hpp"
+
+using geopm::SampleRing;
+using geopm::SampleRingReader;
+using testing::Return;
+
+class SampleRingTest : public ::testing::Test
+{
+    protected:
+        void SetUp();
+        std::unique_ptr<SampleRingReader> make_reader(const std::vector<std::string> &field_names);
+
+        std::vector<std::string> m_names = {"POWER", "ENERGY", "RUNTIME"};
+        size_t m_capacity = 4;
+        MockSharedMemory *m_shmem;
+        std::unique_ptr<SampleRing> m_ring;
+};
+
+void SampleRingTest::SetUp()
+{
+    m_shmem = new MockSharedMemory(SampleRing::region_size(m_names.size(), m_capacity));
+    m_ring = geopm::make_unique<SampleRing>(std::unique_ptr<MockSharedMemory>(m_shmem),
+                                            m_names, m_capacity);
+}
+
+std::unique_ptr<SampleRingReader> SampleRingTest::make_reader(const std::vector<std::string> &field_names)
+{
+    std::unique_ptr<MockSharedMemoryUser> user(new MockSharedMemoryUser(0));
+    EXPECT_CALL(*user, pointer()).WillRepeatedly(Return(m_shmem->pointer()));
+    EXPECT_CALL(*user, size()).WillRepeatedly(Return(m_shmem->size()));
+    return geopm::make_unique<SampleRingReader>(std::move(user), field_names);
+}
+
+TEST_F(SampleRingTest, publish_read)
+{
+    auto reader = make_reader({"RUNTIME", "POWER"});
+    EXPECT_EQ(std::vector<std::string>({"RUNTIME", "POWER"}), reader->field_names());
+    EXPECT_EQ(m_names, make_reader({})->field_names());
+    std::vector<double> timestamp;
+    std::vector<std::vector<double> > sample;
+    EXPECT_EQ(0u, reader->read(timestamp, sample));
+    EXPECT_TRUE(timestamp.empty());
+
+    m_ring->adjust({1.0, 2.0, 3.0});
+    m_ring->write_batch();
+    m_ring->adjust("RUNTIME", 6.0);
+    m_ring->write_batch();
+    EXPECT_EQ(0u, reader->read(timestamp, sample));
+    ASSERT_EQ(2u, timestamp.size());
+    EXPECT_LE(timestamp[0], timestamp[1]);
+    EXPECT_LT(0.0, timestamp[0]);
+    std::vector<std::vector<double> > expected = {{3.0, 1.0}, {6.0, 1.0}};
+    EXPECT_EQ(expected, sample);
+
+    // only new records are returned
+    EXPECT_EQ(0u, reader->read(timestamp, sample));
+    EXPECT_TRUE(sample.empty());
+    m_ring->adjust({4.0, 5.0, 7.0});
+    m_ring->write_batch();
+    EXPECT_EQ(0u, reader->read(timestamp, sample));
+    expected = {{7.0, 4.0}};
+    EXPECT_EQ(expected, sample);
+}
+
+TEST_F(SampleRingTest, overrun)
+{
+    auto reader = make_reader({"ENERGY"});
+    std::vector<double> timestamp;
+    std::vector<std::vector<double> > sample;
+    for (int idx = 0; idx < 10; ++idx) {
+        m_ring->adjust({0.0, (double)idx, 0.0});
+        m_ring->write_batch();
+    }
+    // writer does not wait for the reader; the oldest records are lost
+    EXPECT_EQ(10u - m_capacity, reader->read(timestamp, sample));
+    std::vector<std::vector<double> > expected = {{6.0}, {7.0}, {8.0}, {9.0}};
+    EXPECT_EQ(expected, sample);
+}
+
+TEST_F(SampleRingTest, late_attach)
+{
+    std::vector<double> timestamp;
+    std::vector<std::vector<double> > sample;
+    // the ring has wrapped before the reader attaches
+    for (int idx = 0; idx < 10; ++idx) {
+        m_ring->adjust({0.0, (double)idx, 0.0});
+        m_ring->write_batch();
+    }
+    auto reader = make_reader({"ENERGY"});
+    EXPECT_EQ(0u, reader->read(timestamp, sample));
+    EXPECT_TRUE(sample.empty());
+
+    m_ring->adjust({0.0, 10.0, 0.0});
+    m_ring->write_batch();
+    EXPECT_EQ(0u, reader->read(timestamp, sample));
+    std::vector<std::vector<double> > expected = {{10.0}};
+    EXPECT_EQ(expected, sample);
+
+    // records lost are counted from the attach point
+    for (int idx = 11; idx < 17; ++idx) {
+        m_ring->adjust({0.0, (double)idx, 0.0});
+        m_ring->write_batch();
+    }
+    EXPECT_EQ(6u - m_capacity, reader->read(timestamp, sample));
+    expected = {{13.0}, {14.0}, {15.0}, {16.0}};
+    EXPECT_EQ(expected, sample);
+}
+
+TEST_F(SampleRingTest, negative)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(make_reader({"POWER", "FREQUENCY"}),
+                               GEOPM_ERROR_INVALID, "\"FREQUENCY\" is not published");
+    GEOPM_EXPECT_THROW_MESSAGE(m_ring->adjust("FREQUENCY", 1.0),
+                               GEOPM_ERROR_INVALID, "is not published");
+    GEOPM_EXPECT_THROW_MESSAGE(m_ring->adjust({1.0}),
+                               GEOPM_ERROR_INVALID, "size of settings does not match");
+
+    std::vector<std::string> many_names(geopm::GEOPM_SAMPLE_RING_MAX_FIELD + 1, "NAME");
+    std::unique_ptr<MockSharedMemory> shmem(new MockSharedMemory(SampleRing::region_size(many_names.size(), 1)));
+    GEOPM_EXPECT_THROW_MESSAGE(SampleRing(std::move(shmem), many_names, 1),
+                               GEOPM_ERROR_INVALID, "fields and a capacity");
+
+    std::unique_ptr<MockSharedMemoryUser> user(new MockSharedMemoryUser(SampleRing::region_size(1, 1)));
+    GEOPM_EXPECT_THROW_MESSAGE(SampleRingReader(std::move(user), {}),
+                               GEOPM_ERROR_INVALID, "not a sample ring");
+}
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "SimPlatformIOGroup.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "MockPlatformTopo.hpp"
+#include "geopm_test.hpp"
+
+using geopm::SimPlatformIOGroup;
+using geopm::IPlatformTopo;
+using testing::Return;
+using testing::_;
+
+class SimPlatformIOGroupTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        std::unique_ptr<SimPlatformIOGroup> make_group(void);
+        MockPlatformTopo m_topo;
+        SimPlatformIOGroup::m_model_s m_model;
+        double m_time;
+};
+
+void SimPlatformIOGroupTest::SetUp()
+{
+    ON_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_PACKAGE))
+        .WillByDefault(Return(2));
+    ON_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_BOARD_MEMORY))
+        .WillByDefault(Return(2));
+    ON_CALL(m_topo, num_domain(IPlatformTopo::M_DOMAIN_CPU))
+        .WillByDefault(Return(8));
+    EXPECT_CALL(m_topo, num_domain(_)).Times(testing::AnyNumber());
+    // Deterministic model that reaches its settings immediately
+    m_model.noise = 0.0;
+    m_model.variation = 0.0;
+    m_model.rapl_time_constant = 0.0;
+    m_time = 100.0;
+}
+
+std::unique_ptr<SimPlatformIOGroup> SimPlatformIOGroupTest::make_group(void)
+{
+    return std::unique_ptr<SimPlatformIOGroup>(
+        new SimPlatformIOGroup(m_topo, m_model, 42, [this] () {return m_time;}));
+}
+
+TEST_F(SimPlatformIOGroupTest, valid_signals)
+{
+    auto group = make_group();
+    EXPECT_EQ("SIM", SimPlatformIOGroup::plugin_name());
+    for (const auto &name : {"POWER_PACKAGE", "ENERGY_PACKAGE", "FREQUENCY",
+                             "CYCLES_THREAD", "CYCLES_REFERENCE", "POWER_PACKAGE_MIN",
+                             "POWER_PACKAGE_MAX", "SIM::POWER_PACKAGE_LIMIT",
+                             "SIM::POWER_PACKAGE_TDP"}) {
+        EXPECT_TRUE(group->is_valid_signal(name)) << name;
+        EXPECT_EQ(IPlatformTopo::M_DOMAIN_PACKAGE, group->signal_domain_type(name)) << name;
+    }
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_BOARD_MEMORY, group->signal_domain_type("ENERGY_DRAM"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_BOARD, group->signal_domain_type("SIM::TIME"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_BOARD, group->signal_domain_type("EPOCH_RUNTIME"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_BOARD, group->signal_domain_type("EPOCH_COUNT"));
+    // TIME is left to the TimeIOGroup
+    EXPECT_FALSE(group->is_valid_signal("TIME"));
+    EXPECT_FALSE(group->is_valid_signal("SIM::INVALID"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_INVALID, group->signal_domain_type("SIM::INVALID"));
+    EXPECT_EQ(group->signal_names().size(), 2 * 10 + 3u);
+
+    EXPECT_EQ(4u, group->control_names().size());
+    EXPECT_TRUE(group->is_valid_control("POWER_PACKAGE"));
+    EXPECT_TRUE(group->is_valid_control("SIM::FREQUENCY"));
+    EXPECT_FALSE(group->is_valid_control("ENERGY_PACKAGE"));
+    EXPECT_EQ(IPlatformTopo::M_DOMAIN_PACKAGE, group->control_domain_type("FREQUENCY"));
+
+    EXPECT_EQ(0, group->push_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    EXPECT_EQ(1, group->push_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1));
+    EXPECT_EQ(0, group->push_signal("SIM::POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    GEOPM_EXPECT_THROW_MESSAGE(group->push_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 2),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(group->push_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "domain_type does not match");
+    GEOPM_EXPECT_THROW_MESSAGE(group->push_signal("SIM::INVALID", IPlatformTopo::M_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "not valid for SimPlatformIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(group->sample(0), GEOPM_ERROR_INVALID, "has not been read");
+    group->read_batch();
+    GEOPM_EXPECT_THROW_MESSAGE(group->push_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_INVALID, "cannot push a signal after read_batch");
+    GEOPM_EXPECT_THROW_MESSAGE(group->sample(2), GEOPM_ERROR_INVALID, "batch_idx out of range");
+}
+
+TEST_F(SimPlatformIOGroupTest, power_limit)
+{
+    auto group = make_group();
+    EXPECT_DOUBLE_EQ(150.0, group->read_signal("SIM::POWER_PACKAGE_TDP", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(50.0, group->read_signal("POWER_PACKAGE_MIN", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(200.0, group->read_signal("POWER_PACKAGE_MAX", IPlatformTopo::M_DOMAIN_PACKAGE, 1));
+    // The package starts limited to TDP
+    EXPECT_NEAR(150.0, group->read_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0), 1e-9);
+
+    int limit_idx = group->push_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1);
+    int power_idx[2];
+    int freq_idx[2];
+    for (int pkg = 0; pkg < 2; ++pkg) {
+        power_idx[pkg] = group->push_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, pkg);
+        freq_idx[pkg] = group->push_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, pkg);
+    }
+    int setting_idx = group->push_signal("SIM::POWER_PACKAGE_LIMIT", IPlatformTopo::M_DOMAIN_PACKAGE, 1);
+    group->adjust(limit_idx, 110.0);
+    group->write_batch();
+    m_time += 1.0;
+    group->read_batch();
+    EXPECT_DOUBLE_EQ(110.0, group->sample(setting_idx));
+    EXPECT_NEAR(110.0, group->sample(power_idx[1]), 1e-9);
+    EXPECT_NEAR(150.0, group->sample(power_idx[0]), 1e-9);
+    // Power is cubic in frequency above idle
+    EXPECT_NEAR(2.2e9 * std::cbrt(70.0 / 140.0), group->sample(freq_idx[1]), 1.0);
+
+    // The frequency can not exceed freq_max or go below freq_min
+    group->write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 250.0);
+    group->write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1, 10.0);
+    m_time += 1.0;
+    group->read_batch();
+    EXPECT_DOUBLE_EQ(2.2e9, group->sample(freq_idx[0]));
+    EXPECT_DOUBLE_EQ(180.0, group->sample(power_idx[0]));
+    EXPECT_DOUBLE_EQ(1.0e9, group->sample(freq_idx[1]));
+}
+
+TEST_F(SimPlatformIOGroupTest, frequency_control)
+{
+    m_model.power_tdp = 200.0;
+    m_model.rapl_time_constant = 1.0;
+    auto group = make_group();
+    int control_idx = group->push_control("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    int freq_idx = group->push_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    group->read_batch();
+    EXPECT_DOUBLE_EQ(2.2e9, group->sample(freq_idx));
+    group->adjust(control_idx, 1.2e9);
+    group->write_batch();
+    // The frequency approaches the request with the time constant
+    m_time += 1.0;
+    group->read_batch();
+    EXPECT_NEAR(2.2e9 - 1.0e9 * (1.0 - std::exp(-1.0)), group->sample(freq_idx), 1.0);
+    m_time += 100.0;
+    group->read_batch();
+    EXPECT_NEAR(1.2e9, group->sample(freq_idx), 1.0);
+    // Requests are clamped to the frequency range
+    group->adjust(control_idx, 0.5e9);
+    group->write_batch();
+    m_time += 100.0;
+    group->read_batch();
+    EXPECT_NEAR(1.0e9, group->sample(freq_idx), 1.0);
+}
+
+TEST_F(SimPlatformIOGroupTest, energy_cycles)
+{
+    auto group = make_group();
+    group->write_control("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 1.1e9);
+    int energy_idx = group->push_signal("ENERGY_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    int dram_idx = group->push_signal("ENERGY_DRAM", IPlatformTopo::M_DOMAIN_BOARD_MEMORY, 1);
+    int thread_idx = group->push_signal("CYCLES_THREAD", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    int reference_idx = group->push_signal("CYCLES_REFERENCE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    int time_idx = group->push_signal("SIM::TIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    m_time += 1.0;
+    group->read_batch();
+    double energy = group->sample(energy_idx);
+    double dram = group->sample(dram_idx);
+    double thread = group->sample(thread_idx);
+    double reference = group->sample(reference_idx);
+    EXPECT_DOUBLE_EQ(1.0, group->sample(time_idx));
+    m_time += 2.0;
+    group->read_batch();
+    EXPECT_DOUBLE_EQ(3.0, group->sample(time_idx));
+    EXPECT_NEAR(2.0 * (40.0 + 140.0 / 8.0), group->sample(energy_idx) - energy, 1e-6);
+    EXPECT_NEAR(2.0 * 10.0, group->sample(dram_idx) - dram, 1e-9);
+    // Four CPUs per package
+    EXPECT_NEAR(2.0 * 4 * 1.1e9, group->sample(thread_idx) - thread, 1.0);
+    EXPECT_NEAR(2.0 * 4 * 2.1e9, group->sample(reference_idx) - reference, 1.0);
+}
+
+TEST_F(SimPlatformIOGroupTest, epoch)
+{
+    m_model.power_tdp = 200.0;
+    auto group = make_group();
+    int count_idx = group->push_signal("EPOCH_COUNT", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    int runtime_idx = group->push_signal("EPOCH_RUNTIME", IPlatformTopo::M_DOMAIN_BOARD, 0);
+    group->read_batch();
+    EXPECT_EQ(0.0, group->sample(count_idx));
+    EXPECT_EQ(0.0, group->sample(runtime_idx));
+    m_time += 1.05;
+    group->read_batch();
+    EXPECT_EQ(10.0, group->sample(count_idx));
+    EXPECT_NEAR(0.1, group->sample(runtime_idx), 1e-9);
+    // The slowest package sets the pace, at half frequency the
+    // sensitive part of the epoch takes twice as long: half an epoch
+    // was in progress, and 1.0 / 0.18 more complete
+    group->write_control("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 1, 1.1e9);
+    m_time += 1.0;
+    group->read_batch();
+    EXPECT_EQ(16.0, group->sample(count_idx));
+    EXPECT_NEAR(0.18, group->sample(runtime_idx), 1e-9);
+}
+
+TEST_F(SimPlatformIOGroupTest, variation)
+{
+    m_model.power_tdp = 200.0;
+    m_model.variation = 0.1;
+    auto group = make_group();
+    auto other = make_group();
+    double power[2];
+    for (int pkg = 0; pkg < 2; ++pkg) {
+        power[pkg] = group->read_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, pkg);
+        // The same seed gives the same node
+        EXPECT_DOUBLE_EQ(power[pkg], other->read_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, pkg));
+    }
+    EXPECT_NE(power[0], power[1]);
+    // A limit below the power at freq_max is met by every package
+    group->write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 120.0);
+    group->write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1, 120.0);
+    m_time += 1.0;
+    EXPECT_NEAR(120.0, group->read_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0), 1e-9);
+    EXPECT_NEAR(120.0, group->read_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 1), 1e-9);
+    EXPECT_NE(group->read_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 0),
+              group->read_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 1));
+
+    m_model.noise = 0.1;
+    group = make_group();
+    m_time += 1.0;
+    double sample = group->read_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0);
+    m_time += 1.0;
+    EXPECT_NE(sample, group->read_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+}
+
+TEST_F(SimPlatformIOGroupTest, save_restore)
+{
+    auto group = make_group();
+    group->save_control();
+    group->write_control("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 100.0);
+    group->write_control("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 0, 1.5e9);
+    m_time += 1.0;
+    EXPECT_DOUBLE_EQ(1.5e9, group->read_signal("FREQUENCY", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    group->restore_control();
+    m_time += 1.0;
+    EXPECT_DOUBLE_EQ(150.0, group->read_signal("SIM::POWER_PACKAGE_LIMIT", IPlatformTopo::M_DOMAIN_PACKAGE, 0));
+    EXPECT_NEAR(150.0, group->read_signal("POWER_PACKAGE", IPlatformTopo::M_DOMAIN_PACKAGE, 0), 1e-9);
+}
+
+TEST_F(SimPlatformIOGroupTest, parse_model)
+{
+    SimPlatformIOGroup::m_model_s model =
+        SimPlatformIOGroup::parse_model("{\"power_tdp\" : 120, \"variation\" : 0.1, \"seed\" : 7}");
+    EXPECT_EQ(120.0, model.power_tdp);
+    EXPECT_EQ(0.1, model.variation);
+    EXPECT_EQ(7.0, model.seed);
+    EXPECT_EQ(2.2e9, model.freq_max);
+    EXPECT_EQ(0.8, model.freq_sensitivity);
+    EXPECT_EQ(2.2e9, SimPlatformIOGroup::parse_model("{}").freq_max);
+    GEOPM_EXPECT_THROW_MESSAGE(SimPlatformIOGroup::parse_model("{\"power_tpd\" : 120}"),
+                               GEOPM_ERROR_FILE_PARSE, "unknown model parameter: power_tpd");
+    GEOPM_EXPECT_THROW_MESSAGE(SimPlatformIOGroup::parse_model("{\"power_tdp\" : \"120\"}"),
+                               GEOPM_ERROR_FILE_PARSE, "not a number: power_tdp");
+    GEOPM_EXPECT_THROW_MESSAGE(SimPlatformIOGroup::parse_model("[120]"),
+                               GEOPM_ERROR_FILE_PARSE, "malformed json");
+    m_model.freq_min = 3.0e9;
+    GEOPM_EXPECT_THROW_MESSAGE(make_group(), GEOPM_ERROR_INVALID, "invalid model");
+}
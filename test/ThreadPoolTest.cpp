@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ThreadPool.hpp"
+#include "Exception.hpp"
+#include "geopm_test.hpp"
+
+using geopm::ThreadPool;
+
+TEST(ThreadPoolTest, serial)
+{
+    ThreadPool pool(0);
+    EXPECT_EQ(1, pool.num_thread());
+    std::vector<size_t> order;
+    std::thread::id caller = std::this_thread::get_id();
+    pool.parallel_for(3, 8, [&order, caller](size_t idx) {
+        EXPECT_EQ(caller, std::this_thread::get_id());
+        order.push_back(idx);
+    });
+    EXPECT_EQ(std::vector<size_t>({3, 4, 5, 6, 7}), order);
+    pool.parallel_for(5, 5, [](size_t idx) {
+        FAIL() << "empty range";
+    });
+}
+
+TEST(ThreadPoolTest, parallel)
+{
+    ThreadPool pool(4);
+    EXPECT_EQ(4, pool.num_thread());
+    const size_t num_item = 1000;
+    std::vector<std::atomic<int> > count(num_item);
+    for (int rep = 0; rep < 50; ++rep) {
+        pool.parallel_for(0, num_item, [&count](size_t idx) {
+            ++count[idx];
+        });
+    }
+    for (size_t idx = 0; idx != num_item; ++idx) {
+        EXPECT_EQ(50, count[idx]);
+    }
+    // fewer items than chunks
+    std::vector<int> small(3, 0);
+    pool.parallel_for(0, small.size(), [&small](size_t idx) {
+        small[idx] = idx + 1;
+    });
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), small);
+}
+
+TEST(ThreadPoolTest, nested)
+{
+    ThreadPool pool(3);
+    std::vector<std::vector<int> > result(6, std::vector<int>(4, 0));
+    pool.parallel_for(0, result.size(), [&pool, &result](size_t outer) {
+        pool.parallel_for(0, result[outer].size(), [&result, outer](size_t inner) {
+            result[outer][inner] = outer * 10 + inner;
+        });
+    });
+    for (size_t outer = 0; outer != result.size(); ++outer) {
+        for (size_t inner = 0; inner != result[outer].size(); ++inner) {
+            EXPECT_EQ((int)(outer * 10 + inner), result[outer][inner]);
+        }
+    }
+}
+
+TEST(ThreadPoolTest, negative_exception)
+{
+    ThreadPool pool(4);
+    std::atomic<int> num_call(0);
+    GEOPM_EXPECT_THROW_MESSAGE(
+        pool.parallel_for(0, 100, [&num_call](size_t idx) {
+            ++num_call;
+            if (idx == 37) {
+                throw geopm::Exception("item 37 failed", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }),
+        GEOPM_ERROR_INVALID, "item 37 failed");
+    EXPECT_LE(1, num_call);
+    // pool is usable after an exception
+    std::atomic<int> sum(0);
+    pool.parallel_for(0, 10, [&sum](size_t idx) {
+        sum += idx;
+    });
+    EXPECT_EQ(45, sum);
+}
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <endian.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <future>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "TraceBlockWriter.hpp"
+#include "TraceCodec.hpp"
+#include "Tracer.hpp"
+#include "Helper.hpp"
+#include "Exception.hpp"
+#include "MockPlatformIO.hpp"
+#include "geopm_test.hpp"
+
+using geopm::TraceBlockWriter;
+using geopm::ITraceCodec;
+using geopm::LZ4TraceCodec;
+using testing::HasSubstr;
+using testing::NiceMock;
+
+/// Codec that stalls in compress() until released, or throws.
+class StallTraceCodec : public ITraceCodec
+{
+    public:
+        StallTraceCodec(std::shared_future<void> release, std::promise<void> &entered,
+                        bool is_throw)
+            : m_release(release)
+            , m_entered(entered)
+            , m_is_entered(false)
+            , m_is_throw(is_throw)
+        {
+
+        }
+        virtual ~StallTraceCodec() = default;
+        std::string name(void) const override
+        {
+            return "lz4";
+        }
+        void compress(const char *in, size_t in_size, std::vector<char> &out) override
+        {
+            if (!m_is_entered) {
+                m_is_entered = true;
+                m_entered.set_value();
+            }
+            m_release.wait();
+            if (m_is_throw) {
+                throw geopm::Exception("StallTraceCodec: compress failed",
+                                       GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            m_lz4.compress(in, in_size, out);
+        }
+        void decompress(const char *in, size_t in_size,
+                        size_t out_size, std::vector<char> &out) override
+        {
+            m_lz4.decompress(in, in_size, out_size, out);
+        }
+    private:
+        std::shared_future<void> m_release;
+        std::promise<void> &m_entered;
+        bool m_is_entered;
+        bool m_is_throw;
+        LZ4TraceCodec m_lz4;
+};
+
+class TraceBlockWriterTest : public ::testing::Test
+{
+    protected:
+        void TearDown(void);
+        /// Decompress every block of the file, returns the codec
+        /// name, the text and the statistics line.
+        void read_blocks(const std::string &path, std::string &codec,
+                         std::string &text, std::string &stats);
+        std::string m_path = "test.trace_block";
+};
+
+void TraceBlockWriterTest::TearDown(void)
+{
+    std::remove(m_path.c_str());
+    std::remove((m_path + "-myhost.gtb").c_str());
+}
+
+void TraceBlockWriterTest::read_blocks(const std::string &path, std::string &codec,
+                                       std::string &text, std::string &stats)
+{
+    std::ifstream stream(path, std::ios::binary);
+    ASSERT_TRUE(stream.good());
+    std::string data((std::istreambuf_iterator<char>(stream)),
+                     std::istreambuf_iterator<char>());
+    size_t pos = data.find('\n');
+    ASSERT_NE(std::string::npos, pos);
+    codec = data.substr(0, pos);
+    ++pos;
+    LZ4TraceCodec lz4;
+    std::vector<char> block;
+    text.clear();
+    while (pos + TraceBlockWriter::M_BLOCK_HEADER_SIZE <= data.size()) {
+        uint32_t header[3];
+        memcpy(header, data.data() + pos, sizeof(header));
+        for (auto &field : header) {
+            field = le32toh(field);
+        }
+        if (header[0] != TraceBlockWriter::M_BLOCK_MAGIC) {
+            break;
+        }
+        pos += sizeof(header);
+        ASSERT_LE(pos + header[2], data.size());
+        lz4.decompress(data.data() + pos, header[2], header[1], block);
+        text.append(block.begin(), block.end());
+        pos += header[2];
+    }
+    stats = data.substr(pos);
+}
+
+TEST_F(TraceBlockWriterTest, round_trip)
+{
+    std::string expected;
+    {
+        TraceBlockWriter writer(m_path, geopm::make_unique<LZ4TraceCodec>());
+        // No more blocks than the queue holds, so none are dropped
+        for (int block = 0; block < TraceBlockWriter::M_MAX_QUEUE; ++block) {
+            std::ostringstream lines;
+            for (int row = 0; row < 100; ++row) {
+                lines << block << "|" << row << "|" << block * row << "\n";
+            }
+            expected += lines.str();
+            writer.write(lines.str());
+        }
+        writer.write("");
+        writer.close();
+        EXPECT_EQ(0u, writer.num_dropped());
+        EXPECT_EQ(expected.size(), writer.raw_bytes());
+        EXPECT_LT(writer.compressed_bytes(), writer.raw_bytes());
+        EXPECT_THAT(writer.stats(), HasSubstr("\"codec\" : \"lz4\""));
+        GEOPM_EXPECT_THROW_MESSAGE(writer.write("1|2|3\n"), GEOPM_ERROR_RUNTIME,
+                                   "called after close()");
+    }
+    std::string codec, text, stats;
+    read_blocks(m_path, codec, text, stats);
+    EXPECT_EQ("GEOPM_TRACE_BLOCKS lz4", codec);
+    EXPECT_EQ(expected, text);
+    EXPECT_THAT(stats, HasSubstr("\"raw_bytes\" : " + std::to_string(expected.size())));
+    EXPECT_THAT(stats, HasSubstr("\"ratio\""));
+    EXPECT_THAT(stats, HasSubstr("\"throughput_mb_per_sec\""));
+}
+
+TEST_F(TraceBlockWriterTest, tracer)
+{
+    NiceMock<MockPlatformIO> platform_io;
+    {
+        // Unknown codec falls back to lz4
+        geopm::Tracer tracer(m_path, "myhost", true, platform_io, {"EXTRA"},
+                             1, false, 0.0, 0, "not_a_codec");
+        tracer.columns({"col1"});
+        for (int idx = 0; idx < 10; ++idx) {
+            tracer.update({idx * 1.0}, {});
+        }
+        tracer.flush();
+    }
+    std::string codec, text, stats;
+    read_blocks(m_path + "-myhost.gtb", codec, text, stats);
+    EXPECT_EQ("GEOPM_TRACE_BLOCKS lz4", codec);
+    EXPECT_THAT(text, HasSubstr("# \"node_name\" : \"myhost\"\n"));
+    EXPECT_THAT(text, HasSubstr("|extra|col1\n"));
+    EXPECT_EQ(10 + 7, std::count(text.begin(), text.end(), '\n'));
+    EXPECT_THAT(stats, HasSubstr("\"compression\""));
+}
+
+TEST_F(TraceBlockWriterTest, drop_when_full)
+{
+    std::promise<void> release;
+    std::promise<void> entered;
+    std::string expected;
+    {
+        TraceBlockWriter writer(m_path, geopm::make_unique<StallTraceCodec>(
+                                    release.get_future().share(), entered, false));
+        // First block is held inside compress()
+        expected += "0|0\n";
+        writer.write("0|0\n");
+        entered.get_future().wait();
+        for (int block = 1; block <= TraceBlockWriter::M_MAX_QUEUE; ++block) {
+            std::string line = std::to_string(block) + "|0\n";
+            expected += line;
+            writer.write(std::string(line));
+        }
+        // Queue is full: these return without blocking and are dropped
+        for (int block = 0; block < 5; ++block) {
+            writer.write("dropped\n");
+        }
+        EXPECT_EQ(5u, writer.num_dropped());
+        release.set_value();
+        writer.close();
+        EXPECT_EQ(expected.size(), writer.raw_bytes());
+    }
+    std::string codec, text, stats;
+    read_blocks(m_path, codec, text, stats);
+    EXPECT_EQ(expected, text);
+    EXPECT_THAT(stats, HasSubstr("\"dropped_blocks\" : 5, "));
+    EXPECT_THAT(stats, HasSubstr("\"dropped_bytes\" : 40, "));
+}
+
+TEST_F(TraceBlockWriterTest, codec_error)
+{
+    std::promise<void> release;
+    std::promise<void> entered;
+    TraceBlockWriter writer(m_path, geopm::make_unique<StallTraceCodec>(
+                                release.get_future().share(), entered, true));
+    writer.write("1|2|3\n");
+    entered.get_future().wait();
+    release.set_value();
+    GEOPM_EXPECT_THROW_MESSAGE(writer.close(), GEOPM_ERROR_RUNTIME,
+                               "compress failed");
+    // The error is reported once
+    writer.close();
+
+    std::promise<void> release_write;
+    std::promise<void> entered_write;
+    TraceBlockWriter writer_next(m_path, geopm::make_unique<StallTraceCodec>(
+                                     release_write.get_future().share(), entered_write, true));
+    writer_next.write("1|2|3\n");
+    entered_write.get_future().wait();
+    release_write.set_value();
+    // Once the background thread has failed the next write() throws
+    bool is_thrown = false;
+    for (int retry = 0; !is_thrown && retry < 10000; ++retry) {
+        try {
+            writer_next.write("4|5|6\n");
+            usleep(100);
+        }
+        catch (const geopm::Exception &ex) {
+            EXPECT_THAT(ex.what(), HasSubstr("compress failed"));
+            is_thrown = true;
+        }
+    }
+    EXPECT_TRUE(is_thrown);
+    writer_next.close();
+}
+
+TEST_F(TraceBlockWriterTest, stream_error)
+{
+    TraceBlockWriter writer("/dev/full", geopm::make_unique<LZ4TraceCodec>());
+    std::string block(1 << 16, 'x');
+    block.back() = '\n';
+    writer.write(std::move(block));
+    GEOPM_EXPECT_THROW_MESSAGE(writer.close(), GEOPM_ERROR_RUNTIME,
+                               "failed to write to trace file");
+}
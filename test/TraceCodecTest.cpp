@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "TraceCodec.hpp"
+#include "Exception.hpp"
+#include "geopm_test.hpp"
+
+using geopm::ITraceCodec;
+using geopm::LZ4TraceCodec;
+
+class TraceCodecTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        void check_round_trip(const std::string &input);
+        std::unique_ptr<ITraceCodec> m_codec;
+};
+
+void TraceCodecTest::SetUp(void)
+{
+    m_codec = geopm::trace_codec_factory().make_plugin(LZ4TraceCodec::plugin_name());
+}
+
+void TraceCodecTest::check_round_trip(const std::string &input)
+{
+    std::vector<char> compressed;
+    std::vector<char> result;
+    m_codec->compress(input.data(), input.size(), compressed);
+    m_codec->decompress(compressed.data(), compressed.size(), input.size(), result);
+    EXPECT_EQ(input, std::string(result.begin(), result.end()));
+}
+
+TEST_F(TraceCodecTest, factory)
+{
+    std::vector<std::string> names = geopm::trace_codec_factory().plugin_names();
+    EXPECT_NE(names.end(), std::find(names.begin(), names.end(), "lz4"));
+    EXPECT_EQ("lz4", m_codec->name());
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::trace_codec_factory().make_plugin("not_a_codec"),
+                               GEOPM_ERROR_INVALID, "not_a_codec");
+}
+
+TEST_F(TraceCodecTest, lz4_round_trip)
+{
+    check_round_trip("");
+    check_round_trip("a");
+    check_round_trip("seconds|region_id|");
+    std::ostringstream trace;
+    trace << std::setprecision(16);
+    for (int row = 0; row < 10000; ++row) {
+        trace << row * 0.005 << "|0x0000000000000000|" << 1.5e8 + (row % 7) * 1e3
+              << "|" << 120.0 + (row % 13) << "\n";
+    }
+    std::string text = trace.str();
+    check_round_trip(text);
+    std::vector<char> compressed;
+    m_codec->compress(text.data(), text.size(), compressed);
+    EXPECT_LT(compressed.size(), text.size() / 2);
+}
+
+TEST_F(TraceCodecTest, lz4_long_run)
+{
+    // Literal and match lengths that need the extended length bytes
+    for (size_t length : {14, 15, 16, 19, 269, 270, 271, 100000}) {
+        check_round_trip(std::string(length, 'x'));
+    }
+    std::string noise;
+    uint32_t state = 1;
+    for (int idx = 0; idx < 1000; ++idx) {
+        state = state * 1103515245 + 12345;
+        noise.push_back((char)(state >> 16));
+    }
+    check_round_trip(noise);
+    check_round_trip(noise + std::string(300, 'y') + noise);
+}
+
+TEST_F(TraceCodecTest, lz4_corrupt)
+{
+    std::string input(1000, 'z');
+    std::vector<char> compressed;
+    std::vector<char> result;
+    m_codec->compress(input.data(), input.size(), compressed);
+    // Wrong uncompressed size
+    GEOPM_EXPECT_THROW_MESSAGE(m_codec->decompress(compressed.data(), compressed.size(),
+                                                   input.size() - 1, result),
+                               GEOPM_ERROR_INVALID, "block is corrupt");
+    // Truncated block
+    GEOPM_EXPECT_THROW_MESSAGE(m_codec->decompress(compressed.data(), compressed.size() - 1,
+                                                   input.size(), result),
+                               GEOPM_ERROR_INVALID, "block is corrupt");
+    // Back reference before the start of the block
+    std::vector<char> bad {(char)0x10, 'a', (char)0x08, (char)0x00, (char)0x00};
+    GEOPM_EXPECT_THROW_MESSAGE(m_codec->decompress(bad.data(), bad.size(), 5, result),
+                               GEOPM_ERROR_INVALID, "block is corrupt");
+}
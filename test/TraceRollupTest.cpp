@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "TraceRollup.hpp"
+#include "PlatformIO.hpp"
+#include "PlatformTopo.hpp"
+#include "MockPlatformIO.hpp"
+#include "MockTreeComm.hpp"
+#include "geopm_test.hpp"
+
+using geopm::TraceRollup;
+using geopm::IPlatformTopo;
+using testing::_;
+using testing::Return;
+
+class TraceRollupTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        void TearDown(void);
+        void expect_columns(void);
+        std::vector<std::vector<double> > read_lines(void);
+        MockPlatformIO m_platform_io;
+        MockTreeComm *m_tree_comm;
+        std::string m_path = "test.trace_rollup";
+        std::vector<std::string> m_default_cols;
+        std::vector<std::string> m_extra_cols;
+        std::vector<std::string> m_agent_cols;
+        size_t m_num_col;
+};
+
+void TraceRollupTest::SetUp(void)
+{
+    std::remove(m_path.c_str());
+    m_default_cols = {"REGION_PROGRESS", "REGION_RUNTIME", "ENERGY_PACKAGE",
+                      "ENERGY_DRAM", "POWER_PACKAGE", "FREQUENCY"};
+    m_extra_cols = {"EXTRA"};
+    m_agent_cols = {"col1"};
+    m_num_col = m_default_cols.size() + m_extra_cols.size() + m_agent_cols.size();
+    m_tree_comm = new MockTreeComm;
+}
+
+void TraceRollupTest::TearDown(void)
+{
+    std::remove(m_path.c_str());
+}
+
+void TraceRollupTest::expect_columns(void)
+{
+    int idx = 0;
+    for (const auto &name : m_default_cols) {
+        EXPECT_CALL(m_platform_io, push_signal(name, IPlatformTopo::M_DOMAIN_BOARD, 0))
+            .WillOnce(Return(idx));
+        EXPECT_CALL(m_platform_io, sample(idx))
+            .WillRepeatedly(Return(idx + 0.5));
+        ++idx;
+    }
+    for (const auto &name : m_extra_cols) {
+        EXPECT_CALL(m_platform_io, push_signal(name, IPlatformTopo::M_DOMAIN_BOARD, 0))
+            .WillOnce(Return(idx));
+        EXPECT_CALL(m_platform_io, sample(idx))
+            .WillRepeatedly(Return(idx + 0.5));
+        ++idx;
+    }
+}
+
+std::vector<std::vector<double> > TraceRollupTest::read_lines(void)
+{
+    std::vector<std::vector<double> > result;
+    std::ifstream stream(m_path);
+    std::string line;
+    // Two comment lines and the column names
+    for (int header_idx = 0; header_idx < 3; ++header_idx) {
+        std::getline(stream, line);
+    }
+    EXPECT_EQ(3 * m_num_col, (size_t)std::count(line.begin(), line.end(), '|'));
+    while (std::getline(stream, line)) {
+        std::vector<double> values;
+        std::istringstream line_stream(line);
+        std::string field;
+        while (std::getline(line_stream, field, '|')) {
+            values.push_back(std::stod(field));
+        }
+        result.push_back(values);
+    }
+    return result;
+}
+
+TEST_F(TraceRollupTest, single_node)
+{
+    EXPECT_CALL(*m_tree_comm, num_level_controlled()).WillOnce(Return(0));
+    EXPECT_CALL(*m_tree_comm, root_level()).WillOnce(Return(0));
+    expect_columns();
+    TraceRollup rollup(nullptr, m_path, true, 0.0, m_platform_io, m_extra_cols, 4,
+                       std::unique_ptr<MockTreeComm>(m_tree_comm));
+    rollup.columns(m_agent_cols);
+    rollup.update({10.0});
+    rollup.update({NAN});
+    rollup.flush();
+    rollup.update({20.0}); // no additional lines after flush
+
+    auto lines = read_lines();
+    ASSERT_EQ(2u, lines.size());
+    ASSERT_EQ(1 + 3 * m_num_col, lines[0].size());
+    // Platform column with index 4
+    EXPECT_EQ(4.5, lines[0][1 + 3 * 4]);
+    EXPECT_EQ(4.5, lines[0][2 + 3 * 4]);
+    EXPECT_EQ(4.5, lines[0][3 + 3 * 4]);
+    // Agent column
+    size_t agent_off = 1 + 3 * (m_num_col - 1);
+    EXPECT_EQ(10.0, lines[0][agent_off]);
+    EXPECT_TRUE(std::isnan(lines[1][agent_off]));
+    EXPECT_EQ(0, m_tree_comm->num_send());
+}
+
+TEST_F(TraceRollupTest, buffer_limit)
+{
+    EXPECT_CALL(*m_tree_comm, num_level_controlled()).WillOnce(Return(0));
+    EXPECT_CALL(*m_tree_comm, root_level()).WillOnce(Return(0));
+    expect_columns();
+    TraceRollup rollup(nullptr, m_path, true, 0.0, m_platform_io, m_extra_cols, 4,
+                       std::unique_ptr<MockTreeComm>(m_tree_comm));
+    rollup.columns(m_agent_cols);
+    // Each line is more than 200 bytes, enough to pass the 1 MiB
+    // buffer limit before the flush at shutdown
+    int num_line = 8000;
+    for (int line_idx = 0; line_idx < num_line; ++line_idx) {
+        rollup.update({1.0 * line_idx});
+    }
+    struct stat stat_struct;
+    ASSERT_EQ(0, stat(m_path.c_str(), &stat_struct));
+    EXPECT_LT(0, stat_struct.st_size);
+    rollup.flush();
+
+    auto lines = read_lines();
+    ASSERT_EQ((size_t)num_line, lines.size());
+    size_t agent_off = 1 + 3 * (m_num_col - 1);
+    EXPECT_EQ(num_line - 1.0, lines.back()[agent_off]);
+}
+
+TEST_F(TraceRollupTest, combine_children)
+{
+    EXPECT_CALL(*m_tree_comm, num_level_controlled()).WillOnce(Return(1));
+    EXPECT_CALL(*m_tree_comm, root_level()).WillOnce(Return(1));
+    EXPECT_CALL(*m_tree_comm, level_size(0)).WillOnce(Return(2));
+    expect_columns();
+    TraceRollup rollup(nullptr, m_path, true, 0.0, m_platform_io, m_extra_cols, 4,
+                       std::unique_ptr<MockTreeComm>(m_tree_comm));
+    rollup.columns(m_agent_cols);
+
+    // Other child summarizes two samples in its window
+    std::vector<double> child_summary;
+    for (size_t col_idx = 0; col_idx < m_num_col; ++col_idx) {
+        child_summary.insert(child_summary.end(), {2.0, -1.0, 10.0, 20.0});
+    }
+    ASSERT_EQ(m_num_col * TraceRollup::M_NUM_FIELD, child_summary.size());
+    m_tree_comm->send_up_mock_child(0, 1, child_summary);
+
+    rollup.update({88.0});
+    rollup.flush();
+
+    auto lines = read_lines();
+    ASSERT_EQ(1u, lines.size());
+    ASSERT_EQ(1 + 3 * m_num_col, lines[0].size());
+    EXPECT_EQ(-1.0, lines[0][1]);
+    EXPECT_NEAR((0.5 + 10.0) / 3, lines[0][2], 1e-3);
+    EXPECT_EQ(20.0, lines[0][3]);
+    size_t agent_off = 1 + 3 * (m_num_col - 1);
+    EXPECT_EQ(-1.0, lines[0][agent_off]);
+    EXPECT_NEAR((88.0 + 10.0) / 3, lines[0][agent_off + 1], 1e-3);
+    EXPECT_EQ(88.0, lines[0][agent_off + 2]);
+}
+
+TEST_F(TraceRollupTest, leaf_window)
+{
+    EXPECT_CALL(*m_tree_comm, num_level_controlled()).WillOnce(Return(0));
+    EXPECT_CALL(*m_tree_comm, root_level()).WillOnce(Return(2));
+    expect_columns();
+    TraceRollup rollup(nullptr, m_path, true, 1e6, m_platform_io, m_extra_cols, 4,
+                       std::unique_ptr<MockTreeComm>(m_tree_comm));
+    rollup.columns(m_agent_cols);
+    // Window period has not elapsed, nothing is sent
+    rollup.update({1.0});
+    rollup.update({2.0});
+    EXPECT_EQ(0, m_tree_comm->num_send());
+    rollup.flush();
+    // Only the root writes a file
+    EXPECT_NE(0, access(m_path.c_str(), F_OK));
+}
+
+TEST_F(TraceRollupTest, disabled)
+{
+    EXPECT_CALL(m_platform_io, push_signal(_, _, _)).Times(0);
+    TraceRollup rollup(nullptr, m_path, false, 0.0, m_platform_io, m_extra_cols, 4,
+                       std::unique_ptr<MockTreeComm>(m_tree_comm));
+    rollup.columns(m_agent_cols);
+    rollup.update({1.0});
+    rollup.flush();
+    EXPECT_EQ(0, m_tree_comm->num_send());
+    EXPECT_NE(0, access(m_path.c_str(), F_OK));
+}
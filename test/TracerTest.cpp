@@ -100,7 +100,7 @@ void check_trace(std::istream &expected, std::istream &result);
 
 TEST_F(TracerTest, columns)
 {
-    Tracer tracer(m_path, m_hostname, true, m_platform_io, m_extra_cols, 1);
+    Tracer tracer(m_path, m_hostname, true, m_platform_io, m_extra_cols, 1, false, 0.0, 0, "");
 
     // columns from agent will be printed as-is
     std::vector<std::string> agent_cols {"col1", "col2"};
@@ -126,7 +126,7 @@ TEST_F(TracerTest, columns)
 
 TEST_F(TracerTest, update_samples)
 {
-    Tracer tracer(m_path, m_hostname, true, m_platform_io, m_extra_cols, 1);
+    Tracer tracer(m_path, m_hostname, true, m_platform_io, m_extra_cols, 1, false, 0.0, 0, "");
     int idx = 0;
     for (auto cc : m_default_cols) {
         EXPECT_CALL(m_platform_io, sample(idx))
@@ -156,7 +156,7 @@ TEST_F(TracerTest, update_samples)
 
 TEST_F(TracerTest, region_entry_exit)
 {
-    Tracer tracer(m_path, m_hostname, true, m_platform_io, m_extra_cols, 1);
+    Tracer tracer(m_path, m_hostname, true, m_platform_io, m_extra_cols, 1, false, 0.0, 0, "");
     EXPECT_CALL(m_platform_io, sample(_)).Times(m_default_cols.size() + m_extra_cols.size())
         .WillOnce(Return(2.2))  // time
         .WillOnce(Return(2.2))  // region id
@@ -193,6 +193,50 @@ TEST_F(TracerTest, region_entry_exit)
      check_trace(expected, result);
 }
 
+TEST_F(TracerTest, adaptive)
+{
+    Tracer tracer(m_path, m_hostname, true, m_platform_io, m_extra_cols, 1, true, 0.1, 1, "");
+    double time = 0.0;
+    double value = 1.0;
+    EXPECT_CALL(m_platform_io, sample(_))
+        .WillRepeatedly(testing::Invoke([&time, &value](int idx) {
+                    double result = value;
+                    if (idx == 0) {
+                        result = time;
+                    }
+                    else if (idx == 1) {
+                        result = geopm_field_to_signal(0x123);
+                    }
+                    return result;
+                }));
+    std::vector<std::string> agent_cols {"col1"};
+    std::vector<double> agent_vals {5.0};
+    tracer.columns(agent_cols);
+    // Second row is written by the burst, the next three are within
+    // tolerance, and the change at time 5 writes the row before it
+    // and starts a new burst.
+    std::vector<double> step_value {1.0, 1.0, 1.01, 1.02, 1.03, 2.0, 2.0, 2.0};
+    for (double val : step_value) {
+        value = val;
+        tracer.update(agent_vals, {});
+        time += 1.0;
+    }
+    tracer.flush();
+
+    std::string expected_str = "\n\n\n\n\n\n\n"
+        "0.0e+00|0x0000000000000123|1.0|1.0e+00\n"
+        "1.0e+00|0x0000000000000123|1.0|1.0e+00\n"
+        "# gap 2 2.0e+00 3.0e+00\n"
+        "4.0e+00|0x0000000000000123|1.0|1.0e+00\n"
+        "5.0e+00|0x0000000000000123|2.0|2.0e+00\n"
+        "6.0e+00|0x0000000000000123|2.0|2.0e+00\n"
+        "7.0e+00|0x0000000000000123|2.0|2.0e+00\n";
+    std::istringstream expected(expected_str);
+    std::ifstream result(m_path + "-" + m_hostname);
+    ASSERT_TRUE(result.good()) << strerror(errno);
+    check_trace(expected, result);
+}
+
 /// @todo This is shared with ReporterTest; can be put in common file
 void check_trace(std::istream &expected, std::istream &result)
 {
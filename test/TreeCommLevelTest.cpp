@@ -219,6 +219,71 @@ TEST_F(TreeCommLevelTest, send_down)
                                GEOPM_ERROR_INVALID, "policy vector is not sized correctly");
 }
 
+TEST_F(TreeCommLevelTest, send_down_view)
+{
+    std::vector<double> policy {2.2, 3.3,
+                                2.9, 3.9,
+                                2.1, 3.1,
+                                2.0, 3.0};
+    geopm::MatrixView<const double> policy_view(policy.data(), m_num_rank, m_num_down);
+    size_t msg_size = sizeof(double) * m_num_down;
+
+    // Only the children are sent policies through the window, and
+    // a repeated policy is not sent again.
+    EXPECT_CALL(*m_comm_0, window_lock(_, _, _, _)).Times(m_num_rank - 1);
+    EXPECT_CALL(*m_comm_0, window_unlock(_, _)).Times(m_num_rank - 1);
+    EXPECT_CALL(*m_comm_0, window_put(_, sizeof(double), _, _, _)).Times(m_num_rank - 1);
+    EXPECT_CALL(*m_comm_0, window_put(_, msg_size, _, _, _)).Times(m_num_rank - 1);
+
+    m_level_rank_0->send_down_view(policy_view);
+    m_level_rank_0->send_down_view(policy_view);
+    EXPECT_EQ((sizeof(double) + msg_size) * (m_num_rank - 1), m_level_rank_0->overhead_send());
+    EXPECT_EQ(1.0, m_policy_mem_0[0]);
+    EXPECT_EQ(2.2, m_policy_mem_0[1]);
+    EXPECT_EQ(3.3, m_policy_mem_0[2]);
+
+    // A change for a single child is sent only to that child
+    policy[5] = 3.2;
+    EXPECT_CALL(*m_comm_0, window_lock(_, _, 2, _));
+    EXPECT_CALL(*m_comm_0, window_unlock(_, 2));
+    EXPECT_CALL(*m_comm_0, window_put(_, sizeof(double), 2, _, _));
+    EXPECT_CALL(*m_comm_0, window_put(_, msg_size, 2, _, _));
+    m_level_rank_0->send_down_view(policy_view);
+
+    geopm::MatrixView<const double> bad_view(policy.data(), m_num_rank - 1, m_num_down);
+    GEOPM_EXPECT_THROW_MESSAGE(m_level_rank_0->send_down_view(bad_view),
+                               GEOPM_ERROR_INVALID, "policy matrix is not sized correctly");
+}
+
+TEST_F(TreeCommLevelTest, receive_up_view)
+{
+    std::vector<double> sample {44.4, 33.3, 22.2,
+                                41.1, 31.1, 21.1,
+                                46.6, 36.6, 26.6,
+                                45.5, 35.5, 25.5};
+    std::vector<double> sample_out(m_num_rank * m_num_up, 0.0);
+    geopm::MatrixView<double> sample_view(sample_out.data(), m_num_rank, m_num_up);
+
+    EXPECT_CALL(*m_comm_0, window_lock(_, false, _, _)).Times(2); // read
+    EXPECT_CALL(*m_comm_0, window_lock(_, true, _, _)); // write
+    EXPECT_CALL(*m_comm_0, window_unlock(_, _)).Times(3);
+    // mock writing into window
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        m_sample_mem_0[rank * (m_num_up + 1)] = 1.0;
+        memcpy(m_sample_mem_0 + rank * (m_num_up + 1) + 1,
+               sample.data() + rank * m_num_up, m_num_up * sizeof(double));
+    }
+
+    EXPECT_TRUE(m_level_rank_0->receive_up_view(sample_view));
+    EXPECT_EQ(sample, sample_out);
+    // ready flags are cleared after the samples are received
+    EXPECT_FALSE(m_level_rank_0->receive_up_view(sample_view));
+
+    geopm::MatrixView<double> bad_view(sample_out.data(), m_num_rank, m_num_up - 1);
+    GEOPM_EXPECT_THROW_MESSAGE(m_level_rank_0->receive_up_view(bad_view),
+                               GEOPM_ERROR_INVALID, "sample matrix is not sized correctly");
+}
+
 TEST_F(TreeCommLevelTest, receive_up_complete)
 {
     std::vector<std::vector<double> > sample {{44.4, 33.3, 22.2},
@@ -151,6 +151,30 @@ TEST_F(TreeCommTest, send_receive)
 
 }
 
+TEST_F(TreeCommTest, send_receive_view)
+{
+    std::vector<double> policy {9.0, 8.0};
+    std::vector<double> sample(6);
+    geopm::MatrixView<const double> policy_view(policy.data(), 2, 1);
+    geopm::MatrixView<double> sample_view(sample.data(), 2, 3);
+
+    for (int level = 0; level < 4; ++level) {
+        EXPECT_CALL(*(m_level_ptr[level]), send_down_view(_));
+        m_tree_comm->send_down_view(level, policy_view);
+        EXPECT_CALL(*(m_level_ptr[level]), receive_up_view(_)).WillOnce(Return(true));
+        EXPECT_TRUE(m_tree_comm->receive_up_view(level, sample_view));
+    }
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_tree_comm->send_down_view(-1, policy_view),
+                               GEOPM_ERROR_LEVEL_RANGE, "send_down_view");
+    GEOPM_EXPECT_THROW_MESSAGE(m_tree_comm->receive_up_view(-1, sample_view),
+                               GEOPM_ERROR_LEVEL_RANGE, "receive_up_view");
+    GEOPM_EXPECT_THROW_MESSAGE(m_tree_comm->send_down_view(10, policy_view),
+                               GEOPM_ERROR_LEVEL_RANGE, "send_down_view");
+    GEOPM_EXPECT_THROW_MESSAGE(m_tree_comm->receive_up_view(10, sample_view),
+                               GEOPM_ERROR_LEVEL_RANGE, "receive_up_view");
+}
+
 TEST_F(TreeCommTest, overhead_send)
 {
     std::vector<size_t> overhead{67, 78, 89, 90};